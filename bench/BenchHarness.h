@@ -0,0 +1,123 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+// Каркас микробенчмарков для хостовой сборки.
+// Как и тесты, бенчмарки выполняются в задаче FreeRTOS под планировщиком;
+// BenchMain.cpp собирает результаты и пишет их в JSON (stdout или файл из argv[1]).
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bench {
+
+using BenchFn = void (*)();
+
+struct Case {
+    const char* name;
+    BenchFn     fn;
+    Case*       next;
+};
+
+void registerCase(Case* c);
+
+struct Registrar {
+    Registrar(const char* name, BenchFn fn) : c{name, fn, nullptr} {
+        registerCase(&c);
+    }
+    Case c;
+};
+
+// Монотонное время в наносекундах
+uint64_t nowNs();
+
+// Число итераций на сценарий (переменная окружения BENCH_ITERATIONS, по умолчанию 100000)
+uint32_t iterations();
+
+// Приоритет задачи-раннера; вспомогательные задачи создаются относительно него
+constexpr UBaseType_t RunnerPriority = tskIDLE_PRIORITY + 2;
+
+// Накопитель длительностей отдельных операций.
+// Память выделяется заранее, чтобы не мешать измерениям.
+class Recorder {
+  public:
+    explicit Recorder(size_t capacity) {
+        samples.reserve(capacity);
+    }
+
+    void add(uint64_t ns) {
+        if (samples.size() < samples.capacity()) {
+            samples.push_back(static_cast<uint32_t>(ns > UINT32_MAX ? UINT32_MAX : ns));
+        }
+    }
+
+    // Замер вокруг одной операции
+    template <typename F>
+    void measure(F&& op) {
+        uint64_t t0 = nowNs();
+        op();
+        add(nowNs() - t0);
+    }
+
+    size_t count() const {
+        return samples.size();
+    }
+
+    // Добавить замеры другой задачи
+    void merge(const Recorder& other) {
+        for (uint32_t v : other.samples) add(v);
+    }
+
+    std::vector<uint32_t>& data() {
+        return samples;
+    }
+
+  private:
+    std::vector<uint32_t> samples;
+};
+
+// Сохраняет результат сценария.
+// ops    — число операций за wallNs (для ns/op и ops/sec),
+// lat    — поштучные замеры для перцентилей.
+void report(const char* primitive, const char* scenario, const char* op, uint64_t ops, uint64_t wallNs,
+            Recorder& lat);
+
+class Histogram;
+
+// Сохраняет результат-гистограмму (латентность): сводка попадает в results,
+// полная гистограмма — в массив histograms.
+void reportHistogram(const char* primitive, const char* scenario, const char* op, const Histogram& h);
+
+// Ожидание завершения вспомогательных задач
+class Done {
+  public:
+    explicit Done(UBaseType_t tasks) : count(tasks), sem(xSemaphoreCreateCounting(tasks, 0)) {}
+    ~Done() {
+        vSemaphoreDelete(sem);
+    }
+    void signal() {
+        xSemaphoreGive(sem);
+    }
+    bool wait(uint32_t ms = 60000) {
+        for (UBaseType_t i = 0; i < count; ++i) {
+            if (xSemaphoreTake(sem, pdMS_TO_TICKS(ms)) != pdTRUE) return false;
+        }
+        return true;
+    }
+
+  private:
+    UBaseType_t       count;
+    SemaphoreHandle_t sem;
+};
+
+}  // namespace bench
+
+#define BENCHMARK(name)                                          \
+    static void name();                                          \
+    static ::bench::Registrar name##_registrar(#name, &name);    \
+    static void name()
+
+#endif  // BENCH_HARNESS_H
@@ -0,0 +1,183 @@
+#include "BenchHarness.h"
+#include "Histogram.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#ifdef FREERTOS_CPP_SIM
+#include "SimKernel.h"
+#endif
+
+#ifndef FREERTOS_CPP_BACKEND
+#define FREERTOS_CPP_BACKEND "unknown"
+#endif
+
+namespace bench {
+
+namespace {
+
+struct Result {
+    std::string primitive;
+    std::string scenario;
+    std::string op;
+    uint64_t    ops;
+    uint64_t    samples;
+    double      nsPerOp;
+    double      opsPerSec;
+    uint64_t    p50, p99, p999, max;
+    std::string histogram;  // JSON гистограммы, если есть
+};
+
+Case*               firstCase = nullptr;
+Case*               lastCase  = nullptr;
+std::vector<Result> results;
+const char*         onlyCase  = nullptr;
+std::string         suiteName = "bench";
+
+uint32_t percentile(const std::vector<uint32_t>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+void writeJson(FILE* out) {
+    std::fprintf(out, "{\n  \"suite\": \"%s\",\n  \"backend\": \"%s\",\n", suiteName.c_str(),
+                 FREERTOS_CPP_BACKEND);
+    std::fprintf(out, "  \"tick_rate_hz\": %u,\n  \"iterations\": %u,\n", unsigned(configTICK_RATE_HZ),
+                 unsigned(iterations()));
+    std::fprintf(out, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(out,
+                     "    {\"primitive\": \"%s\", \"scenario\": \"%s\", \"op\": \"%s\", \"ops\": %llu, "
+                     "\"samples\": %llu, \"ns_per_op\": %.1f, \"ops_per_sec\": %.0f, "
+                     "\"p50_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu}%s\n",
+                     r.primitive.c_str(), r.scenario.c_str(), r.op.c_str(), (unsigned long long)r.ops,
+                     (unsigned long long)r.samples, r.nsPerOp, r.opsPerSec, (unsigned long long)r.p50,
+                     (unsigned long long)r.p99, (unsigned long long)r.p999, (unsigned long long)r.max,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ],\n  \"histograms\": [");
+    bool first = true;
+    for (const Result& r : results) {
+        if (r.histogram.empty()) continue;
+        std::fprintf(out, "%s\n    {\"primitive\": \"%s\", \"scenario\": \"%s\", \"op\": \"%s\", \"histogram\": %s}",
+                     first ? "" : ",", r.primitive.c_str(), r.scenario.c_str(), r.op.c_str(), r.histogram.c_str());
+        first = false;
+    }
+    std::fprintf(out, "%s]\n}\n", first ? "" : "\n  ");
+}
+
+void runnerTask(void*) {
+    for (Case* c = firstCase; c; c = c->next) {
+        if (onlyCase && std::string(c->name).find(onlyCase) == std::string::npos) continue;
+        std::fprintf(stderr, "[ RUN  ] %s\n", c->name);
+        c->fn();
+    }
+    vTaskEndScheduler();
+    vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+void registerCase(Case* c) {
+    if (lastCase) {
+        lastCase->next = c;
+    } else {
+        firstCase = c;
+    }
+    lastCase = c;
+}
+
+uint64_t nowNs() {
+#ifdef FREERTOS_CPP_SIM
+    // В симуляторе замеряем виртуальное время: результат зависит только от модели стоимости
+    return sim::nowNs();
+#else
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+uint32_t iterations() {
+    static uint32_t n = [] {
+        const char* env = std::getenv("BENCH_ITERATIONS");
+        long        v   = env ? std::strtol(env, nullptr, 10) : 0;
+        return v > 0 ? static_cast<uint32_t>(v) : 100000u;
+    }();
+    return n;
+}
+
+void report(const char* primitive, const char* scenario, const char* op, uint64_t ops, uint64_t wallNs,
+            Recorder& lat) {
+    std::vector<uint32_t>& s = lat.data();
+    std::sort(s.begin(), s.end());
+
+    Result r;
+    r.primitive = primitive;
+    r.scenario  = scenario;
+    r.op        = op;
+    r.ops       = ops;
+    r.samples   = s.size();
+    r.nsPerOp   = ops ? static_cast<double>(wallNs) / static_cast<double>(ops) : 0.0;
+    r.opsPerSec = r.nsPerOp > 0 ? 1e9 / r.nsPerOp : 0.0;
+    r.p50       = percentile(s, 0.50);
+    r.p99       = percentile(s, 0.99);
+    r.p999      = percentile(s, 0.999);
+    r.max       = s.empty() ? 0 : s.back();
+    results.push_back(r);
+
+    std::fprintf(stderr, "  %-12s %-16s %-28s %9.1f ns/op  p50=%llu p99=%llu p99.9=%llu\n", primitive, scenario, op,
+                 r.nsPerOp, (unsigned long long)r.p50, (unsigned long long)r.p99, (unsigned long long)r.p999);
+    s.clear();
+}
+
+void reportHistogram(const char* primitive, const char* scenario, const char* op, const Histogram& h) {
+    Result r;
+    r.primitive = primitive;
+    r.scenario  = scenario;
+    r.op        = op;
+    r.ops       = h.count();
+    r.samples   = h.count();
+    r.nsPerOp   = h.mean();
+    r.opsPerSec = r.nsPerOp > 0 ? 1e9 / r.nsPerOp : 0.0;
+    r.p50       = h.percentile(0.50);
+    r.p99       = h.percentile(0.99);
+    r.p999      = h.percentile(0.999);
+    r.max       = h.max();
+    r.histogram = h.toJson();
+    results.push_back(r);
+
+    std::fprintf(stderr, "  %-12s %-16s %-12s mean=%.0f p50=%llu p99=%llu p99.9=%llu p99.99=%llu max=%llu ns\n",
+                 primitive, scenario, op, h.mean(), (unsigned long long)r.p50, (unsigned long long)r.p99,
+                 (unsigned long long)r.p999, (unsigned long long)h.percentile(0.9999), (unsigned long long)r.max);
+}
+
+}  // namespace bench
+
+// bench_xxx [out.json] [filter]
+int main(int argc, char** argv) {
+    const char* outPath = argc > 1 ? argv[1] : nullptr;
+    const char* slash   = std::strrchr(argv[0], '/');
+    bench::suiteName    = slash ? slash + 1 : argv[0];
+    if (argc > 2) bench::onlyCase = argv[2];
+
+    xTaskCreate(bench::runnerTask, "bench", configMINIMAL_STACK_SIZE * 4, nullptr, bench::RunnerPriority, nullptr);
+    vTaskStartScheduler();
+
+    FILE* out = stdout;
+    if (outPath && std::string(outPath) != "-") {
+        out = std::fopen(outPath, "w");
+        if (!out) {
+            std::perror(outPath);
+            return 1;
+        }
+    }
+    bench::writeJson(out);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,127 @@
+#ifndef BENCH_HISTOGRAM_H
+#define BENCH_HISTOGRAM_H
+
+// Лог-линейная гистограмма в духе HdrHistogram.
+// Значения до 128 нс хранятся точно, дальше — 64 под-корзины на каждую
+// степень двойки (относительная погрешность < 1.6%). Запись — O(1), без аллокаций,
+// поэтому гистограмму можно заполнять миллионами замеров прямо в горячем цикле.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace bench {
+
+class Histogram {
+  public:
+    static constexpr unsigned SubBits    = 7;
+    static constexpr uint64_t SubCount   = uint64_t(1) << SubBits;  // 128
+    static constexpr uint64_t HalfCount  = SubCount / 2;            // 64
+    static constexpr unsigned MaxExp     = 40 - SubBits + 1;        // до ~2^40 нс (~18 мин)
+    static constexpr size_t   Buckets    = SubCount + MaxExp * HalfCount;
+    static constexpr uint64_t MaxValue   = (uint64_t(1) << 40) - 1;
+
+    void record(uint64_t ns) {
+        if (ns > MaxValue) ns = MaxValue;
+        ++counts[indexOf(ns)];
+        ++total;
+        sum += ns;
+        if (ns < minValue) minValue = ns;
+        if (ns > maxValue) maxValue = ns;
+    }
+
+    void reset() {
+        for (auto& c : counts) c = 0;
+        total    = 0;
+        sum      = 0;
+        minValue = UINT64_MAX;
+        maxValue = 0;
+    }
+
+    uint64_t count() const {
+        return total;
+    }
+
+    uint64_t min() const {
+        return total ? minValue : 0;
+    }
+
+    uint64_t max() const {
+        return maxValue;
+    }
+
+    double mean() const {
+        return total ? static_cast<double>(sum) / static_cast<double>(total) : 0.0;
+    }
+
+    // Значение перцентиля (верхняя граница корзины), p в [0, 1]
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        uint64_t target = static_cast<uint64_t>(p * static_cast<double>(total) + 0.5);
+        if (target < 1) target = 1;
+        if (target > total) target = total;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < Buckets; ++i) {
+            seen += counts[i];
+            if (seen >= target) {
+                uint64_t hi = highOf(i);
+                return hi < maxValue ? hi : maxValue;
+            }
+        }
+        return maxValue;
+    }
+
+    // JSON-объект: сводка перцентилей и непустые корзины [верхняя_граница_нс, число]
+    std::string toJson() const {
+        std::string out;
+        char        buf[128];
+        std::snprintf(buf, sizeof buf, "{\"count\": %llu, \"min_ns\": %llu, \"mean_ns\": %.1f, \"max_ns\": %llu, ",
+                      (unsigned long long)total, (unsigned long long)min(), mean(), (unsigned long long)maxValue);
+        out += buf;
+        out += "\"percentiles\": {";
+        static const double ps[] = {0.5, 0.9, 0.99, 0.999, 0.9999, 0.99999};
+        static const char*  names[] = {"50", "90", "99", "99.9", "99.99", "99.999"};
+        for (size_t i = 0; i < sizeof(ps) / sizeof(ps[0]); ++i) {
+            std::snprintf(buf, sizeof buf, "%s\"%s\": %llu", i ? ", " : "", names[i],
+                          (unsigned long long)percentile(ps[i]));
+            out += buf;
+        }
+        out += "}, \"buckets\": [";
+        bool first = true;
+        for (size_t i = 0; i < Buckets; ++i) {
+            if (!counts[i]) continue;
+            std::snprintf(buf, sizeof buf, "%s[%llu, %llu]", first ? "" : ", ", (unsigned long long)highOf(i),
+                          (unsigned long long)counts[i]);
+            out += buf;
+            first = false;
+        }
+        out += "]}";
+        return out;
+    }
+
+    static size_t indexOf(uint64_t v) {
+        if (v < SubCount) return static_cast<size_t>(v);
+        unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(v));
+        unsigned e   = msb - SubBits + 1;  // >= 1
+        uint64_t m   = v >> e;             // [64, 128)
+        return static_cast<size_t>(SubCount + (e - 1) * HalfCount + (m - HalfCount));
+    }
+
+    static uint64_t highOf(size_t index) {
+        if (index < SubCount) return index;
+        uint64_t e = (index - SubCount) / HalfCount + 1;
+        uint64_t m = (index - SubCount) % HalfCount + HalfCount;
+        return ((m + 1) << e) - 1;
+    }
+
+  private:
+    uint64_t counts[Buckets] = {};
+    uint64_t total           = 0;
+    uint64_t sum             = 0;
+    uint64_t minValue        = UINT64_MAX;
+    uint64_t maxValue        = 0;
+};
+
+}  // namespace bench
+
+#endif  // BENCH_HISTOGRAM_H
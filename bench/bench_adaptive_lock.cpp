@@ -0,0 +1,121 @@
+#include "BenchHarness.h"
+
+#include "AdaptiveLock.h"
+
+#include <chrono>
+#include <cmath>
+
+// Guarded на мьютексе ядра против lock::Adaptive при разных длительностях удержания.
+// Две задачи равного приоритета по очереди берут блокировку и держат её hold мкс;
+// столкновения случаются, когда квант заканчивается внутри секции.
+// В симуляторе ядро одно и держатель никогда не выполняется во время кручения, поэтому
+// здесь видны только быстрый путь и сон; выигрыш от кручения — на двухъядерной цели.
+
+namespace {
+
+struct State {
+    uint32_t value;
+};
+
+enum class Hold { Short, Medium, Bimodal, Exponential };
+
+// Удержание в наносекундах; x — состояние генератора задачи
+uint32_t holdNs(Hold h, uint32_t& x) {
+    x = x * 1664525u + 1013904223u;
+    switch (h) {
+        case Hold::Short:
+            return 1000;
+        case Hold::Medium:
+            return 10000;
+        case Hold::Bimodal:
+            return (x >> 8) % 10 == 0 ? 100000 : 1000;
+        case Hold::Exponential: {
+            const double u = ((x >> 8) + 1) / 16777217.0;  // (0, 1)
+            return static_cast<uint32_t>(-std::log(u) * 5000);
+        }
+    }
+    return 0;
+}
+
+// Занять процессор на ns, не отдавая его
+void busy(uint32_t ns) {
+#ifdef FREERTOS_CPP_SIM
+    sim::consume(ns);
+#else
+    const auto until = std::chrono::steady_clock::now() + std::chrono::nanoseconds(ns);
+    while (std::chrono::steady_clock::now() < until) {
+    }
+#endif
+}
+
+template <class G>
+struct WorkerArgs {
+    G*               shared;
+    Hold             hold;
+    uint32_t         count;
+    uint32_t         seed;
+    bench::Recorder* lat;
+    bench::Done*     done;
+};
+
+template <class G>
+void worker(void* p) {
+    auto*    args = static_cast<WorkerArgs<G>*>(p);
+    uint32_t x    = args->seed;
+    for (uint32_t i = 0; i < args->count; ++i) {
+        const uint32_t ns = holdNs(args->hold, x);
+        uint64_t       t0 = bench::nowNs();
+        auto           s  = (*args->shared)();
+        args->lat->add(bench::nowNs() - t0);
+        busy(ns);
+        s->value++;
+    }
+    args->done->signal();
+    vTaskDelete(nullptr);
+}
+
+template <class G>
+void run(const char* primitive, const char* scenario, Hold hold) {
+    const uint32_t  n = bench::iterations() / 10;
+    G               g;
+    bench::Recorder lat1(n / 2), lat2(n / 2);
+    bench::Done     done(2);
+    WorkerArgs<G>   a{&g, hold, n / 2, 1, &lat1, &done};
+    WorkerArgs<G>   b{&g, hold, n / 2, 2, &lat2, &done};
+
+    uint64_t t0 = bench::nowNs();
+    xTaskCreate(worker<G>, "lA", configMINIMAL_STACK_SIZE, &a, bench::RunnerPriority + 1, nullptr);
+    xTaskCreate(worker<G>, "lB", configMINIMAL_STACK_SIZE, &b, bench::RunnerPriority + 1, nullptr);
+    done.wait();
+    uint64_t wall = bench::nowNs() - t0;
+
+    bench::Recorder all(n);
+    all.merge(lat1);
+    all.merge(lat2);
+    bench::report(primitive, scenario, "acquire", a.count + b.count, wall, all);
+}
+
+using KernelGuarded   = Guarded<State>;
+using AdaptiveGuarded = Guarded<State, lock::Adaptive>;
+
+}  // namespace
+
+BENCHMARK(lock_hold_1us) {
+    run<KernelGuarded>("guarded", "hold 1us", Hold::Short);
+    run<AdaptiveGuarded>("adaptive", "hold 1us", Hold::Short);
+}
+
+BENCHMARK(lock_hold_10us) {
+    run<KernelGuarded>("guarded", "hold 10us", Hold::Medium);
+    run<AdaptiveGuarded>("adaptive", "hold 10us", Hold::Medium);
+}
+
+BENCHMARK(lock_hold_bimodal) {
+    run<KernelGuarded>("guarded", "hold 90% 1us / 10% 100us", Hold::Bimodal);
+    run<AdaptiveGuarded>("adaptive", "hold 90% 1us / 10% 100us", Hold::Bimodal);
+}
+
+BENCHMARK(lock_hold_exponential) {
+    run<KernelGuarded>("guarded", "hold exp mean 5us", Hold::Exponential);
+    run<AdaptiveGuarded>("adaptive", "hold exp mean 5us", Hold::Exponential);
+}
@@ -0,0 +1,103 @@
+#include "BenchHarness.h"
+
+#include "EvenGroupCpp.h"
+#include "Guarded.h"
+#include "Lazy.h"
+#include "QueueCpp.h"
+
+#include <chrono>
+
+// Время загрузки с несколькими сотнями глобальных обёрток: статические конструкторы
+// (создание объектов ядра до main) против Lazy, инициализируемых константой, и одного
+// прохода lazy::initAll() уже из задачи.
+//
+// Порядок конструкторов внутри одной единицы трансляции — порядок определений, поэтому
+// отметки времени BootMark стоят между группами объектов. Время — часы хоста: до запуска
+// планировщика виртуальные часы симулятора стоят.
+
+namespace {
+
+constexpr size_t PerKind = 100;  // каждого вида: очереди, группы событий, Guarded
+constexpr size_t Objects = PerKind * 3;
+
+uint64_t hostNs() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+struct BootMark {
+    uint64_t ns = hostNs();
+};
+
+struct Stats {
+    uint32_t rx, tx, errors;
+};
+
+struct EagerQueue : Queue<uint32_t> {
+    EagerQueue() : Queue<uint32_t>(8) {}
+};
+
+BootMark           eagerStart;
+EagerQueue         eagerQueues[PerKind];
+EventGroup         eagerGroups[PerKind];
+Guarded<Stats>     eagerGuards[PerKind];
+BootMark           eagerEnd;
+
+FREERTOS_CPP_CONSTINIT Lazy<Queue<uint32_t>, 8> lazyQueues[PerKind];
+FREERTOS_CPP_CONSTINIT Lazy<EventGroup>         lazyGroups[PerKind];
+FREERTOS_CPP_CONSTINIT Lazy<Guarded<Stats>>     lazyGuards[PerKind];
+BootMark                                        lazyEnd;
+
+template <typename T, auto... Args>
+void initEach(Lazy<T, Args...> (&ls)[PerKind], bench::Recorder& lat) {
+    for (auto& l : ls) {
+        uint64_t t0 = hostNs();
+        lazy::initAll(l);
+        lat.add(hostNs() - t0);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(boot_global_objects) {
+    // До main: одно измерение на всю группу, в гистограмму — среднее на объект
+    const uint64_t  eagerNs = eagerEnd.ns - eagerStart.ns;
+    bench::Recorder eagerLat(1);
+    eagerLat.add(eagerNs / Objects);
+    bench::report("lazy", "300 globals", "static constructors before main", Objects, eagerNs, eagerLat);
+
+    const uint64_t  lazyNs = lazyEnd.ns - eagerEnd.ns;
+    bench::Recorder lazyLat(1);
+    lazyLat.add(lazyNs / Objects);
+    bench::report("lazy", "300 globals", "constinit Lazy before main", Objects, lazyNs, lazyLat);
+
+    // Та же работа, перенесённая в явный проход из задачи
+    bench::Recorder initLat(Objects);
+    uint64_t        t0 = hostNs();
+    initEach(lazyQueues, initLat);
+    initEach(lazyGroups, initLat);
+    initEach(lazyGuards, initLat);
+    bench::report("lazy", "300 globals", "initAll pass", Objects, hostNs() - t0, initLat);
+
+    // Цена обращения после создания: флаг проверяется на каждом вызове
+    const uint32_t  n = bench::iterations();
+    bench::Recorder getLat(n);
+    uint64_t        start = hostNs();
+    uint32_t        sum   = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t s = hostNs();
+        sum += static_cast<uint32_t>(lazyQueues[i % PerKind]->messagesWaiting());
+        getLat.add(hostNs() - s);
+    }
+    bench::report("lazy", "after init", "get()+messagesWaiting", n, hostNs() - start, getLat);
+
+    bench::Recorder directLat(n);
+    start = hostNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t s = hostNs();
+        sum += static_cast<uint32_t>(eagerQueues[i % PerKind].messagesWaiting());
+        directLat.add(hostNs() - s);
+    }
+    bench::report("lazy", "after init", "direct messagesWaiting", n, hostNs() - start, directLat);
+    asm volatile("" : : "r"(sum));
+}
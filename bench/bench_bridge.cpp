@@ -0,0 +1,94 @@
+#include "BenchHarness.h"
+
+#include "RemoteQueueBridge.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <sys/socket.h>
+
+// RemoteQueueBridge: элементов в секунду в зависимости от размера пачки.
+// Unix-сокет — запись кадра стоит системного вызова, как UART-транзакция на плате;
+// петля через потоковые буферы — для сравнения без ввода-вывода.
+// Время — часы хоста: виртуальные часы симулятора системные вызовы не видят.
+
+namespace {
+
+struct Reading {
+    uint32_t seq;
+    int16_t  value[6];
+};
+
+using Bridge = RemoteQueueBridge<Reading, 64>;
+
+uint64_t hostNs() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+Queue<Reading>* sinkQueue;
+uint32_t        expected;
+
+// n элементов: раннер кладёт в исходную очередь, потребитель разбирает приёмную
+void run(ByteTransport& a, ByteTransport& b, uint16_t batch, const char* transport) {
+    const uint32_t n = bench::iterations() / 10;
+    Queue<Reading> source(256);
+    Queue<Reading> sink(256);
+    Bridge         tx(&a, bridge::Config{batch, 1, 50});
+    Bridge         rx(&b, bridge::Config{batch, 1, 50});
+    rx.startReceiver(sink, "rx", bench::RunnerPriority + 1);
+    tx.startSender(source, "tx", bench::RunnerPriority + 1);
+
+    bench::Done done(1);
+    sinkQueue = &sink;
+    expected  = n;
+    xTaskCreate(
+        [](void* arg) {
+            Reading r{};
+            for (uint32_t i = 0; i < expected; ++i) sinkQueue->receive(r, 10000);
+            static_cast<bench::Done*>(arg)->signal();
+            vTaskDelete(nullptr);
+        },
+        "consumer", configMINIMAL_STACK_SIZE * 2, &done, bench::RunnerPriority + 1, nullptr);
+
+    bench::Recorder lat(n);
+    Reading         r{};
+    const uint64_t  t0 = hostNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        r.seq      = i;
+        uint64_t s = hostNs();
+        source.send(r, 10000);
+        lat.add(hostNs() - s);
+    }
+    done.wait();
+    const uint64_t wall = hostNs() - t0;
+
+    bridge::Stats s = tx.stats();
+    char          scenario[64];
+    std::snprintf(scenario, sizeof(scenario), "%s batch %u", transport, static_cast<unsigned>(batch));
+    char op[64];
+    std::snprintf(op, sizeof(op), "items end to end, %.1f B/item",
+                  s.items ? static_cast<double>(s.wireBytes) / s.items : 0.0);
+    bench::report("bridge", scenario, op, n, wall, lat);
+    tx.stop();
+    rx.stop();
+}
+
+}  // namespace
+
+BENCHMARK(bridge_unix_socket) {
+    for (uint16_t batch : {1, 4, 16, 64}) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) return;
+        UnixSocketTransport left(fds[0]), right(fds[1]);
+        run(left, right, batch, "unix socket");
+    }
+}
+
+BENCHMARK(bridge_loopback) {
+    for (uint16_t batch : {1, 16}) {
+        // Свежая петля на каждый прогон: в старой могли остаться кредиты
+        std::unique_ptr<LoopbackLink<4096>> link(new LoopbackLink<4096>());
+        run(link->a(), link->b(), batch, "loopback");
+    }
+}
@@ -0,0 +1,153 @@
+#include "BenchHarness.h"
+
+#include "CompressedChannel.h"
+#include "QueueCpp.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// CompressedChannel: степень сжатия и цена кодирования/декодирования одного образца.
+// Время — часы хоста: кодек — чистые вычисления, виртуальные часы симулятора их не видят.
+// Степень сжатия (сырые байты / байты кадров) — в названии сценария.
+
+namespace {
+
+struct Imu {
+    uint32_t time;
+    int16_t  accel[3];
+    int16_t  gyro[3];
+    uint16_t temp;
+};
+
+#define IMU_FIELDS &Imu::time, &Imu::accel, &Imu::gyro, &Imu::temp
+
+using Enc = compress::Encoder<Imu, IMU_FIELDS>;
+using Dec = compress::Decoder<Imu, IMU_FIELDS>;
+
+constexpr uint32_t Batch = 64;
+
+uint64_t hostNs() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+// Датчик в покое: метка времени ровно растёт, оси дрожат на единицы
+Imu drift(uint32_t i) {
+    uint32_t x = i * 2654435761u;
+    Imu      s{};
+    s.time = i * 1000;
+    for (int a = 0; a < 3; ++a) {
+        s.accel[a] = static_cast<int16_t>(a * 4000 + static_cast<int>((x >> (a * 3)) & 7) - 4);
+        s.gyro[a]  = static_cast<int16_t>(static_cast<int>((x >> (a * 3 + 9)) & 3) - 2);
+    }
+    s.temp = static_cast<uint16_t>(2500 + i / 1000);
+    return s;
+}
+
+// Худший случай: оси — шум во всю разрядность
+Imu noise(uint32_t i) {
+    Imu      s   = drift(i);
+    uint32_t x   = i * 2246822519u + 0x9E3779B9u;
+    for (int a = 0; a < 3; ++a) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        s.accel[a] = static_cast<int16_t>(x);
+        s.gyro[a]  = static_cast<int16_t>(x >> 16);
+    }
+    return s;
+}
+
+template <typename Gen>
+void codec(const char* signal, Gen gen, uint32_t keyframeInterval) {
+    const uint32_t n = bench::iterations() / Batch * Batch;
+    if (n == 0) return;
+    std::vector<Imu>     in(n);
+    std::vector<uint8_t> bytes(static_cast<size_t>(n) * Enc::MaxFrame);
+    for (uint32_t i = 0; i < n; ++i) in[i] = gen(i);
+
+    Enc             enc(keyframeInterval);
+    bench::Recorder encLat(n / Batch);
+    size_t          total = 0;
+    uint64_t        t0    = hostNs();
+    for (uint32_t i = 0; i < n; i += Batch) {
+        uint64_t s = hostNs();
+        for (uint32_t k = 0; k < Batch; ++k) total += enc.encode(in[i + k], bytes.data() + total);
+        encLat.add((hostNs() - s) / Batch);
+    }
+    const uint64_t encNs = hostNs() - t0;
+
+    Dec             dec;
+    bench::Recorder decLat(n / Batch);
+    size_t          at = 0;
+    Imu             out{};
+    bool            ok = true;
+    t0                 = hostNs();
+    for (uint32_t i = 0; i < n; i += Batch) {
+        uint64_t s = hostNs();
+        for (uint32_t k = 0; k < Batch; ++k) {
+            size_t used = 0;
+            ok          = ok && dec.decode(bytes.data() + at, total - at, out, used) == compress::Status::Sample;
+            at += used;
+        }
+        decLat.add((hostNs() - s) / Batch);
+    }
+    const uint64_t decNs = hostNs() - t0;
+    if (!ok || out.time != in[n - 1].time) std::fprintf(stderr, "  compressed: %s decode mismatch\n", signal);
+
+    char scenario[64];
+    std::snprintf(scenario, sizeof(scenario), "%s key/%u %.2fx", signal, static_cast<unsigned>(keyframeInterval),
+                  static_cast<double>(n) * sizeof(Imu) / static_cast<double>(total));
+    bench::report("compressed", scenario, "encode per sample", n, encNs, encLat);
+    bench::report("compressed", scenario, "decode per sample", n, decNs, decLat);
+}
+
+// Образцов одного размера RAM: Queue<Imu> и канал со столькими же байтами буфера
+template <typename Gen>
+void channel(const char* signal, Gen gen) {
+    constexpr size_t                                Bytes = 1024;
+    Queue<Imu>                                      q(Bytes / sizeof(Imu));
+    static CompressedChannel<Imu, Bytes, IMU_FIELDS> ch(64);
+
+    uint32_t held = 0;
+    while (ch.send(gen(held))) ++held;
+
+    const uint32_t  n = held;
+    bench::Recorder sendLat(n), recvLat(n);
+    Imu             r{};
+    while (ch.receive(r)) {
+    }
+    uint64_t t0 = hostNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t s = hostNs();
+        ch.send(gen(i));
+        sendLat.add(hostNs() - s);
+    }
+    uint64_t t1 = hostNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t s = hostNs();
+        ch.receive(r);
+        recvLat.add(hostNs() - s);
+    }
+    uint64_t t2 = hostNs();
+
+    char scenario[64];
+    std::snprintf(scenario, sizeof(scenario), "%s 1KiB: %u vs %u", signal, static_cast<unsigned>(n),
+                  static_cast<unsigned>(q.spacesAvailable()));
+    bench::report("compressed", scenario, "channel send", n, t1 - t0, sendLat);
+    bench::report("compressed", scenario, "channel receive", n, t2 - t1, recvLat);
+}
+
+}  // namespace
+
+BENCHMARK(compressed_codec) {
+    codec("drift", drift, 64);
+    codec("drift", drift, 8);
+    codec("noise", noise, 64);
+}
+
+// Сколько образцов держит килобайт и цена пути через потоковый буфер
+BENCHMARK(compressed_channel) {
+    channel("drift", drift);
+}
@@ -0,0 +1,117 @@
+#include "BenchHarness.h"
+
+#include "EvenGroupCpp.h"
+
+namespace {
+
+constexpr EventBits_t Go = 1u << 0;
+
+struct WaiterArgs {
+    EventGroup*    group;
+    EventBits_t    bit;
+    bench::Done*   done;
+    volatile bool* stop;
+};
+
+// Ждёт свой бит с очисткой, пока не выставят stop
+void waiterTask(void* p) {
+    auto* args = static_cast<WaiterArgs*>(p);
+    while (!*args->stop) {
+        args->group->waitBits(args->bit, true, true, 1000);
+    }
+    args->done->signal();
+    vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+BENCHMARK(event_group_uncontended) {
+    const uint32_t  n = bench::iterations();
+    EventGroup      ev;
+    bench::Recorder waitLat(n), pairLat(n);
+
+    // Бит уже установлен — waitBits возвращается без блокировки
+    ev.setBits(Go);
+    uint64_t t0 = bench::nowNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        waitLat.measure([&] { ev.waitBits(Go); });
+    }
+    uint64_t waitWall = bench::nowNs() - t0;
+    bench::report("event_group", "uncontended", "waitBits (already set)", n, waitWall, waitLat);
+
+    t0 = bench::nowNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        pairLat.measure([&] {
+            ev.setBits(Go);
+            ev.waitBits(Go, true, true);
+        });
+    }
+    uint64_t pairWall = bench::nowNs() - t0;
+    bench::report("event_group", "uncontended", "setBits+waitBits(clear)", n, pairWall, pairLat);
+}
+
+// Три ожидающих задачи на одной группе: setBits обходит весь список ожидающих
+BENCHMARK(event_group_contended) {
+    const uint32_t  n = bench::iterations();
+    EventGroup      ev;
+    bench::Recorder lat(n);
+    bench::Done     done(3);
+    volatile bool   stop = false;
+    WaiterArgs      w[3] = {{&ev, 1u << 1, &done, &stop}, {&ev, 1u << 2, &done, &stop}, {&ev, 1u << 3, &done, &stop}};
+    for (auto& args : w) {
+        xTaskCreate(waiterTask, "evWait", configMINIMAL_STACK_SIZE, &args, bench::RunnerPriority + 1, nullptr);
+    }
+
+    uint64_t t0 = bench::nowNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        EventBits_t bit = w[i % 3].bit;
+        lat.measure([&] { ev.setBits(bit); });
+    }
+    uint64_t wall = bench::nowNs() - t0;
+    stop = true;
+    ev.setBits(w[0].bit | w[1].bit | w[2].bit);
+    done.wait();
+    bench::report("event_group", "contended", "setBits (3 waiters)", n, wall, lat);
+}
+
+// setBitsFromISR откладывает установку в timer-task; меряем до возврата waitBits
+BENCHMARK(event_group_isr) {
+    const uint32_t  n = bench::iterations();
+    EventGroup      ev;
+    bench::Recorder lat(n);
+
+    uint64_t t0 = bench::nowNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        lat.measure([&] {
+            BaseType_t  woken = pdFALSE;
+            UBaseType_t mask  = taskENTER_CRITICAL_FROM_ISR();
+            ev.setBitsFromISR(Go, &woken);
+            taskEXIT_CRITICAL_FROM_ISR(mask);
+            portYIELD_FROM_ISR(woken);
+            ev.waitBits(Go, true, true, 1000);
+        });
+    }
+    uint64_t wall = bench::nowNs() - t0;
+    bench::report("event_group", "isr", "setBitsFromISR->waitBits", n, wall, lat);
+}
+
+// Высокоприоритетная задача ждёт бит; setBits её будит и отдаёт ей процессор
+BENCHMARK(event_group_cross_priority) {
+    const uint32_t  n = bench::iterations();
+    EventGroup      ev;
+    bench::Recorder lat(n);
+    bench::Done     done(1);
+    volatile bool   stop = false;
+    WaiterArgs      args{&ev, Go, &done, &stop};
+    xTaskCreate(waiterTask, "evHigh", configMINIMAL_STACK_SIZE, &args, bench::RunnerPriority + 1, nullptr);
+
+    uint64_t t0 = bench::nowNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        lat.measure([&] { ev.setBits(Go); });
+    }
+    uint64_t wall = bench::nowNs() - t0;
+    stop = true;
+    ev.setBits(Go);
+    done.wait();
+    bench::report("event_group", "cross_priority", "setBits (wakes higher prio)", n, wall, lat);
+}
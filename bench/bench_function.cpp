@@ -0,0 +1,82 @@
+#include "BenchHarness.h"
+
+#include "InplaceFunction.h"
+
+#include <chrono>
+#include <functional>
+
+// Стоимость вызова и создания колбэка: указатель на функцию, InplaceFunction, std::function.
+// Это чистые вычисления без вызовов ядра, поэтому время — всегда часы хоста (в симуляторе
+// виртуальное время здесь не двигается). Замер — пачка из Batch операций, делённая на Batch.
+
+namespace {
+
+constexpr uint32_t Batch = 64;
+
+uint64_t hostNs() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+// Не даёт компилятору заглянуть внутрь объекта и вызвать лямбду напрямую
+template <typename T>
+void opaque(T& v) {
+    asm volatile("" : : "r"(&v) : "memory");
+}
+
+int plain(int v) {
+    return v + 1;
+}
+
+template <typename Op>
+void batches(const char* scenario, const char* op, Op&& body) {
+    const uint32_t  n = bench::iterations() / Batch + 1;
+    bench::Recorder lat(n);
+    uint64_t        wall = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t t0 = hostNs();
+        for (uint32_t k = 0; k < Batch; ++k) body(k);
+        uint64_t d = hostNs() - t0;
+        wall += d;
+        lat.add(d / Batch);
+    }
+    bench::report("function", scenario, op, static_cast<uint64_t>(n) * Batch, wall, lat);
+}
+
+}  // namespace
+
+BENCHMARK(function_call) {
+    int  a = 1, b = 2;
+    int  acc = 0;
+
+    int (*fp)(int) = plain;
+    opaque(fp);
+    batches("function pointer", "call", [&](uint32_t k) { acc += fp(static_cast<int>(k)); });
+
+    InplaceFunction<int(int)> inplace = [&a, &b](int v) { return v + a + b; };
+    opaque(inplace);
+    batches("InplaceFunction", "call", [&](uint32_t k) { acc += inplace(static_cast<int>(k)); });
+
+    std::function<int(int)> stdfn = [&a, &b](int v) { return v + a + b; };
+    opaque(stdfn);
+    batches("std::function", "call", [&](uint32_t k) { acc += stdfn(static_cast<int>(k)); });
+    opaque(acc);
+}
+
+// Захват трёх указателей: больше буфера малых объектов std::function (два указателя в libstdc++)
+BENCHMARK(function_construct) {
+    int  a = 1, b = 2, c = 3;
+    int* pa = &a;
+    int* pb = &b;
+    int* pc = &c;
+
+    batches("InplaceFunction", "construct 24-byte capture", [&](uint32_t) {
+        InplaceFunction<int(int)> f = [pa, pb, pc](int v) { return v + *pa + *pb + *pc; };
+        opaque(f);
+    });
+
+    batches("std::function", "construct 24-byte capture", [&](uint32_t) {
+        std::function<int(int)> f = [pa, pb, pc](int v) { return v + *pa + *pb + *pc; };
+        opaque(f);
+    });
+}
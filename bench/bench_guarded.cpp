@@ -0,0 +1,105 @@
+#include "BenchHarness.h"
+
+#include "Guarded.h"
+
+// Мьютекс нельзя брать из ISR, поэтому ISR-сценария для Guarded нет.
+
+namespace {
+
+struct State {
+    uint32_t value;
+};
+
+struct WorkerArgs {
+    Guarded<State>*  shared;
+    uint32_t         count;
+    bench::Recorder* lat;
+    bench::Done*     done;
+};
+
+// Держатель отдаёт процессор внутри секции — соседняя задача упирается в мьютекс
+void contendingWorker(void* p) {
+    auto* args = static_cast<WorkerArgs*>(p);
+    for (uint32_t i = 0; i < args->count; ++i) {
+        uint64_t t0 = bench::nowNs();
+        auto     s  = (*args->shared)();
+        args->lat->add(bench::nowNs() - t0);
+        s->value++;
+        taskYIELD();
+    }
+    args->done->signal();
+    vTaskDelete(nullptr);
+}
+
+void highPriorityWaiter(void* p) {
+    auto* args = static_cast<WorkerArgs*>(p);
+    for (uint32_t i = 0; i < args->count; ++i) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint64_t t0 = bench::nowNs();
+        auto     s  = (*args->shared)();
+        args->lat->add(bench::nowNs() - t0);
+        s->value++;
+    }
+    args->done->signal();
+    vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+BENCHMARK(guarded_uncontended) {
+    const uint32_t  n = bench::iterations();
+    Guarded<State>  g;
+    bench::Recorder lat(n);
+
+    uint64_t t0 = bench::nowNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        lat.measure([&] {
+            auto s = g();
+            s->value++;
+        });
+    }
+    uint64_t wall = bench::nowNs() - t0;
+    bench::report("guarded", "uncontended", "lock+unlock", n, wall, lat);
+}
+
+BENCHMARK(guarded_contended) {
+    const uint32_t  n = bench::iterations();
+    Guarded<State>  g;
+    bench::Recorder lat1(n / 2), lat2(n / 2);
+    bench::Done     done(2);
+    WorkerArgs      a{&g, n / 2, &lat1, &done};
+    WorkerArgs      b{&g, n / 2, &lat2, &done};
+
+    uint64_t t0 = bench::nowNs();
+    xTaskCreate(contendingWorker, "gA", configMINIMAL_STACK_SIZE, &a, bench::RunnerPriority + 1, nullptr);
+    xTaskCreate(contendingWorker, "gB", configMINIMAL_STACK_SIZE, &b, bench::RunnerPriority + 1, nullptr);
+    done.wait();
+    uint64_t wall = bench::nowNs() - t0;
+
+    bench::Recorder all(n);
+    all.merge(lat1);
+    all.merge(lat2);
+    bench::report("guarded", "contended", "acquire (holder yields)", a.count + b.count, wall, all);
+}
+
+// Мьютекс держит низкоприоритетная задача (раннер), высокоприоритетная
+// просыпается и ждёт его — с наследованием приоритета.
+BENCHMARK(guarded_cross_priority) {
+    const uint32_t  n = bench::iterations();
+    Guarded<State>  g;
+    bench::Recorder lat(n);
+    bench::Done     done(1);
+    WorkerArgs      args{&g, n, &lat, &done};
+    TaskHandle_t    waiter = nullptr;
+    xTaskCreate(highPriorityWaiter, "gHigh", configMINIMAL_STACK_SIZE, &args, bench::RunnerPriority + 1, &waiter);
+
+    uint64_t t0 = bench::nowNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        auto s = g();
+        xTaskNotifyGive(waiter);  // waiter вытесняет нас и блокируется на мьютексе
+        s->value++;
+    }
+    done.wait();
+    uint64_t wall = bench::nowNs() - t0;
+    bench::report("guarded", "cross_priority", "acquire (held by lower prio)", n, wall, lat);
+}
@@ -0,0 +1,246 @@
+#include "BenchHarness.h"
+#include "Histogram.h"
+
+#include "EvenGroupCpp.h"
+#include "Guarded.h"
+#include "QueueCpp.h"
+#include <cstdlib>
+#include <type_traits>
+
+// Латентность пробуждения: время от send/setBits/notify/отпускания мьютекса
+// в одной задаче до возврата из блокирующего вызова в другой.
+//
+// Пинг-понг: отправитель (раннер) ставит отметку времени и шлёт ping,
+// получатель фиксирует one_way и отвечает pong, отправитель фиксирует round_trip.
+// Получатель запускается с тем же, более высоким или более низким приоритетом.
+//
+// Guarded меряется только one_way и только для same/higher: передать мьютекс
+// задаче с меньшим приоритетом, не блокируясь самому, нельзя.
+
+namespace {
+
+constexpr uint32_t Timeout = 10000;  // мс, защита от зависания
+constexpr uint32_t Warmup  = 1000;
+
+// По умолчанию 1M пинг-понгов на сценарий (переменная LATENCY_ITERATIONS)
+uint32_t latencyIterations() {
+    const char* env = std::getenv("LATENCY_ITERATIONS");
+    long        v   = env ? std::strtol(env, nullptr, 10) : 0;
+    return v > 0 ? static_cast<uint32_t>(v) : bench::iterations() * 10;
+}
+
+struct PrioCase {
+    const char* name;
+    UBaseType_t peer;
+};
+
+const PrioCase prioCases[] = {
+    {"same_prio", bench::RunnerPriority},
+    {"peer_higher", bench::RunnerPriority + 1},
+    {"peer_lower", bench::RunnerPriority - 1},
+};
+
+// ---- Транспорты ping/pong ----
+
+class QueueTransport {
+  public:
+    const char* name() const {
+        return "queue";
+    }
+    void ping(uint64_t t0) {
+        pingQ.send(t0, Timeout);
+    }
+    uint64_t waitPing() {
+        uint64_t t0 = 0;
+        pingQ.receive(t0, Timeout);
+        return t0;
+    }
+    void pong() {
+        pongQ.send(0, Timeout);
+    }
+    void waitPong() {
+        uint8_t v;
+        pongQ.receive(v, Timeout);
+    }
+
+  private:
+    Queue<uint64_t> pingQ{1};
+    Queue<uint8_t>  pongQ{1};
+};
+
+class EventGroupTransport {
+  public:
+    const char* name() const {
+        return "event_group";
+    }
+    void ping(uint64_t t0) {
+        stamp = t0;
+        ev.setBits(Ping);
+    }
+    uint64_t waitPing() {
+        ev.waitBits(Ping, true, true, Timeout);
+        return stamp;
+    }
+    void pong() {
+        ev.setBits(Pong);
+    }
+    void waitPong() {
+        ev.waitBits(Pong, true, true, Timeout);
+    }
+
+  private:
+    static constexpr EventBits_t Ping = 1u << 0;
+    static constexpr EventBits_t Pong = 1u << 1;
+    EventGroup                   ev;
+    volatile uint64_t            stamp = 0;
+};
+
+class NotifyTransport {
+  public:
+    const char* name() const {
+        return "notify";
+    }
+    void bind(TaskHandle_t senderTask, TaskHandle_t peerTask) {
+        sender = senderTask;
+        peer   = peerTask;
+    }
+    void ping(uint64_t t0) {
+        stamp = t0;
+        xTaskNotifyGive(peer);
+    }
+    uint64_t waitPing() {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(Timeout));
+        return stamp;
+    }
+    void pong() {
+        xTaskNotifyGive(sender);
+    }
+    void waitPong() {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(Timeout));
+    }
+
+  private:
+    TaskHandle_t      sender = nullptr;
+    TaskHandle_t      peer   = nullptr;
+    volatile uint64_t stamp  = 0;
+};
+
+template <class Transport>
+struct PeerArgs {
+    Transport*        transport;
+    uint32_t          count;
+    bench::Histogram* oneWay;
+    bench::Done*      done;
+};
+
+template <class Transport>
+void peerTask(void* p) {
+    auto* args = static_cast<PeerArgs<Transport>*>(p);
+    for (uint32_t i = 0; i < args->count; ++i) {
+        uint64_t t0  = args->transport->waitPing();
+        uint64_t now = bench::nowNs();
+        if (i >= Warmup) args->oneWay->record(now - t0);
+        args->transport->pong();
+    }
+    args->done->signal();
+    vTaskDelete(nullptr);
+}
+
+// Гистограммы по ~18 КБ — держим их вне стека задач
+bench::Histogram oneWayHist;
+bench::Histogram roundTripHist;
+
+template <class Transport>
+void pingPong(const PrioCase& prio) {
+    const uint32_t n = latencyIterations() + Warmup;
+    Transport      transport;
+    bench::Done    done(1);
+    oneWayHist.reset();
+    roundTripHist.reset();
+
+    PeerArgs<Transport> args{&transport, n, &oneWayHist, &done};
+    TaskHandle_t        peer = nullptr;
+    xTaskCreate(peerTask<Transport>, "peer", configMINIMAL_STACK_SIZE, &args, prio.peer, &peer);
+    if constexpr (std::is_same<Transport, NotifyTransport>::value) {
+        transport.bind(xTaskGetCurrentTaskHandle(), peer);
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t t0 = bench::nowNs();
+        transport.ping(t0);
+        transport.waitPong();
+        if (i >= Warmup) roundTripHist.record(bench::nowNs() - t0);
+    }
+    done.wait();
+    bench::reportHistogram(transport.name(), prio.name, "one_way", oneWayHist);
+    bench::reportHistogram(transport.name(), prio.name, "round_trip", roundTripHist);
+}
+
+// ---- Guarded: передача мьютекса ожидающей задаче ----
+
+struct GuardedArgs {
+    Guarded<uint32_t>* shared;
+    uint32_t           count;
+    volatile uint64_t* stamp;
+    TaskHandle_t       sender;
+    bench::Done*       done;
+};
+
+void guardedPeer(void* p) {
+    auto* args = static_cast<GuardedArgs*>(p);
+    for (uint32_t i = 0; i < args->count; ++i) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(Timeout));
+        {
+            auto     s   = (*args->shared)();  // блокируемся, пока отправитель держит мьютекс
+            uint64_t now = bench::nowNs();
+            if (i >= Warmup) oneWayHist.record(now - *args->stamp);
+            (*s)++;
+        }
+        xTaskNotifyGive(args->sender);
+    }
+    args->done->signal();
+    vTaskDelete(nullptr);
+}
+
+void guardedHandoff(const PrioCase& prio) {
+    const uint32_t    n = latencyIterations() + Warmup;
+    Guarded<uint32_t> g;
+    volatile uint64_t stamp = 0;
+    bench::Done       done(1);
+    oneWayHist.reset();
+
+    GuardedArgs  args{&g, n, &stamp, xTaskGetCurrentTaskHandle(), &done};
+    TaskHandle_t peer = nullptr;
+    xTaskCreate(guardedPeer, "gPeer", configMINIMAL_STACK_SIZE, &args, prio.peer, &peer);
+
+    for (uint32_t i = 0; i < n; ++i) {
+        {
+            auto s = g();
+            xTaskNotifyGive(peer);
+            taskYIELD();  // дать задаче того же приоритета дойти до мьютекса
+            stamp = bench::nowNs();
+        }  // ~Access() передаёт мьютекс ожидающей задаче
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(Timeout));
+    }
+    done.wait();
+    bench::reportHistogram("guarded", prio.name, "one_way", oneWayHist);
+}
+
+}  // namespace
+
+BENCHMARK(latency_queue) {
+    for (const auto& prio : prioCases) pingPong<QueueTransport>(prio);
+}
+
+BENCHMARK(latency_event_group) {
+    for (const auto& prio : prioCases) pingPong<EventGroupTransport>(prio);
+}
+
+BENCHMARK(latency_notify) {
+    for (const auto& prio : prioCases) pingPong<NotifyTransport>(prio);
+}
+
+BENCHMARK(latency_guarded) {
+    guardedHandoff(prioCases[0]);
+    guardedHandoff(prioCases[1]);
+}
@@ -0,0 +1,47 @@
+#include "BenchHarness.h"
+
+#include "Logger.h"
+
+// Стоимость места вызова: запись в кольцо без форматирования.
+// Кольцо вычитывается вне замеров, сборщик печатает в никуда.
+
+namespace {
+
+void discard(const char*, size_t, void*) {}
+
+template <typename Op>
+void writeLoop(Logger& log, const char* scenario, const char* op, Op&& write) {
+    const uint32_t  n = bench::iterations();
+    bench::Recorder lat(n);
+    uint64_t        busy = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t t0 = bench::nowNs();
+        write(i);
+        uint64_t d = bench::nowNs() - t0;
+        lat.add(d);
+        busy += d;
+        if ((i & (logger::RingSize / 2 - 1)) == logger::RingSize / 2 - 1) log.drain();
+    }
+    log.drain();
+    bench::report("logger", scenario, op, n, busy, lat);
+}
+
+}  // namespace
+
+BENCHMARK(logger_task) {
+    Logger log;
+    log.setSink(discard);
+    writeLoop(log, "uncontended", "write 3 args", [&](uint32_t i) {
+        log.write("Bench", logger::Level::Info, false, "i=%u x=%d f=%f", i, -1, 0.5);
+    });
+}
+
+BENCHMARK(logger_isr) {
+    Logger log;
+    log.setSink(discard);
+    writeLoop(log, "isr", "write 3 args", [&](uint32_t i) {
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+        log.write("Bench", logger::Level::Info, true, "i=%u x=%d f=%f", i, -1, 0.5);
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+    });
+}
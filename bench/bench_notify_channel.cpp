@@ -0,0 +1,72 @@
+#include "BenchHarness.h"
+
+#include "EvenGroupCpp.h"
+#include "NotifyChannel.h"
+#include "freertos/semphr.h"
+
+// Разбудить ожидающую задачу выше приоритетом: уведомление против двоичного семафора и
+// EventGroup. Меряется вызов отправителя, в который входит переключение на получателя.
+
+namespace {
+
+struct Wake : notify::Counting {};
+using BenchNotify = notify::Registry<Wake>;
+
+struct Shared {
+    BenchNotify::Channel<Wake> notify;
+    SemaphoreHandle_t          sem = nullptr;
+    EventGroup                 ev;
+    bench::Done*               done;
+    volatile bool              stop = false;
+};
+
+Shared* shared;
+
+template <class Wait>
+void waiterLoop(Wait wait) {
+    while (!shared->stop) wait();
+    shared->done->signal();
+    vTaskDelete(nullptr);
+}
+
+template <class Give>
+void run(const char* scenario, TaskFunction_t waiter, Give give) {
+    const uint32_t  n = bench::iterations();
+    bench::Done     done(1);
+    bench::Recorder lat(n);
+    shared->done = &done;
+    shared->stop = false;
+    xTaskCreate(waiter, "waiter", configMINIMAL_STACK_SIZE, nullptr, bench::RunnerPriority + 1, nullptr);
+
+    uint64_t t0 = bench::nowNs();
+    for (uint32_t i = 0; i < n; ++i) lat.measure(give);
+    uint64_t wall = bench::nowNs() - t0;
+    shared->stop = true;
+    give();
+    done.wait();
+    bench::report("notify_channel", scenario, "signal (wakes higher prio)", n, wall, lat);
+}
+
+}  // namespace
+
+BENCHMARK(notify_channel_cross_priority) {
+    Shared s;
+    s.sem  = xSemaphoreCreateBinary();
+    shared = &s;
+
+    run(
+        "notify counting",
+        [](void*) {
+            shared->notify.bindCurrent();
+            waiterLoop([] { shared->notify.take(1000); });
+        },
+        [] { shared->notify.give(); });
+    run(
+        "binary semaphore", [](void*) { waiterLoop([] { xSemaphoreTake(shared->sem, pdMS_TO_TICKS(1000)); }); },
+        [] { xSemaphoreGive(shared->sem); });
+    run(
+        "event group", [](void*) { waiterLoop([] { shared->ev.waitBits(1, true, true, 1000); }); },
+        [] { shared->ev.setBits(1); });
+
+    vSemaphoreDelete(s.sem);
+}
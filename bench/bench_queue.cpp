@@ -0,0 +1,147 @@
+#include "BenchHarness.h"
+
+#include "QueueCpp.h"
+
+namespace {
+
+constexpr size_t Batch = 64;
+
+struct ProducerArgs {
+    Queue<uint32_t>* queue;
+    uint32_t         count;
+    bench::Recorder* lat;
+    bench::Done*     done;
+};
+
+void producerTask(void* p) {
+    auto* args = static_cast<ProducerArgs*>(p);
+    for (uint32_t i = 0; i < args->count; ++i) {
+        args->lat->measure([&] { args->queue->send(i, 1000); });
+    }
+    args->done->signal();
+    vTaskDelete(nullptr);
+}
+
+struct ConsumerArgs {
+    Queue<uint32_t>* queue;
+    uint32_t         count;
+    bench::Done*     done;
+};
+
+void consumerTask(void* p) {
+    auto*    args = static_cast<ConsumerArgs*>(p);
+    uint32_t v;
+    for (uint32_t i = 0; i < args->count; ++i) {
+        args->queue->receive(v, 1000);
+    }
+    args->done->signal();
+    vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+// Одна задача, очередь никогда не блокирует: чистая стоимость send/receive
+BENCHMARK(queue_uncontended) {
+    const uint32_t  n = bench::iterations();
+    Queue<uint32_t> q(Batch);
+    bench::Recorder sendLat(n), recvLat(n);
+    uint64_t        sendWall = 0, recvWall = 0;
+
+    for (uint32_t done = 0; done < n; done += Batch) {
+        uint64_t t0 = bench::nowNs();
+        for (uint32_t i = 0; i < Batch; ++i) {
+            sendLat.measure([&] { q.send(i); });
+        }
+        uint64_t t1 = bench::nowNs();
+        uint32_t v;
+        for (uint32_t i = 0; i < Batch; ++i) {
+            recvLat.measure([&] { q.receive(v); });
+        }
+        sendWall += t1 - t0;
+        recvWall += bench::nowNs() - t1;
+    }
+    uint64_t ops = (n + Batch - 1) / Batch * Batch;
+    bench::report("queue", "uncontended", "send", ops, sendWall, sendLat);
+    bench::report("queue", "uncontended", "receive", ops, recvWall, recvLat);
+}
+
+// Два производителя и потребитель одного приоритета на общей очереди
+BENCHMARK(queue_contended) {
+    const uint32_t  n = bench::iterations();
+    Queue<uint32_t> q(16);
+    bench::Recorder lat1(n / 2), lat2(n / 2);
+    bench::Done     done(2);
+    ProducerArgs    a{&q, n / 2, &lat1, &done};
+    ProducerArgs    b{&q, n / 2, &lat2, &done};
+
+    uint64_t t0 = bench::nowNs();
+    xTaskCreate(producerTask, "prodA", configMINIMAL_STACK_SIZE, &a, bench::RunnerPriority, nullptr);
+    xTaskCreate(producerTask, "prodB", configMINIMAL_STACK_SIZE, &b, bench::RunnerPriority, nullptr);
+    uint32_t v;
+    for (uint32_t i = 0; i < a.count + b.count; ++i) {
+        q.receive(v, 1000);
+    }
+    uint64_t wall = bench::nowNs() - t0;
+    done.wait();
+
+    bench::Recorder all(n);
+    all.merge(lat1);
+    all.merge(lat2);
+    bench::report("queue", "contended", "send (2 producers)", a.count + b.count, wall, all);
+}
+
+// FromISR-варианты с маскированием прерываний, как в настоящем обработчике
+BENCHMARK(queue_isr) {
+    const uint32_t  n = bench::iterations();
+    Queue<uint32_t> q(Batch);
+    bench::Recorder sendLat(n), recvLat(n);
+    uint64_t        sendWall = 0, recvWall = 0;
+
+    for (uint32_t done = 0; done < n; done += Batch) {
+        uint64_t t0 = bench::nowNs();
+        for (uint32_t i = 0; i < Batch; ++i) {
+            sendLat.measure([&] {
+                BaseType_t  woken = pdFALSE;
+                UBaseType_t mask  = taskENTER_CRITICAL_FROM_ISR();
+                q.sendFromISR(i, &woken);
+                taskEXIT_CRITICAL_FROM_ISR(mask);
+                portYIELD_FROM_ISR(woken);
+            });
+        }
+        uint64_t t1 = bench::nowNs();
+        uint32_t v;
+        for (uint32_t i = 0; i < Batch; ++i) {
+            recvLat.measure([&] {
+                BaseType_t  woken = pdFALSE;
+                UBaseType_t mask  = taskENTER_CRITICAL_FROM_ISR();
+                q.receiveFromISR(v, &woken);
+                taskEXIT_CRITICAL_FROM_ISR(mask);
+                portYIELD_FROM_ISR(woken);
+            });
+        }
+        sendWall += t1 - t0;
+        recvWall += bench::nowNs() - t1;
+    }
+    uint64_t ops = (n + Batch - 1) / Batch * Batch;
+    bench::report("queue", "isr", "sendFromISR", ops, sendWall, sendLat);
+    bench::report("queue", "isr", "receiveFromISR", ops, recvWall, recvLat);
+}
+
+// Потребитель с более высоким приоритетом ждёт в receive():
+// каждый send переключает контекст туда и обратно
+BENCHMARK(queue_cross_priority) {
+    const uint32_t  n = bench::iterations();
+    Queue<uint32_t> q(1);
+    bench::Recorder lat(n);
+    bench::Done     done(1);
+    ConsumerArgs    args{&q, n, &done};
+    xTaskCreate(consumerTask, "consumer", configMINIMAL_STACK_SIZE, &args, bench::RunnerPriority + 1, nullptr);
+
+    uint64_t t0 = bench::nowNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        lat.measure([&] { q.send(i, 1000); });
+    }
+    uint64_t wall = bench::nowNs() - t0;
+    done.wait();
+    bench::report("queue", "cross_priority", "send (wakes higher prio)", n, wall, lat);
+}
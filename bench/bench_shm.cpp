@@ -0,0 +1,206 @@
+#include "BenchHarness.h"
+
+#include "SharedMemChannel.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// SharedMemChannel между двумя процессами через memfd: латентность пинг-понга и
+// пропускная способность в одну сторону, со звонками eventfd и futex.
+// Второй процесс — этот же исполняемый файл с SHM_PEER в окружении; он поднимает свой
+// планировщик в статическом конструкторе и до main() не доходит.
+// Время — часы хоста: стороны спят в системных вызовах, виртуальные часы этого не видят.
+
+namespace {
+
+struct Msg {
+    uint32_t seq;
+    uint32_t payload[15];  // 64 байта — строка кэша
+};
+
+using Channel = SharedMemChannel<Msg>;
+
+constexpr uint32_t Stop       = UINT32_MAX;
+constexpr size_t   RegionSize = Channel::regionBytes(256);
+constexpr size_t   MapSize    = 2 * RegionSize;  // туда и обратно
+
+uint64_t hostNs() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+// Звонки одной стороны. Место в кольце «туда» — всегда futex.
+struct Bells {
+    FutexDoorbell   futexTo, futexBack, space;
+    EventFdDoorbell efdTo, efdBack;
+    bool            useFutex;
+
+    Bells(uint8_t* mem, int efdTo, int efdBack, bool useFutex)
+        : futexTo(Channel::bellWord(mem, shm::DataBell)),
+          futexBack(Channel::bellWord(mem + RegionSize, shm::DataBell)),
+          space(Channel::bellWord(mem, shm::SpaceBell)),
+          efdTo(efdTo),
+          efdBack(efdBack),
+          useFutex(useFutex) {}
+
+    Doorbell* to() {
+        return useFutex ? static_cast<Doorbell*>(&futexTo) : &efdTo;
+    }
+    Doorbell* back() {
+        return useFutex ? static_cast<Doorbell*>(&futexBack) : &efdBack;
+    }
+};
+
+uint8_t* mapShared(int fd) {
+    void* mem = mmap(nullptr, MapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return mem == MAP_FAILED ? nullptr : static_cast<uint8_t*>(mem);
+}
+
+// ---- Второй процесс: 'e' — эхо каждого сообщения, 's' — счёт до Stop и один ответ ----
+
+struct PeerArgs {
+    int  memFd, efdTo, efdBack, futex;
+    char mode;
+} peer;
+
+void peerTask(void*) {
+    uint8_t* mem = mapShared(peer.memFd);
+    if (!mem) _exit(2);
+    Bells   bells(mem, peer.efdTo, peer.efdBack, peer.futex != 0);
+    Channel in(mem, RegionSize, shm::Attach, bells.to(), &bells.space);
+    Channel out(mem + RegionSize, RegionSize, shm::Attach, bells.back());
+    if (!in.attached() || !out.attached()) _exit(3);
+
+    Msg      m{};
+    uint32_t count = 0;
+    while (in.receive(m, 10000) && m.seq != Stop) {
+        ++count;
+        if (peer.mode == 'e' && !out.send(m, 10000)) _exit(4);
+    }
+    m.seq = count;
+    out.send(m, 10000);
+    _exit(0);
+}
+
+struct PeerHook {
+    PeerHook() {
+        const char* env = std::getenv("SHM_PEER");
+        if (!env || std::sscanf(env, "%d,%d,%d,%d,%c", &peer.memFd, &peer.efdTo, &peer.efdBack, &peer.futex,
+                                &peer.mode) != 5) {
+            return;
+        }
+        xTaskCreate(peerTask, "peer", configMINIMAL_STACK_SIZE * 4, nullptr, bench::RunnerPriority, nullptr);
+        vTaskStartScheduler();
+        _exit(6);
+    }
+} peerHook;
+
+// Область, звонки и второй процесс на один сценарий
+class Session {
+  public:
+    Session(bool futex, char mode) {
+        memFd   = memfd_create("bench_shm", 0);
+        efdTo   = eventfd(0, 0);
+        efdBack = eventfd(0, 0);
+        if (memFd < 0 || ftruncate(memFd, MapSize) != 0 || !(mem = mapShared(memFd))) return;
+        bells = new Bells(mem, efdTo, efdBack, futex);
+        out   = new Channel(mem, RegionSize, shm::Create, bells->to(), &bells->space);
+        in    = new Channel(mem + RegionSize, RegionSize, shm::Create, bells->back());
+
+        char  env[64];
+        char  self[] = "/proc/self/exe";
+        char* argv[] = {self, nullptr};
+        std::snprintf(env, sizeof(env), "SHM_PEER=%d,%d,%d,%d,%c", memFd, efdTo, efdBack, futex ? 1 : 0, mode);
+        char* envp[] = {env, nullptr};
+        pid          = fork();
+        if (pid == 0) {
+            execve(self, argv, envp);
+            _exit(127);
+        }
+    }
+
+    ~Session() {
+        if (pid > 0) waitpid(pid, nullptr, 0);
+        delete in;
+        delete out;
+        delete bells;
+        if (mem) munmap(mem, MapSize);
+        close(efdBack);
+        close(efdTo);
+        close(memFd);
+    }
+
+    bool ok() const {
+        return pid > 0;
+    }
+
+    Channel* out = nullptr;
+    Channel* in  = nullptr;
+
+  private:
+    int      memFd = -1, efdTo = -1, efdBack = -1;
+    pid_t    pid   = -1;
+    uint8_t* mem   = nullptr;
+    Bells*   bells = nullptr;
+};
+
+void pingPong(bool futex) {
+    const char* scenario = futex ? "2 processes, futex" : "2 processes, eventfd";
+    Session     s(futex, 'e');
+    if (!s.ok()) return;
+    const uint32_t  n = bench::iterations() / 10;
+    bench::Recorder lat(n);
+    Msg             m{};
+    uint64_t        t0 = hostNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        m.seq      = i;
+        uint64_t t = hostNs();
+        s.out->send(m, 10000);
+        s.in->receive(m, 10000);
+        lat.add(hostNs() - t);
+    }
+    uint64_t wall = hostNs() - t0;
+    m.seq         = Stop;
+    s.out->send(m, 10000);
+    s.in->receive(m, 10000);
+    bench::report("shm_channel", scenario, "round trip", n, wall, lat);
+}
+
+void stream(bool futex) {
+    const char* scenario = futex ? "2 processes, futex" : "2 processes, eventfd";
+    Session     s(futex, 's');
+    if (!s.ok()) return;
+    const uint32_t  n = bench::iterations();
+    bench::Recorder lat(n);
+    Msg             m{};
+    uint64_t        t0 = hostNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        m.seq      = i;
+        uint64_t t = hostNs();
+        s.out->send(m, 10000);
+        lat.add(hostNs() - t);
+    }
+    m.seq = Stop;
+    s.out->send(m, 10000);
+    s.in->receive(m, 10000);  // второй процесс дочитал всё
+    uint64_t wall = hostNs() - t0;
+    if (m.seq != n) std::fprintf(stderr, "  shm_channel: peer counted %u of %u\n", m.seq, n);
+    bench::report("shm_channel", scenario, "send 64B one way", n, wall, lat);
+}
+
+}  // namespace
+
+BENCHMARK(shm_ping_pong) {
+    pingPong(false);
+    pingPong(true);
+}
+
+BENCHMARK(shm_stream) {
+    stream(false);
+    stream(true);
+}
@@ -0,0 +1,36 @@
+#include "BenchHarness.h"
+
+// Собирается с FREERTOS_CPP_SLO=1 (см. bench/CMakeLists.txt); без него start()/end() пустые
+#include "Slo.h"
+
+#include <chrono>
+
+// Цена отметки пути: start() + end() — чтение часов и несколько атомарных счётчиков.
+// Время — часы хоста: в виртуальном времени симулятора эти операции бесплатны.
+
+namespace {
+
+uint64_t hostNs() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+constexpr uint32_t Batch = 64;
+
+}  // namespace
+
+BENCHMARK(slo_path) {
+    const uint32_t  n = bench::iterations() / Batch * Batch;
+    slo::Path       path("bench", 1000);
+    bench::Recorder lat(n / Batch);
+
+    const uint64_t t0 = hostNs();
+    for (uint32_t i = 0; i < n; i += Batch) {
+        uint64_t s = hostNs();
+        for (uint32_t k = 0; k < Batch; ++k) path.end(path.start());
+        lat.add((hostNs() - s) / Batch);
+    }
+    const uint64_t wall = hostNs() - t0;
+    if (path.stats().count != n) std::fprintf(stderr, "  slo: counted %u of %u\n", path.stats().count, n);
+    bench::report("slo", "enabled", "start+end", n, wall, lat);
+}
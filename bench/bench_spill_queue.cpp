@@ -0,0 +1,74 @@
+#include "BenchHarness.h"
+
+#include "QueueCpp.h"
+#include "SpillQueue.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <unistd.h>
+
+// SpillQueue: пропускная способность записи и чтения в RAM и при всплеске через файл.
+// Время — часы хоста: ввод-вывод в файл реальный, виртуальные часы симулятора его не видят.
+
+namespace {
+
+struct Record {
+    uint32_t seq;
+    uint32_t payload[3];
+};
+
+using Spill = SpillQueue<Record, 4096, 8, 2>;
+
+uint64_t hostNs() {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+// n записей пачками: все send, затем все receive
+template <typename Q>
+void burst(Q& q, uint32_t n, const char* scenario) {
+    bench::Recorder sendLat(n), recvLat(n);
+    Record          r{};
+    uint64_t        t0 = hostNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        r.seq       = i;
+        uint64_t s  = hostNs();
+        q.send(r);
+        sendLat.add(hostNs() - s);
+    }
+    uint64_t t1 = hostNs();
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t s = hostNs();
+        q.receive(r, 1000);
+        recvLat.add(hostNs() - s);
+    }
+    uint64_t t2 = hostNs();
+    bench::report("spill_queue", scenario, "send", n, t1 - t0, sendLat);
+    bench::report("spill_queue", scenario, "receive", n, t2 - t1, recvLat);
+}
+
+}  // namespace
+
+// Всплеск, который помещается в RAM: обычная очередь против SpillQueue без носителя
+BENCHMARK(spill_queue_ram) {
+    const uint32_t n = static_cast<uint32_t>(Spill::ramCapacity());
+    Queue<Record>  q(n);
+    Spill          s;
+    burst(q, n, "Queue<T> baseline");
+    burst(s, n, "in RAM");
+}
+
+// Всплеск в 40 раз больше RAM: середина уходит в файл и подкачивается обратно
+BENCHMARK(spill_queue_file) {
+    char path[] = "/tmp/bench_spill_XXXXXX";
+    int  fd     = mkstemp(path);
+    if (fd >= 0) close(fd);
+    {
+        FileBlockDevice dev(path, 4096, 512);
+        Spill           q(&dev);
+        q.start("spill", bench::RunnerPriority + 1);
+        burst(q, static_cast<uint32_t>(Spill::ramCapacity() * 40), "burst 40x RAM via file");
+        q.stop();
+    }
+    unlink(path);
+}
@@ -0,0 +1,3 @@
+// Шим ESP-IDF-путей: "freertos/FreeRTOS.h" -> FreeRTOS.h из FreeRTOS-Kernel
+#pragma once
+#include <FreeRTOS.h>
@@ -0,0 +1,3 @@
+// Шим ESP-IDF-путей: "freertos/event_groups.h" -> event_groups.h из FreeRTOS-Kernel
+#pragma once
+#include <event_groups.h>
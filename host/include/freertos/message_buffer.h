@@ -0,0 +1,3 @@
+// Шим ESP-IDF-путей: "freertos/message_buffer.h" -> message_buffer.h из FreeRTOS-Kernel
+#pragma once
+#include <message_buffer.h>
@@ -0,0 +1,3 @@
+// Шим ESP-IDF-путей: "freertos/queue.h" -> queue.h из FreeRTOS-Kernel
+#pragma once
+#include <queue.h>
@@ -0,0 +1,3 @@
+// Шим ESP-IDF-путей: "freertos/semphr.h" -> semphr.h из FreeRTOS-Kernel
+#pragma once
+#include <semphr.h>
@@ -0,0 +1,3 @@
+// Шим ESP-IDF-путей: "freertos/stream_buffer.h" -> stream_buffer.h из FreeRTOS-Kernel
+#pragma once
+#include <stream_buffer.h>
@@ -0,0 +1,3 @@
+// Шим ESP-IDF-путей: "freertos/task.h" -> task.h из FreeRTOS-Kernel
+#pragma once
+#include <task.h>
@@ -0,0 +1,3 @@
+// Шим ESP-IDF-путей: "freertos/timers.h" -> timers.h из FreeRTOS-Kernel
+#pragma once
+#include <timers.h>
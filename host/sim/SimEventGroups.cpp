@@ -0,0 +1,138 @@
+// Группы событий симулятора.
+
+#include "SimInternal.h"
+
+using namespace sim;
+using namespace sim::detail;
+
+namespace {
+
+bool satisfied(EventBits_t bits, EventBits_t waitFor, bool all) {
+    return all ? (bits & waitFor) == waitFor : (bits & waitFor) != 0;
+}
+
+// Установить биты и разбудить всех, чьё условие выполнилось.
+// Биты clearOnExit разбуженных задач сбрасываются после обхода, как в ядре.
+void applySet(EventGroupHandle_t eg, EventBits_t set) {
+    eg->bits |= set;
+    EventBits_t               clear = 0;
+    std::vector<TaskHandle_t> waiters(eg->waiters.tasks);
+    for (TaskHandle_t t : waiters) {
+        if (!satisfied(eg->bits, t->evWaitFor, t->evAll)) continue;
+        if (t->evClear) clear |= t->evWaitFor;
+        t->evResult = eg->bits;
+        wake(t);
+    }
+    eg->bits &= ~clear;
+}
+
+EventBits_t wait(EventGroupHandle_t eg, EventBits_t waitFor, bool clear, bool all, TickType_t ticks) {
+    TaskHandle_t t = current();
+    t->evWaitFor   = waitFor;
+    t->evAll       = all;
+    t->evClear     = clear;
+    if (block(&eg->waiters, deadline(ticks))) return t->evResult;
+    // Таймаут: вернуть текущие биты, условие могло выполниться в последний момент
+    EventBits_t bits = eg->bits;
+    if (clear && satisfied(bits, waitFor, all)) eg->bits &= ~waitFor;
+    return bits;
+}
+
+}  // namespace
+
+extern "C" {
+
+EventGroupHandle_t xEventGroupCreate(void) {
+    return new EventGroupDef_t();
+}
+
+EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t* pxEventGroupBuffer) {
+    configASSERT(pxEventGroupBuffer);
+    return new EventGroupDef_t();
+}
+
+void vEventGroupDelete(EventGroupHandle_t xEventGroup) {
+    configASSERT(xEventGroup);
+    // Ядро будит ожидающих с нулевым результатом
+    while (TaskHandle_t t = wakeFirst(xEventGroup->waiters)) t->evResult = 0;
+    delete xEventGroup;
+    preemptIfNeeded();
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor,
+                                const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits,
+                                TickType_t xTicksToWait) {
+    configASSERT(xEventGroup && uxBitsToWaitFor);
+    charge(Op::EventGroupWait);
+    EventBits_t bits = xEventGroup->bits;
+    if (satisfied(bits, uxBitsToWaitFor, xWaitForAllBits)) {
+        if (xClearOnExit) xEventGroup->bits &= ~uxBitsToWaitFor;
+        return bits;
+    }
+    if (xTicksToWait == 0) return bits;
+    return wait(xEventGroup, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, xTicksToWait);
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet) {
+    configASSERT(xEventGroup);
+    charge(Op::EventGroupSet);
+    applySet(xEventGroup, uxBitsToSet);
+    EventBits_t bits = xEventGroup->bits;
+    preemptIfNeeded();
+    return bits;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear) {
+    configASSERT(xEventGroup);
+    if (uxBitsToClear) charge(Op::EventGroupClear);
+    EventBits_t bits = xEventGroup->bits;
+    xEventGroup->bits &= ~uxBitsToClear;
+    return bits;
+}
+
+EventBits_t xEventGroupSync(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet,
+                            const EventBits_t uxBitsToWaitFor, TickType_t xTicksToWait) {
+    configASSERT(xEventGroup && uxBitsToWaitFor);
+    charge(Op::EventGroupSet);
+    EventBits_t original = xEventGroup->bits;
+    applySet(xEventGroup, uxBitsToSet);
+    if (((original | uxBitsToSet) & uxBitsToWaitFor) == uxBitsToWaitFor) {
+        EventBits_t bits = original | uxBitsToSet;
+        xEventGroup->bits &= ~uxBitsToWaitFor;
+        preemptIfNeeded();
+        return bits;
+    }
+    if (xTicksToWait == 0) {
+        EventBits_t bits = xEventGroup->bits;
+        preemptIfNeeded();
+        return bits;
+    }
+    return wait(xEventGroup, uxBitsToWaitFor, true, true, xTicksToWait);
+}
+
+EventBits_t xEventGroupGetBitsFromISR(EventGroupHandle_t xEventGroup) {
+    configASSERT(xEventGroup);
+    return xEventGroup->bits;
+}
+
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet,
+                                     BaseType_t* pxHigherPriorityTaskWoken) {
+    configASSERT(xEventGroup);
+    charge(Op::EventGroupSetFromISR);
+    std::vector<TaskHandle_t> before(xEventGroup->waiters.tasks);
+    applySet(xEventGroup, uxBitsToSet);
+    if (pxHigherPriorityTaskWoken) {
+        for (TaskHandle_t t : before) {
+            if (t->waitList == nullptr && higherThanCurrent(t)) *pxHigherPriorityTaskWoken = pdTRUE;
+        }
+    }
+    return pdPASS;
+}
+
+BaseType_t xEventGroupClearBitsFromISR(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear) {
+    configASSERT(xEventGroup);
+    xEventGroup->bits &= ~uxBitsToClear;
+    return pdPASS;
+}
+
+}  // extern "C"
@@ -0,0 +1,150 @@
+#ifndef SIM_INTERNAL_H
+#define SIM_INTERNAL_H
+
+// Внутренности симулятора: контрольные блоки и примитивы планировщика,
+// общие для SimKernel.cpp, SimQueue.cpp, SimEventGroups.cpp и SimStreamBuffer.cpp.
+
+#include "SimKernel.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/stream_buffer.h"
+#include "freertos/task.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sim {
+namespace detail {
+
+constexpr uint64_t Never = UINT64_MAX;
+
+// Эстафета: поток задачи спит, пока планировщик не передаст ему процессор
+class Baton {
+  public:
+    void post() {
+        std::lock_guard<std::mutex> lock(m);
+        go = true;
+        cv.notify_one();
+    }
+    void wait() {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [this] { return go; });
+        go = false;
+    }
+
+  private:
+    std::mutex              m;
+    std::condition_variable cv;
+    bool                    go = false;
+};
+
+// Список ожидающих: по убыванию приоритета, FIFO среди равных (как event list ядра)
+struct WaitList {
+    std::vector<TaskHandle_t> tasks;
+
+    void insert(TaskHandle_t t);
+    void remove(TaskHandle_t t);
+    bool empty() const {
+        return tasks.empty();
+    }
+};
+
+enum class State : uint8_t { Ready, Running, Blocked, Suspended, Deleted };
+
+enum NotifyState : uint8_t { NotWaiting = 0, Waiting = 1, Received = 2 };
+
+// ---- Примитивы планировщика (вызываются из API) ----
+
+TaskHandle_t current();
+
+// Списать стоимость операции с текущей задачи (в точке входа в API, до изменения состояния)
+void charge(Op op, size_t bytes = 0);
+
+// Момент пробуждения для таймаута в тиках (portMAX_DELAY — никогда)
+uint64_t deadline(TickType_t ticks);
+
+// Заблокировать текущую задачу. true — разбудило событие, false — таймаут
+bool block(WaitList* list, uint64_t wakeAt);
+
+// Разбудить задачу событием
+void wake(TaskHandle_t t);
+
+// Разбудить первую задачу из списка; nullptr, если список пуст
+TaskHandle_t wakeFirst(WaitList& list);
+
+// Переключиться на более приоритетную готовую задачу, если такая есть
+void preemptIfNeeded();
+
+// Приоритет задачи выше текущей (для pxHigherPriorityTaskWoken)
+bool higherThanCurrent(TaskHandle_t t);
+
+}  // namespace detail
+}  // namespace sim
+
+struct tskTaskControlBlock {
+    std::string            name;
+    TaskFunction_t         fn  = nullptr;
+    void*                  arg = nullptr;
+    UBaseType_t            basePriority = 0;
+    UBaseType_t            priority     = 0;
+    UBaseType_t            number       = 0;
+    configSTACK_DEPTH_TYPE stackDepth   = 0;
+
+    sim::detail::State     state     = sim::detail::State::Ready;
+    uint64_t               readySeq  = 0;
+    uint64_t               wakeAt    = sim::detail::Never;
+    bool                   timedOut  = false;
+    sim::detail::WaitList* waitList  = nullptr;
+    UBaseType_t            mutexesHeld = 0;
+
+    // Ожидание в event group
+    EventBits_t evWaitFor = 0;
+    EventBits_t evResult  = 0;
+    bool        evAll     = false;
+    bool        evClear   = false;
+
+    // Уведомления
+    uint32_t notifyValue[configTASK_NOTIFICATION_ARRAY_ENTRIES] = {};
+    uint8_t  notifyState[configTASK_NOTIFICATION_ARRAY_ENTRIES] = {};
+    int      notifyWaitIndex = -1;
+
+    uint64_t           runTimeNs = 0;
+    uint32_t           stackPeak = 0;  // sim::useStack()
+    sim::detail::Baton baton;
+};
+
+struct QueueDefinition {
+    uint8_t              type     = queueQUEUE_TYPE_BASE;
+    UBaseType_t          length   = 0;
+    UBaseType_t          itemSize = 0;
+    std::vector<uint8_t> storage;
+    UBaseType_t          head  = 0;  // индекс самого старого элемента
+    UBaseType_t          count = 0;
+
+    sim::detail::WaitList senders;
+    sim::detail::WaitList receivers;
+
+    TaskHandle_t holder    = nullptr;  // мьютексы
+    UBaseType_t  recursion = 0;
+};
+
+struct StreamBufferDef_t {
+    std::vector<uint8_t> storage;
+    size_t               trigger = 1;
+    size_t               head    = 0;  // первый непрочитанный байт
+    size_t               count   = 0;
+
+    sim::detail::WaitList senders;
+    sim::detail::WaitList receivers;
+};
+
+struct EventGroupDef_t {
+    EventBits_t           bits = 0;
+    sim::detail::WaitList waiters;
+};
+
+#endif  // SIM_INTERNAL_H
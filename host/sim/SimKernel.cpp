@@ -0,0 +1,873 @@
+// Планировщик симулятора: задачи, виртуальные часы, прерывания, уведомления.
+
+#include "SimInternal.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <utility>
+
+namespace sim {
+namespace detail {
+
+namespace {
+
+struct Event {
+    uint64_t              period;
+    std::function<void()> fn;
+    bool                  isr;
+};
+
+struct Kernel {
+    uint64_t now = 0;
+
+    std::vector<TaskHandle_t> tasks;  // все неудалённые задачи в порядке создания
+    TaskHandle_t              running = nullptr;
+    Baton                     mainBaton;  // поток, вызвавший vTaskStartScheduler
+
+    bool started    = false;
+    bool ended      = false;
+    bool deadlocked = false;
+    bool isr        = false;
+    bool probing    = false;
+    bool sliceDue   = false;
+    int  critical   = 0;
+    int  suspended  = 0;
+
+    uint64_t    readySeq   = 0;
+    uint64_t    eventSeq   = 0;
+    UBaseType_t taskNumber = 0;
+    uint64_t    stopAt     = Never;
+
+    std::map<std::pair<uint64_t, uint64_t>, Event> events;
+
+    CostModel cost = CostModel::esp32();
+    Stats     stats{};
+};
+
+Kernel& k() {
+    static Kernel kernel;
+    return kernel;
+}
+
+// Задача простоя только для статистики: потока у неё нет, время ей начисляет moveClock()
+TaskHandle_t idleTask() {
+    static TaskHandle_t idle = [] {
+        TaskHandle_t t = new tskTaskControlBlock();
+        t->name        = "IDLE";
+        t->stackDepth  = configMINIMAL_STACK_SIZE;
+        return t;
+    }();
+    idle->runTimeNs = k().stats.idleNs;
+    return idle;
+}
+
+constexpr uint64_t TickNs = 1000000000ull / configTICK_RATE_HZ;
+
+bool masked() {
+    Kernel& K = k();
+    return K.isr || K.critical > 0;
+}
+
+void makeReady(TaskHandle_t t) {
+    t->state    = State::Ready;
+    t->readySeq = ++k().readySeq;
+}
+
+TaskHandle_t pickReady() {
+    TaskHandle_t best = nullptr;
+    for (TaskHandle_t t : k().tasks) {
+        if (t->state != State::Ready) continue;
+        if (!best || t->priority > best->priority ||
+            (t->priority == best->priority && t->readySeq < best->readySeq)) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+bool sameLevelReady() {
+    Kernel& K = k();
+    if (!K.running) return false;
+    for (TaskHandle_t t : K.tasks) {
+        if (t->state == State::Ready && t->priority >= K.running->priority) return true;
+    }
+    return false;
+}
+
+uint64_t nextWake() {
+    uint64_t t = Never;
+    for (TaskHandle_t task : k().tasks) {
+        if (task->state == State::Blocked && task->wakeAt < t) t = task->wakeAt;
+    }
+    return t;
+}
+
+uint64_t nextEvent() {
+    Kernel& K = k();
+    return K.events.empty() ? Never : K.events.begin()->first.first;
+}
+
+// Сдвинуть часы; время списывается на выполняющуюся задачу или на простой
+void moveClock(uint64_t t) {
+    Kernel& K = k();
+    if (t <= K.now) return;
+    uint64_t d = t - K.now;
+    if (K.running && K.running->state == State::Running) {
+        K.running->runTimeNs += d;
+    } else {
+        K.stats.idleNs += d;
+    }
+    if (t / TickNs != K.now / TickNs) K.sliceDue = true;
+    K.now = t;
+}
+
+void wakeTimedOut() {
+    Kernel& K = k();
+    for (TaskHandle_t t : K.tasks) {
+        if (t->state == State::Blocked && t->wakeAt <= K.now) {
+            if (t->waitList) t->waitList->remove(t);
+            t->waitList = nullptr;
+            t->wakeAt   = Never;
+            t->timedOut = true;
+            makeReady(t);
+        }
+    }
+}
+
+void fireDueEvents() {
+    Kernel& K = k();
+    while (!masked() && !K.events.empty() && K.events.begin()->first.first <= K.now) {
+        auto     node = K.events.extract(K.events.begin());
+        uint64_t at   = node.key().first;
+        Event&   ev   = node.mapped();
+        if (ev.period) {
+            K.events.emplace(std::make_pair(at + ev.period, ++K.eventSeq), ev);
+        }
+        K.isr = true;
+        if (ev.isr) {
+            ++K.stats.interrupts;
+            moveClock(K.now + K.cost.cost(Op::IsrEntry));
+            ev.fn();
+        } else {
+            K.probing = true;
+            ev.fn();
+            K.probing = false;
+        }
+        K.isr = false;
+        wakeTimedOut();
+    }
+}
+
+// Обработать всё, что наступило к текущему моменту: таймауты и прерывания
+void processDue() {
+    wakeTimedOut();
+    fireDueEvents();
+}
+
+[[noreturn]] void park(TaskHandle_t self) {
+    for (;;) self->baton.wait();
+}
+
+// Остановить планировщик: вернуть управление в vTaskStartScheduler
+void finish() {
+    Kernel& K = k();
+    K.ended = true;
+    if (K.running) {
+        TaskHandle_t self = K.running;
+        K.mainBaton.post();
+        park(self);
+    }
+}
+
+// Текущая задача отдаёт процессор (её state уже выставлен).
+// Возвращается, когда задача снова выбрана планировщиком.
+void schedule() {
+    Kernel&      K    = k();
+    TaskHandle_t self = K.running;
+    TaskHandle_t next = nullptr;
+
+    for (;;) {
+        if (K.ended) break;
+        next = pickReady();
+        if (next) break;
+
+        // Простой: перескакиваем к ближайшему событию
+        uint64_t t = std::min({nextEvent(), nextWake(), K.stopAt});
+        if (t == Never) {
+            // Задачи остались, но разбудить их нечему
+            if (!K.tasks.empty()) {
+                K.deadlocked = true;
+                std::fprintf(stderr, "sim: all tasks blocked forever at %llu ns, stopping scheduler\n",
+                             (unsigned long long)K.now);
+            }
+            K.ended = true;
+            break;
+        }
+        moveClock(t);
+        if (K.now >= K.stopAt) {
+            K.ended = true;
+            break;
+        }
+        processDue();
+    }
+
+    if (K.ended) {
+        if (!self) return;  // главный поток: планировщик так и не стартовал
+        K.mainBaton.post();
+        park(self);
+    }
+
+    next->state = State::Running;
+    K.sliceDue  = false;
+    if (next == self) return;
+
+    ++K.stats.contextSwitches;
+    K.running = next;
+    moveClock(K.now + K.cost.cost(Op::ContextSwitch));
+    next->baton.post();
+    if (!self) {
+        K.mainBaton.wait();
+        return;
+    }
+    self->baton.wait();
+    if (K.ended || self->state == State::Deleted) park(self);
+}
+
+void taskMain(TaskHandle_t t) {
+    t->baton.wait();
+    if (k().ended || t->state == State::Deleted) park(t);
+    t->fn(t->arg);
+    // Задача FreeRTOS не должна возвращаться — считаем это самоудалением
+    vTaskDelete(nullptr);
+}
+
+// Время с возможностью вытеснения: останавливаемся на каждом событии
+void advance(uint64_t ns) {
+    Kernel& K = k();
+    if (!K.started || K.probing) return;
+    if (!K.running || masked() || K.suspended) {
+        moveClock(K.now + ns);
+        return;
+    }
+    uint64_t remaining = ns;
+    for (;;) {
+        uint64_t start = K.now;
+        uint64_t stop  = std::min({start + remaining, nextEvent(), nextWake(), K.stopAt});
+        if (configUSE_TIME_SLICING && sameLevelReady()) {
+            stop = std::min(stop, (start / TickNs + 1) * TickNs);
+        }
+        if (stop < start) stop = start;
+        moveClock(stop);
+        remaining -= stop - start;
+        if (K.now >= K.stopAt) finish();
+        processDue();
+        preemptIfNeeded();
+        if (remaining == 0) break;
+    }
+}
+
+TaskHandle_t resolve(TaskHandle_t t) {
+    return t ? t : k().running;
+}
+
+}  // namespace
+
+// ---- WaitList ----
+
+void WaitList::insert(TaskHandle_t t) {
+    auto it = tasks.begin();
+    while (it != tasks.end() && (*it)->priority >= t->priority) ++it;
+    tasks.insert(it, t);
+}
+
+void WaitList::remove(TaskHandle_t t) {
+    auto it = std::find(tasks.begin(), tasks.end(), t);
+    if (it != tasks.end()) tasks.erase(it);
+}
+
+// ---- Примитивы ----
+
+TaskHandle_t current() {
+    return k().running;
+}
+
+void charge(Op op, size_t bytes) {
+    advance(k().cost.cost(op, bytes));
+}
+
+uint64_t deadline(TickType_t ticks) {
+    if (ticks == portMAX_DELAY) return Never;
+    return (k().now / TickNs + ticks) * TickNs;
+}
+
+bool block(WaitList* list, uint64_t wakeAt) {
+    Kernel& K = k();
+    configASSERT(K.running && !K.isr && K.critical == 0 && K.suspended == 0);
+    TaskHandle_t t = K.running;
+    t->timedOut    = false;
+    t->wakeAt      = wakeAt;
+    t->waitList    = list;
+    if (list) list->insert(t);
+    t->state = State::Blocked;
+    schedule();
+    return !t->timedOut;
+}
+
+void wake(TaskHandle_t t) {
+    if (t->waitList) t->waitList->remove(t);
+    t->waitList = nullptr;
+    t->wakeAt   = Never;
+    t->timedOut = false;
+    makeReady(t);
+}
+
+TaskHandle_t wakeFirst(WaitList& list) {
+    if (list.empty()) return nullptr;
+    TaskHandle_t t = list.tasks.front();
+    wake(t);
+    return t;
+}
+
+void preemptIfNeeded() {
+    Kernel& K = k();
+    if (!K.started || !K.running || masked() || K.suspended) return;
+    if (K.ended) finish();
+    TaskHandle_t best  = pickReady();
+    bool         slice = K.sliceDue;
+    K.sliceDue         = false;
+    if (!best) return;
+    if (best->priority > K.running->priority ||
+        (configUSE_TIME_SLICING && slice && best->priority == K.running->priority)) {
+        makeReady(K.running);
+        schedule();
+    }
+}
+
+bool higherThanCurrent(TaskHandle_t t) {
+    TaskHandle_t cur = k().running;
+    return cur && cur->state == State::Running && t->priority > cur->priority;
+}
+
+}  // namespace detail
+
+// ---- Управление симулятором ----
+
+using namespace detail;
+
+CostModel CostModel::zero() {
+    CostModel m{};
+    return m;
+}
+
+CostModel CostModel::esp32() {
+    CostModel m{};
+    auto set = [&m](Op op, uint64_t ns) { m.ns[static_cast<size_t>(op)] = ns; };
+    set(Op::ContextSwitch, 1200);
+    set(Op::TaskCreate, 25000);
+    set(Op::TaskDelete, 8000);
+    set(Op::TaskDelay, 600);
+    set(Op::TaskYield, 400);
+    set(Op::QueueSend, 900);
+    set(Op::QueueReceive, 900);
+    set(Op::QueuePeek, 700);
+    set(Op::QueueSendFromISR, 700);
+    set(Op::QueueReceiveFromISR, 700);
+    set(Op::SemaphoreTake, 600);
+    set(Op::SemaphoreGive, 600);
+    set(Op::MutexTake, 700);
+    set(Op::MutexGive, 800);
+    set(Op::EventGroupSet, 900);
+    set(Op::EventGroupClear, 300);
+    set(Op::EventGroupWait, 700);
+    set(Op::EventGroupSetFromISR, 1200);
+    set(Op::Notify, 500);
+    set(Op::NotifyFromISR, 400);
+    set(Op::NotifyWait, 400);
+    set(Op::IsrEntry, 600);
+    m.copyPsPerByte = 1000;
+    return m;
+}
+
+static const char* const opNames[OpCount] = {
+    "context_switch", "task_create", "task_delete", "task_delay", "task_yield",
+    "queue_send", "queue_receive", "queue_peek", "queue_send_isr", "queue_receive_isr",
+    "semaphore_take", "semaphore_give", "mutex_take", "mutex_give",
+    "event_group_set", "event_group_clear", "event_group_wait", "event_group_set_isr",
+    "notify", "notify_isr", "notify_wait", "isr_entry",
+};
+
+const char* opName(Op op) {
+    return opNames[static_cast<size_t>(op)];
+}
+
+bool opFromName(const char* name, Op& op) {
+    for (size_t i = 0; i < OpCount; ++i) {
+        if (std::strcmp(name, opNames[i]) == 0) {
+            op = static_cast<Op>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void setCostModel(const CostModel& model) {
+    k().cost = model;
+}
+
+const CostModel& costModel() {
+    return k().cost;
+}
+
+uint64_t nowNs() {
+    return k().now;
+}
+
+void consume(uint64_t ns) {
+    advance(ns);
+}
+
+static void addEvent(uint64_t atNs, uint64_t periodNs, std::function<void()> fn, bool isr) {
+    Kernel& K = k();
+    if (atNs < K.now) atNs = K.now;
+    K.events.emplace(std::make_pair(atNs, ++K.eventSeq), Event{periodNs, std::move(fn), isr});
+}
+
+void at(uint64_t atNs, std::function<void()> fn) {
+    addEvent(atNs, 0, std::move(fn), true);
+}
+
+void every(uint64_t firstNs, uint64_t periodNs, std::function<void()> fn) {
+    configASSERT(periodNs > 0);
+    addEvent(firstNs, periodNs, std::move(fn), true);
+}
+
+void probe(uint64_t firstNs, uint64_t periodNs, std::function<void()> fn) {
+    configASSERT(periodNs > 0);
+    addEvent(firstNs, periodNs, std::move(fn), false);
+}
+
+void stopAt(uint64_t ns) {
+    k().stopAt = ns;
+}
+
+bool inIsr() {
+    return k().isr;
+}
+
+bool deadlocked() {
+    return k().deadlocked;
+}
+
+const Stats& stats() {
+    return k().stats;
+}
+
+uint64_t taskRunTimeNs(TaskHandle_t task) {
+    return resolve(task)->runTimeNs;
+}
+
+void useStack(uint32_t words) {
+    TaskHandle_t t = current();
+    configASSERT(t && words <= t->stackDepth);
+    if (words > t->stackPeak) t->stackPeak = words;
+}
+
+}  // namespace sim
+
+using namespace sim;
+using namespace sim::detail;
+
+// ---- Порт ----
+
+extern "C" {
+
+void vPortEnterCritical(void) {
+    ++k().critical;
+}
+
+void vPortExitCritical(void) {
+    Kernel& K = k();
+    configASSERT(K.critical > 0);
+    if (--K.critical == 0 && !K.isr) {
+        processDue();
+        preemptIfNeeded();
+    }
+}
+
+UBaseType_t uxPortSetInterruptMaskFromISR(void) {
+    return static_cast<UBaseType_t>(k().critical++);
+}
+
+void vPortClearInterruptMaskFromISR(UBaseType_t uxSavedStatus) {
+    Kernel& K  = k();
+    K.critical = static_cast<int>(uxSavedStatus);
+    if (K.critical == 0 && !K.isr) {
+        processDue();
+        preemptIfNeeded();
+    }
+}
+
+void vPortYield(void) {
+    Kernel& K = k();
+    if (!K.started || !K.running || masked() || K.suspended) return;
+    charge(Op::TaskYield);
+    makeReady(K.running);
+    schedule();
+}
+
+void vPortYieldFromISR(BaseType_t xSwitchRequired) {
+    // Из настоящего ISR переключение выполнит выход из прерывания
+    if (xSwitchRequired && !k().isr) preemptIfNeeded();
+}
+
+// ---- Задачи ----
+
+static TaskHandle_t createTask(TaskFunction_t fn, const char* name, configSTACK_DEPTH_TYPE depth, void* arg,
+                               UBaseType_t priority) {
+    Kernel& K = k();
+    configASSERT(priority < configMAX_PRIORITIES);
+    charge(Op::TaskCreate);
+
+    TaskHandle_t t  = new tskTaskControlBlock();
+    t->name         = name ? std::string(name).substr(0, configMAX_TASK_NAME_LEN - 1) : std::string();
+    t->fn           = fn;
+    t->arg          = arg;
+    t->basePriority = priority;
+    t->priority     = priority;
+    t->stackDepth   = depth;
+    t->number       = ++K.taskNumber;
+    makeReady(t);
+    K.tasks.push_back(t);
+    std::thread(taskMain, t).detach();
+    return t;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char* pcName, configSTACK_DEPTH_TYPE uxStackDepth,
+                       void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pxCreatedTask) {
+    TaskHandle_t t = createTask(pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority);
+    if (pxCreatedTask) *pxCreatedTask = t;
+    preemptIfNeeded();
+    return pdPASS;
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char* pcName, configSTACK_DEPTH_TYPE uxStackDepth,
+                               void* pvParameters, UBaseType_t uxPriority, StackType_t* puxStackBuffer,
+                               StaticTask_t* pxTaskBuffer) {
+    configASSERT(puxStackBuffer && pxTaskBuffer);
+    TaskHandle_t t = createTask(pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority);
+    preemptIfNeeded();
+    return t;
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+    Kernel&      K = k();
+    TaskHandle_t t = resolve(xTaskToDelete);
+    configASSERT(t);
+    charge(Op::TaskDelete);
+    if (t->waitList) t->waitList->remove(t);
+    t->waitList = nullptr;
+    t->state    = State::Deleted;
+    // Контрольный блок не освобождается: поток задачи навсегда спит на своей эстафете
+    K.tasks.erase(std::find(K.tasks.begin(), K.tasks.end(), t));
+    if (t == K.running) {
+        schedule();
+        park(t);
+    }
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+    if (xTicksToDelay == 0) {
+        vPortYield();
+        return;
+    }
+    charge(Op::TaskDelay);
+    block(nullptr, deadline(xTicksToDelay));
+}
+
+BaseType_t xTaskDelayUntil(TickType_t* pxPreviousWakeTime, TickType_t xTimeIncrement) {
+    configASSERT(pxPreviousWakeTime && xTimeIncrement > 0);
+    charge(Op::TaskDelay);
+    const TickType_t now  = xTaskGetTickCount();
+    const TickType_t wake = *pxPreviousWakeTime + xTimeIncrement;
+    bool             shouldDelay;
+    if (now < *pxPreviousWakeTime) {
+        // Счётчик тиков переполнился с прошлого пробуждения
+        shouldDelay = wake < *pxPreviousWakeTime && wake > now;
+    } else {
+        shouldDelay = wake < *pxPreviousWakeTime || wake > now;
+    }
+    *pxPreviousWakeTime = wake;
+    if (shouldDelay) {
+        block(nullptr, deadline(static_cast<TickType_t>(wake - now)));
+        return pdTRUE;
+    }
+    return pdFALSE;
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return static_cast<TickType_t>(k().now / TickNs);
+}
+
+TickType_t xTaskGetTickCountFromISR(void) {
+    return xTaskGetTickCount();
+}
+
+void vTaskStartScheduler(void) {
+    Kernel& K = k();
+    configASSERT(!K.started);
+    K.started = true;
+    schedule();
+    // Снова главный поток: задач больше нет (деструкторы глобальных объектов вызывают ядро)
+    K.running = nullptr;
+}
+
+void vTaskEndScheduler(void) {
+    finish();
+}
+
+void vTaskSuspendAll(void) {
+    ++k().suspended;
+}
+
+BaseType_t xTaskResumeAll(void) {
+    Kernel& K = k();
+    configASSERT(K.suspended > 0);
+    if (--K.suspended > 0) return pdFALSE;
+    processDue();
+    uint64_t switches = K.stats.contextSwitches;
+    preemptIfNeeded();
+    return K.stats.contextSwitches != switches ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xTaskGetSchedulerState(void) {
+    Kernel& K = k();
+    if (!K.started) return taskSCHEDULER_NOT_STARTED;
+    return K.suspended ? taskSCHEDULER_SUSPENDED : taskSCHEDULER_RUNNING;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask) {
+    return resolve(xTask)->priority;
+}
+
+void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority) {
+    configASSERT(uxNewPriority < configMAX_PRIORITIES);
+    TaskHandle_t t = resolve(xTask);
+    // Унаследованный приоритет не понижаем, пока держится мьютекс
+    if (t->priority == t->basePriority || uxNewPriority > t->priority) {
+        t->priority = uxNewPriority;
+    }
+    t->basePriority = uxNewPriority;
+    preemptIfNeeded();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return k().running;
+}
+
+eTaskState eTaskGetState(TaskHandle_t xTask) {
+    TaskHandle_t t = resolve(xTask);
+    switch (t->state) {
+        case State::Running: return eRunning;
+        case State::Ready: return eReady;
+        case State::Blocked: return eBlocked;
+        case State::Suspended: return eSuspended;
+        case State::Deleted: return eDeleted;
+    }
+    return eInvalid;
+}
+
+char* pcTaskGetName(TaskHandle_t xTaskToQuery) {
+    return &resolve(xTaskToQuery)->name[0];
+}
+
+UBaseType_t uxTaskGetNumberOfTasks(void) {
+    return static_cast<UBaseType_t>(k().tasks.size() + 1);  // с задачей простоя
+}
+
+// ---- Статистика ----
+
+static configRUN_TIME_COUNTER_TYPE runTimeCounter(uint64_t ns) {
+    return static_cast<configRUN_TIME_COUNTER_TYPE>(ns / 1000);
+}
+
+static void fillStatus(TaskHandle_t t, TaskStatus_t& status) {
+    status.xHandle              = t;
+    status.pcTaskName           = t->name.c_str();
+    status.xTaskNumber          = t->number;
+    status.eCurrentState        = t == idleTask() ? eReady : eTaskGetState(t);
+    status.uxCurrentPriority    = t->priority;
+    status.uxBasePriority       = t->basePriority;
+    status.ulRunTimeCounter     = runTimeCounter(t->runTimeNs);
+    status.pxStackBase          = nullptr;
+    status.usStackHighWaterMark = static_cast<configSTACK_DEPTH_TYPE>(t->stackDepth - t->stackPeak);
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t* pxTaskStatusArray, const UBaseType_t uxArraySize,
+                                 configRUN_TIME_COUNTER_TYPE* pulTotalRunTime) {
+    Kernel& K = k();
+    // Как в ядре: массив меньше числа задач — ничего не заполняем
+    if (uxArraySize < uxTaskGetNumberOfTasks()) return 0;
+    UBaseType_t n = 0;
+    for (TaskHandle_t t : K.tasks) fillStatus(t, pxTaskStatusArray[n++]);
+    fillStatus(idleTask(), pxTaskStatusArray[n++]);
+    if (pulTotalRunTime) *pulTotalRunTime = runTimeCounter(K.now);
+    return n;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask) {
+    TaskHandle_t t = resolve(xTask);
+    return t->stackDepth - t->stackPeak;
+}
+
+configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter(const TaskHandle_t xTask) {
+    return runTimeCounter(resolve(xTask)->runTimeNs);
+}
+
+configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter(void) {
+    return runTimeCounter(k().stats.idleNs);
+}
+
+TaskHandle_t xTaskGetIdleTaskHandle(void) {
+    return idleTask();
+}
+
+void vTaskSuspend(TaskHandle_t xTaskToSuspend) {
+    TaskHandle_t t = resolve(xTaskToSuspend);
+    if (t->waitList) t->waitList->remove(t);
+    t->waitList = nullptr;
+    t->wakeAt   = Never;
+    t->timedOut = true;  // прерванное ожидание завершится как по таймауту
+    t->state    = State::Suspended;
+    if (t == k().running) schedule();
+}
+
+void vTaskResume(TaskHandle_t xTaskToResume) {
+    if (xTaskToResume->state != State::Suspended) return;
+    makeReady(xTaskToResume);
+    preemptIfNeeded();
+}
+
+BaseType_t xTaskResumeFromISR(TaskHandle_t xTaskToResume) {
+    if (xTaskToResume->state != State::Suspended) return pdFALSE;
+    makeReady(xTaskToResume);
+    return higherThanCurrent(xTaskToResume) ? pdTRUE : pdFALSE;
+}
+
+// ---- Уведомления ----
+
+static BaseType_t applyNotify(TaskHandle_t t, UBaseType_t index, uint32_t value, eNotifyAction action,
+                              uint32_t* previous, bool& woken) {
+    configASSERT(t && index < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+    if (previous) *previous = t->notifyValue[index];
+    uint8_t old            = t->notifyState[index];
+    t->notifyState[index]  = Received;
+    BaseType_t result      = pdPASS;
+    switch (action) {
+        case eSetBits: t->notifyValue[index] |= value; break;
+        case eIncrement: t->notifyValue[index]++; break;
+        case eSetValueWithOverwrite: t->notifyValue[index] = value; break;
+        case eSetValueWithoutOverwrite:
+            if (old != Received) {
+                t->notifyValue[index] = value;
+            } else {
+                result = pdFAIL;
+            }
+            break;
+        case eNoAction: break;
+    }
+    woken = false;
+    if (old == Waiting && t->state == State::Blocked && t->notifyWaitIndex == static_cast<int>(index)) {
+        wake(t);
+        woken = true;
+    }
+    return result;
+}
+
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+                              eNotifyAction eAction, uint32_t* pulPreviousNotificationValue) {
+    charge(Op::Notify);
+    bool       woken;
+    BaseType_t r = applyNotify(xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, woken);
+    if (woken) preemptIfNeeded();
+    return r;
+}
+
+BaseType_t xTaskGenericNotifyFromISR(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+                                     eNotifyAction eAction, uint32_t* pulPreviousNotificationValue,
+                                     BaseType_t* pxHigherPriorityTaskWoken) {
+    charge(Op::NotifyFromISR);
+    bool       woken;
+    BaseType_t r = applyNotify(xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, woken);
+    if (woken && pxHigherPriorityTaskWoken && higherThanCurrent(xTaskToNotify)) {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+    return r;
+}
+
+void vTaskGenericNotifyGiveFromISR(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify,
+                                   BaseType_t* pxHigherPriorityTaskWoken) {
+    xTaskGenericNotifyFromISR(xTaskToNotify, uxIndexToNotify, 0, eIncrement, nullptr, pxHigherPriorityTaskWoken);
+}
+
+BaseType_t xTaskGenericNotifyWait(UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry,
+                                  uint32_t ulBitsToClearOnExit, uint32_t* pulNotificationValue,
+                                  TickType_t xTicksToWait) {
+    configASSERT(uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+    charge(Op::NotifyWait);
+    TaskHandle_t t = k().running;
+    if (t->notifyState[uxIndexToWaitOn] != Received) {
+        t->notifyValue[uxIndexToWaitOn] &= ~ulBitsToClearOnEntry;
+        if (xTicksToWait > 0) {
+            t->notifyState[uxIndexToWaitOn] = Waiting;
+            t->notifyWaitIndex              = static_cast<int>(uxIndexToWaitOn);
+            block(nullptr, deadline(xTicksToWait));
+            t->notifyWaitIndex = -1;
+        }
+    }
+    if (pulNotificationValue) *pulNotificationValue = t->notifyValue[uxIndexToWaitOn];
+    BaseType_t r = pdFALSE;
+    if (t->notifyState[uxIndexToWaitOn] == Received) {
+        t->notifyValue[uxIndexToWaitOn] &= ~ulBitsToClearOnExit;
+        r = pdTRUE;
+    }
+    t->notifyState[uxIndexToWaitOn] = NotWaiting;
+    return r;
+}
+
+uint32_t ulTaskGenericNotifyTake(UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit,
+                                 TickType_t xTicksToWait) {
+    configASSERT(uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+    charge(Op::NotifyWait);
+    TaskHandle_t t = k().running;
+    if (t->notifyValue[uxIndexToWaitOn] == 0 && xTicksToWait > 0) {
+        t->notifyState[uxIndexToWaitOn] = Waiting;
+        t->notifyWaitIndex              = static_cast<int>(uxIndexToWaitOn);
+        block(nullptr, deadline(xTicksToWait));
+        t->notifyWaitIndex = -1;
+    }
+    uint32_t value = t->notifyValue[uxIndexToWaitOn];
+    if (value) {
+        t->notifyValue[uxIndexToWaitOn] = xClearCountOnExit ? 0 : value - 1;
+    }
+    t->notifyState[uxIndexToWaitOn] = NotWaiting;
+    return value;
+}
+
+BaseType_t xTaskGenericNotifyStateClear(TaskHandle_t xTask, UBaseType_t uxIndexToClear) {
+    TaskHandle_t t = resolve(xTask);
+    if (t->notifyState[uxIndexToClear] != Received) return pdFAIL;
+    t->notifyState[uxIndexToClear] = NotWaiting;
+    return pdPASS;
+}
+
+uint32_t ulTaskGenericNotifyValueClear(TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear) {
+    TaskHandle_t t   = resolve(xTask);
+    uint32_t     old = t->notifyValue[uxIndexToClear];
+    t->notifyValue[uxIndexToClear] &= ~ulBitsToClear;
+    return old;
+}
+
+}  // extern "C"
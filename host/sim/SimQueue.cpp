@@ -0,0 +1,311 @@
+// Очереди, семафоры и мьютексы симулятора.
+// Семафор — очередь с нулевым размером элемента, мьютекс — двоичный семафор
+// с владельцем и наследованием приоритета, как в queue.c ядра.
+
+#include "SimInternal.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace sim;
+using namespace sim::detail;
+
+namespace {
+
+bool isMutex(QueueHandle_t q) {
+    return q->type == queueQUEUE_TYPE_MUTEX || q->type == queueQUEUE_TYPE_RECURSIVE_MUTEX;
+}
+
+Op sendOp(QueueHandle_t q) {
+    if (isMutex(q)) return Op::MutexGive;
+    return q->itemSize ? Op::QueueSend : Op::SemaphoreGive;
+}
+
+Op receiveOp(QueueHandle_t q) {
+    if (isMutex(q)) return Op::MutexTake;
+    return q->itemSize ? Op::QueueReceive : Op::SemaphoreTake;
+}
+
+QueueHandle_t createQueue(UBaseType_t length, UBaseType_t itemSize, uint8_t type) {
+    configASSERT(length > 0);
+    QueueHandle_t q = new QueueDefinition();
+    q->type         = type;
+    q->length       = length;
+    q->itemSize     = itemSize;
+    q->storage.resize(static_cast<size_t>(length) * itemSize);
+    return q;
+}
+
+uint8_t* slot(QueueHandle_t q, UBaseType_t index) {
+    return q->storage.data() + static_cast<size_t>(index % q->length) * q->itemSize;
+}
+
+void copyIn(QueueHandle_t q, const void* item, BaseType_t position) {
+    if (position == queueOVERWRITE && q->count == 1) {
+        // Перезапись: очередь длины 1 остаётся полной
+        if (q->itemSize) std::memcpy(slot(q, q->head), item, q->itemSize);
+        return;
+    }
+    if (position == queueSEND_TO_FRONT) {
+        q->head = (q->head + q->length - 1) % q->length;
+        if (q->itemSize) std::memcpy(slot(q, q->head), item, q->itemSize);
+    } else if (q->itemSize) {
+        std::memcpy(slot(q, q->head + q->count), item, q->itemSize);
+    }
+    ++q->count;
+}
+
+void copyOut(QueueHandle_t q, void* buffer, bool remove) {
+    if (q->itemSize && buffer) std::memcpy(buffer, slot(q, q->head), q->itemSize);
+    if (remove) {
+        q->head = (q->head + 1) % q->length;
+        --q->count;
+    }
+}
+
+// Сменить действующий приоритет, сохраняя порядок списка ожидания
+void setPriority(TaskHandle_t t, UBaseType_t priority) {
+    t->priority = priority;
+    if (t->waitList) {
+        WaitList* list = t->waitList;
+        list->remove(t);
+        list->insert(t);
+    }
+}
+
+void inherit(QueueHandle_t q, TaskHandle_t waiter) {
+    if (q->holder && q->holder->priority < waiter->priority) setPriority(q->holder, waiter->priority);
+}
+
+// Ожидающий мьютекс ушёл по таймауту: снизить унаследованный приоритет держателя
+void disinheritAfterTimeout(QueueHandle_t q) {
+    TaskHandle_t h = q->holder;
+    if (!h || h->mutexesHeld != 1) return;
+    UBaseType_t top = h->basePriority;
+    if (!q->receivers.empty()) top = std::max(top, q->receivers.tasks.front()->priority);
+    if (top != h->priority) setPriority(h, top);
+}
+
+void takeOwnership(QueueHandle_t q) {
+    if (!isMutex(q)) return;
+    q->holder = current();
+    if (q->holder) ++q->holder->mutexesHeld;
+}
+
+void releaseOwnership(QueueHandle_t q) {
+    TaskHandle_t h = q->holder;
+    q->holder      = nullptr;
+    if (!h) return;
+    --h->mutexesHeld;
+    if (h->mutexesHeld == 0 && h->priority != h->basePriority) setPriority(h, h->basePriority);
+}
+
+BaseType_t receive(QueueHandle_t q, void* buffer, TickType_t ticks, bool remove) {
+    configASSERT(q);
+    charge(remove ? receiveOp(q) : Op::QueuePeek, q->itemSize);
+    const uint64_t until = deadline(ticks);
+    for (;;) {
+        if (q->count > 0) {
+            copyOut(q, buffer, remove);
+            if (remove) {
+                takeOwnership(q);
+                wakeFirst(q->senders);
+            } else {
+                // Элемент остался в очереди — его может забрать следующий ожидающий
+                wakeFirst(q->receivers);
+            }
+            preemptIfNeeded();
+            return pdPASS;
+        }
+        if (ticks == 0 || until <= nowNs()) return errQUEUE_EMPTY;
+        if (isMutex(q)) inherit(q, current());
+        if (!block(&q->receivers, until) && q->count == 0) {
+            if (isMutex(q)) {
+                disinheritAfterTimeout(q);
+                preemptIfNeeded();
+            }
+            return errQUEUE_EMPTY;
+        }
+    }
+}
+
+}  // namespace
+
+extern "C" {
+
+QueueHandle_t xQueueGenericCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize, uint8_t ucQueueType) {
+    return createQueue(uxQueueLength, uxItemSize, ucQueueType);
+}
+
+QueueHandle_t xQueueGenericCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize, uint8_t* pucQueueStorage,
+                                        StaticQueue_t* pxStaticQueue, uint8_t ucQueueType) {
+    // Буферы пользователя не используются: симулятору память не критична
+    configASSERT(pxStaticQueue && (uxItemSize == 0 || pucQueueStorage));
+    return createQueue(uxQueueLength, uxItemSize, ucQueueType);
+}
+
+QueueHandle_t xQueueCreateMutex(uint8_t ucQueueType) {
+    QueueHandle_t q = createQueue(1, 0, ucQueueType);
+    q->count        = 1;
+    return q;
+}
+
+QueueHandle_t xQueueCreateMutexStatic(uint8_t ucQueueType, StaticQueue_t* pxStaticQueue) {
+    configASSERT(pxStaticQueue);
+    return xQueueCreateMutex(ucQueueType);
+}
+
+QueueHandle_t xQueueCreateCountingSemaphore(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount) {
+    configASSERT(uxInitialCount <= uxMaxCount);
+    QueueHandle_t q = createQueue(uxMaxCount, 0, queueQUEUE_TYPE_COUNTING_SEMAPHORE);
+    q->count        = uxInitialCount;
+    return q;
+}
+
+QueueHandle_t xQueueCreateCountingSemaphoreStatic(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount,
+                                                  StaticQueue_t* pxStaticQueue) {
+    configASSERT(pxStaticQueue);
+    return xQueueCreateCountingSemaphore(uxMaxCount, uxInitialCount);
+}
+
+void vQueueDelete(QueueHandle_t xQueue) {
+    configASSERT(xQueue && xQueue->senders.empty() && xQueue->receivers.empty());
+    if (xQueue->holder) --xQueue->holder->mutexesHeld;
+    delete xQueue;
+}
+
+BaseType_t xQueueGenericSend(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait,
+                             BaseType_t xCopyPosition) {
+    configASSERT(xQueue && (pvItemToQueue || xQueue->itemSize == 0));
+    configASSERT(xCopyPosition != queueOVERWRITE || xQueue->length == 1);
+    charge(sendOp(xQueue), xQueue->itemSize);
+
+    if (isMutex(xQueue)) {
+        // Отдать мьютекс может только держатель
+        if (xQueue->holder != current()) return pdFAIL;
+        releaseOwnership(xQueue);
+    }
+
+    const uint64_t until = deadline(xTicksToWait);
+    for (;;) {
+        if (xQueue->count < xQueue->length || xCopyPosition == queueOVERWRITE) {
+            copyIn(xQueue, pvItemToQueue, xCopyPosition);
+            wakeFirst(xQueue->receivers);
+            preemptIfNeeded();
+            return pdPASS;
+        }
+        if (xTicksToWait == 0 || until <= nowNs()) return errQUEUE_FULL;
+        if (!block(&xQueue->senders, until) && xQueue->count == xQueue->length) return errQUEUE_FULL;
+    }
+}
+
+BaseType_t xQueueGenericSendFromISR(QueueHandle_t xQueue, const void* pvItemToQueue,
+                                    BaseType_t* pxHigherPriorityTaskWoken, BaseType_t xCopyPosition) {
+    configASSERT(xQueue && !isMutex(xQueue));
+    configASSERT(xCopyPosition != queueOVERWRITE || xQueue->length == 1);
+    charge(Op::QueueSendFromISR, xQueue->itemSize);
+    if (xQueue->count >= xQueue->length && xCopyPosition != queueOVERWRITE) return errQUEUE_FULL;
+    copyIn(xQueue, pvItemToQueue, xCopyPosition);
+    TaskHandle_t woken = wakeFirst(xQueue->receivers);
+    if (woken && pxHigherPriorityTaskWoken && higherThanCurrent(woken)) *pxHigherPriorityTaskWoken = pdTRUE;
+    return pdPASS;
+}
+
+BaseType_t xQueueGiveFromISR(QueueHandle_t xQueue, BaseType_t* pxHigherPriorityTaskWoken) {
+    configASSERT(xQueue && xQueue->itemSize == 0);
+    return xQueueGenericSendFromISR(xQueue, nullptr, pxHigherPriorityTaskWoken, queueSEND_TO_BACK);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait) {
+    configASSERT(!xQueue || xQueue->itemSize == 0 || pvBuffer);
+    return receive(xQueue, pvBuffer, xTicksToWait, true);
+}
+
+BaseType_t xQueueSemaphoreTake(QueueHandle_t xQueue, TickType_t xTicksToWait) {
+    configASSERT(xQueue && xQueue->itemSize == 0);
+    return receive(xQueue, nullptr, xTicksToWait, true);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait) {
+    configASSERT(!xQueue || xQueue->itemSize == 0 || pvBuffer);
+    return receive(xQueue, pvBuffer, xTicksToWait, false);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void* pvBuffer, BaseType_t* pxHigherPriorityTaskWoken) {
+    configASSERT(xQueue && !isMutex(xQueue));
+    charge(Op::QueueReceiveFromISR, xQueue->itemSize);
+    if (xQueue->count == 0) return pdFAIL;
+    copyOut(xQueue, pvBuffer, true);
+    TaskHandle_t woken = wakeFirst(xQueue->senders);
+    if (woken && pxHigherPriorityTaskWoken && higherThanCurrent(woken)) *pxHigherPriorityTaskWoken = pdTRUE;
+    return pdPASS;
+}
+
+BaseType_t xQueuePeekFromISR(QueueHandle_t xQueue, void* pvBuffer) {
+    configASSERT(xQueue && xQueue->itemSize > 0);
+    if (xQueue->count == 0) return pdFAIL;
+    copyOut(xQueue, pvBuffer, false);
+    return pdPASS;
+}
+
+BaseType_t xQueueGenericReset(QueueHandle_t xQueue, BaseType_t xNewQueue) {
+    configASSERT(xQueue);
+    xQueue->head  = 0;
+    xQueue->count = 0;
+    if (!xNewQueue && wakeFirst(xQueue->senders)) preemptIfNeeded();
+    return pdPASS;
+}
+
+BaseType_t xQueueTakeMutexRecursive(QueueHandle_t xMutex, TickType_t xTicksToWait) {
+    configASSERT(xMutex && xMutex->type == queueQUEUE_TYPE_RECURSIVE_MUTEX);
+    if (xMutex->holder && xMutex->holder == current()) {
+        charge(Op::MutexTake);
+        ++xMutex->recursion;
+        return pdPASS;
+    }
+    BaseType_t r = receive(xMutex, nullptr, xTicksToWait, true);
+    if (r == pdPASS) xMutex->recursion = 1;
+    return r;
+}
+
+BaseType_t xQueueGiveMutexRecursive(QueueHandle_t xMutex) {
+    configASSERT(xMutex && xMutex->type == queueQUEUE_TYPE_RECURSIVE_MUTEX);
+    if (xMutex->holder != current()) return pdFAIL;
+    if (--xMutex->recursion > 0) {
+        charge(Op::MutexGive);
+        return pdPASS;
+    }
+    return xQueueGenericSend(xMutex, nullptr, 0, queueSEND_TO_BACK);
+}
+
+TaskHandle_t xQueueGetMutexHolder(QueueHandle_t xSemaphore) {
+    return isMutex(xSemaphore) ? xSemaphore->holder : nullptr;
+}
+
+TaskHandle_t xQueueGetMutexHolderFromISR(QueueHandle_t xSemaphore) {
+    return xQueueGetMutexHolder(xSemaphore);
+}
+
+UBaseType_t uxQueueMessagesWaiting(const QueueHandle_t xQueue) {
+    configASSERT(xQueue);
+    return xQueue->count;
+}
+
+UBaseType_t uxQueueMessagesWaitingFromISR(const QueueHandle_t xQueue) {
+    return uxQueueMessagesWaiting(xQueue);
+}
+
+UBaseType_t uxQueueSpacesAvailable(const QueueHandle_t xQueue) {
+    configASSERT(xQueue);
+    return xQueue->length - xQueue->count;
+}
+
+BaseType_t xQueueIsQueueEmptyFromISR(const QueueHandle_t xQueue) {
+    return xQueue->count == 0 ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xQueueIsQueueFullFromISR(const QueueHandle_t xQueue) {
+    return xQueue->count == xQueue->length ? pdTRUE : pdFALSE;
+}
+
+}  // extern "C"
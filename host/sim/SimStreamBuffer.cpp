@@ -0,0 +1,166 @@
+// Потоковые буферы симулятора: кольцо байтов, как stream_buffer.c ядра.
+// Писатель ждёт места под всю порцию, читатель — пока данных не станет не меньше
+// порога (trigger level); по таймауту каждый забирает то, что есть.
+
+#include "SimInternal.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace sim;
+using namespace sim::detail;
+
+namespace {
+
+StreamBufferHandle_t create(size_t size, size_t trigger) {
+    configASSERT(size > 0 && trigger <= size);
+    StreamBufferHandle_t sb = new StreamBufferDef_t();
+    sb->storage.resize(size);
+    sb->trigger = trigger ? trigger : 1;  // ядро тоже трактует 0 как 1
+    return sb;
+}
+
+size_t spaces(StreamBufferHandle_t sb) {
+    return sb->storage.size() - sb->count;
+}
+
+size_t write(StreamBufferHandle_t sb, const void* data, size_t len) {
+    const size_t size = sb->storage.size();
+    len               = std::min(len, spaces(sb));
+    const size_t tail = (sb->head + sb->count) % size;
+    const size_t first = std::min(len, size - tail);
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    std::memcpy(sb->storage.data() + tail, src, first);
+    std::memcpy(sb->storage.data(), src + first, len - first);
+    sb->count += len;
+    return len;
+}
+
+size_t read(StreamBufferHandle_t sb, void* data, size_t len) {
+    const size_t size  = sb->storage.size();
+    len                = std::min(len, sb->count);
+    const size_t first = std::min(len, size - sb->head);
+    uint8_t*     dst   = static_cast<uint8_t*>(data);
+    std::memcpy(dst, sb->storage.data() + sb->head, first);
+    std::memcpy(dst + first, sb->storage.data(), len - first);
+    sb->head = (sb->head + len) % size;
+    sb->count -= len;
+    return len;
+}
+
+}  // namespace
+
+extern "C" {
+
+StreamBufferHandle_t xStreamBufferCreate(size_t xBufferSizeBytes, size_t xTriggerLevelBytes) {
+    return create(xBufferSizeBytes, xTriggerLevelBytes);
+}
+
+StreamBufferHandle_t xStreamBufferCreateStatic(size_t xBufferSizeBytes, size_t xTriggerLevelBytes,
+                                               uint8_t* pucStreamBufferStorageArea,
+                                               StaticStreamBuffer_t* pxStaticStreamBuffer) {
+    // Буферы пользователя не используются, как и у очередей
+    configASSERT(pucStreamBufferStorageArea && pxStaticStreamBuffer);
+    return create(xBufferSizeBytes, xTriggerLevelBytes);
+}
+
+void vStreamBufferDelete(StreamBufferHandle_t xStreamBuffer) {
+    configASSERT(xStreamBuffer && xStreamBuffer->senders.empty() && xStreamBuffer->receivers.empty());
+    delete xStreamBuffer;
+}
+
+size_t xStreamBufferSend(StreamBufferHandle_t xStreamBuffer, const void* pvTxData, size_t xDataLengthBytes,
+                         TickType_t xTicksToWait) {
+    configASSERT(xStreamBuffer && (pvTxData || xDataLengthBytes == 0));
+    charge(Op::QueueSend, xDataLengthBytes);
+    const size_t   required = std::min(xDataLengthBytes, xStreamBuffer->storage.size());
+    const uint64_t until    = deadline(xTicksToWait);
+    while (spaces(xStreamBuffer) < required && xTicksToWait != 0 && until > nowNs()) {
+        if (!block(&xStreamBuffer->senders, until)) break;
+    }
+    const size_t written = write(xStreamBuffer, pvTxData, xDataLengthBytes);
+    if (written > 0 && xStreamBuffer->count >= xStreamBuffer->trigger) wakeFirst(xStreamBuffer->receivers);
+    preemptIfNeeded();
+    return written;
+}
+
+size_t xStreamBufferSendFromISR(StreamBufferHandle_t xStreamBuffer, const void* pvTxData, size_t xDataLengthBytes,
+                                BaseType_t* pxHigherPriorityTaskWoken) {
+    configASSERT(xStreamBuffer && (pvTxData || xDataLengthBytes == 0));
+    charge(Op::QueueSendFromISR, xDataLengthBytes);
+    const size_t written = write(xStreamBuffer, pvTxData, xDataLengthBytes);
+    if (written > 0 && xStreamBuffer->count >= xStreamBuffer->trigger) {
+        TaskHandle_t woken = wakeFirst(xStreamBuffer->receivers);
+        if (woken && pxHigherPriorityTaskWoken && higherThanCurrent(woken)) *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+    return written;
+}
+
+size_t xStreamBufferReceive(StreamBufferHandle_t xStreamBuffer, void* pvRxData, size_t xBufferLengthBytes,
+                            TickType_t xTicksToWait) {
+    configASSERT(xStreamBuffer && (pvRxData || xBufferLengthBytes == 0));
+    charge(Op::QueueReceive, xBufferLengthBytes);
+    // Ждать, только если пусто; проснувшись, ждать дальше, пока не наберётся порог
+    if (xStreamBuffer->count == 0) {
+        const uint64_t until = deadline(xTicksToWait);
+        while (xStreamBuffer->count < xStreamBuffer->trigger && xTicksToWait != 0 && until > nowNs()) {
+            if (!block(&xStreamBuffer->receivers, until)) break;
+        }
+    }
+    const size_t got = read(xStreamBuffer, pvRxData, xBufferLengthBytes);
+    if (got > 0) {
+        wakeFirst(xStreamBuffer->senders);
+        preemptIfNeeded();
+    }
+    return got;
+}
+
+size_t xStreamBufferReceiveFromISR(StreamBufferHandle_t xStreamBuffer, void* pvRxData, size_t xBufferLengthBytes,
+                                   BaseType_t* pxHigherPriorityTaskWoken) {
+    configASSERT(xStreamBuffer && (pvRxData || xBufferLengthBytes == 0));
+    charge(Op::QueueReceiveFromISR, xBufferLengthBytes);
+    const size_t got = read(xStreamBuffer, pvRxData, xBufferLengthBytes);
+    if (got > 0) {
+        TaskHandle_t woken = wakeFirst(xStreamBuffer->senders);
+        if (woken && pxHigherPriorityTaskWoken && higherThanCurrent(woken)) *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+    return got;
+}
+
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t xStreamBuffer) {
+    configASSERT(xStreamBuffer);
+    return xStreamBuffer->count;
+}
+
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t xStreamBuffer) {
+    configASSERT(xStreamBuffer);
+    return spaces(xStreamBuffer);
+}
+
+BaseType_t xStreamBufferIsEmpty(StreamBufferHandle_t xStreamBuffer) {
+    configASSERT(xStreamBuffer);
+    return xStreamBuffer->count == 0 ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xStreamBufferIsFull(StreamBufferHandle_t xStreamBuffer) {
+    configASSERT(xStreamBuffer);
+    return spaces(xStreamBuffer) == 0 ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xStreamBufferReset(StreamBufferHandle_t xStreamBuffer) {
+    configASSERT(xStreamBuffer);
+    // Ядро отказывает, пока кто-то ждёт на буфере
+    if (!xStreamBuffer->senders.empty() || !xStreamBuffer->receivers.empty()) return pdFAIL;
+    xStreamBuffer->head  = 0;
+    xStreamBuffer->count = 0;
+    return pdPASS;
+}
+
+BaseType_t xStreamBufferSetTriggerLevel(StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel) {
+    configASSERT(xStreamBuffer);
+    if (xTriggerLevel > xStreamBuffer->storage.size()) return pdFALSE;
+    xStreamBuffer->trigger = xTriggerLevel ? xTriggerLevel : 1;
+    return pdTRUE;
+}
+
+}  // extern "C"
@@ -0,0 +1,115 @@
+#ifndef SIM_KERNEL_H
+#define SIM_KERNEL_H
+
+// Управление симулятором ядра: виртуальные часы, модель стоимости операций,
+// прерывания по расписанию. Доступно только в сборке с FREERTOS_CPP_BACKEND=sim.
+//
+// Модель исполнения: каждая задача — отдельный поток ОС, но в любой момент
+// выполняется ровно одна (эстафета, как в порту GCC_POSIX). Время не течёт само:
+// оно сдвигается только стоимостью вызовов API, sim::consume() и ожиданиями.
+// Когда готовых задач нет, часы перескакивают к ближайшему событию
+// (таймаут, прерывание). Поэтому каждый прогон даёт одинаковый результат.
+
+#include "freertos/FreeRTOS.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace sim {
+
+// Операции, стоимость которых задаёт модель
+enum class Op : uint8_t {
+    ContextSwitch,
+    TaskCreate,
+    TaskDelete,
+    TaskDelay,
+    TaskYield,
+    QueueSend,
+    QueueReceive,
+    QueuePeek,
+    QueueSendFromISR,
+    QueueReceiveFromISR,
+    SemaphoreTake,
+    SemaphoreGive,
+    MutexTake,
+    MutexGive,
+    EventGroupSet,
+    EventGroupClear,
+    EventGroupWait,
+    EventGroupSetFromISR,
+    Notify,
+    NotifyFromISR,
+    NotifyWait,
+    IsrEntry,
+    Count
+};
+
+constexpr size_t OpCount = static_cast<size_t>(Op::Count);
+
+// Стоимость каждой операции в нс плюс копирование данных очереди (пикосекунд на байт)
+struct CostModel {
+    uint64_t ns[OpCount];
+    uint64_t copyPsPerByte;
+
+    uint64_t cost(Op op, size_t bytes = 0) const {
+        return ns[static_cast<size_t>(op)] + (copyPsPerByte * bytes) / 1000u;
+    }
+
+    // Всё бесплатно: время идёт только от задержек и sim::consume()
+    static CostModel zero();
+    // Порядок величин для ядра ~240 МГц (ESP32). Для точных прогнозов
+    // заменить на собственные замеры (bench_micro на железе).
+    static CostModel esp32();
+};
+
+const char* opName(Op op);
+bool        opFromName(const char* name, Op& op);
+
+void             setCostModel(const CostModel& model);
+const CostModel& costModel();
+
+// Виртуальное время, нс
+uint64_t nowNs();
+
+// Смоделировать вычисления текущей задачи длительностью ns.
+// Задача может быть вытеснена посередине — оставшаяся часть доработается позже.
+void consume(uint64_t ns);
+
+// Однократное прерывание в момент atNs. fn выполняется в контексте ISR:
+// можно вызывать только FromISR-функции.
+void at(uint64_t atNs, std::function<void()> fn);
+
+// Периодическое прерывание
+void every(uint64_t firstNs, uint64_t periodNs, std::function<void()> fn);
+
+// Наблюдатель: как every(), но бесплатный и не считается прерыванием.
+// Для съёма метрик (глубина очередей и т.п.), не должен менять состояние системы.
+void probe(uint64_t firstNs, uint64_t periodNs, std::function<void()> fn);
+
+// Остановить планировщик при достижении виртуального времени (vTaskStartScheduler вернётся)
+void stopAt(uint64_t ns);
+
+// Выполняется ли код в контексте прерывания симулятора
+bool inIsr();
+
+// Планировщик остановлен, потому что все задачи заблокированы навсегда
+bool deadlocked();
+
+struct Stats {
+    uint64_t contextSwitches;
+    uint64_t interrupts;
+    uint64_t idleNs;
+};
+
+const Stats& stats();
+
+// Процессорное время задачи в виртуальных нс
+uint64_t taskRunTimeNs(TaskHandle_t task);
+
+// Смоделировать расход стека текущей задачей (в словах StackType_t).
+// Запоминается пик — от него считается uxTaskGetStackHighWaterMark().
+void useStack(uint32_t words);
+
+}  // namespace sim
+
+#endif  // SIM_KERNEL_H
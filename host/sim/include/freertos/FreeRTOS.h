@@ -0,0 +1,144 @@
+#ifndef SIM_FREERTOS_H
+#define SIM_FREERTOS_H
+
+// Симулятор ядра FreeRTOS с виртуальным временем (см. host/sim/include/SimKernel.h).
+// Реализует то подмножество API, которое используют обёртки библиотеки,
+// с теми же именами, типами и семантикой, что и FreeRTOS-Kernel.
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ---- Конфигурация (можно переопределить через -D) ----
+
+#ifndef configTICK_RATE_HZ
+#define configTICK_RATE_HZ ((TickType_t)1000)
+#endif
+#ifndef configMAX_PRIORITIES
+#define configMAX_PRIORITIES 10
+#endif
+#ifndef configMINIMAL_STACK_SIZE
+#define configMINIMAL_STACK_SIZE ((unsigned short)4096)
+#endif
+#ifndef configMAX_TASK_NAME_LEN
+#define configMAX_TASK_NAME_LEN 16
+#endif
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 5
+#endif
+#ifndef configUSE_TIME_SLICING
+#define configUSE_TIME_SLICING 1
+#endif
+#ifndef configSTACK_DEPTH_TYPE
+#define configSTACK_DEPTH_TYPE uint32_t
+#endif
+#ifndef configASSERT
+#define configASSERT(x) assert(x)
+#endif
+#ifndef configRUN_TIME_COUNTER_TYPE
+#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
+#define configUSE_PREEMPTION                1
+#define configUSE_MUTEXES                   1
+#define configUSE_RECURSIVE_MUTEXES         1
+#define configUSE_COUNTING_SEMAPHORES       1
+#define configUSE_TASK_NOTIFICATIONS        1
+#define configUSE_EVENT_GROUPS              1
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+#define configSUPPORT_STATIC_ALLOCATION     1
+#define configUSE_TRACE_FACILITY            1
+#define configGENERATE_RUN_TIME_STATS       1
+#define INCLUDE_vTaskPrioritySet            1
+#define INCLUDE_uxTaskPriorityGet           1
+#define INCLUDE_vTaskDelete                 1
+#define INCLUDE_vTaskSuspend                1
+#define INCLUDE_vTaskDelay                  1
+#define INCLUDE_xTaskDelayUntil             1
+#define INCLUDE_xTaskGetSchedulerState      1
+#define INCLUDE_xTaskGetCurrentTaskHandle   1
+#define INCLUDE_eTaskGetState               1
+#define INCLUDE_xSemaphoreGetMutexHolder    1
+#define INCLUDE_uxTaskGetStackHighWaterMark 1
+#define INCLUDE_xTaskGetIdleTaskHandle      1
+
+// ---- Типы порта ----
+
+typedef long          BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t      TickType_t;
+typedef unsigned long StackType_t;
+typedef TickType_t    EventBits_t;
+
+#define portMAX_DELAY       ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS  ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portTICK_RATE_MS    portTICK_PERIOD_MS
+#define portBYTE_ALIGNMENT  8
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE  ((BaseType_t)1)
+#define pdFAIL  (pdFALSE)
+#define pdPASS  (pdTRUE)
+
+#define errQUEUE_EMPTY ((BaseType_t)0)
+#define errQUEUE_FULL  ((BaseType_t)0)
+
+#ifndef pdMS_TO_TICKS
+#define pdMS_TO_TICKS(xTimeInMs) \
+    ((TickType_t)(((uint64_t)(xTimeInMs) * (uint64_t)configTICK_RATE_HZ) / (uint64_t)1000U))
+#endif
+#define pdTICKS_TO_MS(xTicks) ((TickType_t)(((uint64_t)(xTicks) * (uint64_t)1000U) / (uint64_t)configTICK_RATE_HZ))
+
+// ---- Хэндлы и статические контрольные блоки ----
+
+typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef struct QueueDefinition*     QueueHandle_t;
+typedef struct EventGroupDef_t*     EventGroupHandle_t;
+
+// Размеры как у 32-битных портов: статические блоки лишь резервируют место,
+// симулятор хранит своё состояние отдельно.
+typedef struct {
+    void*    dummy[3];
+    uint32_t dummy2[17];
+} StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+typedef struct {
+    void*    dummy[1];
+    uint32_t dummy2[7];
+} StaticEventGroup_t;
+typedef struct {
+    void*    dummy[20];
+    uint32_t dummy2[20];
+} StaticTask_t;
+typedef struct {
+    size_t   dummy[4];
+    void*    dummy2[3];
+    uint8_t  dummy3;
+    uint32_t dummy4;
+} StaticStreamBuffer_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Порт: прерывания/критические секции и переключение из ISR
+void        vPortEnterCritical(void);
+void        vPortExitCritical(void);
+UBaseType_t uxPortSetInterruptMaskFromISR(void);
+void        vPortClearInterruptMaskFromISR(UBaseType_t uxSavedStatus);
+void        vPortYield(void);
+void        vPortYieldFromISR(BaseType_t xSwitchRequired);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define portYIELD()                  vPortYield()
+#define portYIELD_FROM_ISR(x)        vPortYieldFromISR((BaseType_t)(x))
+#define portEND_SWITCHING_ISR(x)     vPortYieldFromISR((BaseType_t)(x))
+#define portENTER_CRITICAL()         vPortEnterCritical()
+#define portEXIT_CRITICAL()          vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()    uxPortSetInterruptMaskFromISR()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x) vPortClearInterruptMaskFromISR(x)
+
+#endif  // SIM_FREERTOS_H
@@ -0,0 +1,64 @@
+#ifndef SIM_QUEUE_H
+#define SIM_QUEUE_H
+
+#ifndef SIM_FREERTOS_H
+#error "include freertos/FreeRTOS.h must appear before including freertos/queue.h"
+#endif
+
+#include "task.h"
+
+#define queueSEND_TO_BACK  ((BaseType_t)0)
+#define queueSEND_TO_FRONT ((BaseType_t)1)
+#define queueOVERWRITE     ((BaseType_t)2)
+
+#define queueQUEUE_TYPE_BASE               ((uint8_t)0U)
+#define queueQUEUE_TYPE_MUTEX              ((uint8_t)1U)
+#define queueQUEUE_TYPE_COUNTING_SEMAPHORE ((uint8_t)2U)
+#define queueQUEUE_TYPE_BINARY_SEMAPHORE   ((uint8_t)3U)
+#define queueQUEUE_TYPE_RECURSIVE_MUTEX    ((uint8_t)4U)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+QueueHandle_t xQueueGenericCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize, uint8_t ucQueueType);
+QueueHandle_t xQueueGenericCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize,
+                                        uint8_t* pucQueueStorage, StaticQueue_t* pxStaticQueue,
+                                        uint8_t ucQueueType);
+void          vQueueDelete(QueueHandle_t xQueue);
+
+BaseType_t xQueueGenericSend(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait,
+                             BaseType_t xCopyPosition);
+BaseType_t xQueueGenericSendFromISR(QueueHandle_t xQueue, const void* pvItemToQueue,
+                                    BaseType_t* pxHigherPriorityTaskWoken, BaseType_t xCopyPosition);
+BaseType_t xQueueGiveFromISR(QueueHandle_t xQueue, BaseType_t* pxHigherPriorityTaskWoken);
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait);
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait);
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void* pvBuffer, BaseType_t* pxHigherPriorityTaskWoken);
+BaseType_t xQueuePeekFromISR(QueueHandle_t xQueue, void* pvBuffer);
+BaseType_t xQueueGenericReset(QueueHandle_t xQueue, BaseType_t xNewQueue);
+
+UBaseType_t uxQueueMessagesWaiting(const QueueHandle_t xQueue);
+UBaseType_t uxQueueMessagesWaitingFromISR(const QueueHandle_t xQueue);
+UBaseType_t uxQueueSpacesAvailable(const QueueHandle_t xQueue);
+BaseType_t  xQueueIsQueueEmptyFromISR(const QueueHandle_t xQueue);
+BaseType_t  xQueueIsQueueFullFromISR(const QueueHandle_t xQueue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define xQueueCreate(len, size)            xQueueGenericCreate((len), (size), queueQUEUE_TYPE_BASE)
+#define xQueueCreateStatic(len, size, buf, q) \
+    xQueueGenericCreateStatic((len), (size), (buf), (q), queueQUEUE_TYPE_BASE)
+#define xQueueSend(q, p, t)                xQueueGenericSend((q), (p), (t), queueSEND_TO_BACK)
+#define xQueueSendToBack(q, p, t)          xQueueGenericSend((q), (p), (t), queueSEND_TO_BACK)
+#define xQueueSendToFront(q, p, t)         xQueueGenericSend((q), (p), (t), queueSEND_TO_FRONT)
+#define xQueueOverwrite(q, p)              xQueueGenericSend((q), (p), 0, queueOVERWRITE)
+#define xQueueSendFromISR(q, p, w)         xQueueGenericSendFromISR((q), (p), (w), queueSEND_TO_BACK)
+#define xQueueSendToBackFromISR(q, p, w)   xQueueGenericSendFromISR((q), (p), (w), queueSEND_TO_BACK)
+#define xQueueSendToFrontFromISR(q, p, w)  xQueueGenericSendFromISR((q), (p), (w), queueSEND_TO_FRONT)
+#define xQueueOverwriteFromISR(q, p, w)    xQueueGenericSendFromISR((q), (p), (w), queueOVERWRITE)
+#define xQueueReset(q)                     xQueueGenericReset((q), pdFALSE)
+
+#endif  // SIM_QUEUE_H
@@ -0,0 +1,57 @@
+#ifndef SIM_SEMPHR_H
+#define SIM_SEMPHR_H
+
+#ifndef SIM_FREERTOS_H
+#error "include freertos/FreeRTOS.h must appear before including freertos/semphr.h"
+#endif
+
+#include "queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+#define semGIVE_BLOCK_TIME ((TickType_t)0U)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+QueueHandle_t xQueueCreateMutex(uint8_t ucQueueType);
+QueueHandle_t xQueueCreateMutexStatic(uint8_t ucQueueType, StaticQueue_t* pxStaticQueue);
+QueueHandle_t xQueueCreateCountingSemaphore(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount);
+QueueHandle_t xQueueCreateCountingSemaphoreStatic(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount,
+                                                  StaticQueue_t* pxStaticQueue);
+BaseType_t    xQueueSemaphoreTake(QueueHandle_t xQueue, TickType_t xTicksToWait);
+BaseType_t    xQueueTakeMutexRecursive(QueueHandle_t xMutex, TickType_t xTicksToWait);
+BaseType_t    xQueueGiveMutexRecursive(QueueHandle_t xMutex);
+TaskHandle_t  xQueueGetMutexHolder(QueueHandle_t xSemaphore);
+TaskHandle_t  xQueueGetMutexHolderFromISR(QueueHandle_t xSemaphore);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define xSemaphoreCreateBinary() \
+    xQueueGenericCreate((UBaseType_t)1, (UBaseType_t)0, queueQUEUE_TYPE_BINARY_SEMAPHORE)
+#define xSemaphoreCreateBinaryStatic(buf) \
+    xQueueGenericCreateStatic((UBaseType_t)1, (UBaseType_t)0, NULL, (buf), queueQUEUE_TYPE_BINARY_SEMAPHORE)
+#define xSemaphoreCreateMutex()                 xQueueCreateMutex(queueQUEUE_TYPE_MUTEX)
+#define xSemaphoreCreateMutexStatic(buf)        xQueueCreateMutexStatic(queueQUEUE_TYPE_MUTEX, (buf))
+#define xSemaphoreCreateRecursiveMutex()        xQueueCreateMutex(queueQUEUE_TYPE_RECURSIVE_MUTEX)
+#define xSemaphoreCreateRecursiveMutexStatic(b) xQueueCreateMutexStatic(queueQUEUE_TYPE_RECURSIVE_MUTEX, (b))
+#define xSemaphoreCreateCounting(max, init)     xQueueCreateCountingSemaphore((max), (init))
+#define xSemaphoreCreateCountingStatic(max, init, buf) \
+    xQueueCreateCountingSemaphoreStatic((max), (init), (buf))
+
+#define xSemaphoreTake(s, t)              xQueueSemaphoreTake((s), (t))
+#define xSemaphoreTakeRecursive(s, t)     xQueueTakeMutexRecursive((s), (t))
+#define xSemaphoreGive(s)                 xQueueGenericSend((QueueHandle_t)(s), NULL, semGIVE_BLOCK_TIME, queueSEND_TO_BACK)
+#define xSemaphoreGiveRecursive(s)        xQueueGiveMutexRecursive((s))
+#define xSemaphoreGiveFromISR(s, w)       xQueueGiveFromISR((QueueHandle_t)(s), (w))
+#define xSemaphoreTakeFromISR(s, w)       xQueueReceiveFromISR((QueueHandle_t)(s), NULL, (w))
+#define vSemaphoreDelete(s)               vQueueDelete((QueueHandle_t)(s))
+#define xSemaphoreGetMutexHolder(s)       xQueueGetMutexHolder((s))
+#define xSemaphoreGetMutexHolderFromISR(s) xQueueGetMutexHolderFromISR((s))
+#define uxSemaphoreGetCount(s)            uxQueueMessagesWaiting((QueueHandle_t)(s))
+#define uxSemaphoreGetCountFromISR(s)     uxQueueMessagesWaitingFromISR((QueueHandle_t)(s))
+
+#endif  // SIM_SEMPHR_H
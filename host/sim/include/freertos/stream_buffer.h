@@ -0,0 +1,46 @@
+#ifndef SIM_STREAM_BUFFER_H
+#define SIM_STREAM_BUFFER_H
+
+#ifndef SIM_FREERTOS_H
+#error "include freertos/FreeRTOS.h must appear before including freertos/stream_buffer.h"
+#endif
+
+#include "task.h"
+
+// Потоковые буферы: один писатель и один читатель, как в ядре.
+// Буферов сообщений (message_buffer.h) в симуляторе нет.
+
+typedef struct StreamBufferDef_t* StreamBufferHandle_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// В ядре это макросы над xStreamBufferGenericCreate*; сигнатуры те же
+StreamBufferHandle_t xStreamBufferCreate(size_t xBufferSizeBytes, size_t xTriggerLevelBytes);
+StreamBufferHandle_t xStreamBufferCreateStatic(size_t xBufferSizeBytes, size_t xTriggerLevelBytes,
+                                               uint8_t* pucStreamBufferStorageArea,
+                                               StaticStreamBuffer_t* pxStaticStreamBuffer);
+void                 vStreamBufferDelete(StreamBufferHandle_t xStreamBuffer);
+
+size_t xStreamBufferSend(StreamBufferHandle_t xStreamBuffer, const void* pvTxData, size_t xDataLengthBytes,
+                         TickType_t xTicksToWait);
+size_t xStreamBufferSendFromISR(StreamBufferHandle_t xStreamBuffer, const void* pvTxData, size_t xDataLengthBytes,
+                                BaseType_t* pxHigherPriorityTaskWoken);
+size_t xStreamBufferReceive(StreamBufferHandle_t xStreamBuffer, void* pvRxData, size_t xBufferLengthBytes,
+                            TickType_t xTicksToWait);
+size_t xStreamBufferReceiveFromISR(StreamBufferHandle_t xStreamBuffer, void* pvRxData, size_t xBufferLengthBytes,
+                                   BaseType_t* pxHigherPriorityTaskWoken);
+
+size_t     xStreamBufferBytesAvailable(StreamBufferHandle_t xStreamBuffer);
+size_t     xStreamBufferSpacesAvailable(StreamBufferHandle_t xStreamBuffer);
+BaseType_t xStreamBufferIsEmpty(StreamBufferHandle_t xStreamBuffer);
+BaseType_t xStreamBufferIsFull(StreamBufferHandle_t xStreamBuffer);
+BaseType_t xStreamBufferReset(StreamBufferHandle_t xStreamBuffer);
+BaseType_t xStreamBufferSetTriggerLevel(StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // SIM_STREAM_BUFFER_H
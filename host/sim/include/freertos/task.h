@@ -0,0 +1,136 @@
+#ifndef SIM_TASK_H
+#define SIM_TASK_H
+
+#ifndef SIM_FREERTOS_H
+#error "include freertos/FreeRTOS.h must appear before including freertos/task.h"
+#endif
+
+#define tskIDLE_PRIORITY ((UBaseType_t)0U)
+
+#define taskSCHEDULER_SUSPENDED   ((BaseType_t)0)
+#define taskSCHEDULER_NOT_STARTED ((BaseType_t)1)
+#define taskSCHEDULER_RUNNING     ((BaseType_t)2)
+
+typedef void (*TaskFunction_t)(void*);
+
+typedef enum {
+    eRunning = 0,
+    eReady,
+    eBlocked,
+    eSuspended,
+    eDeleted,
+    eInvalid
+} eTaskState;
+
+typedef enum {
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+// Состояние задачи для uxTaskGetSystemState (поля как в FreeRTOS-Kernel V11)
+typedef struct xTASK_STATUS {
+    TaskHandle_t                xHandle;
+    const char*                 pcTaskName;
+    UBaseType_t                 xTaskNumber;
+    eTaskState                  eCurrentState;
+    UBaseType_t                 uxCurrentPriority;
+    UBaseType_t                 uxBasePriority;
+    configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;
+    StackType_t*                pxStackBase;
+    configSTACK_DEPTH_TYPE      usStackHighWaterMark;
+} TaskStatus_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+BaseType_t   xTaskCreate(TaskFunction_t pxTaskCode, const char* pcName, configSTACK_DEPTH_TYPE uxStackDepth,
+                         void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pxCreatedTask);
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char* pcName, configSTACK_DEPTH_TYPE uxStackDepth,
+                               void* pvParameters, UBaseType_t uxPriority, StackType_t* puxStackBuffer,
+                               StaticTask_t* pxTaskBuffer);
+void         vTaskDelete(TaskHandle_t xTaskToDelete);
+
+void       vTaskDelay(TickType_t xTicksToDelay);
+BaseType_t xTaskDelayUntil(TickType_t* pxPreviousWakeTime, TickType_t xTimeIncrement);
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+
+void       vTaskStartScheduler(void);
+void       vTaskEndScheduler(void);
+void       vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+BaseType_t xTaskGetSchedulerState(void);
+
+UBaseType_t  uxTaskPriorityGet(TaskHandle_t xTask);
+void         vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+eTaskState   eTaskGetState(TaskHandle_t xTask);
+char*        pcTaskGetName(TaskHandle_t xTaskToQuery);
+UBaseType_t  uxTaskGetNumberOfTasks(void);
+void         vTaskSuspend(TaskHandle_t xTaskToSuspend);
+void         vTaskResume(TaskHandle_t xTaskToResume);
+BaseType_t   xTaskResumeFromISR(TaskHandle_t xTaskToResume);
+
+// Статистика. Счётчик времени — виртуальные микросекунды; в списке есть задача IDLE,
+// которой начисляется время простоя. Стек моделируется: см. sim::useStack().
+UBaseType_t                 uxTaskGetSystemState(TaskStatus_t* pxTaskStatusArray, const UBaseType_t uxArraySize,
+                                                 configRUN_TIME_COUNTER_TYPE* pulTotalRunTime);
+UBaseType_t                 uxTaskGetStackHighWaterMark(TaskHandle_t xTask);
+configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter(const TaskHandle_t xTask);
+configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter(void);
+TaskHandle_t                xTaskGetIdleTaskHandle(void);
+
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+                              eNotifyAction eAction, uint32_t* pulPreviousNotificationValue);
+BaseType_t xTaskGenericNotifyFromISR(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue,
+                                     eNotifyAction eAction, uint32_t* pulPreviousNotificationValue,
+                                     BaseType_t* pxHigherPriorityTaskWoken);
+void       vTaskGenericNotifyGiveFromISR(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify,
+                                         BaseType_t* pxHigherPriorityTaskWoken);
+BaseType_t xTaskGenericNotifyWait(UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry,
+                                  uint32_t ulBitsToClearOnExit, uint32_t* pulNotificationValue,
+                                  TickType_t xTicksToWait);
+uint32_t   ulTaskGenericNotifyTake(UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit,
+                                   TickType_t xTicksToWait);
+BaseType_t xTaskGenericNotifyStateClear(TaskHandle_t xTask, UBaseType_t uxIndexToClear);
+uint32_t   ulTaskGenericNotifyValueClear(TaskHandle_t xTask, UBaseType_t uxIndexToClear, uint32_t ulBitsToClear);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define vTaskDelayUntil(pxPreviousWakeTime, xTimeIncrement) \
+    do { (void)xTaskDelayUntil((pxPreviousWakeTime), (xTimeIncrement)); } while (0)
+
+#define taskYIELD()                        portYIELD()
+#define taskENTER_CRITICAL()               portENTER_CRITICAL()
+#define taskEXIT_CRITICAL()                portEXIT_CRITICAL()
+#define taskENTER_CRITICAL_FROM_ISR()      portSET_INTERRUPT_MASK_FROM_ISR()
+#define taskEXIT_CRITICAL_FROM_ISR(x)      portCLEAR_INTERRUPT_MASK_FROM_ISR(x)
+#define taskDISABLE_INTERRUPTS()           portENTER_CRITICAL()
+#define taskENABLE_INTERRUPTS()            portEXIT_CRITICAL()
+
+#define xTaskNotify(t, v, a)                         xTaskGenericNotify((t), 0, (v), (a), NULL)
+#define xTaskNotifyIndexed(t, i, v, a)               xTaskGenericNotify((t), (i), (v), (a), NULL)
+#define xTaskNotifyAndQuery(t, v, a, p)              xTaskGenericNotify((t), 0, (v), (a), (p))
+#define xTaskNotifyAndQueryIndexed(t, i, v, a, p)    xTaskGenericNotify((t), (i), (v), (a), (p))
+#define xTaskNotifyGive(t)                           xTaskGenericNotify((t), 0, 0, eIncrement, NULL)
+#define xTaskNotifyGiveIndexed(t, i)                 xTaskGenericNotify((t), (i), 0, eIncrement, NULL)
+#define xTaskNotifyFromISR(t, v, a, w)               xTaskGenericNotifyFromISR((t), 0, (v), (a), NULL, (w))
+#define xTaskNotifyIndexedFromISR(t, i, v, a, w)     xTaskGenericNotifyFromISR((t), (i), (v), (a), NULL, (w))
+#define vTaskNotifyGiveFromISR(t, w)                 vTaskGenericNotifyGiveFromISR((t), 0, (w))
+#define vTaskNotifyGiveIndexedFromISR(t, i, w)       vTaskGenericNotifyGiveFromISR((t), (i), (w))
+#define xTaskNotifyWait(c1, c2, v, w)                xTaskGenericNotifyWait(0, (c1), (c2), (v), (w))
+#define xTaskNotifyWaitIndexed(i, c1, c2, v, w)      xTaskGenericNotifyWait((i), (c1), (c2), (v), (w))
+#define ulTaskNotifyTake(c, w)                       ulTaskGenericNotifyTake(0, (c), (w))
+#define ulTaskNotifyTakeIndexed(i, c, w)             ulTaskGenericNotifyTake((i), (c), (w))
+#define xTaskNotifyStateClear(t)                     xTaskGenericNotifyStateClear((t), 0)
+#define xTaskNotifyStateClearIndexed(t, i)           xTaskGenericNotifyStateClear((t), (i))
+#define ulTaskNotifyValueClear(t, b)                 ulTaskGenericNotifyValueClear((t), 0, (b))
+#define ulTaskNotifyValueClearIndexed(t, i, b)       ulTaskGenericNotifyValueClear((t), (i), (b))
+
+#endif  // SIM_TASK_H
@@ -0,0 +1,20 @@
+# Запускает sim_profile дважды на одном сценарии и сравнивает таймлайны.
+# Параметры: SIM_PROFILE, SCRIPT, OUT_DIR
+
+file(MAKE_DIRECTORY ${OUT_DIR})
+
+foreach(run 1 2)
+    execute_process(
+        COMMAND ${SIM_PROFILE} ${SCRIPT} -o ${OUT_DIR}/run${run}.csv
+        RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "sim_profile run ${run} failed: ${result}")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E compare_files ${OUT_DIR}/run1.csv ${OUT_DIR}/run2.csv
+    RESULT_VARIABLE differ)
+if(NOT differ EQUAL 0)
+    message(FATAL_ERROR "timelines differ between runs: ${OUT_DIR}/run1.csv vs run2.csv")
+endif()
@@ -0,0 +1,347 @@
+// Прогон профиля нагрузки в симуляторе ядра.
+//
+//   sim_profile <script> [-o timeline.csv]
+//
+// Скрипт — построчные директивы, '#' — комментарий. Длительности: 10ns, 5us, 10ms, 1s.
+//
+//   cost <op> <ns>                       стоимость операции (имена — sim::opName), "cost copy <ps/byte>"
+//   queue <name> length=<n> [item=<bytes>]
+//   producer <queue> burst=<n> every=<dur> [prio=<p>] [start=<dur>] [gap=<dur>] [timeout=<ms>]
+//   isr_producer <queue> burst=<n> every=<dur> [start=<dur>]
+//   consumer <queue> [prio=<p>] [work=<dur>]
+//   sample every=<dur>
+//   run <dur>
+//
+// Таймлайн (CSV): time_us и для каждой очереди <name>.depth, <name>.consumed,
+// <name>.dropped, <name>.latency_max_us (максимум за интервал выборки).
+// Итоги прогона печатаются в stderr.
+
+#include "SimKernel.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct QueueStats {
+    std::string   name;
+    QueueHandle_t handle   = nullptr;
+    UBaseType_t   length   = 0;
+    UBaseType_t   itemSize = 8;
+
+    uint64_t produced = 0;
+    uint64_t consumed = 0;
+    uint64_t dropped  = 0;
+    UBaseType_t maxDepth = 0;
+
+    uint64_t latencySumNs = 0;
+    uint64_t latencyMaxNs = 0;
+    uint64_t windowMaxNs  = 0;  // максимум с прошлой выборки
+};
+
+struct Producer {
+    QueueStats* queue   = nullptr;
+    uint32_t    burst   = 1;
+    uint64_t    everyNs = 0;
+    uint64_t    startNs = 0;
+    uint64_t    gapNs   = 0;
+    TickType_t  timeout = 0;
+    UBaseType_t prio    = 2;
+    bool        isr     = false;
+};
+
+struct Consumer {
+    QueueStats* queue  = nullptr;
+    uint64_t    workNs = 0;
+    UBaseType_t prio   = 1;
+};
+
+std::vector<std::unique_ptr<QueueStats>> queues;
+std::vector<std::unique_ptr<Producer>>   producers;
+std::vector<std::unique_ptr<Consumer>>   consumers;
+std::FILE*                               timeline = nullptr;
+
+[[noreturn]] void fail(int line, const std::string& msg) {
+    std::fprintf(stderr, "line %d: %s\n", line, msg.c_str());
+    std::exit(2);
+}
+
+uint64_t parseDuration(int line, const std::string& s) {
+    char*    end = nullptr;
+    double   v   = std::strtod(s.c_str(), &end);
+    std::string unit(end);
+    double      scale;
+    if (unit == "ns") {
+        scale = 1;
+    } else if (unit == "us") {
+        scale = 1e3;
+    } else if (unit == "ms") {
+        scale = 1e6;
+    } else if (unit == "s") {
+        scale = 1e9;
+    } else {
+        fail(line, "bad duration '" + s + "' (expected ns/us/ms/s suffix)");
+    }
+    if (end == s.c_str() || v < 0) fail(line, "bad duration '" + s + "'");
+    return static_cast<uint64_t>(v * scale + 0.5);
+}
+
+uint64_t parseNumber(int line, const std::string& s) {
+    char*              end = nullptr;
+    unsigned long long v   = std::strtoull(s.c_str(), &end, 10);
+    if (end == s.c_str() || *end) fail(line, "bad number '" + s + "'");
+    return v;
+}
+
+QueueStats* findQueue(int line, const std::string& name) {
+    for (auto& q : queues) {
+        if (q->name == name) return q.get();
+    }
+    fail(line, "unknown queue '" + name + "'");
+}
+
+// Разбор "key=value" после позиционных аргументов
+std::map<std::string, std::string> options(int line, std::istringstream& in) {
+    std::map<std::string, std::string> opts;
+    std::string                        tok;
+    while (in >> tok) {
+        size_t eq = tok.find('=');
+        if (eq == std::string::npos) fail(line, "expected key=value, got '" + tok + "'");
+        opts[tok.substr(0, eq)] = tok.substr(eq + 1);
+    }
+    return opts;
+}
+
+void stamp(std::vector<uint8_t>& buf) {
+    uint64_t now = sim::nowNs();
+    std::memcpy(buf.data(), &now, sizeof(now));
+}
+
+void noteSent(QueueStats* q, bool ok) {
+    if (ok) {
+        ++q->produced;
+        q->maxDepth = std::max(q->maxDepth, uxQueueMessagesWaiting(q->handle));
+    } else {
+        ++q->dropped;
+    }
+}
+
+void producerTask(void* arg) {
+    Producer*            p = static_cast<Producer*>(arg);
+    std::vector<uint8_t> buf(p->queue->itemSize);
+    const TickType_t     period = pdMS_TO_TICKS(p->everyNs / 1000000u);
+    if (p->startNs) vTaskDelay(pdMS_TO_TICKS(p->startNs / 1000000u));
+    TickType_t last = xTaskGetTickCount();
+    for (;;) {
+        for (uint32_t i = 0; i < p->burst; ++i) {
+            stamp(buf);
+            noteSent(p->queue, xQueueSend(p->queue->handle, buf.data(), p->timeout) == pdTRUE);
+            if (p->gapNs) sim::consume(p->gapNs);
+        }
+        vTaskDelayUntil(&last, period);
+    }
+}
+
+void consumerTask(void* arg) {
+    Consumer*            c = static_cast<Consumer*>(arg);
+    QueueStats*          q = c->queue;
+    std::vector<uint8_t> buf(q->itemSize);
+    for (;;) {
+        if (xQueueReceive(q->handle, buf.data(), portMAX_DELAY) != pdTRUE) continue;
+        uint64_t sent;
+        std::memcpy(&sent, buf.data(), sizeof(sent));
+        uint64_t latency = sim::nowNs() - sent;
+        ++q->consumed;
+        q->latencySumNs += latency;
+        q->latencyMaxNs = std::max(q->latencyMaxNs, latency);
+        q->windowMaxNs  = std::max(q->windowMaxNs, latency);
+        if (c->workNs) sim::consume(c->workNs);
+    }
+}
+
+void writeHeader() {
+    if (!timeline) return;
+    std::fprintf(timeline, "time_us");
+    for (auto& q : queues) {
+        const char* n = q->name.c_str();
+        std::fprintf(timeline, ",%s.depth,%s.consumed,%s.dropped,%s.latency_max_us", n, n, n, n);
+    }
+    std::fprintf(timeline, "\n");
+}
+
+void writeSample() {
+    if (!timeline) return;
+    std::fprintf(timeline, "%.3f", sim::nowNs() / 1e3);
+    for (auto& q : queues) {
+        std::fprintf(timeline, ",%lu,%llu,%llu,%.3f", uxQueueMessagesWaiting(q->handle),
+                     (unsigned long long)q->consumed, (unsigned long long)q->dropped, q->windowMaxNs / 1e3);
+        q->windowMaxNs = 0;
+    }
+    std::fprintf(timeline, "\n");
+}
+
+void summary() {
+    const sim::Stats& st = sim::stats();
+    std::fprintf(stderr, "virtual time %.3f ms, context switches %llu, interrupts %llu, idle %.1f%%\n",
+                 sim::nowNs() / 1e6, (unsigned long long)st.contextSwitches, (unsigned long long)st.interrupts,
+                 sim::nowNs() ? 100.0 * st.idleNs / sim::nowNs() : 0.0);
+    for (auto& q : queues) {
+        std::fprintf(stderr,
+                     "%s: produced %llu, consumed %llu, dropped %llu, max depth %lu/%lu, "
+                     "latency mean %.3f us, max %.3f us\n",
+                     q->name.c_str(), (unsigned long long)q->produced, (unsigned long long)q->consumed,
+                     (unsigned long long)q->dropped, q->maxDepth, q->length,
+                     q->consumed ? q->latencySumNs / 1e3 / q->consumed : 0.0, q->latencyMaxNs / 1e3);
+    }
+}
+
+void run(uint64_t durationNs, uint64_t sampleNs) {
+    writeHeader();
+    if (sampleNs) sim::probe(sampleNs, sampleNs, writeSample);
+    for (auto& c : consumers) {
+        xTaskCreate(consumerTask, "consumer", configMINIMAL_STACK_SIZE, c.get(), c->prio, nullptr);
+    }
+    for (auto& p : producers) {
+        if (p->isr) continue;
+        xTaskCreate(producerTask, "producer", configMINIMAL_STACK_SIZE, p.get(), p->prio, nullptr);
+    }
+    // +1 нс — чтобы выборка ровно в конце прогона попала в таймлайн
+    sim::stopAt(durationNs + 1);
+    vTaskStartScheduler();
+    summary();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* script = nullptr;
+    const char* out    = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out = argv[++i];
+        } else {
+            script = argv[i];
+        }
+    }
+    if (!script) {
+        std::fprintf(stderr, "usage: %s <script> [-o timeline.csv]\n", argv[0]);
+        return 2;
+    }
+    std::ifstream in(script);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", script);
+        return 2;
+    }
+    if (out) {
+        timeline = std::fopen(out, "w");
+        if (!timeline) {
+            std::fprintf(stderr, "cannot write %s\n", out);
+            return 2;
+        }
+    }
+
+    sim::CostModel cost       = sim::CostModel::esp32();
+    uint64_t       sampleNs   = 0;
+    uint64_t       durationNs = 0;
+    std::string    text;
+    int            line = 0;
+    while (std::getline(in, text)) {
+        ++line;
+        text = text.substr(0, text.find('#'));
+        std::istringstream ls(text);
+        std::string        cmd;
+        if (!(ls >> cmd)) continue;
+
+        if (cmd == "cost") {
+            std::string op, value;
+            if (!(ls >> op >> value)) fail(line, "usage: cost <op> <ns>");
+            sim::Op o;
+            if (op == "copy") {
+                cost.copyPsPerByte = parseNumber(line, value);
+            } else if (sim::opFromName(op.c_str(), o)) {
+                cost.ns[static_cast<size_t>(o)] = parseNumber(line, value);
+            } else {
+                fail(line, "unknown op '" + op + "'");
+            }
+        } else if (cmd == "queue") {
+            auto q = std::make_unique<QueueStats>();
+            if (!(ls >> q->name)) fail(line, "usage: queue <name> length=<n> [item=<bytes>]");
+            auto opts = options(line, ls);
+            if (!opts.count("length")) fail(line, "queue needs length=");
+            q->length = parseNumber(line, opts["length"]);
+            if (opts.count("item")) q->itemSize = parseNumber(line, opts["item"]);
+            if (q->itemSize < sizeof(uint64_t)) fail(line, "item must be at least 8 bytes (send timestamp)");
+            q->handle = xQueueCreate(q->length, q->itemSize);
+            queues.push_back(std::move(q));
+        } else if (cmd == "producer" || cmd == "isr_producer") {
+            auto        p = std::make_unique<Producer>();
+            std::string name;
+            if (!(ls >> name)) fail(line, "usage: " + cmd + " <queue> burst=<n> every=<dur>");
+            p->queue  = findQueue(line, name);
+            auto opts = options(line, ls);
+            if (!opts.count("every")) fail(line, cmd + " needs every=");
+            p->everyNs = parseDuration(line, opts["every"]);
+            if (opts.count("burst")) p->burst = parseNumber(line, opts["burst"]);
+            if (opts.count("start")) p->startNs = parseDuration(line, opts["start"]);
+            if (p->everyNs == 0) fail(line, "every= must be positive");
+            if (cmd == "isr_producer") {
+                p->isr        = true;
+                Producer* raw = p.get();
+                auto      buf = std::make_shared<std::vector<uint8_t>>(raw->queue->itemSize);
+                sim::every(raw->startNs, raw->everyNs, [raw, buf] {
+                    BaseType_t woken = pdFALSE;
+                    for (uint32_t i = 0; i < raw->burst; ++i) {
+                        stamp(*buf);
+                        noteSent(raw->queue, xQueueSendFromISR(raw->queue->handle, buf->data(), &woken) == pdTRUE);
+                    }
+                    portYIELD_FROM_ISR(woken);
+                });
+                producers.push_back(std::move(p));
+                continue;
+            }
+            if (p->everyNs % 1000000u || p->startNs % 1000000u) {
+                fail(line, "task producer period/start must be whole ticks (ms); use isr_producer for finer rates");
+            }
+            if (opts.count("prio")) p->prio = parseNumber(line, opts["prio"]);
+            if (opts.count("gap")) p->gapNs = parseDuration(line, opts["gap"]);
+            if (opts.count("timeout")) p->timeout = pdMS_TO_TICKS(parseNumber(line, opts["timeout"]));
+            producers.push_back(std::move(p));
+        } else if (cmd == "consumer") {
+            auto        c = std::make_unique<Consumer>();
+            std::string name;
+            if (!(ls >> name)) fail(line, "usage: consumer <queue> [prio=<p>] [work=<dur>]");
+            c->queue  = findQueue(line, name);
+            auto opts = options(line, ls);
+            if (opts.count("prio")) c->prio = parseNumber(line, opts["prio"]);
+            if (opts.count("work")) c->workNs = parseDuration(line, opts["work"]);
+            consumers.push_back(std::move(c));
+        } else if (cmd == "sample") {
+            auto opts = options(line, ls);
+            if (!opts.count("every")) fail(line, "usage: sample every=<dur>");
+            sampleNs = parseDuration(line, opts["every"]);
+        } else if (cmd == "run") {
+            std::string d;
+            if (!(ls >> d)) fail(line, "usage: run <dur>");
+            durationNs = parseDuration(line, d);
+        } else {
+            fail(line, "unknown directive '" + cmd + "'");
+        }
+    }
+    if (!durationNs) fail(line, "script has no 'run <dur>'");
+
+    sim::setCostModel(cost);
+    run(durationNs, sampleNs);
+    if (timeline) std::fclose(timeline);
+    return sim::deadlocked() ? 1 : 0;
+}
@@ -0,0 +1,305 @@
+// Конвертер дампа трассы (src/Trace.h) в Chrome/Perfetto JSON.
+//
+//   trace2perfetto <trace.bin> [trace.json]
+//
+// Результат открывается в ui.perfetto.dev или chrome://tracing:
+//   - дорожка на каждую задачу (и на прерывания каждого ядра);
+//   - интервалы "hold <guard>" / "wait <guard>" — кто держал Guarded и кто его ждал;
+//   - "blocked send/receive <queue>" — задача стояла на полной/пустой очереди;
+//   - "wait <event group>" — ожидание битов;
+//   - счётчики "<queue> depth" — глубина очередей во времени.
+
+#include "TraceFormat.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+struct Entry {
+    uint64_t      time;  // полное значение часов
+    uint32_t      core;
+    trace::Record rec;
+};
+
+struct Converter {
+    uint64_t                        clockHz = 1;
+    uint64_t                        origin  = 0;
+    std::map<uint32_t, std::string> names;
+    std::vector<std::string>        out;
+
+    // Открытые интервалы: (задача, объект, вид) → начало
+    std::map<std::tuple<uint32_t, uint32_t, int>, uint64_t> open;
+    std::map<uint32_t, uint32_t>                            lanes;  // tid → ядро (для прерываний)
+
+    enum Kind { Request, Hold, SendBlock, ReceiveBlock, EventWait };
+
+    double us(uint64_t t) const {
+        return static_cast<double>(t - origin) * 1e6 / static_cast<double>(clockHz);
+    }
+
+    std::string objectName(uint32_t id) const {
+        auto it = names.find(id);
+        if (it != names.end()) return it->second;
+        char buf[24];
+        std::snprintf(buf, sizeof(buf), "0x%08" PRIx32, id);
+        return buf;
+    }
+
+    static std::string quote(const std::string& s) {
+        std::string r = "\"";
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                r += '\\';
+                r += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                r += ' ';
+            } else {
+                r += c;
+            }
+        }
+        return r + "\"";
+    }
+
+    // Дорожка: задача или прерывания конкретного ядра
+    uint32_t tid(const Entry& e) {
+        uint32_t t = e.rec.task == trace::IsrTask ? e.core : e.rec.task;
+        lanes.emplace(t, e.core);
+        return t;
+    }
+
+    void span(uint32_t tid, const std::string& name, uint64_t begin, uint64_t end, const std::string& args = "") {
+        char buf[160];
+        std::snprintf(buf, sizeof(buf), "\"ph\":\"X\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":%.3f,\"dur\":%.3f", tid,
+                      us(begin), us(end) - us(begin));
+        out.push_back("{\"name\":" + quote(name) + "," + buf + (args.empty() ? "" : ",\"args\":{" + args + "}") +
+                      "}");
+    }
+
+    void instant(uint32_t tid, const std::string& name, uint64_t t, const std::string& args = "") {
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), "\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":%.3f", tid,
+                      us(t));
+        out.push_back("{\"name\":" + quote(name) + "," + buf + (args.empty() ? "" : ",\"args\":{" + args + "}") +
+                      "}");
+    }
+
+    void depth(uint32_t object, uint64_t t, uint32_t value) {
+        char buf[128];
+        std::snprintf(buf, sizeof(buf), "\"ph\":\"C\",\"pid\":2,\"ts\":%.3f,\"args\":{\"depth\":%" PRIu32 "}",
+                      us(t), value);
+        out.push_back("{\"name\":" + quote(objectName(object) + " depth") + "," + buf + "}");
+    }
+
+    bool close(uint32_t task, uint32_t object, Kind kind, uint64_t& begin) {
+        auto it = open.find(std::make_tuple(task, object, static_cast<int>(kind)));
+        if (it == open.end()) return false;
+        begin = it->second;
+        open.erase(it);
+        return true;
+    }
+
+    static std::string hexArg(const char* key, uint32_t v) {
+        char buf[48];
+        std::snprintf(buf, sizeof(buf), "\"%s\":\"0x%06" PRIx32 "\"", key, v);
+        return buf;
+    }
+
+    void handle(const Entry& e) {
+        using trace::Event;
+        const uint32_t    lane = tid(e);
+        const uint32_t    task = e.rec.task;
+        const uint32_t    obj  = e.rec.object;
+        const std::string name = objectName(obj);
+        uint64_t          begin;
+
+        switch (e.rec.event()) {
+            case Event::LockRequest:
+                open[std::make_tuple(task, obj, static_cast<int>(Request))] = e.time;
+                break;
+            case Event::LockAcquired:
+                if (close(task, obj, Request, begin) && e.time > begin) span(lane, "wait " + name, begin, e.time);
+                open[std::make_tuple(task, obj, static_cast<int>(Hold))] = e.time;
+                break;
+            case Event::LockReleased:
+                if (close(task, obj, Hold, begin)) span(lane, "hold " + name, begin, e.time);
+                break;
+
+            case Event::QueueSendBlock:
+                open[std::make_tuple(task, obj, static_cast<int>(SendBlock))] = e.time;
+                depth(obj, e.time, e.rec.arg());
+                break;
+            case Event::QueueReceiveBlock:
+                open[std::make_tuple(task, obj, static_cast<int>(ReceiveBlock))] = e.time;
+                depth(obj, e.time, e.rec.arg());
+                break;
+            case Event::QueueSend:
+            case Event::QueueSendFail:
+                if (close(task, obj, SendBlock, begin)) span(lane, "blocked send " + name, begin, e.time);
+                if (e.rec.event() == Event::QueueSendFail) instant(lane, "send failed " + name, e.time);
+                depth(obj, e.time, e.rec.arg());
+                break;
+            case Event::QueueReceive:
+            case Event::QueuePeek:
+            case Event::QueueReceiveFail:
+                if (close(task, obj, ReceiveBlock, begin)) span(lane, "blocked receive " + name, begin, e.time);
+                if (e.rec.event() == Event::QueueReceiveFail) instant(lane, "receive failed " + name, e.time);
+                depth(obj, e.time, e.rec.arg());
+                break;
+            case Event::QueueReset:
+                instant(lane, "reset " + name, e.time);
+                depth(obj, e.time, 0);
+                break;
+
+            case Event::EventSet:
+                instant(lane, "set " + name, e.time, hexArg("bits", e.rec.arg()));
+                break;
+            case Event::EventClear:
+                instant(lane, "clear " + name, e.time, hexArg("bits", e.rec.arg()));
+                break;
+            case Event::EventWaitBegin:
+                open[std::make_tuple(task, obj, static_cast<int>(EventWait))] = e.time;
+                break;
+            case Event::EventWaitEnd:
+                if (close(task, obj, EventWait, begin)) {
+                    span(lane, "wait " + name, begin, e.time, hexArg("result", e.rec.arg()));
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Интервалы, не закрытые к моменту дампа, дотягиваем до конца трассы
+    void flush(uint64_t end) {
+        static const char* const prefix[] = {"wait ", "hold ", "blocked send ", "blocked receive ", "wait "};
+        for (const auto& o : open) {
+            uint32_t task = std::get<0>(o.first);
+            uint32_t obj  = std::get<1>(o.first);
+            int      kind = std::get<2>(o.first);
+            span(task, prefix[kind] + objectName(obj), o.second, end, "\"unfinished\":true");
+        }
+        open.clear();
+    }
+
+    void metadata() {
+        out.push_back("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Tasks\"}}");
+        out.push_back("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,\"args\":{\"name\":\"Queues\"}}");
+        for (const auto& lane : lanes) {
+            std::string label;
+            if (lane.first == lane.second && lane.first < 64) {
+                label = "ISR core " + std::to_string(lane.second);
+            } else {
+                label = objectName(lane.first);
+            }
+            out.push_back("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(lane.first) +
+                          ",\"args\":{\"name\":" + quote(label) + "}}");
+        }
+    }
+};
+
+template <typename T>
+bool readPod(const std::vector<char>& data, size_t& pos, T& value) {
+    if (pos + sizeof(T) > data.size()) return false;
+    std::memcpy(&value, data.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <trace.bin> [trace.json]\n", argv[0]);
+        return 2;
+    }
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 2;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    size_t             pos = 0;
+    trace::FileHeader  header;
+    if (!readPod(data, pos, header) || header.magic != trace::FileMagic) {
+        std::fprintf(stderr, "%s: not a trace dump\n", argv[1]);
+        return 1;
+    }
+    if (header.version != trace::FileVersion || header.recordSize != sizeof(trace::Record)) {
+        std::fprintf(stderr, "%s: unsupported version %u / record size %u\n", argv[1], header.version,
+                     header.recordSize);
+        return 1;
+    }
+
+    Converter conv;
+    conv.clockHz = header.clockHz ? header.clockHz : 1;
+    for (uint32_t i = 0; i < header.nameCount; ++i) {
+        trace::NameEntry n;
+        if (!readPod(data, pos, n)) {
+            std::fprintf(stderr, "%s: truncated name table\n", argv[1]);
+            return 1;
+        }
+        n.name[trace::NameLength - 1] = '\0';
+        conv.names[n.object]          = n.name;
+    }
+
+    std::vector<Entry> entries;
+    uint64_t           lost = 0;
+    for (uint32_t c = 0; c < header.cores; ++c) {
+        trace::CoreHeader core;
+        if (!readPod(data, pos, core)) {
+            std::fprintf(stderr, "%s: truncated core header\n", argv[1]);
+            return 1;
+        }
+        lost += core.lost;
+        std::vector<trace::Record> recs(core.count);
+        for (auto& r : recs) {
+            if (!readPod(data, pos, r)) {
+                std::fprintf(stderr, "%s: truncated records\n", argv[1]);
+                return 1;
+            }
+        }
+        // Разворачиваем 32-битные метки от момента дампа назад
+        std::vector<uint64_t> times(recs.size());
+        uint64_t              t    = header.dumpTime;
+        uint32_t              prev = static_cast<uint32_t>(header.dumpTime);
+        for (size_t i = recs.size(); i-- > 0;) {
+            t -= static_cast<uint32_t>(prev - recs[i].time);
+            prev     = recs[i].time;
+            times[i] = t;
+        }
+        // Порядок записи сохраняем: у событий с одинаковой меткой он единственный источник истины
+        for (size_t i = 0; i < recs.size(); ++i) entries.push_back({times[i], core.core, recs[i]});
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+
+    if (!entries.empty()) conv.origin = entries.front().time;
+    for (const Entry& e : entries) conv.handle(e);
+    conv.flush(entries.empty() ? conv.origin : entries.back().time);
+    conv.metadata();
+
+    std::FILE* out = argc > 2 ? std::fopen(argv[2], "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "cannot write %s\n", argv[2]);
+        return 2;
+    }
+    std::fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (size_t i = 0; i < conv.out.size(); ++i) {
+        std::fprintf(out, "%s%s\n", conv.out[i].c_str(), i + 1 < conv.out.size() ? "," : "");
+    }
+    std::fprintf(out, "]}\n");
+    if (out != stdout) std::fclose(out);
+
+    std::fprintf(stderr, "%zu records (%" PRIu64 " lost to ring overwrite), %zu trace events\n", entries.size(), lost,
+                 conv.out.size());
+    return 0;
+}
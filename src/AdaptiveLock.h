@@ -0,0 +1,214 @@
+#ifndef ADAPTIVE_LOCK_H
+#define ADAPTIVE_LOCK_H
+
+// Адаптивная политика для Guarded: сначала покрутиться, потом заснуть.
+//
+// Guarded<T, lock::Adaptive> — для коротких секций на двухъядерных целях (ESP32): если
+// держатель сейчас выполняется на другом ядре, он освободит секцию через несколько
+// микросекунд. Это дешевле, чем заснуть на мьютексе и проснуться через планировщик.
+//
+// В основе — мьютекс ядра, как у lock::KernelMutex, с наследованием приоритета. Если он
+// занят, а держатель (xSemaphoreGetMutexHolder) выполняется на другом ядре, ждущий
+// крутится, пробуя взять мьютекс без ожидания, с нарастающей паузой в пределах бюджета.
+// Бюджет каждой блокировки подстраивается под недавние удержания: освобождая, держатель
+// обновляет скользящее среднее длительности удержания (1/8 нового), а бюджет — два средних
+// плюс небольшой запас. Если удержания в среднем длиннее maxSpinNs (порядок цены
+// заснуть-проснуться), бюджет нулевой, и ждущий сразу засыпает. Если держатель не
+// выполняется (вытеснен или ядро одно), крутиться бессмысленно — ждущий сразу засыпает
+// на мьютексе, и держатель наследует его приоритет.
+//
+// Из ISR брать нельзя, как и мьютекс.
+//
+// Часы (FREERTOS_CPP_SPIN_CLOCK / FREERTOS_CPP_SPIN_CLOCK_HZ): по умолчанию общий мелкий
+// счётчик FREERTOS_CPP_CLOCK_CYCLES (MicrosClock.h). В симуляторе часы стоят, пока
+// задача считает без вызовов ядра, поэтому кручение ограничено ещё и числом проверок
+// (FREERTOS_CPP_SPIN_MAX_ITERATIONS).
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "BlockingDetector.h"
+#include "Guarded.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+#ifndef FREERTOS_CPP_SPIN_CLOCK
+#include "MicrosClock.h"
+#define FREERTOS_CPP_SPIN_CLOCK()  static_cast<uint32_t>(FREERTOS_CPP_CLOCK_CYCLES())
+#define FREERTOS_CPP_SPIN_CLOCK_HZ FREERTOS_CPP_CLOCK_CYCLES_HZ
+#endif
+
+// Выполняется ли задача прямо сейчас на другом ядре
+#ifndef FREERTOS_CPP_SPIN_OWNER_RUNNING
+#if defined(ESP_PLATFORM) && portNUM_PROCESSORS > 1
+#define FREERTOS_CPP_SPIN_OWNER_RUNNING(task) \
+    (xTaskGetCurrentTaskHandleForCore(1 - xPortGetCoreID()) == (task))
+#else
+// Одно ядро: пока ждущий крутится, держатель стоит
+#define FREERTOS_CPP_SPIN_OWNER_RUNNING(task) (false)
+#endif
+#endif
+
+// Пауза между проверками слова блокировки
+#ifndef FREERTOS_CPP_CPU_RELAX
+#if defined(__x86_64__) || defined(__i386__)
+#define FREERTOS_CPP_CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define FREERTOS_CPP_CPU_RELAX() __asm__ __volatile__("yield")
+#else
+#define FREERTOS_CPP_CPU_RELAX() __asm__ __volatile__("nop")
+#endif
+#endif
+
+// Дольше этого крутиться не стоит: порядок цены заснуть и проснуться через планировщик
+#ifndef FREERTOS_CPP_SPIN_MAX_NS
+#define FREERTOS_CPP_SPIN_MAX_NS 10000
+#endif
+
+#ifndef FREERTOS_CPP_SPIN_MAX_ITERATIONS
+#define FREERTOS_CPP_SPIN_MAX_ITERATIONS 1024
+#endif
+
+namespace lock {
+
+class Adaptive {
+  public:
+    struct Stats {
+        uint32_t acquired;  // всего захватов
+        uint32_t spun;      // из них после кручения
+        uint32_t blocked;   // из них после сна на мьютексе
+        uint32_t holdNs;    // скользящее среднее удержания
+        uint32_t budgetNs;  // текущий бюджет кручения
+    };
+
+    explicit Adaptive(uint32_t maxSpinNs = FREERTOS_CPP_SPIN_MAX_NS) : maxSpin(toClock(maxSpinNs)) {
+#if configSUPPORT_STATIC_ALLOCATION
+        mutex = xSemaphoreCreateMutexStatic(&mutexBuffer);
+#else
+        mutex = xSemaphoreCreateMutex();
+#endif
+        if (mutex == nullptr) {
+            configASSERT(false && "Failed to create adaptive lock");
+            abort();
+        }
+    }
+
+    ~Adaptive() {
+        blocking::forget(mutex);
+        vSemaphoreDelete(mutex);
+    }
+
+    Adaptive(const Adaptive&)            = delete;
+    Adaptive& operator=(const Adaptive&) = delete;
+
+    void lock() {
+        if (xSemaphoreTake(mutex, 0) != pdTRUE) {
+            if (spin()) {
+                spun.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                blocking::Wait wait(mutex, blocking::Kind::Mutex, xSemaphoreGetMutexHolder(mutex));
+                xSemaphoreTake(mutex, portMAX_DELAY);
+                blocked.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        acquired.fetch_add(1, std::memory_order_relaxed);
+        since = FREERTOS_CPP_SPIN_CLOCK();
+    }
+
+    void unlock() {
+        // Среднее пишет только держатель, поэтому хватает relaxed
+        const uint32_t held = FREERTOS_CPP_SPIN_CLOCK() - since;
+        const uint32_t avg  = holdAvg.load(std::memory_order_relaxed);
+        holdAvg.store(held >= avg ? avg + (held - avg) / 8 : avg - (avg - held) / 8, std::memory_order_relaxed);
+        xSemaphoreGive(mutex);
+    }
+
+    const void* id() const {
+        return mutex;
+    }
+
+    static constexpr size_t heapFootprint() {
+#if configSUPPORT_STATIC_ALLOCATION
+        return 0;
+#else
+        return ::footprint::semaphore();
+#endif
+    }
+
+    // Сколько крутиться сейчас, в единицах часов; 0 — сразу спать
+    uint32_t budget() const {
+        const uint32_t twice = 2 * holdAvg.load(std::memory_order_relaxed);
+        return twice > maxSpin ? 0 : twice + maxSpin / 16;
+    }
+
+    Stats stats() const {
+        return Stats{acquired.load(std::memory_order_relaxed), spun.load(std::memory_order_relaxed),
+                     blocked.load(std::memory_order_relaxed), toNs(holdAvg.load(std::memory_order_relaxed)),
+                     toNs(budget())};
+    }
+
+  private:
+    static constexpr uint32_t MaxPause = 64;
+
+    static constexpr uint32_t toClock(uint32_t ns) {
+        return static_cast<uint32_t>(ns * FREERTOS_CPP_SPIN_CLOCK_HZ / 1000000000ull);
+    }
+
+    static constexpr uint32_t toNs(uint32_t ticks) {
+        return static_cast<uint32_t>(ticks * 1000000000ull / FREERTOS_CPP_SPIN_CLOCK_HZ);
+    }
+
+    // Крутиться, пока держатель выполняется и бюджет не исчерпан. true — захватили.
+    bool spin() {
+        const uint32_t limit = budget();
+        if (limit == 0) return false;
+        const uint32_t start = FREERTOS_CPP_SPIN_CLOCK();
+        uint32_t       pause = 1;
+        for (uint32_t i = 0; i < FREERTOS_CPP_SPIN_MAX_ITERATIONS; ++i) {
+            TaskHandle_t holder = xSemaphoreGetMutexHolder(mutex);
+            if (holder && !FREERTOS_CPP_SPIN_OWNER_RUNNING(holder)) return false;
+            for (uint32_t k = 0; k < pause; ++k) FREERTOS_CPP_CPU_RELAX();
+            if (pause < MaxPause) pause *= 2;
+            if (xSemaphoreTake(mutex, 0) == pdTRUE) return true;
+            if (FREERTOS_CPP_SPIN_CLOCK() - start >= limit) return false;
+        }
+        return false;
+    }
+
+    uint32_t                  since = 0;
+    std::atomic<uint32_t>     holdAvg{0};
+    const uint32_t            maxSpin;
+    std::atomic<uint32_t>     acquired{0};
+    std::atomic<uint32_t>     spun{0};
+    std::atomic<uint32_t>     blocked{0};
+    SemaphoreHandle_t         mutex;
+#if configSUPPORT_STATIC_ALLOCATION
+    StaticSemaphore_t mutexBuffer;
+#endif
+};
+
+}  // namespace lock
+
+#endif  // ADAPTIVE_LOCK_H
+
+/*
+// Счётчики, которые оба ядра трогают на несколько микросекунд
+Guarded<Counters, lock::Adaptive> counters;
+
+void core0Task(void*) {
+    for (;;) {
+        counters()->rx++;
+        ...
+    }
+}
+
+// Как ведёт себя блокировка
+lock::Adaptive::Stats s = counters.policy().stats();
+printf("spun %u, blocked %u of %u, hold %u ns, budget %u ns\n", s.spun, s.blocked, s.acquired, s.holdNs,
+       s.budgetNs);
+*/
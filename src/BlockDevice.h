@@ -0,0 +1,119 @@
+#ifndef BLOCK_DEVICE_H
+#define BLOCK_DEVICE_H
+
+// Блочное хранилище для SpillQueue и подобных: блоки одного размера, чтение и запись
+// блока целиком по номеру. Реализации — поверх раздела флеш-памяти, SD-карты, файла.
+//
+// FileBlockDevice — файл фиксированного размера на хосте (Linux, POSIX-порт, симулятор):
+// pread/pwrite по смещению block * blockSize.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+
+class BlockDevice {
+  public:
+    virtual ~BlockDevice() = default;
+
+    // Размер блока в байтах и число блоков
+    virtual size_t   blockSize() const  = 0;
+    virtual uint32_t blockCount() const = 0;
+
+    // Прочитать / записать блок целиком. false — ошибка ввода-вывода.
+    virtual bool read(uint32_t block, void* dst)        = 0;
+    virtual bool write(uint32_t block, const void* src) = 0;
+
+    // Дождаться, пока записанное окажется на носителе
+    virtual bool sync() {
+        return true;
+    }
+};
+
+#if defined(__unix__) && !defined(ESP_PLATFORM)
+
+#include <fcntl.h>
+#include <unistd.h>
+
+class FileBlockDevice : public BlockDevice {
+  public:
+    // Открыть или создать файл и довести его до blocks * size байт
+    FileBlockDevice(const char* path, size_t size, uint32_t blocks) : size(size), blocks(blocks) {
+        fd = ::open(path, O_RDWR | O_CREAT, 0644);
+        if (fd >= 0 && ::ftruncate(fd, static_cast<off_t>(size) * blocks) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    ~FileBlockDevice() override {
+        if (fd >= 0) ::close(fd);
+    }
+
+    FileBlockDevice(const FileBlockDevice&)            = delete;
+    FileBlockDevice& operator=(const FileBlockDevice&) = delete;
+
+    bool isOpen() const {
+        return fd >= 0;
+    }
+
+    size_t blockSize() const override {
+        return size;
+    }
+
+    uint32_t blockCount() const override {
+        return blocks;
+    }
+
+    bool read(uint32_t block, void* dst) override {
+        if (fd < 0 || block >= blocks) return false;
+        return ::pread(fd, dst, size, offset(block)) == static_cast<ssize_t>(size);
+    }
+
+    bool write(uint32_t block, const void* src) override {
+        if (fd < 0 || block >= blocks) return false;
+        return ::pwrite(fd, src, size, offset(block)) == static_cast<ssize_t>(size);
+    }
+
+    bool sync() override {
+        return fd >= 0 && ::fsync(fd) == 0;
+    }
+
+  private:
+    int      fd = -1;
+    size_t   size;
+    uint32_t blocks;
+
+    off_t offset(uint32_t block) const {
+        return static_cast<off_t>(block) * static_cast<off_t>(size);
+    }
+};
+
+#endif
+
+#endif  // BLOCK_DEVICE_H
+
+/*
+// Раздел флеш-памяти ESP-IDF как блочное устройство
+class PartitionDevice : public BlockDevice {
+  public:
+    explicit PartitionDevice(const esp_partition_t* p) : part(p) {}
+    size_t   blockSize() const override { return 4096; }
+    uint32_t blockCount() const override { return part->size / 4096; }
+    bool     read(uint32_t b, void* dst) override {
+        return esp_partition_read(part, b * 4096, dst, 4096) == ESP_OK;
+    }
+    bool write(uint32_t b, const void* src) override {
+        return esp_partition_erase_range(part, b * 4096, 4096) == ESP_OK &&
+               esp_partition_write(part, b * 4096, src, 4096) == ESP_OK;
+    }
+
+  private:
+    const esp_partition_t* part;
+};
+
+// На хосте — файл на 1024 блока по 512 байт
+FileBlockDevice spill("/tmp/telemetry.spill", 512, 1024);
+*/
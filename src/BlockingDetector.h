@@ -0,0 +1,358 @@
+#ifndef BLOCKING_DETECTOR_H
+#define BLOCKING_DETECTOR_H
+
+// Детектор инверсий приоритетов и долгих блокировок в Guarded и Queue.
+//
+// Каждое ожидание обёртки сравнивает приоритет ждущей задачи с приоритетом той задачи, от
+// которой ожидание зависит («блокирующей»):
+//   Kind::Mutex      — держатель мьютекса Guarded;
+//   Kind::QueueEmpty — последняя задача, положившая в очередь (она же её кормит);
+//   Kind::QueueFull  — последняя задача, забравшая из очереди (она же её разгружает).
+// Если блокирующая задача ниже приоритетом, случай записывается как инверсия, сколько бы
+// он ни длился. Остальные ожидания записываются, только если дольше setLongBlockUs().
+// Глубина цепочки — сколько задач подряд ждут друг друга: держатель мьютекса сам ждёт
+// другой мьютекс или очередь, и так далее (1 — прямая зависимость).
+//
+// Записи сводятся по ресурсам в таблицу фиксированного размера. report() отдаёт её копию,
+// упорядоченную по суммарному времени инверсий, затем по суммарному времени ожидания.
+// Это и есть список ресурсов, которые стоит переделать первыми.
+//
+// Включается при компиляции: -DFREERTOS_CPP_BLOCKING=1. Без него обёртки не меняются.
+// Включённый детектор сперва пробует взять ресурс без ожидания, а таблицы трогает только
+// при настоящем ожидании (под vTaskSuspendAll). Приоритет держателя мьютекса — текущий:
+// если он уже унаследовал приоритет от другого ждущего, инверсию записал тот, первый.
+// Для очередей приоритет и имя запоминаются при send/receive (Party): поставщик мог уже
+// удалиться, и его хэндл разыменовывать нельзя.
+//
+// Размеры: FREERTOS_CPP_BLOCKING_RESOURCES (32) ресурсов в отчёте,
+// FREERTOS_CPP_BLOCKING_WAITERS (16) одновременно ждущих задач.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cstddef>
+#include <cstdint>
+
+#ifndef FREERTOS_CPP_BLOCKING
+#define FREERTOS_CPP_BLOCKING 0
+#endif
+
+namespace blocking {
+
+constexpr bool Enabled = FREERTOS_CPP_BLOCKING != 0;
+
+enum class Kind : uint8_t { Mutex, QueueEmpty, QueueFull };
+
+// Строка отчёта: один ресурс
+struct Entry {
+    const void* resource;  // хэндл мьютекса или очереди
+    const char* name;      // из setTraceName() обёртки или blocking::name(); nullptr — без имени
+    Kind        kind;      // вид последней записи
+    uint32_t    blocks;      // записанных ожиданий
+    uint32_t    inversions;  // из них — инверсий
+    uint64_t    inversionUs;  // суммарное время инверсий
+    uint64_t    totalUs;      // суммарное время записанных ожиданий
+    uint32_t    maxUs;        // самое долгое ожидание
+    uint8_t     maxDepth;     // самая длинная цепочка
+    // Самое долгое ожидание: кто ждал и кого
+    UBaseType_t waiterPriority;
+    UBaseType_t blockerPriority;
+    char        waiter[configMAX_TASK_NAME_LEN];
+    char        blocker[configMAX_TASK_NAME_LEN];  // пусто — блокирующая задача неизвестна (ISR)
+};
+
+}  // namespace blocking
+
+#if FREERTOS_CPP_BLOCKING
+
+#include "MicrosClock.h"
+#include <cstring>
+
+#ifndef FREERTOS_CPP_BLOCKING_RESOURCES
+#define FREERTOS_CPP_BLOCKING_RESOURCES 32
+#endif
+
+#ifndef FREERTOS_CPP_BLOCKING_WAITERS
+#define FREERTOS_CPP_BLOCKING_WAITERS 16
+#endif
+
+#ifndef FREERTOS_CPP_BLOCKING_LONG_US
+#define FREERTOS_CPP_BLOCKING_LONG_US 1000
+#endif
+
+namespace blocking {
+
+namespace detail {
+
+constexpr uint8_t MaxDepth = 8;
+
+// Кто сейчас ждёт и от кого зависит
+struct Waiting {
+    TaskHandle_t task;
+    TaskHandle_t blocker;
+};
+
+struct State {
+    Entry    entries[FREERTOS_CPP_BLOCKING_RESOURCES];
+    size_t   count;
+    Waiting  waiting[FREERTOS_CPP_BLOCKING_WAITERS];
+    uint32_t longBlockUs = FREERTOS_CPP_BLOCKING_LONG_US;
+    uint32_t dropped;  // не хватило строк или мест для ждущих
+};
+
+inline State& state() {
+    static State s;
+    return s;
+}
+
+inline void copyName(char* dst, TaskHandle_t task) {
+    if (task) {
+        std::strncpy(dst, pcTaskGetName(task), configMAX_TASK_NAME_LEN - 1);
+        dst[configMAX_TASK_NAME_LEN - 1] = '\0';
+    } else {
+        dst[0] = '\0';
+    }
+}
+
+// Строка ресурса; создаётся при первом обращении. Под vTaskSuspendAll.
+inline Entry* entryFor(const void* resource) {
+    State& s = state();
+    for (size_t i = 0; i < s.count; ++i) {
+        if (s.entries[i].resource == resource) return &s.entries[i];
+    }
+    if (s.count == FREERTOS_CPP_BLOCKING_RESOURCES) return nullptr;
+    Entry* e = &s.entries[s.count++];
+    *e          = Entry{};
+    e->resource = resource;
+    return e;
+}
+
+// Длина цепочки ожиданий, начиная с blocker. Под vTaskSuspendAll.
+inline uint8_t depthFrom(TaskHandle_t blocker) {
+    const State& s     = state();
+    uint8_t      depth = 0;
+    while (blocker && depth < MaxDepth) {
+        ++depth;
+        TaskHandle_t next = nullptr;
+        for (const Waiting& w : s.waiting) {
+            if (w.task == blocker) next = w.blocker;
+        }
+        blocker = next;
+    }
+    return depth;
+}
+
+}  // namespace detail
+
+// Последняя задача, положившая в очередь или забравшая из неё: снимок на момент операции.
+// Задача могла с тех пор удалиться, поэтому её хэндл только сравнивается, но не
+// разыменовывается, а приоритет и имя берутся из снимка.
+struct Party {
+    TaskHandle_t task     = nullptr;  // nullptr — никто или ISR
+    UBaseType_t  priority = 0;
+    char         name[configMAX_TASK_NAME_LEN] = {};
+
+    // Запомнить текущую задачу
+    void capture() {
+        task     = xTaskGetCurrentTaskHandle();
+        priority = uxTaskPriorityGet(nullptr);
+        detail::copyName(name, task);
+    }
+};
+
+// Одно ожидание: конструктор перед блокирующим вызовом, деструктор — после
+class Wait {
+  public:
+    // blocker жив всё ожидание (держатель мьютекса)
+    Wait(const void* resource, Kind kind, TaskHandle_t blocker) : Wait(resource, kind, blocker, nullptr) {}
+
+    // Блокирующая задача из снимка (очереди)
+    Wait(const void* resource, Kind kind, const Party& last) : Wait(resource, kind, last.task, &last) {}
+
+    ~Wait() {
+        const uint32_t  us        = FREERTOS_CPP_CLOCK_US() - start;
+        const bool      inversion = blocker && blockerPriority < waiterPriority;
+        detail::State&  s         = detail::state();
+        vTaskSuspendAll();
+        if (slot) *slot = detail::Waiting{};
+        if (inversion || us >= s.longBlockUs) {
+            if (Entry* e = detail::entryFor(resource)) {
+                e->kind = kind;
+                ++e->blocks;
+                e->totalUs += us;
+                if (inversion) {
+                    ++e->inversions;
+                    e->inversionUs += us;
+                }
+                if (depth > e->maxDepth) e->maxDepth = depth;
+                if (us >= e->maxUs) {
+                    e->maxUs           = us;
+                    e->waiterPriority  = waiterPriority;
+                    e->blockerPriority = blockerPriority;
+                    detail::copyName(e->waiter, self);
+                    std::memcpy(e->blocker, blockerName, sizeof(blockerName));
+                }
+            } else {
+                ++s.dropped;
+            }
+        }
+        xTaskResumeAll();
+    }
+
+    Wait(const Wait&)            = delete;
+    Wait& operator=(const Wait&) = delete;
+
+  private:
+    Wait(const void* resource, Kind kind, TaskHandle_t blocker, const Party* last)
+        : resource(resource), blocker(blocker), self(xTaskGetCurrentTaskHandle()), kind(kind) {
+        if (blocker == self) this->blocker = nullptr;
+        waiterPriority  = uxTaskPriorityGet(nullptr);
+        blockerPriority = !this->blocker ? 0 : last ? last->priority : uxTaskPriorityGet(this->blocker);
+        detail::State& s = detail::state();
+        vTaskSuspendAll();
+        depth = detail::depthFrom(this->blocker);
+        if (last && this->blocker) {
+            std::memcpy(blockerName, last->name, sizeof(blockerName));
+        } else {
+            detail::copyName(blockerName, this->blocker);
+        }
+        for (detail::Waiting& w : s.waiting) {
+            if (w.task == nullptr) {
+                w    = detail::Waiting{self, this->blocker};
+                slot = &w;
+                break;
+            }
+        }
+        if (!slot) ++s.dropped;
+        xTaskResumeAll();
+        start = FREERTOS_CPP_CLOCK_US();
+    }
+
+    const void*      resource;
+    TaskHandle_t     blocker;
+    TaskHandle_t     self;
+    Kind             kind;
+    uint8_t          depth = 0;
+    UBaseType_t      waiterPriority;
+    UBaseType_t      blockerPriority;
+    detail::Waiting* slot = nullptr;
+    uint32_t         start;
+    char             blockerName[configMAX_TASK_NAME_LEN];
+};
+
+// Подписать ресурс в отчёте (обёртки зовут из setTraceName)
+inline void name(const void* resource, const char* text) {
+    vTaskSuspendAll();
+    if (Entry* e = detail::entryFor(resource)) e->name = text;
+    xTaskResumeAll();
+}
+
+// Убрать ресурс из отчёта (обёртки зовут при удалении: хэндл может достаться новому объекту)
+inline void forget(const void* resource) {
+    detail::State& s = detail::state();
+    vTaskSuspendAll();
+    for (size_t i = 0; i < s.count; ++i) {
+        if (s.entries[i].resource == resource) {
+            s.entries[i] = s.entries[--s.count];
+            break;
+        }
+    }
+    xTaskResumeAll();
+}
+
+// Порог записи ожиданий без инверсии
+inline void setLongBlockUs(uint32_t us) {
+    detail::state().longBlockUs = us;
+}
+
+// Скопировать до max строк, худшие первыми. Возвращает число строк.
+inline size_t report(Entry* out, size_t max) {
+    detail::State& s = detail::state();
+    vTaskSuspendAll();
+    // Вставками прямо в таблице: строк немного, а отчёт снимают редко
+    for (size_t i = 1; i < s.count; ++i) {
+        Entry  e = s.entries[i];
+        size_t j = i;
+        while (j > 0 && (s.entries[j - 1].inversionUs < e.inversionUs ||
+                         (s.entries[j - 1].inversionUs == e.inversionUs && s.entries[j - 1].totalUs < e.totalUs))) {
+            s.entries[j] = s.entries[j - 1];
+            --j;
+        }
+        s.entries[j] = e;
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < s.count && n < max; ++i) {
+        if (s.entries[i].blocks > 0) out[n++] = s.entries[i];
+    }
+    xTaskResumeAll();
+    return n;
+}
+
+// Забыть накопленное (имена ресурсов остаются)
+inline void reset() {
+    detail::State& s = detail::state();
+    vTaskSuspendAll();
+    for (size_t i = 0; i < s.count; ++i) {
+        Entry&      e        = s.entries[i];
+        const void* resource = e.resource;
+        const char* text     = e.name;
+        e                    = Entry{};
+        e.resource           = resource;
+        e.name               = text;
+    }
+    s.dropped = 0;
+    xTaskResumeAll();
+}
+
+inline uint32_t dropped() {
+    return detail::state().dropped;
+}
+
+}  // namespace blocking
+
+#else  // FREERTOS_CPP_BLOCKING
+
+namespace blocking {
+
+class Wait {
+  public:
+    Wait(const void*, Kind, TaskHandle_t) {}
+};
+
+inline void name(const void*, const char*) {}
+inline void forget(const void*) {}
+inline void setLongBlockUs(uint32_t) {}
+inline size_t report(Entry*, size_t) {
+    return 0;
+}
+inline void reset() {}
+inline uint32_t dropped() {
+    return 0;
+}
+
+}  // namespace blocking
+
+#endif  // FREERTOS_CPP_BLOCKING
+
+#endif  // BLOCKING_DETECTOR_H
+
+/*
+// Сборка с -DFREERTOS_CPP_BLOCKING=1
+Guarded<Settings> settings;
+Queue<Frame>      frames(8);
+settings.setTraceName("settings");  // имя и в трассе, и в отчёте
+frames.setTraceName("frames");
+
+// В диагностике
+blocking::Entry rows[8];
+size_t          n = blocking::report(rows, 8);
+for (size_t i = 0; i < n; ++i) {
+    const blocking::Entry& r = rows[i];
+    printf("%-10s inv=%u (%llu us) blocks=%u max=%u us depth=%u  %s(%u) waited for %s(%u)\n",
+           r.name ? r.name : "?", r.inversions, (unsigned long long)r.inversionUs, r.blocks, r.maxUs,
+           r.maxDepth, r.waiter, r.waiterPriority, r.blocker, r.blockerPriority);
+}
+*/
@@ -0,0 +1,196 @@
+#ifndef BYTE_TRANSPORT_H
+#define BYTE_TRANSPORT_H
+
+// Двунаправленный поток байтов между узлами для RemoteQueueBridge и подобных:
+// UART, SPI, сокет. Границы записей не сохраняются, порядок байтов — сохраняется.
+//
+// LoopbackLink — два конца в одном образе поверх пары потоковых буферов: a() пишет то,
+// что читает b(), и наоборот.
+// UnixSocketTransport — сокет AF_UNIX (socketpair или connect) на хосте. Чтение опрашивает
+// сокет раз в тик, чтобы задача не занимала процессор в системном вызове.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/stream_buffer.h"
+#include "freertos/task.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+class ByteTransport {
+  public:
+    // Результат read(): связь разорвана насовсем (сокет закрыт другой стороной)
+    static constexpr size_t Closed = SIZE_MAX;
+
+    virtual ~ByteTransport() = default;
+
+    // Записать все len байт, ожидая места сколько нужно. false — связь разорвана.
+    virtual bool write(const void* data, size_t len) = 0;
+
+    // Прочитать то, что пришло, не больше max, ожидая первых байтов до ms. 0 — ничего,
+    // Closed — читать больше нечего, ждать бессмысленно.
+    virtual size_t read(void* dst, size_t max, uint32_t ms) = 0;
+};
+
+#if configSUPPORT_STATIC_ALLOCATION
+
+// Два конца в одном образе: по потоковому буферу на направление
+template <size_t Bytes = 1024>
+class LoopbackLink {
+  public:
+    LoopbackLink() : ends{End(this, 0), End(this, 1)} {
+        for (int i = 0; i < 2; ++i) {
+            buffers[i] = xStreamBufferCreateStatic(Bytes, 1, storage[i], &control[i]);
+            if (buffers[i] == nullptr) {
+                configASSERT(false && "Failed to create loopback link");
+                abort();
+            }
+        }
+    }
+
+    ~LoopbackLink() {
+        for (StreamBufferHandle_t b : buffers) vStreamBufferDelete(b);
+    }
+
+    LoopbackLink(const LoopbackLink&)            = delete;
+    LoopbackLink& operator=(const LoopbackLink&) = delete;
+
+    ByteTransport& a() {
+        return ends[0];
+    }
+
+    ByteTransport& b() {
+        return ends[1];
+    }
+
+  private:
+    class End : public ByteTransport {
+      public:
+        End(LoopbackLink* link, int side) : link(link), side(side) {}
+
+        bool write(const void* data, size_t len) override {
+            const uint8_t* p = static_cast<const uint8_t*>(data);
+            while (len > 0) {
+                const size_t n = xStreamBufferSend(link->buffers[side], p, len, portMAX_DELAY);
+                p += n;
+                len -= n;
+            }
+            return true;
+        }
+
+        size_t read(void* dst, size_t max, uint32_t ms) override {
+            return xStreamBufferReceive(link->buffers[1 - side], dst, max, pdMS_TO_TICKS(ms));
+        }
+
+      private:
+        LoopbackLink* link;
+        int           side;  // пишет в buffers[side], читает из buffers[1 - side]
+    };
+
+    StreamBufferHandle_t buffers[2] = {};
+    uint8_t              storage[2][Bytes + 1];
+    StaticStreamBuffer_t control[2];
+    End                  ends[2];
+};
+
+#endif
+
+#if defined(__unix__) && !defined(ESP_PLATFORM)
+
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+class UnixSocketTransport : public ByteTransport {
+  public:
+    // Готовый сокет (например, конец socketpair); закрывается вместе с объектом
+    explicit UnixSocketTransport(int fd) : fd(fd) {}
+
+    // Подключиться к сокету по пути
+    explicit UnixSocketTransport(const char* path) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        size_t i        = 0;
+        for (; path[i] && i + 1 < sizeof(addr.sun_path); ++i) addr.sun_path[i] = path[i];
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    ~UnixSocketTransport() override {
+        if (fd >= 0) ::close(fd);
+    }
+
+    UnixSocketTransport(const UnixSocketTransport&)            = delete;
+    UnixSocketTransport& operator=(const UnixSocketTransport&) = delete;
+
+    bool isOpen() const {
+        return fd >= 0;
+    }
+
+    bool write(const void* data, size_t len) override {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        while (fd >= 0 && len > 0) {
+            const ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n > 0) {
+                p += n;
+                len -= static_cast<size_t>(n);
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                vTaskDelay(1);  // буфер сокета полон
+            } else if (n < 0 && errno != EINTR) {
+                return false;
+            }
+        }
+        return fd >= 0;
+    }
+
+    size_t read(void* dst, size_t max, uint32_t ms) override {
+        const TickType_t start = xTaskGetTickCount();
+        const TickType_t limit = pdMS_TO_TICKS(ms);
+        for (;;) {
+            if (fd < 0) return Closed;
+            const ssize_t n = ::recv(fd, dst, max, MSG_DONTWAIT);
+            if (n > 0) return static_cast<size_t>(n);
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) return Closed;
+            if (xTaskGetTickCount() - start >= limit) return 0;
+            vTaskDelay(1);
+        }
+    }
+
+  private:
+    int fd = -1;
+};
+
+#endif
+
+#endif  // BYTE_TRANSPORT_H
+
+/*
+// UART ESP-IDF как транспорт
+class UartTransport : public ByteTransport {
+  public:
+    explicit UartTransport(uart_port_t port) : port(port) {}
+    bool write(const void* data, size_t len) override {
+        return uart_write_bytes(port, data, len) == static_cast<int>(len);
+    }
+    size_t read(void* dst, size_t max, uint32_t ms) override {
+        int n = uart_read_bytes(port, dst, max, pdMS_TO_TICKS(ms));
+        return n > 0 ? static_cast<size_t>(n) : 0;  // UART не закрывается: Closed не бывает
+    }
+
+  private:
+    uart_port_t port;
+};
+
+// Хост: пара связанных сокетов
+int                 fds[2];
+socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+UnixSocketTransport left(fds[0]), right(fds[1]);
+*/
@@ -0,0 +1,355 @@
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+// Каналы в духе Go: Channel<T, Capacity> и select по нескольким операциям.
+//
+// Capacity == 0 — рандеву: send() ждёт получателя, и значение копируется прямо из
+// переменной отправителя в переменную получателя, без промежуточного буфера.
+// Capacity > 0 — буфер на Capacity элементов внутри объекта.
+//
+// channel::select({channel::send(a, v), channel::recv(b, x)}, ms) выполняет ровно одну из
+// готовых операций и возвращает её номер (-1 — таймаут). Готовые проверяются по порядку,
+// так что ранние варианты приоритетнее. Если готовых нет, задача встаёт в очереди всех
+// каналов сразу; первый партнёр выполняет операцию и снимает её из остальных очередей.
+//
+// close(): отправители получают false, получатели дочитывают буфер и тоже получают false.
+// Готовность «закрыт» в select срабатывает сразу, результат — в *ok.
+//
+// Все каналы защищены одним мьютексом (с наследованием приоритета): так select атомарен
+// по любому набору каналов. Критические секции короткие — копирование одного T.
+// Ожидание — уведомление задачи (индекс библиотеки, NotifyIndex.h). Из прерываний каналы
+// не используются.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "NotifyIndex.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+// Наибольшее число вариантов в одном select
+#ifndef FREERTOS_CPP_SELECT_MAX_CASES
+#define FREERTOS_CPP_SELECT_MAX_CASES 8
+#endif
+
+#if !configSUPPORT_STATIC_ALLOCATION
+#error "Channel requires configSUPPORT_STATIC_ALLOCATION"
+#endif
+
+namespace channel {
+
+class ChannelBase;
+struct Waiter;
+
+// Вариант select: операция над каналом. Создаётся channel::send() / channel::recv().
+struct Case {
+    ChannelBase* ch;
+    bool         isSend;
+    void*        data;  // const T* для отправки, T* для приёма
+    bool*        ok;    // true — значение передано, false — канал закрыт
+
+    // Заполняет select, пока задача стоит в очереди канала
+    Waiter* waiter;
+    Case*   next;
+};
+
+struct Waiter {
+    TaskHandle_t     task;
+    Case*            cases;
+    size_t           count;
+    std::atomic<int> fired{-1};
+};
+
+enum class Result : uint8_t {
+    Done,
+    Closed,
+    WouldBlock,
+};
+
+namespace detail {
+
+// Без FREERTOS_CPP_RAM: статик inline-функции лежит в COMDAT-группе, и GCC не даёт
+// смешать его в одной секции с объектами пользователя (section type conflict)
+inline SemaphoreHandle_t lockHandle() {
+    static StaticSemaphore_t buffer;
+    static SemaphoreHandle_t handle = xSemaphoreCreateMutexStatic(&buffer);
+    return handle;
+}
+
+struct Lock {
+    Lock() {
+        xSemaphoreTake(lockHandle(), portMAX_DELAY);
+    }
+    ~Lock() {
+        xSemaphoreGive(lockHandle());
+    }
+    Lock(const Lock&)            = delete;
+    Lock& operator=(const Lock&) = delete;
+};
+
+}  // namespace detail
+
+class ChannelBase {
+  public:
+    ChannelBase() = default;
+
+    virtual ~ChannelBase() {
+        configASSERT(senders == nullptr && receivers == nullptr);
+    }
+
+    ChannelBase(const ChannelBase&)            = delete;
+    ChannelBase& operator=(const ChannelBase&) = delete;
+
+    // Закрыть канал и разбудить всех ждущих
+    void close() {
+        detail::Lock lock;
+        closed = true;
+        while (Case* c = pop(receivers)) finish(c, false);
+        while (Case* c = pop(senders)) finish(c, false);
+    }
+
+    bool isClosed() const {
+        detail::Lock lock;
+        return closed;
+    }
+
+  protected:
+    bool closed = false;
+
+    // Под замком: выполнить операцию без ожидания
+    virtual Result trySend(const void* src) = 0;
+    virtual Result tryRecv(void* dst)       = 0;
+
+    // Очереди ждущих: элементы — варианты select
+    Case* senders   = nullptr;
+    Case* receivers = nullptr;
+
+    static Case* pop(Case*& head) {
+        Case* c = head;
+        if (c) head = c->next;
+        return c;
+    }
+
+    static void append(Case*& head, Case* c) {
+        c->next = nullptr;
+        Case** p = &head;
+        while (*p) p = &(*p)->next;
+        *p = c;
+    }
+
+    static void unlink(Case*& head, Case* c) {
+        for (Case** p = &head; *p; p = &(*p)->next) {
+            if (*p == c) {
+                *p = c->next;
+                return;
+            }
+        }
+    }
+
+    // Операция ждущей задачи выполнена: снять остальные её варианты и разбудить.
+    // После fired ждущий может выйти из select() по таймауту, не беря замок, и его Waiter
+    // на стеке уже не существует — задачу читаем до публикации.
+    static void finish(Case* c, bool ok) {
+        Waiter* w = c->waiter;
+        if (c->ok) *c->ok = ok;
+        for (size_t i = 0; i < w->count; ++i) w->cases[i].ch->dequeue(&w->cases[i]);
+        TaskHandle_t task = w->task;
+        w->fired.store(static_cast<int>(c - w->cases), std::memory_order_release);
+        notify::library::give(task);
+    }
+
+    void enqueue(Case* c) {
+        append(c->isSend ? senders : receivers, c);
+    }
+
+    void dequeue(Case* c) {
+        unlink(c->isSend ? senders : receivers, c);
+    }
+
+    friend int select(std::initializer_list<Case> cases, uint32_t ms);
+};
+
+// Выполнить ровно одну готовую операцию, ожидая до ms. Возвращает номер варианта или -1.
+inline int select(std::initializer_list<Case> cases, uint32_t ms) {
+    configASSERT(cases.size() > 0 && cases.size() <= FREERTOS_CPP_SELECT_MAX_CASES);
+    Case   own[FREERTOS_CPP_SELECT_MAX_CASES];
+    size_t n = 0;
+    for (const Case& c : cases) own[n++] = c;
+
+    Waiter w;
+    w.task  = xTaskGetCurrentTaskHandle();
+    w.cases = own;
+    w.count = n;
+    {
+        detail::Lock lock;
+        for (size_t i = 0; i < n; ++i) {
+            Case&  c = own[i];
+            Result r = c.isSend ? c.ch->trySend(c.data) : c.ch->tryRecv(c.data);
+            if (r == Result::WouldBlock) continue;
+            if (c.ok) *c.ok = r == Result::Done;
+            return static_cast<int>(i);
+        }
+        if (ms == 0) return -1;
+        for (size_t i = 0; i < n; ++i) {
+            own[i].waiter = &w;
+            own[i].ch->enqueue(&own[i]);
+        }
+    }
+
+    const TickType_t start = xTaskGetTickCount();
+    const TickType_t limit = pdMS_TO_TICKS(ms);
+    while (w.fired.load(std::memory_order_acquire) < 0) {
+        const TickType_t spent = xTaskGetTickCount() - start;
+        if (spent >= limit) break;
+        notify::library::take(limit - spent);
+    }
+    if (w.fired.load(std::memory_order_acquire) < 0) {
+        detail::Lock lock;
+        if (w.fired.load(std::memory_order_relaxed) < 0) {
+            for (size_t i = 0; i < n; ++i) own[i].ch->dequeue(&own[i]);
+            return -1;
+        }
+    }
+    return w.fired.load(std::memory_order_acquire);
+}
+
+}  // namespace channel
+
+template <typename T, size_t Capacity = 0>
+class Channel : public channel::ChannelBase {
+  public:
+    Channel() = default;
+
+    // Отправить, ожидая места или получателя до ms. false — таймаут или канал закрыт.
+    bool send(const T& item, uint32_t ms = 0) {
+        bool ok = false;
+        return channel::select({sendCase(item, &ok)}, ms) == 0 && ok;
+    }
+
+    // Получить до ms. false — таймаут или канал закрыт и пуст.
+    bool receive(T& item, uint32_t ms = 0) {
+        bool ok = false;
+        return channel::select({recvCase(item, &ok)}, ms) == 0 && ok;
+    }
+
+    // Элементов в буфере (для рандеву всегда 0)
+    size_t size() const {
+        channel::detail::Lock lock;
+        return count;
+    }
+
+    static constexpr size_t capacity() {
+        return Capacity;
+    }
+
+    channel::Case sendCase(const T& item, bool* ok = nullptr) {
+        return {this, true, const_cast<T*>(&item), ok, nullptr, nullptr};
+    }
+
+    channel::Case recvCase(T& item, bool* ok = nullptr) {
+        return {this, false, &item, ok, nullptr, nullptr};
+    }
+
+  protected:
+    channel::Result trySend(const void* src) override {
+        const T& item = *static_cast<const T*>(src);
+        if (closed) return channel::Result::Closed;
+        if (Case* r = pop(receivers)) {
+            *static_cast<T*>(r->data) = item;  // прямо в переменную получателя
+            finish(r, true);
+            return channel::Result::Done;
+        }
+        if (count < Capacity) {
+            buffer[(head + count) % slots()] = item;
+            ++count;
+            return channel::Result::Done;
+        }
+        return channel::Result::WouldBlock;
+    }
+
+    channel::Result tryRecv(void* dst) override {
+        T& item = *static_cast<T*>(dst);
+        if (count > 0) {
+            item = buffer[head];
+            head = (head + 1) % slots();
+            --count;
+            // Освободилось место — принять ждущего отправителя
+            if (Case* s = pop(senders)) {
+                buffer[(head + count) % slots()] = *static_cast<const T*>(s->data);
+                ++count;
+                finish(s, true);
+            }
+            return channel::Result::Done;
+        }
+        if (Case* s = pop(senders)) {
+            item = *static_cast<const T*>(s->data);  // рандеву: прямо из переменной отправителя
+            finish(s, true);
+            return channel::Result::Done;
+        }
+        return closed ? channel::Result::Closed : channel::Result::WouldBlock;
+    }
+
+  private:
+    using Case = channel::Case;
+
+    static constexpr size_t slots() {
+        return Capacity ? Capacity : 1;
+    }
+
+    std::array<T, Capacity> buffer{};
+    size_t                  head  = 0;
+    size_t                  count = 0;
+};
+
+namespace channel {
+
+// Варианты для select
+template <typename T, size_t Capacity>
+Case send(Channel<T, Capacity>& ch, const T& item, bool* ok = nullptr) {
+    return ch.sendCase(item, ok);
+}
+
+template <typename T, size_t Capacity>
+Case recv(Channel<T, Capacity>& ch, T& item, bool* ok = nullptr) {
+    return ch.recvCase(item, ok);
+}
+
+}  // namespace channel
+
+#endif  // CHANNEL_H
+
+/*
+Channel<Packet>     uplink;  // рандеву: отправитель ждёт, пока маршрутизатор заберёт
+Channel<Packet, 8>  downlink;
+Channel<Command, 4> control;
+
+void routerTask(void*) {
+    Packet  in;
+    Command cmd;
+    bool    ok;
+    for (;;) {
+        // Новый пакет или команда — что придёт раньше
+        switch (channel::select({channel::recv(uplink, in, &ok), channel::recv(control, cmd, &ok)}, 100)) {
+            case 0:
+                if (!ok) return;  // uplink закрыт и пуст — выходим
+                downlink.send(route(in), 10);
+                break;
+            case 1:
+                apply(cmd);
+                break;
+            default:  // таймаут
+                break;
+        }
+    }
+}
+
+// Остановка: потребители дочитывают буфер и получают false
+uplink.close();
+*/
@@ -0,0 +1,445 @@
+#ifndef COMPRESSED_CHANNEL_H
+#define COMPRESSED_CHANNEL_H
+
+// Канал телеметрии со сжатием: образцы из медленно меняющихся целых полей
+// (отсчёты АЦП, счётчики, метки времени) идут через потоковый буфер не копией
+// структуры, а кадром из разностей.
+//
+// Кадр — varint-заголовок (длина << 1 | ключевой) и по varint на каждое поле из
+// списка Fields (массивы — поэлементно). В разностном кадре поле кодируется как
+// zigzag(текущее − предыдущее) в разрядности поля, в ключевом — само значение.
+// Разность в ±63 занимает один байт, поэтому 16-байтный образец обычно сжимается
+// до 4–6 байт.
+//
+// Ключевой кадр идёт первым, раз в keyframeInterval кадров и после каждой потери:
+// не поместившийся кадр не пишется вовсе (потоковый буфер не умеет «всё или
+// ничего», поэтому send() не ждёт), а следующий за ним будет ключевым. Поток в
+// буфере всегда декодируется целиком; периодические ключевые кадры нужны тем,
+// кто пересылает байты дальше (receiveEncoded) по каналу с потерями: удалённый
+// compress::Decoder пропускает разностные кадры до ближайшего ключевого.
+//
+// Один производитель и один потребитель, как у потокового буфера ядра.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/stream_buffer.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#if !configSUPPORT_STATIC_ALLOCATION
+#error "CompressedChannel requires configSUPPORT_STATIC_ALLOCATION"
+#endif
+
+namespace compress {
+
+// Счётчики канала с момента создания
+struct Stats {
+    uint32_t sent;          // образцов записано в буфер
+    uint32_t dropped;       // не поместилось в буфер
+    uint32_t keyframes;     // из записанных — ключевых
+    uint32_t received;      // образцов декодировано
+    uint32_t rawBytes;      // sent * sizeof(T)
+    uint32_t encodedBytes;  // байт кадров записано
+
+    // Во сколько раз кадры короче исходных структур
+    float ratio() const {
+        return encodedBytes ? static_cast<float>(rawBytes) / static_cast<float>(encodedBytes) : 0.0f;
+    }
+};
+
+enum class Status : uint8_t {
+    Sample,      // кадр декодирован
+    Skipped,     // разностный кадр до первого ключевого — пропущен
+    Incomplete,  // кадр ещё не пришёл целиком, нужны байты
+    Corrupt      // мусор в потоке: пропущен, ждём ключевой кадр
+};
+
+inline uint64_t zigzag(int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t unzigzag(uint64_t z) {
+    return static_cast<int64_t>(z >> 1) ^ -static_cast<int64_t>(z & 1);
+}
+
+constexpr size_t varintSize(uint64_t v) {
+    size_t n = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        ++n;
+    }
+    return n;
+}
+
+inline size_t putVarint(uint8_t* p, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = static_cast<uint8_t>(v) | 0x80;
+        v >>= 7;
+    }
+    p[n++] = static_cast<uint8_t>(v);
+    return n;
+}
+
+// Прочитать varint из [p, end). 0 — число оборвалось или длиннее 10 байт.
+inline size_t getVarint(const uint8_t* p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (size_t n = 0; n < 10 && p + n < end; ++n) {
+        v |= static_cast<uint64_t>(p[n] & 0x7F) << (7 * n);
+        if (!(p[n] & 0x80)) return n + 1;
+    }
+    return 0;
+}
+
+namespace detail {
+
+template <typename M>
+struct MemberOf;
+
+template <typename C, typename F>
+struct MemberOf<F C::*> {
+    using type = F;
+};
+
+// Поле или массив полей: разрядность, кодирование одного значения
+template <typename F>
+struct Field {
+    static_assert(std::is_integral<F>::value && !std::is_same<F, bool>::value,
+                  "CompressedChannel fields must be integers (scale floats to fixed point)");
+    using U = typename std::make_unsigned<F>::type;
+    using S = typename std::make_signed<F>::type;
+
+    static constexpr size_t maxBytes = (sizeof(F) * 8 + 6) / 7;
+
+    static void put(const F& cur, const F& prev, bool key, uint8_t*& p) {
+        // Разность по модулю 2^bits: переполнение счётчика — маленькая разность
+        const U diff = key ? static_cast<U>(cur) : static_cast<U>(static_cast<U>(cur) - static_cast<U>(prev));
+        p += putVarint(p, zigzag(static_cast<S>(diff)));
+    }
+
+    static bool get(F& value, bool key, const uint8_t*& p, const uint8_t* end) {
+        uint64_t     z = 0;
+        const size_t n = getVarint(p, end, z);
+        if (n == 0) return false;
+        p += n;
+        const U diff = static_cast<U>(static_cast<S>(unzigzag(z)));
+        value        = static_cast<F>(key ? diff : static_cast<U>(static_cast<U>(value) + diff));
+        return true;
+    }
+};
+
+template <typename F, size_t N>
+struct Field<F[N]> {
+    static constexpr size_t maxBytes = N * Field<F>::maxBytes;
+
+    static void put(const F (&cur)[N], const F (&prev)[N], bool key, uint8_t*& p) {
+        for (size_t i = 0; i < N; ++i) Field<F>::put(cur[i], prev[i], key, p);
+    }
+
+    static bool get(F (&value)[N], bool key, const uint8_t*& p, const uint8_t* end) {
+        for (size_t i = 0; i < N; ++i) {
+            if (!Field<F>::get(value[i], key, p, end)) return false;
+        }
+        return true;
+    }
+};
+
+// Список полей образца; пустой — образец сам целое число
+template <typename T, auto... Fields>
+struct Layout {
+    static constexpr size_t maxPayload = (Field<typename MemberOf<decltype(Fields)>::type>::maxBytes + ...);
+
+    static void put(const T& cur, const T& prev, bool key, uint8_t*& p) {
+        (Field<typename MemberOf<decltype(Fields)>::type>::put(cur.*Fields, prev.*Fields, key, p), ...);
+    }
+
+    static bool get(T& value, bool key, const uint8_t*& p, const uint8_t* end) {
+        return (Field<typename MemberOf<decltype(Fields)>::type>::get(value.*Fields, key, p, end) && ...);
+    }
+};
+
+template <typename T>
+struct Layout<T> {
+    static constexpr size_t maxPayload = Field<T>::maxBytes;
+
+    static void put(const T& cur, const T& prev, bool key, uint8_t*& p) {
+        Field<T>::put(cur, prev, key, p);
+    }
+
+    static bool get(T& value, bool key, const uint8_t*& p, const uint8_t* end) {
+        return Field<T>::get(value, key, p, end);
+    }
+};
+
+}  // namespace detail
+
+// Кодировщик: хранит предыдущий образец и счётчик до ключевого кадра
+template <typename T, auto... Fields>
+class Encoder {
+    static_assert(std::is_trivially_copyable<T>::value, "CompressedChannel samples must be trivially copyable");
+    using Layout = detail::Layout<T, Fields...>;
+
+  public:
+    static constexpr size_t MaxPayload = Layout::maxPayload;
+    static constexpr size_t MaxHeader  = varintSize(MaxPayload << 1 | 1);
+    static constexpr size_t MaxFrame   = MaxHeader + MaxPayload;
+
+    // keyframeInterval — каждый N-й кадр ключевой; 0 — только первый и после потерь
+    explicit Encoder(uint32_t keyframeInterval = 32) : interval(keyframeInterval) {}
+
+    // Следующий кадр будет ключевым
+    void resync() {
+        due = true;
+    }
+
+    bool keyframeDue() const {
+        return due || (interval != 0 && sinceKey + 1 >= interval);
+    }
+
+    // Записать кадр образца в out (не меньше MaxFrame байт), вернуть его длину
+    size_t encode(const T& sample, uint8_t* out) {
+        const bool key = keyframeDue();
+        uint8_t    payload[MaxPayload];
+        uint8_t*   p = payload;
+        Layout::put(sample, prev, key, p);
+        const size_t len    = static_cast<size_t>(p - payload);
+        const size_t header = putVarint(out, static_cast<uint64_t>(len) << 1 | (key ? 1 : 0));
+        std::memcpy(out + header, payload, len);
+        prev     = sample;
+        sinceKey = key ? 0 : sinceKey + 1;
+        due      = false;
+        return header + len;
+    }
+
+  private:
+    T        prev{};
+    uint32_t interval;
+    uint32_t sinceKey = 0;
+    bool     due      = true;
+};
+
+// Декодировщик: до первого ключевого кадра разностные пропускает
+template <typename T, auto... Fields>
+class Decoder {
+    using Layout = detail::Layout<T, Fields...>;
+
+  public:
+    static constexpr size_t MaxPayload = Encoder<T, Fields...>::MaxPayload;
+    static constexpr size_t MaxHeader  = Encoder<T, Fields...>::MaxHeader;
+
+    // Потеряли байты потока: ждать ключевой кадр
+    void resync() {
+        synced = false;
+    }
+
+    bool inSync() const {
+        return synced;
+    }
+
+    // Разобрать кадр в начале [in, in + n). used — сколько байт он занял
+    // (0 при Incomplete); out заполняется только при Sample.
+    Status decode(const uint8_t* in, size_t n, T& out, size_t& used) {
+        used                = 0;
+        const uint8_t* end  = in + n;
+        uint64_t       head = 0;
+        const size_t   hn   = getVarint(in, end, head);
+        if (hn == 0) {
+            if (n < MaxHeader) return Status::Incomplete;
+            return corrupt(used, 1);
+        }
+        const uint64_t len = head >> 1;
+        const bool     key = head & 1;
+        if (len > MaxPayload) return corrupt(used, 1);
+        if (n < hn + len) return Status::Incomplete;
+        used = hn + static_cast<size_t>(len);
+        if (!key && !synced) return Status::Skipped;
+
+        // Разбор в копию: испорченный кадр не трогает опорный образец
+        T              next = prev;
+        const uint8_t* p    = in + hn;
+        if (!Layout::get(next, key, p, in + used) || p != in + used) return corrupt(used, used);
+        prev   = next;
+        synced = true;
+        out    = next;
+        return Status::Sample;
+    }
+
+  private:
+    T    prev{};
+    bool synced = false;
+
+    Status corrupt(size_t& used, size_t skip) {
+        used   = skip;
+        synced = false;
+        return Status::Corrupt;
+    }
+};
+
+}  // namespace compress
+
+// Bytes — размер потокового буфера. Fields — указатели на целые поля T (или
+// массивы целых); без них T само должно быть целым.
+template <typename T, size_t Bytes, auto... Fields>
+class CompressedChannel {
+    using Codec = compress::Encoder<T, Fields...>;
+
+  public:
+    static constexpr size_t MaxFrame = Codec::MaxFrame;
+    static_assert(Bytes >= MaxFrame, "CompressedChannel buffer must hold at least one frame");
+
+    explicit CompressedChannel(uint32_t keyframeInterval = 32) : encoder(keyframeInterval) {
+        buffer = xStreamBufferCreateStatic(Bytes, 1, storage, &control);
+        if (buffer == nullptr) {
+            configASSERT(false && "Failed to create compressed channel");
+            abort();
+        }
+    }
+
+    ~CompressedChannel() {
+        vStreamBufferDelete(buffer);
+    }
+
+    CompressedChannel(const CompressedChannel&)            = delete;
+    CompressedChannel& operator=(const CompressedChannel&) = delete;
+
+    // Закодировать и записать образец. Не ждёт: нет места под кадр — образец
+    // потерян (dropped), следующий уйдёт ключевым кадром.
+    bool send(const T& sample) {
+        uint8_t      frame[MaxFrame];
+        const bool   key = encoder.keyframeDue();
+        const size_t len = encoder.encode(sample, frame);
+        if (xStreamBufferSpacesAvailable(buffer) < len) return drop();
+        xStreamBufferSend(buffer, frame, len, 0);
+        return sentFrame(len, key);
+    }
+
+    bool sendFromISR(const T& sample, BaseType_t* pxHigherPriorityTaskWoken) {
+        uint8_t      frame[MaxFrame];
+        const bool   key = encoder.keyframeDue();
+        const size_t len = encoder.encode(sample, frame);
+        if (xStreamBufferSpacesAvailable(buffer) < len) return drop();
+        xStreamBufferSendFromISR(buffer, frame, len, pxHigherPriorityTaskWoken);
+        return sentFrame(len, key);
+    }
+
+    // Взять и декодировать образец, ожидая до ms
+    bool receive(T& sample, uint32_t ms = 0) {
+        const TickType_t start = xTaskGetTickCount();
+        const TickType_t limit = pdMS_TO_TICKS(ms);
+        for (;;) {
+            while (pos < have) {
+                size_t                 used = 0;
+                const compress::Status s    = decoder.decode(stage + pos, have - pos, sample, used);
+                if (s == compress::Status::Incomplete) break;
+                pos += used;
+                if (s == compress::Status::Sample) {
+                    counters.received.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            // Остаток кадра — в начало, дочитать из буфера
+            std::memmove(stage, stage + pos, have - pos);
+            have -= pos;
+            pos = 0;
+            const TickType_t spent = xTaskGetTickCount() - start;
+            const size_t     got =
+                xStreamBufferReceive(buffer, stage + have, sizeof(stage) - have, spent < limit ? limit - spent : 0);
+            if (got == 0) return false;
+            have += got;
+        }
+    }
+
+    // Забрать закодированные байты как есть, ожидая до ms — например, для отправки
+    // по радио; на той стороне их разбирает compress::Decoder<T, Fields...>.
+    // Не смешивать с receive(): кадр может оказаться разрезан между ними.
+    size_t receiveEncoded(void* dst, size_t max, uint32_t ms = 0) {
+        return xStreamBufferReceive(buffer, dst, max, pdMS_TO_TICKS(ms));
+    }
+
+    size_t bytesAvailable() const {
+        return xStreamBufferBytesAvailable(buffer);
+    }
+
+    compress::Stats stats() const {
+        return compress::Stats{counters.sent.load(std::memory_order_relaxed),
+                               counters.dropped.load(std::memory_order_relaxed),
+                               counters.keyframes.load(std::memory_order_relaxed),
+                               counters.received.load(std::memory_order_relaxed),
+                               counters.rawBytes.load(std::memory_order_relaxed),
+                               counters.encodedBytes.load(std::memory_order_relaxed)};
+    }
+
+    // Всё внутри объекта: буфер, управляющий блок, буфер разбора
+    static constexpr size_t footprint() {
+        return sizeof(CompressedChannel);
+    }
+
+  private:
+    StreamBufferHandle_t            buffer = nullptr;
+    uint8_t                         storage[Bytes + 1];  // ядру нужен байт сверх размера
+    StaticStreamBuffer_t            control;
+    Codec                           encoder;
+    compress::Decoder<T, Fields...> decoder;
+    uint8_t                         stage[MaxFrame * 4];  // несколько кадров за одно обращение к буферу
+    size_t                          have = 0;
+    size_t                          pos  = 0;
+
+    struct {
+        std::atomic<uint32_t> sent{0};
+        std::atomic<uint32_t> dropped{0};
+        std::atomic<uint32_t> keyframes{0};
+        std::atomic<uint32_t> received{0};
+        std::atomic<uint32_t> rawBytes{0};
+        std::atomic<uint32_t> encodedBytes{0};
+    } counters;
+
+    bool drop() {
+        encoder.resync();
+        counters.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool sentFrame(size_t len, bool key) {
+        counters.sent.fetch_add(1, std::memory_order_relaxed);
+        if (key) counters.keyframes.fetch_add(1, std::memory_order_relaxed);
+        counters.rawBytes.fetch_add(sizeof(T), std::memory_order_relaxed);
+        counters.encodedBytes.fetch_add(static_cast<uint32_t>(len), std::memory_order_relaxed);
+        return true;
+    }
+};
+
+#endif  // COMPRESSED_CHANNEL_H
+
+/*
+struct Imu {
+    uint32_t time;      // мкс, растёт ровно
+    int16_t  accel[3];  // медленно плывёт
+    int16_t  gyro[3];
+};
+
+CompressedChannel<Imu, 1024, &Imu::time, &Imu::accel, &Imu::gyro> imu(64);  // ключевой — раз в 64
+
+// Задача опроса датчика
+Imu s = readImu();
+imu.send(s);
+
+// Потребитель
+Imu r;
+if (imu.receive(r, 100)) process(r);
+
+// Или переслать байты по радио как есть и разобрать на земле
+uint8_t packet[64];
+size_t  n = imu.receiveEncoded(packet, sizeof(packet), 100);
+radio.send(packet, n);
+
+// На земле: пропал пакет — decoder.resync(), дальше с ближайшего ключевого кадра
+compress::Decoder<Imu, &Imu::time, &Imu::accel, &Imu::gyro> decoder;
+*/
@@ -0,0 +1,158 @@
+#ifndef DOORBELL_H
+#define DOORBELL_H
+
+// Дверной звонок: как одна сторона SharedMemChannel будит другую, если та ждёт.
+//
+// Ожидающая сторона зовёт arm(), ещё раз проверяет условие и только потом wait(token, ms):
+// звонок между arm() и wait() не теряется. ring() зовёт другая сторона — в другом ядре
+// или процессе, поэтому у каждой стороны свой объект-звонок над общим ресурсом.
+//
+// IrqDoorbell — на целевой платформе: ring() поднимает межъядерное (программное)
+// прерывание через функцию пользователя, обработчик прерывания на принимающем ядре
+// зовёт signalFromISR(), а wait() спит на уведомлении задачи (индекс библиотеки,
+// NotifyIndex.h).
+//
+// На Linux (хост, POSIX-порт, симулятор):
+//   EventFdDoorbell — eventfd, унаследованный обоими процессами;
+//   FutexDoorbell   — futex на 32-битном слове в общей памяти.
+// Ожидание на хосте — системный вызов: нить задачи спит в ядре ОС.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "NotifyIndex.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstdint>
+
+class Doorbell {
+  public:
+    virtual ~Doorbell() = default;
+
+    // Разбудить ожидающего на другой стороне
+    virtual void ring() = 0;
+
+    // Подготовиться к ожиданию; результат передать в wait()
+    virtual uint32_t arm() {
+        return 0;
+    }
+
+    // Ждать звонка до ms. false — таймаут. Возможны ложные пробуждения.
+    virtual bool wait(uint32_t token, uint32_t ms) = 0;
+};
+
+// Межъядерное прерывание: raise(arg) поднимает его на другом ядре
+class IrqDoorbell : public Doorbell {
+  public:
+    using RaiseFn = void (*)(void* arg);
+
+    IrqDoorbell(RaiseFn raise, void* arg) : raiseFn(raise), raiseArg(arg) {}
+
+    void ring() override {
+        raiseFn(raiseArg);
+    }
+
+    uint32_t arm() override {
+        waiter.store(xTaskGetCurrentTaskHandle(), std::memory_order_release);
+        return 0;
+    }
+
+    bool wait(uint32_t, uint32_t ms) override {
+        const bool woke = notify::library::take(pdMS_TO_TICKS(ms)) > 0;
+        waiter.store(nullptr, std::memory_order_relaxed);
+        return woke;
+    }
+
+    // Из обработчика прерывания на этом ядре
+    void signalFromISR(BaseType_t* pxHigherPriorityTaskWoken) {
+        if (TaskHandle_t w = waiter.load(std::memory_order_acquire)) notify::library::giveFromISR(w, pxHigherPriorityTaskWoken);
+    }
+
+    // Из задачи — когда «прерывание» обрабатывается в задаче или обе стороны в одном образе
+    void signal() {
+        if (TaskHandle_t w = waiter.load(std::memory_order_acquire)) notify::library::give(w);
+    }
+
+  private:
+    RaiseFn                   raiseFn;
+    void*                     raiseArg;
+    std::atomic<TaskHandle_t> waiter{nullptr};
+};
+
+#if defined(__linux__) && !defined(ESP_PLATFORM)
+
+#include <climits>
+#include <linux/futex.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// eventfd: счётчик в ядре ОС, звонок до wait() не теряется и без arm()
+class EventFdDoorbell : public Doorbell {
+  public:
+    explicit EventFdDoorbell(int fd) : fd(fd) {}
+
+    void ring() override {
+        const uint64_t one = 1;
+        (void)!::write(fd, &one, sizeof(one));
+    }
+
+    bool wait(uint32_t, uint32_t ms) override {
+        pollfd p{fd, POLLIN, 0};
+        if (::poll(&p, 1, ms > INT_MAX ? -1 : static_cast<int>(ms)) <= 0) return false;
+        uint64_t count = 0;
+        return ::read(fd, &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count));
+    }
+
+  private:
+    int fd;
+};
+
+// futex: звонок увеличивает слово и будит; arm() запоминает его значение
+class FutexDoorbell : public Doorbell {
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be a plain 32-bit word");
+
+  public:
+    explicit FutexDoorbell(std::atomic<uint32_t>* word) : word(word) {}
+
+    void ring() override {
+        word->fetch_add(1, std::memory_order_release);
+        ::syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    uint32_t arm() override {
+        return word->load(std::memory_order_acquire);
+    }
+
+    bool wait(uint32_t token, uint32_t ms) override {
+        timespec timeout{static_cast<time_t>(ms / 1000), static_cast<long>(ms % 1000) * 1000000L};
+        ::syscall(SYS_futex, word, FUTEX_WAIT, token, &timeout, nullptr, 0);
+        return word->load(std::memory_order_acquire) != token;
+    }
+
+  private:
+    std::atomic<uint32_t>* word;
+};
+
+#endif
+
+#endif  // DOORBELL_H
+
+/*
+// Два образа FreeRTOS на двух ядрах: raiseIpi() платформы — запись в регистр мейлбокса,
+// программное прерывание другого ядра и т.п.
+IrqDoorbell bell([](void*) { raiseIpi(OTHER_CORE); }, nullptr);
+
+void ipiHandler() {  // обработчик на этом ядре
+    BaseType_t woken = pdFALSE;
+    bell.signalFromISR(&woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// Linux: eventfd, унаследованный дочерним процессом
+int             efd = eventfd(0, 0);
+EventFdDoorbell bell(efd);
+*/
@@ -0,0 +1,324 @@
+#ifndef EDF_SCHEDULER_H
+#define EDF_SCHEDULER_H
+
+// Планирование по ближайшему сроку (EDF) поверх фиксированных приоритетов FreeRTOS.
+//
+// Задачи добавляются через add() с периодом, относительным сроком и оценкой времени
+// работы (WCET). Служебная задача-диспетчер (приоритет выше всей полосы) выпускает
+// задания по периодам: на каждом выпуске активные задания сортируются по абсолютному
+// сроку, и приоритеты полосы [base, base + levels) раздаются заново — ближайший срок
+// получает старший. Все vTaskPrioritySet() одного выпуска выполняются пакетом при
+// остановленном планировщике (vTaskSuspendAll), так что промежуточный порядок никто не видит.
+// Если активных заданий больше, чем уровней, самые поздние делят нижний уровень.
+//
+// Приём (admission): add() отказывает, если суммарная плотность Σ WCET / min(D, P)
+// превысит предел (по умолчанию 100%). Для D == P это точный критерий EDF (U <= 1),
+// для D < P — достаточный.
+//
+// Задание, не закончившееся к своему сроку, считается в misses; выпуск, пришедшийся на
+// ещё работающее задание, пропускается и считается в skipped.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "Footprint.h"
+#include "InplaceFunction.h"
+#include "NotifyIndex.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace edf {
+
+struct TaskStats {
+    uint32_t jobs;           // заданий выполнено
+    uint32_t misses;         // закончились позже срока
+    uint32_t skipped;        // выпусков пропущено: предыдущее задание ещё работало
+    uint32_t worstResponse;  // наибольшее время отклика, тиков
+};
+
+}  // namespace edf
+
+template <size_t MaxTasks = 8>
+class EdfScheduler {
+  public:
+    using Function = void (*)(void*);
+    using Job      = InplaceFunction<void()>;
+
+    // Полоса приоритетов задач: [basePriority, basePriority + levels), диспетчер — над ней
+    explicit EdfScheduler(UBaseType_t basePriority, UBaseType_t levels = MaxTasks,
+                          uint32_t densityLimit = 10000)
+        : base(basePriority), levels(levels), limit(densityLimit) {
+        configASSERT(levels > 0 && basePriority + levels < configMAX_PRIORITIES);
+    }
+
+    ~EdfScheduler() {
+        stop();
+    }
+
+    EdfScheduler(const EdfScheduler&)            = delete;
+    EdfScheduler& operator=(const EdfScheduler&) = delete;
+
+    // Добавить задачу до start(). Номер задачи или -1: не прошла тест приёма, нет места.
+    int add(Job job, const char* name, uint32_t periodMs, uint32_t deadlineMs, uint32_t wcetUs,
+            uint32_t stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        if (started || count == MaxTasks || !job || periodMs == 0) return -1;
+        if (deadlineMs == 0 || deadlineMs > periodMs) deadlineMs = periodMs;
+        const uint32_t d = density(deadlineMs, wcetUs);
+        if (load + d > limit) return -1;
+
+        Entry& j   = entries[count];
+        j.job      = job;
+        j.name     = name;
+        j.period   = pdMS_TO_TICKS(periodMs);
+        j.deadline = pdMS_TO_TICKS(deadlineMs);
+        j.stack    = stackDepth;
+        configASSERT(j.period > 0 && j.deadline > 0);
+        load += d;
+        return static_cast<int>(count++);
+    }
+
+    int add(Function fn, void* ctx, const char* name, uint32_t periodMs, uint32_t deadlineMs, uint32_t wcetUs,
+            uint32_t stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        if (!fn) return -1;
+        return add([fn, ctx] { fn(ctx); }, name, periodMs, deadlineMs, wcetUs, stackDepth);
+    }
+
+    // Прошла бы задача тест приёма вместе с уже добавленными
+    bool admits(uint32_t periodMs, uint32_t deadlineMs, uint32_t wcetUs) const {
+        if (deadlineMs == 0 || deadlineMs > periodMs) deadlineMs = periodMs;
+        return periodMs && load + density(deadlineMs, wcetUs) <= limit;
+    }
+
+    // Суммарная плотность добавленных задач, сотые доли процента
+    uint32_t density() const {
+        return load;
+    }
+
+    // Создать задачи и диспетчер; первые задания выпускаются сразу
+    bool start(const char* name = "edf") {
+        if (started || count == 0) return false;
+        for (size_t i = 0; i < count; ++i) {
+            entries[i].owner    = this;
+            entries[i].priority = base;
+            if (xTaskCreate(body, entries[i].name, entries[i].stack, &entries[i], base, &entries[i].handle) != pdPASS) {
+                stop();
+                return false;
+            }
+        }
+        started = true;
+        if (xTaskCreate(run, name, configMINIMAL_STACK_SIZE * 2, this, base + levels, &dispatcher) != pdPASS) {
+            stop();
+            return false;
+        }
+        return true;
+    }
+
+    void stop() {
+        if (dispatcher) vTaskDelete(dispatcher);
+        dispatcher = nullptr;
+        for (size_t i = 0; i < count; ++i) {
+            if (entries[i].handle) vTaskDelete(entries[i].handle);
+            entries[i].handle = nullptr;
+        }
+        started = false;
+    }
+
+    edf::TaskStats stats(int id) {
+        configASSERT(id >= 0 && static_cast<size_t>(id) < count);
+        lock();
+        edf::TaskStats s = entries[id].stats;
+        unlock();
+        return s;
+    }
+
+    TaskHandle_t handle(int id) const {
+        return id >= 0 && static_cast<size_t>(id) < count ? entries[id].handle : nullptr;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    // RAM при всех MaxTasks задачах со стеком stackDepth: объект, задачи и диспетчер
+    static constexpr size_t footprint(size_t stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        return sizeof(EdfScheduler) + MaxTasks * ::footprint::task(stackDepth) +
+               ::footprint::task(configMINIMAL_STACK_SIZE * 2);
+    }
+
+  private:
+    struct Entry {
+        Job            job;
+        const char*    name     = nullptr;
+        TickType_t     period   = 0;
+        TickType_t     deadline = 0;
+        uint32_t       stack    = 0;
+        TaskHandle_t   handle   = nullptr;
+        EdfScheduler*  owner    = nullptr;
+        UBaseType_t    priority = 0;
+        TickType_t     release  = 0;  // выпуск текущего задания
+        TickType_t     due      = 0;  // его абсолютный срок
+        TickType_t     next     = 0;  // следующий выпуск
+        bool           active   = false;
+        bool           pending  = false;  // выпущено, но задача ещё не начала
+        edf::TaskStats stats    = {};
+    };
+
+    Entry        entries[MaxTasks];
+    size_t       count = 0;
+    UBaseType_t  base;
+    UBaseType_t  levels;
+    uint32_t     limit;
+    uint32_t     load       = 0;
+    bool         started    = false;
+    TaskHandle_t dispatcher = nullptr;
+#ifdef ESP_PLATFORM
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+    // WCET / D в сотых долях процента, с округлением вверх
+    static uint32_t density(uint32_t deadlineMs, uint32_t wcetUs) {
+        return static_cast<uint32_t>((static_cast<uint64_t>(wcetUs) * 10 + deadlineMs - 1) / deadlineMs);
+    }
+
+    static bool reached(TickType_t now, TickType_t t) {
+        return static_cast<int32_t>(now - t) >= 0;
+    }
+
+    // Уведомление — только повод проверить pending: задание могло оставить после себя
+    // чужое уведомление (например, от Channel или TripleBuffer), и это не выпуск
+    static void body(void* arg) {
+        Entry& j = *static_cast<Entry*>(arg);
+        for (;;) {
+            notify::library::take(portMAX_DELAY);
+            if (!j.owner->take(j)) continue;
+            j.job();
+            j.owner->complete(j);
+        }
+    }
+
+    bool take(Entry& j) {
+        lock();
+        const bool released = j.pending;
+        j.pending           = false;
+        unlock();
+        return released;
+    }
+
+    void complete(Entry& j) {
+        const TickType_t now = xTaskGetTickCount();
+        lock();
+        const TickType_t response = now - j.release;
+        ++j.stats.jobs;
+        if (!reached(j.due, now)) ++j.stats.misses;  // с точностью до тика
+        if (response > j.stats.worstResponse) j.stats.worstResponse = response;
+        j.active = false;
+        unlock();
+    }
+
+    static void run(void* arg) {
+        static_cast<EdfScheduler*>(arg)->dispatch();
+    }
+
+    void dispatch() {
+        const TickType_t start = xTaskGetTickCount();
+        for (size_t i = 0; i < count; ++i) entries[i].next = start;
+
+        for (;;) {
+            const TickType_t now      = xTaskGetTickCount();
+            Entry*           released[MaxTasks];
+            size_t           nReleased = 0;
+
+            lock();
+            for (size_t i = 0; i < count; ++i) {
+                Entry& j = entries[i];
+                while (reached(now, j.next)) {
+                    if (j.active) {
+                        ++j.stats.skipped;
+                    } else {
+                        j.active  = true;
+                        j.pending = true;
+                        j.release = j.next;
+                        j.due     = j.next + j.deadline;
+                        released[nReleased++] = &j;
+                    }
+                    j.next += j.period;
+                }
+            }
+            Entry* order[MaxTasks];
+            size_t active = 0;
+            for (size_t i = 0; i < count; ++i) {
+                if (!entries[i].active) continue;
+                // Вставка по возрастанию абсолютного срока
+                size_t k = active++;
+                while (k > 0 && static_cast<int32_t>(order[k - 1]->due - entries[i].due) > 0) {
+                    order[k] = order[k - 1];
+                    --k;
+                }
+                order[k] = &entries[i];
+            }
+            unlock();
+
+            if (nReleased) {
+                vTaskSuspendAll();
+                for (size_t r = 0; r < active; ++r) {
+                    const UBaseType_t rank = r < levels ? static_cast<UBaseType_t>(r) : levels - 1;
+                    const UBaseType_t prio = base + levels - 1 - rank;
+                    if (order[r]->priority != prio) {
+                        vTaskPrioritySet(order[r]->handle, prio);
+                        order[r]->priority = prio;
+                    }
+                }
+                xTaskResumeAll();
+                for (size_t r = 0; r < nReleased; ++r) notify::library::give(released[r]->handle);
+            }
+
+            TickType_t wake = entries[0].next;
+            for (size_t i = 1; i < count; ++i) {
+                if (static_cast<int32_t>(entries[i].next - wake) < 0) wake = entries[i].next;
+            }
+            const TickType_t after = xTaskGetTickCount();
+            if (!reached(after, wake)) vTaskDelay(wake - after);
+        }
+    }
+
+#ifdef ESP_PLATFORM
+    void lock() {
+        taskENTER_CRITICAL(&mux);
+    }
+    void unlock() {
+        taskEXIT_CRITICAL(&mux);
+    }
+#else
+    void lock() {
+        taskENTER_CRITICAL();
+    }
+    void unlock() {
+        taskEXIT_CRITICAL();
+    }
+#endif
+};
+
+#endif  // EDF_SCHEDULER_H
+
+/*
+void control(void*);
+void telemetry(void*);
+void logging(void*);
+
+EdfScheduler<4> edfSched(2);  // задачи на приоритетах 2..5, диспетчер на 6
+
+void setup() {
+    // период, срок (мс), WCET (мкс)
+    edfSched.add(control, nullptr, "control", 5, 5, 2000);
+    edfSched.add([] { telemetry(&uplink); }, "telemetry", 7, 7, 4000);  // RM бы здесь срывал сроки
+    if (edfSched.add(logging, nullptr, "log", 100, 100, 5000) < 0) {
+        // не прошла тест приёма: плотность превысила бы 100%
+    }
+    edfSched.start();
+}
+
+auto s = edfSched.stats(1);  // jobs, misses, skipped, worstResponse
+*/
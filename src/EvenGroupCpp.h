@@ -5,9 +5,12 @@
 #include <Arduino.h>
 #endif
 
+#include "Footprint.h"
+#include "Trace.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
 #include <cstdint>
+#include <cstdlib>
 #include <stdexcept>
 
 class EventGroup {
@@ -57,25 +60,34 @@ class EventGroup {
         return handle != nullptr;
     }
 
+    // RAM своей группы: объект и блок из кучи
+    static constexpr size_t footprint() {
+        return sizeof(EventGroup) + ::footprint::eventGroup();
+    }
+
     // ==== Установка/сброс флагов ====
 
     // Установить биты (из задачи)
     EventBits_t setBits(EventBits_t bits) {
+        trace::emit(trace::Event::EventSet, handle, bits);
         return xEventGroupSetBits(handle, bits);
     }
 
     // Установить биты (из ISR)
     BaseType_t setBitsFromISR(EventBits_t bits, BaseType_t* higherPriorityTaskWoken = nullptr) {
+        trace::emitFromISR(trace::Event::EventSet, handle, bits);
         return xEventGroupSetBitsFromISR(handle, bits, higherPriorityTaskWoken);
     }
 
     // Сбросить биты (из задачи)
     EventBits_t clearBits(EventBits_t bits) {
+        trace::emit(trace::Event::EventClear, handle, bits);
         return xEventGroupClearBits(handle, bits);
     }
 
     // Сбросить биты (из ISR)
     EventBits_t clearBitsFromISR(EventBits_t bits) {
+        trace::emitFromISR(trace::Event::EventClear, handle, bits);
         return xEventGroupClearBitsFromISR(handle, bits);
     }
 
@@ -96,13 +108,21 @@ class EventGroup {
     // clearOnExit = true → указанные биты будут очищены при выходе
     EventBits_t waitBits(EventBits_t bits, bool waitAll = true, bool clearOnExit = false, uint32_t timeoutMs = 0) {
         TickType_t to = (timeoutMs == 0) ? 0 : pdMS_TO_TICKS(timeoutMs);
-        return xEventGroupWaitBits(handle, bits, clearOnExit ? pdTRUE : pdFALSE, waitAll ? pdTRUE : pdFALSE, to);
+        trace::emit(trace::Event::EventWaitBegin, handle, bits);
+        EventBits_t result =
+            xEventGroupWaitBits(handle, bits, clearOnExit ? pdTRUE : pdFALSE, waitAll ? pdTRUE : pdFALSE, to);
+        trace::emit(trace::Event::EventWaitEnd, handle, result);
+        return result;
     }
 
     // Барьерная синхронизация (xEventGroupSync)
     EventBits_t sync(EventBits_t bitsToSet, EventBits_t bitsToWaitFor, uint32_t timeoutMs = 0) {
         TickType_t to = (timeoutMs == 0) ? 0 : pdMS_TO_TICKS(timeoutMs);
-        return xEventGroupSync(handle, bitsToSet, bitsToWaitFor, to);
+        trace::emit(trace::Event::EventSet, handle, bitsToSet);
+        trace::emit(trace::Event::EventWaitBegin, handle, bitsToWaitFor);
+        EventBits_t result = xEventGroupSync(handle, bitsToSet, bitsToWaitFor, to);
+        trace::emit(trace::Event::EventWaitEnd, handle, result);
+        return result;
     }
 
     // Доступ к "сырую" ручке
@@ -110,6 +130,11 @@ class EventGroup {
         return handle;
     }
 
+    // Имя в трассе (FREERTOS_CPP_TRACE)
+    void setTraceName(const char* name) const {
+        trace::name(handle, name);
+    }
+
   protected:
     static constexpr unsigned MaxUserBits = sizeof(EventBits_t) * 8u - 8u;  // 24 бита при 32-битном EventBits_t
 
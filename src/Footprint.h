@@ -0,0 +1,185 @@
+#ifndef FOOTPRINT_H
+#define FOOTPRINT_H
+
+// Сколько RAM стоят объекты библиотеки — на этапе компиляции.
+//
+// У обёрток с объектами ядра есть static constexpr footprint(): размер самого объекта
+// плюс то, что он берёт из кучи FreeRTOS (очередь Queue<T>, задача xTaskCreate, группа
+// событий), с учётом заголовка блока и выравнивания heap_4. Параметры, известные только
+// во время работы (длина Queue<T>, глубина стека), передаются аргументами.
+// footprint::of<T>() — то же для любого типа: T::footprint(), если он есть, иначе sizeof(T).
+//
+// FREERTOS_CPP_RAM_BUDGET(Name, Bytes, Types...) суммирует объекты подсистемы и ломает
+// сборку (static_assert), если сумма больше бюджета. Name::total, Name::headroom и
+// footprint::report<...>() доступны и во время работы — для вывода в лог.
+//
+// FREERTOS_CPP_RAM перед определением статического объекта кладёт его в секцию
+// .bss.freertos_cpp (имя — FREERTOS_CPP_RAM_SECTION, с префиксом .bss.): в map-файле все
+// объекты библиотеки видны одной строкой. Секция NOBITS — места в образе во флеше она не
+// занимает, стандартные скрипты компоновки собирают её в .bss и обнуляют при старте. Туда
+// идут объекты с нулевой инициализацией и с конструкторами (StaticQueue, Guarded, Pipeline,
+// PeriodicTask). Объект с ненулевой константной инициализацией (индексы TripleBuffer,
+// vptr Channel) сборку ломает: GCC пускает в .bss.* только нулевые инициализаторы.
+// Для таких объектов — FREERTOS_CPP_RAM_DATA: секция .data.freertos_cpp
+// (FREERTOS_CPP_RAM_DATA_SECTION) собирается в .data, и стартовый код копирует начальные
+// значения без правки скрипта компоновки.
+//
+// Буферы объектов ядра внутри обёрток (хранилище StaticQueue, буфер мьютекса Guarded)
+// — поля объекта и попадают туда же, куда сам объект; атрибут секции у поля невозможен.
+// Статики в самих заголовках (inline-функции) в секцию не кладутся: они в COMDAT-группах,
+// и GCC не смешивает их с обычными объектами в одной секции.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Заголовок блока кучи (BlockLink_t в heap_4: указатель и размер)
+#ifndef FREERTOS_CPP_HEAP_BLOCK_OVERHEAD
+#define FREERTOS_CPP_HEAP_BLOCK_OVERHEAD (2 * sizeof(void*))
+#endif
+
+// Секции для статических объектов: нулевые — без места в образе, константные — в .data
+#ifndef FREERTOS_CPP_RAM_SECTION
+#define FREERTOS_CPP_RAM_SECTION ".bss.freertos_cpp"
+#endif
+
+#ifndef FREERTOS_CPP_RAM_DATA_SECTION
+#define FREERTOS_CPP_RAM_DATA_SECTION ".data.freertos_cpp"
+#endif
+
+#if defined(__ELF__) && !defined(FREERTOS_CPP_NO_RAM_SECTION)
+#define FREERTOS_CPP_RAM      __attribute__((section(FREERTOS_CPP_RAM_SECTION)))
+#define FREERTOS_CPP_RAM_DATA __attribute__((section(FREERTOS_CPP_RAM_DATA_SECTION)))
+#else
+#define FREERTOS_CPP_RAM
+#define FREERTOS_CPP_RAM_DATA
+#endif
+
+namespace footprint {
+
+// Блок из кучи FreeRTOS: запрошенные байты, заголовок, выравнивание portBYTE_ALIGNMENT
+constexpr size_t heap(size_t bytes) {
+    const size_t raw = bytes + FREERTOS_CPP_HEAP_BLOCK_OVERHEAD;
+    return (raw + portBYTE_ALIGNMENT - 1) / portBYTE_ALIGNMENT * portBYTE_ALIGNMENT;
+}
+
+// Объекты ядра, созданные динамически (размеры управляющих блоков — как у Static*_t)
+constexpr size_t queue(size_t length, size_t itemSize) {
+    return heap(sizeof(StaticQueue_t) + length * itemSize);
+}
+
+constexpr size_t semaphore() {
+    return heap(sizeof(StaticSemaphore_t));
+}
+
+constexpr size_t eventGroup() {
+    return heap(sizeof(StaticEventGroup_t));
+}
+
+// xTaskCreate: стек и TCB — два отдельных блока
+constexpr size_t task(size_t stackDepth) {
+    return heap(stackDepth * sizeof(StackType_t)) + heap(sizeof(StaticTask_t));
+}
+
+// Память, не выраженная типом (буфер драйвера, Queue<T> с длиной из настроек)
+template <size_t N>
+struct Bytes {
+    static constexpr size_t footprint() {
+        return N;
+    }
+};
+
+namespace detail {
+
+template <typename T, typename = void>
+struct HasFootprint : std::false_type {};
+
+template <typename T>
+struct HasFootprint<T, std::void_t<decltype(std::integral_constant<size_t, T::footprint()>{})>> : std::true_type {};
+
+template <typename T, typename = void>
+struct HasFootprintMember : std::false_type {};
+
+template <typename T>
+struct HasFootprintMember<T, std::void_t<decltype(&T::footprint)>> : std::true_type {};
+
+}  // namespace detail
+
+template <typename T>
+constexpr size_t of() {
+    if constexpr (detail::HasFootprint<T>::value) {
+        return T::footprint();
+    } else {
+        static_assert(!detail::HasFootprintMember<T>::value,
+                      "footprint depends on run-time arguments: use footprint::Bytes<T::footprint(...)>");
+        return sizeof(T);
+    }
+}
+
+template <size_t Budget, typename... Objects>
+struct Subsystem {
+    static constexpr size_t budget   = Budget;
+    static constexpr size_t total    = (size_t{0} + ... + of<Objects>());
+    static constexpr size_t headroom = total <= budget ? budget - total : 0;
+    static constexpr size_t objects  = sizeof...(Objects);
+};
+
+struct Line {
+    const char* name;
+    size_t      total;
+    size_t      budget;
+};
+
+// Отчёт по подсистемам, объявленным через FREERTOS_CPP_RAM_BUDGET: строка на подсистему
+template <typename... Subsystems>
+constexpr size_t report(Line* out, size_t max) {
+    const Line lines[] = {{Subsystems::name, Subsystems::total, Subsystems::budget}...};
+    size_t     n       = 0;
+    for (; n < sizeof...(Subsystems) && n < max; ++n) out[n] = lines[n];
+    return sizeof...(Subsystems);
+}
+
+template <typename... Subsystems>
+constexpr size_t total() {
+    return (size_t{0} + ... + Subsystems::total);
+}
+
+}  // namespace footprint
+
+// Подсистема с бюджетом RAM: сборка падает, если объекты не укладываются
+#define FREERTOS_CPP_RAM_BUDGET(Name, Budget, ...)                                    \
+    struct Name : footprint::Subsystem<(Budget), __VA_ARGS__> {                       \
+        static constexpr const char* name = #Name;                                    \
+    };                                                                                \
+    static_assert(Name::total <= Name::budget, "RAM budget exceeded: " #Name)
+
+#endif  // FOOTPRINT_H
+
+/*
+struct Packet { uint8_t data[64]; };
+struct Stats  { uint32_t rx, tx, errors; };
+
+// Объекты — в секции .bss.freertos_cpp, их видно в map-файле
+FREERTOS_CPP_RAM StaticQueue<Packet, 8> rxQueue;
+FREERTOS_CPP_RAM Guarded<Stats>         linkStats;
+FREERTOS_CPP_RAM PeriodicTask<10>       poller(pollRadio);
+FREERTOS_CPP_RAM_DATA TripleBuffer<Frame> frames;  // ненулевые индексы — .data.freertos_cpp
+Queue<Packet>                            txQueue(16);  // куча: размер через Bytes<>
+
+FREERTOS_CPP_RAM_BUDGET(Radio, 2048,
+                        StaticQueue<Packet, 8>, Guarded<Stats>, PeriodicTask<10>,
+                        footprint::Bytes<Queue<Packet>::footprint(16)>);
+// error: static assertion failed: RAM budget exceeded: Radio
+
+FREERTOS_CPP_RAM_BUDGET(Telemetry, 8192, Logger, EventGroup);
+
+// Во время работы — в лог
+footprint::Line lines[2];
+footprint::report<Radio, Telemetry>(lines, 2);
+for (auto& l : lines) LOGI("ram", "%s: %u of %u", l.name, l.total, l.budget);
+*/
@@ -1,28 +1,93 @@
 #ifndef GUARDED_HPP
 #define GUARDED_HPP
 
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "BlockingDetector.h"
+#include "Footprint.h"
+#include "Trace.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
-#include <Arduino.h>
+#include <cstdlib>
 
-template <typename T>
-class Guarded {
-    T                 data;
-    SemaphoreHandle_t mutex;
+namespace lock {
 
+// Политика блокировки Guarded по умолчанию: мьютекс ядра с наследованием приоритета.
+// Политика — класс с lock(), unlock(), id() (объект для трассы и отчёта блокировок)
+// и heapFootprint(); другие — в AdaptiveLock.h.
+class KernelMutex {
   public:
-    Guarded() {
+    KernelMutex() {
+#if configSUPPORT_STATIC_ALLOCATION
+        mutex = xSemaphoreCreateMutexStatic(&mutexBuffer);
+#else
         mutex = xSemaphoreCreateMutex();
-        // Можно добавить assert(mutex != nullptr);
+#endif
+        if (mutex == nullptr) {
+            configASSERT(false && "Failed to create Guarded mutex");
+            abort();
+        }
     }
 
-    ~Guarded() {
+    ~KernelMutex() {
         if (mutex) {
+            blocking::forget(mutex);
             vSemaphoreDelete(mutex);
         }
     }
 
+    KernelMutex(const KernelMutex&)            = delete;
+    KernelMutex& operator=(const KernelMutex&) = delete;
+
+    void lock() {
+#if FREERTOS_CPP_BLOCKING
+        // Ждём только если занято — тогда детектор знает, кто держит
+        if (xSemaphoreTake(mutex, 0) != pdTRUE) {
+            blocking::Wait wait(mutex, blocking::Kind::Mutex, xSemaphoreGetMutexHolder(mutex));
+            xSemaphoreTake(mutex, portMAX_DELAY);
+        }
+#else
+        xSemaphoreTake(mutex, portMAX_DELAY);
+#endif
+    }
+
+    void unlock() {
+        xSemaphoreGive(mutex);
+    }
+
+    const void* id() const {
+        return mutex;
+    }
+
+    // Куча сверх объекта (при динамическом выделении — блок мьютекса)
+    static constexpr size_t heapFootprint() {
+#if configSUPPORT_STATIC_ALLOCATION
+        return 0;
+#else
+        return ::footprint::semaphore();
+#endif
+    }
+
+  private:
+    SemaphoreHandle_t mutex;
+#if configSUPPORT_STATIC_ALLOCATION
+    StaticSemaphore_t mutexBuffer;  // мьютекс внутри объекта, без кучи
+#endif
+};
+
+}  // namespace lock
+
+template <typename T, class Lock = lock::KernelMutex>
+class Guarded {
+    T    data;
+    Lock guard;
+
+  public:
+    Guarded() = default;
+
     // Запрет копирования и присваивания
     Guarded(const Guarded&)            = delete;
     Guarded& operator=(const Guarded&) = delete;
@@ -32,46 +97,70 @@ class Guarded {
     Guarded& operator=(Guarded&&) = delete;
 
     class Access {
-        T*                ptr;
-        SemaphoreHandle_t mutex;
+        T*    ptr;
+        Lock* lock;
 
       public:
-        Access(T* p, SemaphoreHandle_t m) : ptr(p), mutex(m) {}
+        Access(T* p, Lock* l) : ptr(p), lock(l) {}
 
-        // Запрет копирования, чтобы не было двойного Give
+        // Запрет копирования, чтобы не было двойного unlock
         Access(const Access&)            = delete;
         Access& operator=(const Access&) = delete;
 
         // Можно разрешить перемещение, если нужно
-        Access(Access&& other) noexcept : ptr(other.ptr), mutex(other.mutex) {
-            other.ptr   = nullptr;
-            other.mutex = nullptr;
+        Access(Access&& other) noexcept : ptr(other.ptr), lock(other.lock) {
+            other.ptr  = nullptr;
+            other.lock = nullptr;
         }
         Access& operator=(Access&& other) noexcept {
             if (this != &other) {
                 // сначала отдать старый, если есть
-                if (mutex) xSemaphoreGive(mutex);
+                if (lock) release();
                 ptr        = other.ptr;
-                mutex      = other.mutex;
+                lock       = other.lock;
                 other.ptr  = nullptr;
-                other.mutex = nullptr;
+                other.lock = nullptr;
             }
             return *this;
         }
 
         ~Access() {
-            if (mutex) {
-                xSemaphoreGive(mutex);
+            if (lock) {
+                release();
             }
         }
 
         T* operator->() { return ptr; }
         T& operator*()  { return *ptr; }
+
+      private:
+        void release() {
+            trace::emit(trace::Event::LockReleased, lock->id());
+            lock->unlock();
+        }
     };
 
     Access operator()() {
-        xSemaphoreTake(mutex, portMAX_DELAY);
-        return Access(&data, mutex);
+        trace::emit(trace::Event::LockRequest, guard.id());
+        guard.lock();
+        trace::emit(trace::Event::LockAcquired, guard.id());
+        return Access(&data, &guard);
+    }
+
+    // Политика блокировки (например, статистика AdaptiveLock)
+    const Lock& policy() const {
+        return guard;
+    }
+
+    // RAM: данные и блокировка (при динамическом выделении — плюс блок из кучи)
+    static constexpr size_t footprint() {
+        return sizeof(Guarded) + Lock::heapFootprint();
+    }
+
+    // Имя в трассе (FREERTOS_CPP_TRACE) и в отчёте блокировок (FREERTOS_CPP_BLOCKING)
+    void setTraceName(const char* name) const {
+        trace::name(guard.id(), name);
+        blocking::name(guard.id(), name);
     }
 };
 
@@ -0,0 +1,100 @@
+#ifndef INPLACE_FUNCTION_H
+#define INPLACE_FUNCTION_H
+
+// Функциональный объект без кучи: InplaceFunction<R(Args...), Bytes>.
+//
+// Захваченное состояние хранится внутри объекта, в Bytes байтах. Не влезло — ошибка
+// компиляции, а не тихий malloc, как у std::function. Вызов — один косвенный переход
+// через указатель на функцию-переходник, без менеджера типа.
+//
+// Принимаются только тривиально копируемые и уничтожаемые вызываемые объекты (лямбды с
+// захватом чисел, указателей, ссылок; указатели на функции). Поэтому сам InplaceFunction
+// тривиально копируем: его можно класть в Queue<T> (копирование memcpy), в статические
+// массивы и в структуры, которые копируются побайтно.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Ёмкость по умолчанию: четыре указателя
+#ifndef FREERTOS_CPP_INPLACE_FUNCTION_SIZE
+#define FREERTOS_CPP_INPLACE_FUNCTION_SIZE (4 * sizeof(void*))
+#endif
+
+template <typename Signature, size_t Bytes = FREERTOS_CPP_INPLACE_FUNCTION_SIZE>
+class InplaceFunction;
+
+template <typename R, typename... Args, size_t Bytes>
+class InplaceFunction<R(Args...), Bytes> {
+  public:
+    InplaceFunction() = default;
+    InplaceFunction(std::nullptr_t) {}
+
+    template <typename F, typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<Fn, InplaceFunction> &&
+                                          std::is_invocable_r_v<R, Fn&, Args...>>>
+    InplaceFunction(F&& f) {
+        static_assert(sizeof(Fn) <= Bytes, "callable does not fit: enlarge InplaceFunction capacity");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "over-aligned callable");
+        static_assert(std::is_trivially_copyable_v<Fn> && std::is_trivially_destructible_v<Fn>,
+                      "InplaceFunction is copied bytewise: captures must be trivially copyable");
+        ::new (static_cast<void*>(storage)) Fn(std::forward<F>(f));
+        invoke = &call<Fn>;
+    }
+
+    R operator()(Args... args) const {
+        configASSERT(invoke);
+        return invoke(storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const {
+        return invoke != nullptr;
+    }
+
+    bool operator==(std::nullptr_t) const {
+        return invoke == nullptr;
+    }
+
+    bool operator!=(std::nullptr_t) const {
+        return invoke != nullptr;
+    }
+
+    static constexpr size_t capacity() {
+        return Bytes;
+    }
+
+  private:
+    using Invoker = R (*)(void*, Args...);
+
+    alignas(std::max_align_t) mutable unsigned char storage[Bytes];
+    Invoker invoke = nullptr;
+
+    template <typename Fn>
+    static R call(void* s, Args... args) {
+        return (*std::launder(static_cast<Fn*>(s)))(std::forward<Args>(args)...);
+    }
+};
+
+#endif  // INPLACE_FUNCTION_H
+
+/*
+struct Sensor { ... };
+Sensor   imu;
+uint32_t threshold = 40;
+
+// Захват указателя и числа — 16 байт, влезает в ёмкость по умолчанию
+InplaceFunction<bool(int)> check = [&imu, threshold](int raw) { return imu.scale(raw) > threshold; };
+if (check(readRaw())) alarm();
+
+// Колбэки можно передавать через очередь: объект копируется memcpy
+Queue<InplaceFunction<void()>> jobs(8);
+jobs.send([&imu] { imu.calibrate(); });
+
+InplaceFunction<void(), 8> tiny = [&imu, threshold] {};  // ошибка компиляции: не влезает
+*/
@@ -0,0 +1,150 @@
+#ifndef LAZY_H
+#define LAZY_H
+
+// Отложенное создание глобальных обёрток: Lazy<T, Args...>.
+//
+// Глобальные Queue, EventGroup, Guarded создают объекты ядра в статических конструкторах
+// ещё до setup(): загрузка дольше, а конструктор одного глобального объекта может
+// обратиться к другому, ещё не созданному. Lazy<T, Args...> инициализируется константой
+// (constexpr-конструктор, объект лежит в .bss), а T(Args...) строится на месте:
+//   - при первом обращении — флаг «один раз» на атомике, без мьютекса;
+//   - или явно, одним проходом lazy::initAll(a, b, c) в заданном порядке.
+// После создания обращение стоит одну acquire-загрузку и ветвление.
+//
+// Если объект строят две задачи сразу, строит первая, остальные ждут по тику. Первое
+// обращение из прерывания недопустимо (создание объектов ядра не ISR-безопасно) — такие
+// объекты нужно перечислить в initAll().
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// Проверка константной инициализации: ошибка компиляции, если у глобального объекта
+// всё же остался динамический конструктор
+#if defined(__cpp_constinit)
+#define FREERTOS_CPP_CONSTINIT constinit
+#elif defined(__clang__)
+#define FREERTOS_CPP_CONSTINIT [[clang::require_constant_initialization]]
+#elif defined(__GNUC__) && __GNUC__ >= 10
+#define FREERTOS_CPP_CONSTINIT __constinit
+#else
+#define FREERTOS_CPP_CONSTINIT
+#endif
+
+template <typename T, auto... Args>
+class Lazy {
+  public:
+    constexpr Lazy() : empty() {}
+
+    ~Lazy() {
+        if (ready()) value.~T();
+    }
+
+    Lazy(const Lazy&)            = delete;
+    Lazy& operator=(const Lazy&) = delete;
+
+    // Объект; создаётся при первом вызове
+    T& get() {
+        if (state.load(std::memory_order_acquire) == Ready) return value;
+        return construct();
+    }
+
+    T* operator->() {
+        return &get();
+    }
+
+    T& operator*() {
+        return get();
+    }
+
+    // Для обёрток с operator(): settings()->speed как у Guarded
+    template <typename... A>
+    decltype(auto) operator()(A&&... a) {
+        return get()(std::forward<A>(a)...);
+    }
+
+    bool ready() const {
+        return state.load(std::memory_order_acquire) == Ready;
+    }
+
+  private:
+    enum : uint8_t { Empty, Building, Ready };
+
+    union {
+        char empty;
+        T    value;
+    };
+    std::atomic<uint8_t> state{Empty};
+
+    T& construct() {
+        uint8_t expected = Empty;
+        if (state.compare_exchange_strong(expected, Building, std::memory_order_acquire)) {
+            ::new (static_cast<void*>(&value)) T(Args...);
+            state.store(Ready, std::memory_order_release);
+            return value;
+        }
+        // Строит другая задача: уступить ей, в том числе если её приоритет ниже
+        while (state.load(std::memory_order_acquire) != Ready) {
+            configASSERT(xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+            vTaskDelay(1);
+        }
+        return value;
+    }
+};
+
+namespace lazy {
+
+namespace detail {
+
+template <typename T, auto... Args>
+void init(Lazy<T, Args...>& l) {
+    l.get();
+}
+
+template <typename T, auto... Args, size_t N>
+void init(Lazy<T, Args...> (&ls)[N]) {
+    for (auto& l : ls) l.get();
+}
+
+}  // namespace detail
+
+// Создать объекты (и массивы объектов) в указанном порядке
+template <typename... Objects>
+void initAll(Objects&... objects) {
+    (detail::init(objects), ...);
+}
+
+}  // namespace lazy
+
+#endif  // LAZY_H
+
+/*
+struct Settings { int speed; float kP; };
+
+// Ни одного вызова ядра до setup(): объекты в .bss, конструкторов нет
+FREERTOS_CPP_CONSTINIT Lazy<Queue<Packet>, 16> inbox;
+FREERTOS_CPP_CONSTINIT Lazy<EventGroup>        events;
+FREERTOS_CPP_CONSTINIT Lazy<Guarded<Settings>> settings;
+FREERTOS_CPP_CONSTINIT Lazy<Queue<uint32_t>, 4> channels[8];
+
+void setup() {
+    lazy::initAll(events, inbox, channels);  // явно и в нужном порядке
+    // settings создастся при первом обращении
+    settings()->speed = 10;
+}
+
+void rxTask(void*) {
+    Packet p;
+    for (;;) {
+        if (inbox->receive(p, 100)) events->setBits(GotPacket);
+    }
+}
+*/
@@ -0,0 +1,396 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+// Асинхронный лог с отложенным форматированием.
+//
+// Место вызова не форматирует: в lock-free кольцо копируются указатель на строку
+// формата, тег модуля, метка времени и сырые аргументы (по 8 байт). Это один CAS и
+// несколько слов — порядка 100 нс, без printf, без блокировок, можно из ISR.
+// Низкоприоритетная задача-сборщик (start()) разбирает формат, печатает строку и
+// отдаёт её в sink (по умолчанию Serial / stdout). При переполнении кольца записи
+// отбрасываются, а сборщик печатает, сколько потеряно.
+//
+// Так как форматирование отложено, строка формата и аргументы %s должны жить
+// дольше записи — это строковые литералы или статические буферы.
+//
+// Уровни задаются при компиляции: модуль объявляется LOG_MODULE(имя, уровень),
+// общий потолок — FREERTOS_CPP_LOG_LEVEL. Вызовы ниже уровня не компилируются,
+// их аргументы не вычисляются.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "Footprint.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+// Общий потолок: 0 — ничего, 1 — ошибки ... 5 — всё
+#ifndef FREERTOS_CPP_LOG_LEVEL
+#define FREERTOS_CPP_LOG_LEVEL 3
+#endif
+
+// Записей в кольце (степень двойки)
+#ifndef FREERTOS_CPP_LOG_RING_SIZE
+#define FREERTOS_CPP_LOG_RING_SIZE 64
+#endif
+
+#ifndef FREERTOS_CPP_LOG_MAX_ARGS
+#define FREERTOS_CPP_LOG_MAX_ARGS 6
+#endif
+
+// Максимальная длина строки после форматирования
+#ifndef FREERTOS_CPP_LOG_LINE
+#define FREERTOS_CPP_LOG_LINE 128
+#endif
+
+namespace logger {
+
+enum class Level : uint8_t { None = 0, Error, Warn, Info, Debug, Verbose };
+
+constexpr size_t RingSize = FREERTOS_CPP_LOG_RING_SIZE;
+constexpr size_t MaxArgs  = FREERTOS_CPP_LOG_MAX_ARGS;
+constexpr size_t LineSize = FREERTOS_CPP_LOG_LINE;
+static_assert((RingSize & (RingSize - 1)) == 0, "FREERTOS_CPP_LOG_RING_SIZE must be a power of two");
+
+// Уровень включён, если он не выше уровня модуля и общего потолка
+template <typename Module>
+constexpr bool enabled(Level level) {
+    return static_cast<int>(level) <= static_cast<int>(Module::level) &&
+           static_cast<int>(level) <= FREERTOS_CPP_LOG_LEVEL && level != Level::None;
+}
+
+struct Record {
+    const char* format;
+    const char* tag;
+    TickType_t  time;
+    Level       level;
+    uint8_t     argc;
+    bool        isr;
+    uint64_t    args[MaxArgs];
+};
+
+// Аргумент в 8-байтовый слот: целые расширяются со знаком, float → double, указатели как есть
+template <typename T>
+uint64_t pack(T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        double   d = static_cast<double>(value);
+        uint64_t u;
+        std::memcpy(&u, &d, sizeof(u));
+        return u;
+    } else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>) {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+    } else if constexpr (std::is_enum_v<T>) {
+        return pack(static_cast<std::underlying_type_t<T>>(value));
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        return static_cast<uint64_t>(static_cast<int64_t>(value));
+    } else {
+        static_assert(std::is_integral_v<T>, "log arguments: integers, floats, enums and pointers only");
+        return static_cast<uint64_t>(value);
+    }
+}
+
+// Только для проверки формата компилятором (-Wformat), никогда не вызывается
+#if defined(__GNUC__)
+__attribute__((format(printf, 1, 2)))
+#endif
+inline void checkFormat(const char*, ...) {}
+
+// Отформатировать запись printf-подобно. Модификаторы длины в формате не важны:
+// целые печатаются как 64-битные, %f/%e/%g — как double.
+inline size_t format(const Record& r, char* out, size_t size) {
+    static const char levels[] = "-EWIDV";
+    int n = std::snprintf(out, size, "%8lu %c %s%s: ", static_cast<unsigned long>(r.time),
+                          levels[static_cast<int>(r.level)], r.tag, r.isr ? "(isr)" : "");
+    size_t len  = n > 0 ? static_cast<size_t>(n) : 0;
+    size_t next = 0;
+    auto   arg  = [&]() -> uint64_t { return next < r.argc ? r.args[next++] : 0; };
+    auto   put  = [&](int written) {
+        if (written > 0) len += static_cast<size_t>(written);
+        if (len > size - 1) len = size - 1;
+    };
+
+    for (const char* p = r.format; *p && len + 1 < size; ++p) {
+        if (*p != '%') {
+            out[len++] = *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[len++] = '%';
+            ++p;
+            continue;
+        }
+        // Собираем спецификатор заново: флаги, ширина, точность, свой модификатор длины
+        char   spec[40] = "%";  // с запасом на ширину из '*' и суффикс
+        size_t s        = 1;
+        for (++p; *p && std::strchr("-+ #0123456789.*hljztLq", *p); ++p) {
+            if (std::strchr("hljztLq", *p) || s > 20) continue;
+            if (*p == '*') {
+                s += static_cast<size_t>(std::snprintf(spec + s, 12, "%d", static_cast<int>(arg())));
+            } else {
+                spec[s++] = *p;
+            }
+        }
+        if (!*p) break;
+        const char conv     = *p;
+        char*      o        = out + len;
+        size_t     room     = size - len;
+        auto       withConv = [&](const char* suffix) {  // дописать модификатор и преобразование
+            std::strcpy(spec + s, suffix);
+            return spec;
+        };
+        switch (conv) {
+            case 'd':
+            case 'i': put(std::snprintf(o, room, withConv("lld"), static_cast<long long>(arg()))); break;
+            case 'u': put(std::snprintf(o, room, withConv("llu"), static_cast<unsigned long long>(arg()))); break;
+            case 'o': put(std::snprintf(o, room, withConv("llo"), static_cast<unsigned long long>(arg()))); break;
+            case 'x': put(std::snprintf(o, room, withConv("llx"), static_cast<unsigned long long>(arg()))); break;
+            case 'X': put(std::snprintf(o, room, withConv("llX"), static_cast<unsigned long long>(arg()))); break;
+            case 'c': put(std::snprintf(o, room, withConv("c"), static_cast<int>(arg()))); break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': {
+                const char suffix[] = {conv, '\0'};
+                uint64_t   u        = arg();
+                double     d;
+                std::memcpy(&d, &u, sizeof(d));
+                put(std::snprintf(o, room, withConv(suffix), d));
+                break;
+            }
+            case 's': {
+                const char* str = reinterpret_cast<const char*>(static_cast<uintptr_t>(arg()));
+                put(std::snprintf(o, room, withConv("s"), str ? str : "(null)"));
+                break;
+            }
+            case 'p':
+                put(std::snprintf(o, room, withConv("p"), reinterpret_cast<void*>(static_cast<uintptr_t>(arg()))));
+                break;
+            default:  // %n и неизвестные — пропускаем
+                break;
+        }
+    }
+    if (len + 1 < size) out[len++] = '\n';
+    out[len] = '\0';
+    return len;
+}
+
+}  // namespace logger
+
+class Logger {
+  public:
+    // Куда отдавать готовые строки (вызывается из задачи-сборщика)
+    using Sink = void (*)(const char* line, size_t length, void* ctx);
+
+    Logger() {
+        for (size_t i = 0; i < logger::RingSize; ++i) slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    ~Logger() {
+        if (task) vTaskDelete(task);
+    }
+
+    Logger(const Logger&)            = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Задать вывод до start()
+    void setSink(Sink s, void* ctx = nullptr) {
+        sink    = s;
+        sinkCtx = ctx;
+    }
+
+    // Запустить задачу-сборщик: раз в pollTicks вычитывает кольцо
+    bool start(const char* name = "log", UBaseType_t priority = tskIDLE_PRIORITY + 1,
+               configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE * 2,
+               TickType_t pollTicks = pdMS_TO_TICKS(10)) {
+        if (task) return false;
+        poll = pollTicks ? pollTicks : 1;
+        return xTaskCreate(run, name, stackDepth, this, priority, &task) == pdPASS;
+    }
+
+    // Положить запись в кольцо. false — кольцо полно, запись посчитана как потерянная.
+    template <typename... Args>
+    bool write(const char* tag, logger::Level level, bool fromIsr, const char* fmt, Args... args) {
+        static_assert(sizeof...(Args) <= logger::MaxArgs, "too many log arguments (FREERTOS_CPP_LOG_MAX_ARGS)");
+        size_t pos = head.load(std::memory_order_relaxed);
+        Slot*  slot;
+        for (;;) {
+            slot         = &slots[pos & (logger::RingSize - 1)];
+            size_t seq   = slot->seq.load(std::memory_order_acquire);
+            auto   diff  = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                drops.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+        logger::Record& r = slot->record;
+        r.format          = fmt;
+        r.tag             = tag;
+        r.time            = fromIsr ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
+        r.level           = level;
+        r.argc            = static_cast<uint8_t>(sizeof...(Args));
+        r.isr             = fromIsr;
+        size_t i          = 0;
+        ((r.args[i++] = logger::pack(args)), ...);
+        (void)i;
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Отформатировать и вывести до maxRecords записей. Сборщик вызывает это сам;
+    // без start() — вручную из одной задачи. Возвращает число выведенных записей.
+    size_t drain(size_t maxRecords = SIZE_MAX) {
+        char   line[logger::LineSize];
+        size_t done = 0;
+        reportDrops(line);
+        while (done < maxRecords) {
+            Slot& slot = slots[tail & (logger::RingSize - 1)];
+            if (slot.seq.load(std::memory_order_acquire) != tail + 1) break;  // пусто или ещё пишется
+            logger::Record r = slot.record;
+            slot.seq.store(tail + logger::RingSize, std::memory_order_release);
+            ++tail;
+            output(line, logger::format(r, line, sizeof(line)));
+            ++done;
+        }
+        return done;
+    }
+
+    // Потеряно записей с момента создания
+    uint32_t dropped() const {
+        return drops.load(std::memory_order_relaxed);
+    }
+
+    TaskHandle_t taskHandle() const {
+        return task;
+    }
+
+    // RAM: кольцо записей, стек и TCB задачи-сборщика
+    static constexpr size_t footprint(size_t stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        return sizeof(Logger) + ::footprint::task(stackDepth);
+    }
+
+  private:
+    struct Slot {
+        std::atomic<size_t> seq;  // == позиция: свободен; позиция + 1: записан
+        logger::Record      record;
+    };
+
+    Slot                  slots[logger::RingSize];
+    std::atomic<size_t>   head{0};
+    size_t                tail = 0;
+    std::atomic<uint32_t> drops{0};
+    uint32_t              reportedDrops = 0;
+    Sink                  sink          = defaultSink;
+    void*                 sinkCtx       = nullptr;
+    TaskHandle_t          task          = nullptr;
+    TickType_t            poll          = 1;
+
+    static void run(void* arg) {
+        auto* self = static_cast<Logger*>(arg);
+        for (;;) {
+            self->drain();
+            vTaskDelay(self->poll);
+        }
+    }
+
+    void output(const char* line, size_t length) {
+        if (sink) sink(line, length, sinkCtx);
+    }
+
+    void reportDrops(char* line) {
+        uint32_t d = drops.load(std::memory_order_relaxed);
+        if (d == reportedDrops) return;
+        int n = std::snprintf(line, logger::LineSize, "%8lu W log: %lu messages dropped\n",
+                              static_cast<unsigned long>(xTaskGetTickCount()),
+                              static_cast<unsigned long>(d - reportedDrops));
+        reportedDrops = d;
+        if (n > 0) output(line, std::min(static_cast<size_t>(n), logger::LineSize - 1));
+    }
+
+    static void defaultSink(const char* line, size_t length, void*) {
+#ifdef Arduino_h
+        Serial.write(reinterpret_cast<const uint8_t*>(line), length);
+#else
+        std::fwrite(line, 1, length, stdout);
+#endif
+    }
+};
+
+namespace logger {
+
+// Лог по умолчанию для макросов LOG_*
+inline Logger global;
+
+}  // namespace logger
+
+// Объявить модуль: LOG_MODULE(Net, Debug) — всё до Debug включительно
+#define LOG_MODULE(name, minLevel)                                          \
+    struct name {                                                           \
+        static constexpr const char*     tag   = #name;                     \
+        static constexpr ::logger::Level level = ::logger::Level::minLevel; \
+    }
+
+#define FREERTOS_CPP_LOG(module, lvl, fromIsr, ...)                                   \
+    do {                                                                              \
+        if constexpr (::logger::enabled<module>(lvl)) {                               \
+            if (false) ::logger::checkFormat(__VA_ARGS__);                            \
+            ::logger::global.write(module::tag, lvl, fromIsr, __VA_ARGS__);           \
+        }                                                                             \
+    } while (0)
+
+#define LOG_ERROR(module, ...)   FREERTOS_CPP_LOG(module, ::logger::Level::Error, false, __VA_ARGS__)
+#define LOG_WARN(module, ...)    FREERTOS_CPP_LOG(module, ::logger::Level::Warn, false, __VA_ARGS__)
+#define LOG_INFO(module, ...)    FREERTOS_CPP_LOG(module, ::logger::Level::Info, false, __VA_ARGS__)
+#define LOG_DEBUG(module, ...)   FREERTOS_CPP_LOG(module, ::logger::Level::Debug, false, __VA_ARGS__)
+#define LOG_VERBOSE(module, ...) FREERTOS_CPP_LOG(module, ::logger::Level::Verbose, false, __VA_ARGS__)
+
+// Из прерывания
+#define LOG_ERROR_ISR(module, ...) FREERTOS_CPP_LOG(module, ::logger::Level::Error, true, __VA_ARGS__)
+#define LOG_WARN_ISR(module, ...)  FREERTOS_CPP_LOG(module, ::logger::Level::Warn, true, __VA_ARGS__)
+#define LOG_INFO_ISR(module, ...)  FREERTOS_CPP_LOG(module, ::logger::Level::Info, true, __VA_ARGS__)
+#define LOG_DEBUG_ISR(module, ...) FREERTOS_CPP_LOG(module, ::logger::Level::Debug, true, __VA_ARGS__)
+
+#endif  // LOGGER_H
+
+/*
+LOG_MODULE(Motor, Debug);  // всё до Debug
+LOG_MODULE(Net, Warn);     // только ошибки и предупреждения
+
+void motorTask(void*) {
+    for (;;) {
+        int32_t rpm = readRpm();
+        LOG_DEBUG(Motor, "rpm=%d target=%d", rpm, target);  // ~100 нс, без printf
+        LOG_INFO(Net, "not compiled at all");                 // Net ниже Info
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+void IRAM_ATTR onEncoderOverflow() {
+    LOG_WARN_ISR(Motor, "encoder overflow at %u", TIMG0.cnt);
+}
+
+void setup() {
+    Serial.begin(115200);
+    logger::global.start("log", 1);  // сборщик печатает в Serial
+}
+
+// Вывод:
+//     1234 D Motor: rpm=1480 target=1500
+//     1240 W Motor(isr): encoder overflow at 65535
+//     1300 W log: 3 messages dropped
+*/
@@ -0,0 +1,64 @@
+#ifndef MICROS_CLOCK_H
+#define MICROS_CLOCK_H
+
+// Общие часы библиотеки: один выбор платформы для всех, кто меряет время.
+//
+// FREERTOS_CPP_CLOCK_US64() — микросекунды, 64 бита, не переполняются (PeriodicTask).
+// FREERTOS_CPP_CLOCK_US()   — те же микросекунды, 32 бита: переполняются раз в ~71 минуту,
+//                             разность двух отметок без переполнения верна (Slo.h,
+//                             BlockingDetector.h).
+// FREERTOS_CPP_CLOCK_CYCLES() / FREERTOS_CPP_CLOCK_CYCLES_HZ — самый мелкий счётчик
+//                             платформы для коротких интервалов (Trace.h, AdaptiveLock.h).
+//                             Младшие 32 бита разности двух отметок верны.
+//
+// Платформы: виртуальное время в симуляторе (наносекунды), esp_timer и счётчик тактов
+// на ESP32, steady_clock на хосте (наносекунды). Для других платформ задать
+// FREERTOS_CPP_CLOCK_US64() и FREERTOS_CPP_CLOCK_CYCLES()/_HZ вручную.
+
+#include <cstdint>
+
+#if !defined(FREERTOS_CPP_CLOCK_US64) || !defined(FREERTOS_CPP_CLOCK_CYCLES)
+#if defined(FREERTOS_CPP_SIM)
+#include "SimKernel.h"
+#ifndef FREERTOS_CPP_CLOCK_US64
+#define FREERTOS_CPP_CLOCK_US64() (sim::nowNs() / 1000)
+#endif
+#ifndef FREERTOS_CPP_CLOCK_CYCLES
+#define FREERTOS_CPP_CLOCK_CYCLES()   sim::nowNs()
+#define FREERTOS_CPP_CLOCK_CYCLES_HZ  1000000000ull
+#endif
+#elif defined(ESP_PLATFORM)
+#include "esp_cpu.h"
+#include "esp_timer.h"
+#ifndef FREERTOS_CPP_CLOCK_US64
+#define FREERTOS_CPP_CLOCK_US64() static_cast<uint64_t>(esp_timer_get_time())
+#endif
+#ifndef FREERTOS_CPP_CLOCK_CYCLES
+#define FREERTOS_CPP_CLOCK_CYCLES()   static_cast<uint64_t>(esp_cpu_get_cycle_count())
+#define FREERTOS_CPP_CLOCK_CYCLES_HZ  (CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1000000ull)
+#endif
+#elif defined(__linux__) || defined(__APPLE__) || defined(_WIN32)
+#include <chrono>
+#ifndef FREERTOS_CPP_CLOCK_US64
+#define FREERTOS_CPP_CLOCK_US64()                                                               \
+    static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(                \
+                              std::chrono::steady_clock::now().time_since_epoch())              \
+                              .count())
+#endif
+#ifndef FREERTOS_CPP_CLOCK_CYCLES
+#define FREERTOS_CPP_CLOCK_CYCLES()                                                             \
+    static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(                 \
+                              std::chrono::steady_clock::now().time_since_epoch())              \
+                              .count())
+#define FREERTOS_CPP_CLOCK_CYCLES_HZ 1000000000ull
+#endif
+#else
+#error "Define FREERTOS_CPP_CLOCK_US64() and FREERTOS_CPP_CLOCK_CYCLES()/_HZ for this platform"
+#endif
+#endif
+
+#ifndef FREERTOS_CPP_CLOCK_US
+#define FREERTOS_CPP_CLOCK_US() static_cast<uint32_t>(FREERTOS_CPP_CLOCK_US64())
+#endif
+
+#endif  // MICROS_CLOCK_H
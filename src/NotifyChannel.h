@@ -0,0 +1,325 @@
+#ifndef NOTIFY_CHANNEL_H
+#define NOTIFY_CHANNEL_H
+
+// Типизированные каналы поверх уведомлений задачи (массив уведомлений, FreeRTOS ≥ 10.4).
+// Уведомление — самый дешёвый способ разбудить задачу: ни объекта ядра, ни кучи.
+// Ждать может только одна задача — та, к которой канал привязан (bind).
+//
+// Индексы в массиве уведомлений раздаёт реестр на этапе компиляции: один список видов на
+// прошивку, и два модуля не займут один индекс. Индекс 0 (xTaskNotifyGive() без индекса,
+// потоковые буферы ядра) и индекс ожиданий самой библиотеки (FREERTOS_CPP_NOTIFY_LIBRARY_INDEX:
+// Channel, TripleBuffer, PingPongBuffer, Pipeline, EdfScheduler, SpillQueue, IrqDoorbell)
+// не раздаются — см. NotifyIndex.h. Реестр начинает с FREERTOS_CPP_NOTIFY_FIRST_INDEX:
+// при индексе библиотеки 1 виды получают индексы 2, 3, ...
+//
+// Массив уведомлений должен вмещать FREERTOS_CPP_NOTIFY_FIRST_INDEX + число видов. При
+// configTASK_NOTIFICATION_ARRAY_ENTRIES == 1 (по умолчанию в ESP-IDF) любой непустой реестр
+// не собирается (static_assert) — размер массива нужно поднять, например до 4 для двух видов.
+//
+// Вид уведомления — пустая структура, наследующая режим:
+//   notify::Counting  — счётчик: give()/take(), замена двоичного и счётного семафора;
+//   notify::Bits      — битовая маска: set()/wait(), замена EventGroup с одним ожидающим;
+//   notify::Value<T>  — последнее значение T (до 4 байт): post() перезаписывает,
+//                       tryPost() — только если прошлое уже прочитано.
+// Таймауты в миллисекундах, 0 — не ждать (как у Queue и EventGroup), portMAX_DELAY — вечно.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "NotifyIndex.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Первый индекс, который раздаёт реестр: следующий за индексом библиотеки
+#ifndef FREERTOS_CPP_NOTIFY_FIRST_INDEX
+#define FREERTOS_CPP_NOTIFY_FIRST_INDEX (FREERTOS_CPP_NOTIFY_LIBRARY_INDEX + 1)
+#endif
+
+template <class Kind, class Registry>
+class NotifyChannel;
+
+namespace notify {
+
+namespace detail {
+
+template <class K, class... Kinds>
+constexpr size_t position() {
+    size_t      i       = 0;
+    const bool  found[] = {false, std::is_same<K, Kinds>::value...};
+    for (size_t j = 1; j < sizeof(found) / sizeof(found[0]); ++j, ++i) {
+        if (found[j]) return i;
+    }
+    return i;  // == sizeof...(Kinds): вида нет в реестре
+}
+
+template <class... Kinds>
+constexpr bool unique() {
+    const size_t at[] = {0, position<Kinds, Kinds...>()...};
+    for (size_t j = 1; j < sizeof(at) / sizeof(at[0]); ++j) {
+        if (at[j] != j - 1) return false;  // встретился раньше своего места
+    }
+    return true;
+}
+
+inline TickType_t ticks(uint32_t ms) {
+    return ms == portMAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(ms);
+}
+
+// Задача-получатель и индекс; общая часть всех режимов
+template <UBaseType_t Index>
+class Target {
+  public:
+    // Привязать к задаче, которая будет ждать. Уведомления до привязки теряются.
+    void bind(TaskHandle_t task) {
+        waiter = task;
+    }
+
+    // Привязать к текущей задаче (зовёт сам получатель)
+    void bindCurrent() {
+        waiter = xTaskGetCurrentTaskHandle();
+    }
+
+    TaskHandle_t task() const {
+        return waiter;
+    }
+
+    bool isBound() const {
+        return waiter != nullptr;
+    }
+
+    static constexpr UBaseType_t index() {
+        return Index;
+    }
+
+    // Забыть непрочитанное (из задачи-получателя)
+    void clear() {
+        xTaskNotifyStateClearIndexed(nullptr, Index);
+        ulTaskNotifyValueClearIndexed(nullptr, Index, UINT32_MAX);
+    }
+
+  protected:
+    bool notify(uint32_t value, eNotifyAction action) {
+        if (!waiter) return false;
+        return xTaskNotifyIndexed(waiter, Index, value, action) == pdPASS;
+    }
+
+    bool notifyFromISR(uint32_t value, eNotifyAction action, BaseType_t* woken) {
+        if (!waiter) return false;
+        return xTaskNotifyIndexedFromISR(waiter, Index, value, action, woken) == pdPASS;
+    }
+
+    // Ждать может только привязанная задача
+    void assertWaiter() const {
+        configASSERT(waiter == xTaskGetCurrentTaskHandle());
+    }
+
+    TaskHandle_t waiter = nullptr;
+};
+
+template <UBaseType_t Index>
+class CountingOps : public Target<Index> {
+  public:
+    // Прибавить единицу (из задачи)
+    void give() {
+        if (this->waiter) xTaskNotifyGiveIndexed(this->waiter, Index);
+    }
+
+    // Прибавить единицу (из ISR)
+    void giveFromISR(BaseType_t* higherPriorityTaskWoken = nullptr) {
+        if (this->waiter) vTaskNotifyGiveIndexedFromISR(this->waiter, Index, higherPriorityTaskWoken);
+    }
+
+    // Забрать одну единицу, ожидая до ms. false — таймаут.
+    bool take(uint32_t ms = 0) {
+        this->assertWaiter();
+        return ulTaskNotifyTakeIndexed(Index, pdFALSE, ticks(ms)) > 0;
+    }
+
+    // Забрать все накопленные разом (как двоичный семафор). 0 — таймаут.
+    uint32_t takeAll(uint32_t ms = 0) {
+        this->assertWaiter();
+        return ulTaskNotifyTakeIndexed(Index, pdTRUE, ticks(ms));
+    }
+};
+
+template <UBaseType_t Index>
+class BitsOps : public Target<Index> {
+  public:
+    // Выставить биты (из задачи)
+    void set(uint32_t bits) {
+        this->notify(bits, eSetBits);
+    }
+
+    // Выставить биты (из ISR)
+    void setFromISR(uint32_t bits, BaseType_t* higherPriorityTaskWoken = nullptr) {
+        this->notifyFromISR(bits, eSetBits, higherPriorityTaskWoken);
+    }
+
+    // Ждать битов из mask до ms: все (waitAll) или хотя бы одного. Возвращает
+    // дождавшиеся биты и снимает их; 0 — таймаут, остальные биты не трогаются.
+    uint32_t wait(uint32_t mask, bool waitAll = false, uint32_t ms = 0) {
+        this->assertWaiter();
+        const TickType_t start = xTaskGetTickCount();
+        const TickType_t limit = ticks(ms);
+        for (;;) {
+            const uint32_t hit = ulTaskNotifyValueClearIndexed(nullptr, Index, 0) & mask;
+            if (waitAll ? hit == mask : hit != 0) {
+                ulTaskNotifyValueClearIndexed(nullptr, Index, hit);
+                return hit;
+            }
+            const TickType_t spent = xTaskGetTickCount() - start;
+            if (limit != portMAX_DELAY && spent >= limit) return 0;
+            // Возвращается сразу, если с прошлой проверки что-то пришло
+            xTaskNotifyWaitIndexed(Index, 0, 0, nullptr, limit == portMAX_DELAY ? portMAX_DELAY : limit - spent);
+        }
+    }
+
+    // Текущие биты без ожидания и без очистки
+    uint32_t peek() const {
+        if (!this->waiter) return 0;
+        return ulTaskNotifyValueClearIndexed(this->waiter, Index, 0);
+    }
+};
+
+template <UBaseType_t Index, class T>
+class ValueOps : public Target<Index> {
+    static_assert(sizeof(T) <= sizeof(uint32_t), "notify::Value<T>: T must fit in 32 bits");
+    static_assert(std::is_trivially_copyable<T>::value, "notify::Value<T>: T must be trivially copyable");
+
+  public:
+    // Записать значение поверх непрочитанного (из задачи)
+    void post(const T& value) {
+        this->notify(pack(value), eSetValueWithOverwrite);
+    }
+
+    // То же из ISR
+    void postFromISR(const T& value, BaseType_t* higherPriorityTaskWoken = nullptr) {
+        this->notifyFromISR(pack(value), eSetValueWithOverwrite, higherPriorityTaskWoken);
+    }
+
+    // Записать, только если прошлое значение уже прочитано. false — не записано.
+    bool tryPost(const T& value) {
+        return this->notify(pack(value), eSetValueWithoutOverwrite);
+    }
+
+    bool tryPostFromISR(const T& value, BaseType_t* higherPriorityTaskWoken = nullptr) {
+        return this->notifyFromISR(pack(value), eSetValueWithoutOverwrite, higherPriorityTaskWoken);
+    }
+
+    // Дождаться нового значения до ms. false — таймаут.
+    bool receive(T& out, uint32_t ms = 0) {
+        this->assertWaiter();
+        uint32_t raw = 0;
+        if (xTaskNotifyWaitIndexed(Index, 0, 0, &raw, ticks(ms)) != pdTRUE) return false;
+        std::memcpy(&out, &raw, sizeof(T));
+        return true;
+    }
+
+  private:
+    static uint32_t pack(const T& value) {
+        uint32_t raw = 0;
+        std::memcpy(&raw, &value, sizeof(T));
+        return raw;
+    }
+};
+
+}  // namespace detail
+
+// ==== Режимы: вид наследует один из них ====
+
+struct Counting {
+    template <UBaseType_t Index>
+    using Ops = detail::CountingOps<Index>;
+};
+
+struct Bits {
+    template <UBaseType_t Index>
+    using Ops = detail::BitsOps<Index>;
+};
+
+template <class T>
+struct Value {
+    template <UBaseType_t Index>
+    using Ops = detail::ValueOps<Index, T>;
+};
+
+// Реестр видов уведомлений прошивки: индекс вида — его место в списке
+template <class... Kinds>
+struct Registry {
+    static_assert(detail::unique<Kinds...>(), "notify::Registry: kind listed twice");
+    static_assert(FREERTOS_CPP_NOTIFY_FIRST_INDEX + sizeof...(Kinds) <= configTASK_NOTIFICATION_ARRAY_ENTRIES,
+                  "notify::Registry: raise configTASK_NOTIFICATION_ARRAY_ENTRIES");
+    static_assert(FREERTOS_CPP_NOTIFY_FIRST_INDEX > FREERTOS_CPP_NOTIFY_LIBRARY_INDEX ||
+                      FREERTOS_CPP_NOTIFY_FIRST_INDEX + sizeof...(Kinds) <= FREERTOS_CPP_NOTIFY_LIBRARY_INDEX,
+                  "notify::Registry: indices overlap FREERTOS_CPP_NOTIFY_LIBRARY_INDEX");
+
+    static constexpr size_t size = sizeof...(Kinds);
+
+    template <class K>
+    static constexpr bool contains = detail::position<K, Kinds...>() < sizeof...(Kinds);
+
+    template <class K>
+    static constexpr UBaseType_t index = FREERTOS_CPP_NOTIFY_FIRST_INDEX + detail::position<K, Kinds...>();
+
+    template <class K>
+    using Channel = NotifyChannel<K, Registry>;
+};
+
+}  // namespace notify
+
+template <class Kind, class Registry>
+class NotifyChannel : public Kind::template Ops<Registry::template index<Kind>> {
+    static_assert(Registry::template contains<Kind>, "NotifyChannel: kind is not in the registry");
+
+  public:
+    NotifyChannel() = default;
+
+    explicit NotifyChannel(TaskHandle_t task) {
+        this->bind(task);
+    }
+
+    // Объект ядра не нужен: вся RAM — указатель на задачу
+    static constexpr size_t footprint() {
+        return sizeof(NotifyChannel);
+    }
+};
+
+#endif  // NOTIFY_CHANNEL_H
+
+/*
+// Один список на прошивку (например, в AppNotify.h)
+struct AdcReady : notify::Counting {};
+struct Buttons : notify::Bits {};
+struct Setpoint : notify::Value<float> {};
+using AppNotify = notify::Registry<AdcReady, Buttons, Setpoint>;  // индексы 2, 3, 4 (нужно >= 5 записей)
+
+AppNotify::Channel<AdcReady> adcReady;
+AppNotify::Channel<Buttons>  buttons;
+AppNotify::Channel<Setpoint> setpoint;
+
+void IRAM_ATTR adcIsr(void*) {
+    BaseType_t woken = pdFALSE;
+    adcReady.giveFromISR(&woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void controlTask(void*) {
+    adcReady.bindCurrent();
+    buttons.bindCurrent();
+    setpoint.bindCurrent();
+    float target = 0;
+    for (;;) {
+        if (adcReady.take(10)) { ... }
+        if (uint32_t b = buttons.wait(0x3, false, 0)) { ... }
+        setpoint.receive(target, 0);
+    }
+}
+
+setpoint.post(21.5f);   // из другой задачи: последнее значение побеждает
+buttons.set(1u << 0);
+*/
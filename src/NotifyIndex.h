@@ -0,0 +1,81 @@
+#ifndef NOTIFY_INDEX_H
+#define NOTIFY_INDEX_H
+
+// Индексы массива уведомлений задачи, занятые библиотекой.
+//
+//   0                                  — уведомления без индекса: xTaskNotifyGive() кода
+//                                        пользователя, потоковые буферы ядра;
+//   FREERTOS_CPP_NOTIFY_LIBRARY_INDEX  — ожидания примитивов библиотеки (Channel, TripleBuffer,
+//                                        PingPongBuffer, Pipeline, EdfScheduler, SpillQueue,
+//                                        IrqDoorbell);
+//   дальше                             — реестр NotifyChannel.
+//
+// Примитивы библиотеки делят свой индекс между собой и каждый ждёт в цикле по своему
+// состоянию: уведомление, оставшееся от другого примитива, даёт только лишнее пробуждение.
+// Если массив уведомлений из одного элемента (configTASK_NOTIFICATION_ARRAY_ENTRIES == 1,
+// так по умолчанию в ESP-IDF), библиотека остаётся на индексе 0 и вызовах без индекса.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cstdint>
+
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#ifndef FREERTOS_CPP_NOTIFY_LIBRARY_INDEX
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES > 1
+#define FREERTOS_CPP_NOTIFY_LIBRARY_INDEX 1
+#else
+#define FREERTOS_CPP_NOTIFY_LIBRARY_INDEX 0
+#endif
+#endif
+
+static_assert(FREERTOS_CPP_NOTIFY_LIBRARY_INDEX < configTASK_NOTIFICATION_ARRAY_ENTRIES,
+              "FREERTOS_CPP_NOTIFY_LIBRARY_INDEX is outside the notification array");
+
+namespace notify {
+namespace library {
+
+inline void give(TaskHandle_t task) {
+#if FREERTOS_CPP_NOTIFY_LIBRARY_INDEX
+    xTaskNotifyGiveIndexed(task, FREERTOS_CPP_NOTIFY_LIBRARY_INDEX);
+#else
+    xTaskNotifyGive(task);
+#endif
+}
+
+inline void giveFromISR(TaskHandle_t task, BaseType_t* pxHigherPriorityTaskWoken) {
+#if FREERTOS_CPP_NOTIFY_LIBRARY_INDEX
+    vTaskNotifyGiveIndexedFromISR(task, FREERTOS_CPP_NOTIFY_LIBRARY_INDEX, pxHigherPriorityTaskWoken);
+#else
+    vTaskNotifyGiveFromISR(task, pxHigherPriorityTaskWoken);
+#endif
+}
+
+// Дождаться уведомления до ticks тиков и сбросить счётчик. 0 — таймаут.
+inline uint32_t take(TickType_t ticks) {
+#if FREERTOS_CPP_NOTIFY_LIBRARY_INDEX
+    return ulTaskNotifyTakeIndexed(FREERTOS_CPP_NOTIFY_LIBRARY_INDEX, pdTRUE, ticks);
+#else
+    return ulTaskNotifyTake(pdTRUE, ticks);
+#endif
+}
+
+}  // namespace library
+}  // namespace notify
+
+#endif  // NOTIFY_INDEX_H
+
+/*
+// Свой примитив поверх индекса библиотеки: ждать в цикле по своему состоянию
+while (!ready.load(std::memory_order_acquire)) notify::library::take(portMAX_DELAY);
+
+// Сторона, которая будит
+ready.store(true, std::memory_order_release);
+notify::library::give(waiterTask);
+*/
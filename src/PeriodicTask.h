@@ -0,0 +1,265 @@
+#ifndef PERIODIC_TASK_H
+#define PERIODIC_TASK_H
+
+// Периодическая задача: вызывает функцию раз в PeriodMs без накопления дрейфа.
+//
+// Моменты запуска лежат на сетке start + phase + k * period (xTaskDelayUntil), поэтому
+// время работы функции и задержки планировщика не сдвигают следующие запуски.
+// Если запуск закончился позже следующего по сетке — это перегрузка (overrun). Дальше
+// по политике Missed: Skip — пропустить прошедшие моменты и ждать следующего по сетке,
+// CatchUp — отработать пропущенные подряд без ожидания.
+//
+// На каждом запуске в гистограммы пишутся (в микросекундах):
+//   jitter — отклонение интервала между стартами от интервала между их моментами по сетке;
+//   exec   — время работы функции.
+// Запуски дольше бюджета (Config::budgetUs, по умолчанию — весь период) считаются отдельно.
+//
+// Часы — общие FREERTOS_CPP_CLOCK_US64 (MicrosClock.h).
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "Footprint.h"
+#include "InplaceFunction.h"
+#include "MicrosClock.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace periodic {
+
+// Что делать с моментами запуска, пропущенными из-за перегрузки
+enum class Missed : uint8_t {
+    Skip,     // продолжить со следующего момента по сетке
+    CatchUp,  // отработать пропущенные подряд
+};
+
+inline uint64_t nowUs() {
+    return FREERTOS_CPP_CLOCK_US64();
+}
+
+// Гистограмма по степеням двойки: корзина 0 — ровно 0 мкс, корзина i — [2^(i-1), 2^i).
+// Последняя корзина собирает всё, что больше. 112 байт, запись — несколько тактов.
+class Histogram {
+  public:
+    static constexpr size_t Buckets = 24;  // до ~8 с
+
+    void record(uint32_t us) {
+        size_t i = us ? 32 - static_cast<size_t>(__builtin_clz(us)) : 0;
+        ++counts[i < Buckets ? i : Buckets - 1];
+        ++total;
+        sum += us;
+        if (us > maxValue) maxValue = us;
+    }
+
+    void reset() {
+        *this = Histogram();
+    }
+
+    uint32_t count() const {
+        return total;
+    }
+
+    uint32_t max() const {
+        return maxValue;
+    }
+
+    uint32_t mean() const {
+        return total ? static_cast<uint32_t>(sum / total) : 0;
+    }
+
+    uint32_t bucket(size_t i) const {
+        return i < Buckets ? counts[i] : 0;
+    }
+
+    // Верхняя граница корзины, в которую попадает перцентиль p (0..100)
+    uint32_t percentile(uint32_t p) const {
+        if (total == 0) return 0;
+        uint64_t target = (static_cast<uint64_t>(total) * p + 99) / 100;
+        if (target == 0) target = 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < Buckets; ++i) {
+            seen += counts[i];
+            if (seen >= target) {
+                uint32_t hi = i ? (1u << i) - 1 : 0;
+                return hi < maxValue ? hi : maxValue;
+            }
+        }
+        return maxValue;
+    }
+
+  private:
+    uint32_t counts[Buckets] = {};
+    uint32_t total           = 0;
+    uint32_t maxValue        = 0;
+    uint64_t sum             = 0;
+};
+
+struct Stats {
+    uint32_t  runs;        // вызовов функции
+    uint32_t  overruns;    // запуск закончился позже следующего момента по сетке
+    uint32_t  skipped;     // моментов пропущено (Missed::Skip)
+    uint32_t  overBudget;  // запусков дольше бюджета
+    Histogram jitter;
+    Histogram exec;
+};
+
+}  // namespace periodic
+
+template <uint32_t PeriodMs, typename Fn = InplaceFunction<void()>>
+class PeriodicTask {
+  public:
+    static constexpr TickType_t PeriodTicks = pdMS_TO_TICKS(PeriodMs);
+    static_assert(PeriodTicks > 0 && static_cast<uint64_t>(PeriodMs) * configTICK_RATE_HZ % 1000 == 0,
+                  "period must be a whole number of ticks");
+
+    struct Config {
+        uint32_t        phaseMs  = 0;  // сдвиг первого запуска от start()
+        periodic::Missed missed  = periodic::Missed::Skip;
+        uint32_t        budgetUs = PeriodMs * 1000;
+    };
+
+    explicit PeriodicTask(Fn fn) : PeriodicTask(std::move(fn), Config()) {}
+    PeriodicTask(Fn fn, const Config& cfg) : fn(std::move(fn)), config(cfg) {}
+
+    ~PeriodicTask() {
+        stop();
+    }
+
+    PeriodicTask(const PeriodicTask&)            = delete;
+    PeriodicTask& operator=(const PeriodicTask&) = delete;
+
+    bool start(const char* name = "periodic", UBaseType_t priority = configMAX_PRIORITIES - 1,
+               configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        if (task) return false;
+        return xTaskCreate(run, name, stackDepth, this, priority, &task) == pdPASS;
+    }
+
+    void stop() {
+        if (task) vTaskDelete(task);
+        task = nullptr;
+    }
+
+    // RAM: объект, стек и TCB задачи из кучи
+    static constexpr size_t footprint(configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        return sizeof(PeriodicTask) + ::footprint::task(stackDepth);
+    }
+
+    // Копия счётчиков и гистограмм
+    periodic::Stats stats() {
+        lock();
+        periodic::Stats copy = collected;
+        unlock();
+        return copy;
+    }
+
+    void resetStats() {
+        lock();
+        collected = periodic::Stats();
+        unlock();
+    }
+
+    TaskHandle_t handle() const {
+        return task;
+    }
+
+  private:
+    Fn              fn;
+    Config          config;
+    TaskHandle_t    task      = nullptr;
+    periodic::Stats collected = {};
+#ifdef ESP_PLATFORM
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+    static void run(void* arg) {
+        static_cast<PeriodicTask*>(arg)->loop();
+    }
+
+    void loop() {
+        constexpr uint64_t TickUs = 1000000ull / configTICK_RATE_HZ;
+
+        TickType_t release = xTaskGetTickCount();
+        if (config.phaseMs) xTaskDelayUntil(&release, pdMS_TO_TICKS(config.phaseMs));
+
+        TickType_t prevRelease = release;
+        uint64_t   prevStart   = 0;
+        bool       first       = true;
+        for (;;) {
+            const uint64_t startUs = periodic::nowUs();
+            fn();
+            const uint64_t endUs = periodic::nowUs();
+
+            const TickType_t late = xTaskGetTickCount() - release;
+            uint32_t         skip = 0;
+            if (late >= PeriodTicks && config.missed == periodic::Missed::Skip) {
+                skip = late / PeriodTicks;
+            }
+
+            lock();
+            ++collected.runs;
+            if (!first) {
+                const int64_t actual   = static_cast<int64_t>(startUs - prevStart);
+                const int64_t expected = static_cast<int64_t>((release - prevRelease) * TickUs);
+                const int64_t dev      = actual > expected ? actual - expected : expected - actual;
+                collected.jitter.record(static_cast<uint32_t>(dev));
+            }
+            collected.exec.record(static_cast<uint32_t>(endUs - startUs));
+            if (endUs - startUs > config.budgetUs) ++collected.overBudget;
+            if (late >= PeriodTicks) ++collected.overruns;
+            collected.skipped += skip;
+            unlock();
+
+            first       = false;
+            prevStart   = startUs;
+            prevRelease = release;
+            release += skip * PeriodTicks;  // остаёмся на сетке
+            xTaskDelayUntil(&release, PeriodTicks);
+        }
+    }
+
+#ifdef ESP_PLATFORM
+    void lock() {
+        taskENTER_CRITICAL(&mux);
+    }
+    void unlock() {
+        taskEXIT_CRITICAL(&mux);
+    }
+#else
+    void lock() {
+        taskENTER_CRITICAL();
+    }
+    void unlock() {
+        taskEXIT_CRITICAL();
+    }
+#endif
+};
+
+#endif  // PERIODIC_TASK_H
+
+/*
+void controlStep() {
+    readSensors();
+    updatePid();
+    writeActuators();
+}
+
+// 1 кГц (нужен configTICK_RATE_HZ 1000), бюджет 400 мкс
+PeriodicTask<1> control(controlStep, {0, periodic::Missed::Skip, 400});
+
+void setup() {
+    control.start("control", configMAX_PRIORITIES - 2);
+}
+
+// Раз в секунду из другой задачи
+auto s = control.stats();
+printf("runs=%u overruns=%u skipped=%u over budget=%u\n", s.runs, s.overruns, s.skipped, s.overBudget);
+printf("exec p99 <= %u us, max %u us; jitter p99 <= %u us\n", s.exec.percentile(99), s.exec.max(),
+       s.jitter.percentile(99));
+
+// Лямбда с захватом — через InplaceFunction, без кучи
+PeriodicTask<500> blinker([&led] { led.toggle(); });
+*/
@@ -0,0 +1,171 @@
+#ifndef PING_PONG_BUFFER_H
+#define PING_PONG_BUFFER_H
+
+// Буферы DMA с передачей владения из прерывания в задачу обработки.
+//
+// N блоков T (N = 2 — классический ping-pong, больше — запас на всплески обработки).
+// N — степень двойки: номер блока — свободно бегущий 32-битный счётчик по модулю N, и при
+// переполнении счётчика последовательность блоков не должна сбиться.
+// DMA пишет в dmaBuffer(). Прерывание завершения блока вызывает completeFromISR():
+// заполненный блок переходит к задаче (сдвиг счётчика + уведомление задачи), а
+// прерывание получает следующий блок для перезапуска DMA. Данные не копируются.
+//
+// Задача берёт блоки по порядку: acquire() — самый старый заполненный, release() — вернуть.
+// Если следующий блок ещё у задачи (она не успела освободить), прерывание получает тот же
+// блок обратно: DMA перезаписывает его, а потеря считается в overruns(). Поэтому задаче
+// принадлежат не больше N - 1 заполненных блоков, ещё один всегда у DMA.
+//
+// Одно прерывание-производитель и одна задача-потребитель. Задача, которую будить,
+// запоминается при первом acquire() или задаётся attach().
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "NotifyIndex.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template <typename T, size_t N = 2>
+class PingPongBuffer {
+    static_assert(N >= 2, "DMA needs at least two buffers");
+    static_assert((N & (N - 1)) == 0, "N must be a power of two: counters wrap at 2^32");
+
+  public:
+    PingPongBuffer() = default;
+
+    PingPongBuffer(const PingPongBuffer&)            = delete;
+    PingPongBuffer& operator=(const PingPongBuffer&) = delete;
+
+    // ---- Сторона DMA ----
+
+    // Блок, в который сейчас пишет DMA (для первого запуска)
+    T* dmaBuffer() {
+        return &blocks[head.load(std::memory_order_relaxed) % N];
+    }
+
+    // Блок заполнен: отдать его задаче и получить следующий для DMA
+    T* completeFromISR(BaseType_t* pxHigherPriorityTaskWoken) {
+        TaskHandle_t wake = nullptr;
+        T*           next = advance(wake);
+        if (wake) notify::library::giveFromISR(wake, pxHigherPriorityTaskWoken);
+        return next;
+    }
+
+    // То же из задачи (программный DMA, тесты)
+    T* complete() {
+        TaskHandle_t wake = nullptr;
+        T*           next = advance(wake);
+        if (wake) notify::library::give(wake);
+        return next;
+    }
+
+    // ---- Сторона задачи ----
+
+    // Задача, которую будит completeFromISR(); по умолчанию — первая вызвавшая acquire()
+    void attach(TaskHandle_t task = xTaskGetCurrentTaskHandle()) {
+        owner.store(task, std::memory_order_relaxed);
+    }
+
+    // Самый старый заполненный блок; ждать до ms. nullptr — за это время блоков не было.
+    // Повторный вызов без release() вернёт тот же блок.
+    T* acquire(uint32_t ms = 0) {
+        if (!owner.load(std::memory_order_relaxed)) attach();
+        const uint32_t   t     = tail.load(std::memory_order_relaxed);
+        const TickType_t start = xTaskGetTickCount();
+        const TickType_t limit = pdMS_TO_TICKS(ms);
+        while (head.load(std::memory_order_acquire) == t) {
+            const TickType_t spent = xTaskGetTickCount() - start;
+            if (spent >= limit) return nullptr;
+            notify::library::take(limit - spent);
+        }
+        return &blocks[t % N];
+    }
+
+    // Вернуть блок, полученный acquire(), для DMA
+    void release() {
+        const uint32_t t = tail.load(std::memory_order_relaxed);
+        configASSERT(head.load(std::memory_order_relaxed) != t);
+        tail.store(t + 1, std::memory_order_release);
+    }
+
+    // ---- Счётчики ----
+
+    // Заполненных блоков ждут обработки (включая взятый задачей)
+    size_t pending() const {
+        return head.load(std::memory_order_relaxed) - tail.load(std::memory_order_relaxed);
+    }
+
+    // Наибольшее pending() с создания
+    size_t peakPending() const {
+        return peak.load(std::memory_order_relaxed);
+    }
+
+    // Блоков передано задаче
+    uint32_t completed() const {
+        return head.load(std::memory_order_relaxed);
+    }
+
+    // Блоков перезаписано, потому что задача не освободила следующий
+    uint32_t overruns() const {
+        return overrunCount.load(std::memory_order_relaxed);
+    }
+
+    static constexpr size_t capacity() {
+        return N;
+    }
+
+  private:
+    T                         blocks[N] = {};
+    std::atomic<uint32_t>     head{0};  // блоков заполнено; head % N — у DMA
+    std::atomic<uint32_t>     tail{0};  // блоков освобождено задачей
+    std::atomic<uint32_t>     overrunCount{0};
+    std::atomic<uint32_t>     peak{0};
+    std::atomic<TaskHandle_t> owner{nullptr};
+
+    // Сдвинуть head; wake — задача, которой передан блок
+    T* advance(TaskHandle_t& wake) {
+        const uint32_t h = head.load(std::memory_order_relaxed);
+        const uint32_t t = tail.load(std::memory_order_acquire);
+        if (h + 1 - t >= N) {
+            // Следующий блок ещё у задачи: DMA перезапишет текущий
+            overrunCount.fetch_add(1, std::memory_order_relaxed);
+            return &blocks[h % N];
+        }
+        head.store(h + 1, std::memory_order_release);
+        if (h + 1 - t > peak.load(std::memory_order_relaxed)) peak.store(h + 1 - t, std::memory_order_relaxed);
+        wake = owner.load(std::memory_order_relaxed);
+        return &blocks[(h + 1) % N];
+    }
+};
+
+#endif  // PING_PONG_BUFFER_H
+
+/*
+using Block = std::array<int16_t, 256>;
+
+static PingPongBuffer<Block, 4> adc;  // 4 блока: до трёх ждут обработки
+
+// Прерывание завершения DMA (половина кольца / дескриптор)
+void IRAM_ATTR onDmaDone() {
+    BaseType_t woken = pdFALSE;
+    Block*     next  = adc.completeFromISR(&woken);
+    dmaStart(next->data(), next->size());  // перезапуск без копирования
+    portYIELD_FROM_ISR(woken);
+}
+
+void processTask(void*) {
+    adc.attach();
+    dmaStart(adc.dmaBuffer()->data(), Block().size());
+    for (;;) {
+        if (Block* b = adc.acquire(100)) {
+            filter(*b);
+            adc.release();
+        }
+        // adc.overruns() — блоки, потерянные из-за медленной обработки
+    }
+}
+*/
@@ -0,0 +1,409 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+// Конвейер из задач, соединённых очередями:
+//
+//   static auto rx = pipeline::source<Frame, 16>("rx")
+//                  | pipeline::stage<2, 8>(decode, "decode")   // 2 задачи, выходная очередь на 8
+//                  | pipeline::stage(filter, "filter")
+//                  | pipeline::sink(store, "store");
+//   rx.start();
+//   rx.push(frame);
+//
+// Очереди, стеки и TCB всех задач — статическая память внутри объекта Pipeline
+// (xQueueCreateStatic / xTaskCreateStatic), размеры задаются параметрами шаблонов.
+//
+// Этап — функция Out(const In&). Вернула std::optional<Out> без значения — элемент
+// отбрасывается. У этапа с несколькими задачами порядок элементов сохраняется:
+// задачи берут элементы с номерами по порядку и отправляют дальше строго по номеру.
+// Давление назад: этап ждёт места в выходной очереди, push() с таймаутом вернёт false.
+//
+// stats() — по каждому этапу обработано, пропускная способность с прошлого вызова,
+// заполнение входной очереди и число ожиданий выходной; pipeline::bottleneck() — узкое место.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "NotifyIndex.h"
+#include "QueueCpp.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if !configSUPPORT_STATIC_ALLOCATION
+#error "Pipeline requires configSUPPORT_STATIC_ALLOCATION"
+#endif
+
+namespace pipeline {
+
+constexpr size_t DefaultDepth = 8;
+constexpr size_t DefaultStack = configMINIMAL_STACK_SIZE * 2;
+
+// Статистика этапа
+struct Stats {
+    const char* name;
+    uint32_t    workers;
+    uint32_t    processed;   // элементов с момента запуска
+    uint32_t    throughput;  // элементов в секунду с прошлого stats()
+    uint32_t    depth;       // сейчас во входной очереди
+    uint32_t    peakDepth;   // максимум во входной очереди с прошлого stats()
+    uint32_t    capacity;
+    uint32_t    stalls;      // ожиданий места в выходной очереди с прошлого stats()
+};
+
+// Узкое место по снимку stats(): этап с самой заполненной входной очередью,
+// который сам не ждал места на выходе. -1 — очередей нет нигде.
+inline int bottleneck(const Stats* s, size_t count) {
+    int      best     = -1;
+    uint64_t bestFill = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (s[i].stalls > 0 || s[i].capacity == 0) continue;
+        uint64_t fill = static_cast<uint64_t>(s[i].peakDepth) * 1000 / s[i].capacity;
+        if (fill > bestFill || (fill == bestFill && fill > 0)) {
+            best     = static_cast<int>(i);
+            bestFill = fill;
+        }
+    }
+    return best;
+}
+
+template <typename T, size_t Depth>
+struct SourceSpec {
+    static_assert(Depth > 0, "source queue depth must be positive");
+    using Type                    = T;
+    static constexpr size_t depth = Depth;
+    const char*             name;
+};
+
+template <typename Fn, size_t Workers, size_t Depth, size_t Stack, bool IsSink>
+struct StageSpec {
+    static_assert(Workers > 0, "stage needs at least one worker");
+    static_assert(Depth > 0, "stage output queue depth must be positive");
+    static constexpr size_t workers = Workers;
+    static constexpr size_t depth   = Depth;  // выходная очередь (вход следующего этапа)
+    static constexpr size_t stack   = Stack;
+    static constexpr bool   isSink  = IsSink;
+    Fn                      fn;
+    const char*             name;
+    UBaseType_t             priority;
+};
+
+// Начало конвейера: элементы T, очередь на Depth
+template <typename T, size_t Depth = DefaultDepth>
+SourceSpec<T, Depth> source(const char* name = "source") {
+    return {name};
+}
+
+// Этап: Workers задач, выходная очередь на Depth
+template <size_t Workers = 1, size_t Depth = DefaultDepth, size_t Stack = DefaultStack, typename Fn>
+StageSpec<Fn, Workers, Depth, Stack, false> stage(Fn fn, const char* name = "stage",
+                                                  UBaseType_t priority = tskIDLE_PRIORITY + 1) {
+    return {std::move(fn), name, priority};
+}
+
+// Конец конвейера: функция void(const In&) в своей задаче
+template <size_t Stack = DefaultStack, typename Fn>
+StageSpec<Fn, 1, 1, Stack, true> sink(Fn fn, const char* name = "sink", UBaseType_t priority = tskIDLE_PRIORITY + 1) {
+    return {std::move(fn), name, priority};
+}
+
+namespace detail {
+
+template <typename T>
+struct Unwrap {
+    using Type                  = T;
+    static constexpr bool Maybe = false;
+};
+template <typename T>
+struct Unwrap<std::optional<T>> {
+    using Type                  = T;
+    static constexpr bool Maybe = true;
+};
+
+// Этап во время работы: входная очередь, задачи, очередь номеров
+template <typename In, size_t InDepth, typename Spec>
+class Stage {
+    using Result = std::invoke_result_t<decltype(Spec::fn)&, const In&>;
+
+  public:
+    using Out = typename Unwrap<Result>::Type;
+    static_assert(Spec::isSink == std::is_void_v<Result>, "only the sink returns void");
+
+    explicit Stage(Spec&& s) : spec(std::move(s)) {
+        if constexpr (Spec::workers > 1) {
+            order = xSemaphoreCreateMutexStatic(&orderBuffer);
+            configASSERT(order);
+        }
+    }
+
+    ~Stage() {
+        stop();
+        if constexpr (Spec::workers > 1) vSemaphoreDelete(order);
+    }
+
+    Stage(const Stage&)            = delete;
+    Stage& operator=(const Stage&) = delete;
+
+    StaticQueue<In, InDepth> input;
+    QueueTypeBase<Out>*      next = nullptr;  // вход следующего этапа
+
+    void start() {
+        for (size_t i = 0; i < Spec::workers; ++i) {
+            tasks[i] = xTaskCreateStatic(run, spec.name, Spec::stack, this, spec.priority, stacks[i], &tcbs[i]);
+            configASSERT(tasks[i]);
+        }
+    }
+
+    void stop() {
+        for (TaskHandle_t& t : tasks) {
+            if (t) vTaskDelete(t);
+            t = nullptr;
+        }
+    }
+
+    void collect(Stats& s, uint32_t elapsedMs) {
+        const uint32_t done = processed.load(std::memory_order_relaxed);
+        s.name              = spec.name;
+        s.workers           = Spec::workers;
+        s.processed         = done;
+        s.throughput        = elapsedMs ? static_cast<uint32_t>((done - reported) * 1000ull / elapsedMs) : 0;
+        s.depth             = static_cast<uint32_t>(input.messagesWaiting());
+        s.peakDepth         = peak.exchange(s.depth, std::memory_order_relaxed);
+        if (s.depth > s.peakDepth) s.peakDepth = s.depth;
+        s.capacity = static_cast<uint32_t>(InDepth);
+        s.stalls   = stallCount.exchange(0, std::memory_order_relaxed);
+        reported   = done;
+    }
+
+  private:
+    Spec                  spec;
+    TaskHandle_t          tasks[Spec::workers] = {};
+    StaticTask_t          tcbs[Spec::workers];
+    StackType_t           stacks[Spec::workers][Spec::stack];
+    SemaphoreHandle_t     order = nullptr;  // выдача номеров при приёме
+    StaticSemaphore_t     orderBuffer;
+    uint32_t              ticket = 0;  // под order
+    std::atomic<uint32_t> turn{0};     // номер, который отправляется следующим
+    std::atomic<uint32_t> processed{0};
+    std::atomic<uint32_t> stallCount{0};
+    std::atomic<uint32_t> peak{0};
+    uint32_t              reported = 0;
+
+    static void run(void* arg) {
+        static_cast<Stage*>(arg)->loop();
+    }
+
+    void loop() {
+        In item;
+        for (;;) {
+            uint32_t my = take(item);
+            if constexpr (Spec::isSink) {
+                spec.fn(item);
+            } else if constexpr (Unwrap<Result>::Maybe) {
+                std::optional<Out> out = spec.fn(item);
+                waitTurn(my);
+                if (out) sendNext(*out);
+                passTurn();
+            } else {
+                Out out = spec.fn(item);
+                waitTurn(my);
+                sendNext(out);
+                passTurn();
+            }
+            processed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Принять элемент и получить его номер
+    uint32_t take(In& item) {
+        uint32_t my = 0;
+        if constexpr (Spec::workers > 1) {
+            xSemaphoreTake(order, portMAX_DELAY);
+            while (!input.receive(item, portMAX_DELAY)) {
+            }
+            my = ticket++;
+            xSemaphoreGive(order);
+        } else {
+            while (!input.receive(item, portMAX_DELAY)) {
+            }
+        }
+        notePeak(static_cast<uint32_t>(input.messagesWaiting()) + 1);
+        return my;
+    }
+
+    void notePeak(uint32_t depth) {
+        uint32_t seen = peak.load(std::memory_order_relaxed);
+        while (depth > seen && !peak.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Давление назад: ждём места в следующей очереди сколько нужно
+    template <typename U>
+    void sendNext(const U& out) {
+        if (next->isFull()) stallCount.fetch_add(1, std::memory_order_relaxed);
+        while (!next->send(out, portMAX_DELAY)) {
+        }
+    }
+
+    void waitTurn(uint32_t my) {
+        if constexpr (Spec::workers > 1) {
+            while (turn.load(std::memory_order_acquire) != my) notify::library::take(portMAX_DELAY);
+        }
+    }
+
+    // Передать очередь отправки следующему номеру и разбудить остальные задачи этапа
+    void passTurn() {
+        if constexpr (Spec::workers > 1) {
+            turn.fetch_add(1, std::memory_order_release);
+            TaskHandle_t self = xTaskGetCurrentTaskHandle();
+            for (TaskHandle_t t : tasks) {
+                if (t && t != self) notify::library::give(t);
+            }
+        }
+    }
+};
+
+// Типы этапов по цепочке: вход следующего — выход предыдущего
+template <typename In, size_t InDepth, typename... Specs>
+struct Stages {
+    using Type = std::tuple<>;
+};
+template <typename In, size_t InDepth, typename Spec, typename... Rest>
+struct Stages<In, InDepth, Spec, Rest...> {
+    using Head = Stage<In, InDepth, Spec>;
+    using Type = decltype(std::tuple_cat(std::declval<std::tuple<Head*>>(),
+                                         std::declval<typename Stages<typename Head::Out, Spec::depth, Rest...>::Type>()));
+};
+
+template <typename Tuple>
+struct Storage;
+template <typename... Ptrs>
+struct Storage<std::tuple<Ptrs...>> {
+    using Type = std::tuple<std::remove_pointer_t<Ptrs>...>;
+};
+
+}  // namespace detail
+
+// Незавершённая цепочка: источник и этапы без стока
+template <typename Source, typename... Specs>
+struct Chain {
+    Source                 source;
+    std::tuple<Specs...>   specs;
+};
+
+}  // namespace pipeline
+
+template <typename Source, typename... Specs>
+class Pipeline {
+    using Stages =
+        typename pipeline::detail::Storage<typename pipeline::detail::Stages<typename Source::Type,
+                                                                            Source::depth, Specs...>::Type>::Type;
+    static constexpr size_t Count = sizeof...(Specs);
+
+  public:
+    using Input = typename Source::Type;
+
+    explicit Pipeline(pipeline::Chain<Source, Specs...>&& chain)
+        : Pipeline(std::move(chain), std::index_sequence_for<Specs...>{}) {}
+
+    // Сначала останавливаются все задачи, потом удаляются очереди
+    ~Pipeline() {
+        std::apply([](auto&... s) { (s.stop(), ...); }, stages);
+    }
+
+    Pipeline(const Pipeline&)            = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    // Запустить задачи всех этапов
+    void start() {
+        std::apply([](auto&... s) { (s.start(), ...); }, stages);
+        lastStats = xTaskGetTickCount();
+    }
+
+    // Положить элемент на вход; false — очередь полна дольше ms
+    bool push(const Input& item, uint32_t ms = 0) {
+        return input().send(item, ms);
+    }
+
+    // Входная очередь (для sendFromISR и т.п.)
+    QueueTypeBase<Input>& input() {
+        return std::get<0>(stages).input;
+    }
+
+    static constexpr size_t stageCount() {
+        return Count;
+    }
+
+    // Всё внутри объекта: очереди, стеки и TCB всех этапов
+    static constexpr size_t footprint() {
+        return sizeof(Pipeline);
+    }
+
+    // Статистика этапов (включая сток) за время с прошлого вызова. Возвращает число этапов.
+    size_t stats(pipeline::Stats* out, size_t max) {
+        const TickType_t now     = xTaskGetTickCount();
+        const uint32_t   elapsed = static_cast<uint32_t>(pdTICKS_TO_MS(now - lastStats));
+        lastStats                = now;
+        pipeline::Stats all[Count];
+        size_t          i = 0;
+        std::apply([&](auto&... s) { (s.collect(all[i++], elapsed), ...); }, stages);
+        for (i = 0; i < Count && i < max; ++i) out[i] = all[i];
+        return Count;
+    }
+
+  private:
+    Stages     stages;
+    TickType_t lastStats = 0;
+
+    template <size_t... I>
+    Pipeline(pipeline::Chain<Source, Specs...>&& chain, std::index_sequence<I...>)
+        : stages(std::move(std::get<I>(chain.specs))...) {
+        link(std::make_index_sequence<Count - 1>{});
+    }
+
+    template <size_t... I>
+    void link(std::index_sequence<I...>) {
+        ((std::get<I>(stages).next = &std::get<I + 1>(stages).input), ...);
+    }
+};
+
+namespace pipeline {
+
+template <typename T, size_t Depth, typename Fn, size_t W, size_t D, size_t S>
+Chain<SourceSpec<T, Depth>, StageSpec<Fn, W, D, S, false>> operator|(SourceSpec<T, Depth> src,
+                                                                     StageSpec<Fn, W, D, S, false> st) {
+    return {src, std::make_tuple(std::move(st))};
+}
+
+template <typename Source, typename... Specs, typename Fn, size_t W, size_t D, size_t S>
+Chain<Source, Specs..., StageSpec<Fn, W, D, S, false>> operator|(Chain<Source, Specs...>&& chain,
+                                                                 StageSpec<Fn, W, D, S, false> st) {
+    return {chain.source, std::tuple_cat(std::move(chain.specs), std::make_tuple(std::move(st)))};
+}
+
+// Сток завершает цепочку и создаёт конвейер на месте (без копирования)
+template <typename Source, typename... Specs, typename Fn, size_t S>
+Pipeline<Source, Specs..., StageSpec<Fn, 1, 1, S, true>> operator|(Chain<Source, Specs...>&& chain,
+                                                                   StageSpec<Fn, 1, 1, S, true> snk) {
+    return Pipeline<Source, Specs..., StageSpec<Fn, 1, 1, S, true>>(Chain<Source, Specs..., StageSpec<Fn, 1, 1, S, true>>{
+        chain.source, std::tuple_cat(std::move(chain.specs), std::make_tuple(std::move(snk)))});
+}
+
+template <typename T, size_t Depth, typename Fn, size_t S>
+Pipeline<SourceSpec<T, Depth>, StageSpec<Fn, 1, 1, S, true>> operator|(SourceSpec<T, Depth> src,
+                                                                       StageSpec<Fn, 1, 1, S, true> snk) {
+    return Pipeline<SourceSpec<T, Depth>, StageSpec<Fn, 1, 1, S, true>>(
+        Chain<SourceSpec<T, Depth>, StageSpec<Fn, 1, 1, S, true>>{src, std::make_tuple(std::move(snk))});
+}
+
+}  // namespace pipeline
+
+#endif  // PIPELINE_H
@@ -5,9 +5,14 @@
 #include <Arduino.h>
 #endif
 
+#include "BlockingDetector.h"
+#include "Footprint.h"
+#include "Trace.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <stdexcept>
 
 class QueueBase {
@@ -15,6 +20,7 @@ class QueueBase {
     QueueBase(QueueHandle_t handle) : handle(handle) {}
     // Очищает очередь
     bool reset() const {
+        traceEvent(trace::Event::QueueReset);
         return xQueueReset(handle) == pdTRUE;
     }
     // Возвращает количество сообщений в очереди
@@ -45,8 +51,14 @@ class QueueBase {
     QueueHandle_t nativeHandle() const {
         return handle;
     }
+    // Имя очереди в трассе (FREERTOS_CPP_TRACE) и в отчёте блокировок (FREERTOS_CPP_BLOCKING)
+    void setTraceName(const char* name) const {
+        trace::name(handle, name);
+        blocking::name(handle, name);
+    }
     virtual ~QueueBase() {
         if (handle) {
+            blocking::forget(handle);
             vQueueDelete(handle);
         }
     }
@@ -54,6 +66,71 @@ class QueueBase {
   protected:
     QueueHandle_t handle;
 
+    // ---- Трассировка: без FREERTOS_CPP_TRACE вызовы исчезают целиком ----
+
+    // Перед блокирующим вызовом: отметить, что задача уходит ждать
+    void traceBeforeSend(TickType_t ticks) const {
+        if constexpr (trace::Enabled) {
+            if (ticks && uxQueueSpacesAvailable(handle) == 0) traceEvent(trace::Event::QueueSendBlock);
+        }
+    }
+    void traceBeforeReceive(TickType_t ticks) const {
+        if constexpr (trace::Enabled) {
+            if (ticks && uxQueueMessagesWaiting(handle) == 0) traceEvent(trace::Event::QueueReceiveBlock);
+        }
+    }
+    // После вызова: результат и глубина очереди
+    bool traceResult(bool ok, trace::Event success, trace::Event failure) const {
+        if constexpr (trace::Enabled) traceEvent(ok ? success : failure);
+        return ok;
+    }
+    bool traceResultFromISR(bool ok, trace::Event success, trace::Event failure) const {
+        if constexpr (trace::Enabled) {
+            trace::emitFromISR(ok ? success : failure, handle, uxQueueMessagesWaitingFromISR(handle));
+        }
+        return ok;
+    }
+    void traceEvent(trace::Event e) const {
+        if constexpr (trace::Enabled) trace::emit(e, handle, uxQueueMessagesWaiting(handle));
+    }
+
+    // ---- Детектор блокировок: без FREERTOS_CPP_BLOCKING остаётся op(ticks) ----
+
+    // op(ticks) — вызов ядра. Сначала без ожидания: детектор видит только настоящие ожидания.
+    // moves — успех сдвигает очередь (send/receive, но не peek).
+    template <class Op>
+    bool watch(TickType_t ticks, blocking::Kind kind, bool moves, Op op) {
+#if FREERTOS_CPP_BLOCKING
+        const bool sending = kind == blocking::Kind::QueueFull;
+        bool       ok      = op(0);
+        if (!ok && ticks) {
+            blocking::Wait wait(handle, kind, sending ? lastReceiver : lastSender);
+            ok = op(ticks);
+        }
+        if (ok && moves) (sending ? lastSender : lastReceiver).capture();
+        return ok;
+#else
+        (void)kind;
+        (void)moves;
+        return op(ticks);
+#endif
+    }
+
+    // Из ISR: поставщик или потребитель становится неизвестным
+    bool watchFromISR(bool ok, bool sending) {
+#if FREERTOS_CPP_BLOCKING
+        if (ok) (sending ? lastSender : lastReceiver).task = nullptr;
+#else
+        (void)sending;
+#endif
+        return ok;
+    }
+
+#if FREERTOS_CPP_BLOCKING
+    blocking::Party lastSender;    // кто последним положил
+    blocking::Party lastReceiver;  // кто последним забрал
+#endif
+
   private:
     QueueBase(QueueBase const&) = delete;
     void operator=(QueueBase const&) = delete;
@@ -69,51 +146,85 @@ class QueueTypeBase : public QueueBase {
   public:
     // Добавляет элемент в очередь
     bool send(const T& item, uint32_t ms = 0) {
-        return xQueueSend(handle, &item, pdMS_TO_TICKS(ms)) == pdTRUE;
+        traceBeforeSend(pdMS_TO_TICKS(ms));
+        const bool ok = watch(pdMS_TO_TICKS(ms), blocking::Kind::QueueFull, true,
+                              [&](TickType_t t) { return xQueueSend(handle, &item, t) == pdTRUE; });
+        return traceResult(ok, trace::Event::QueueSend, trace::Event::QueueSendFail);
     }
+
     // Добавляет элемент в конец очереди
     bool sendToBack(const T& item, uint32_t ms = 0) {
-        return xQueueSendToBack(handle, &item, pdMS_TO_TICKS(ms)) == pdTRUE;
+        traceBeforeSend(pdMS_TO_TICKS(ms));
+        const bool ok = watch(pdMS_TO_TICKS(ms), blocking::Kind::QueueFull, true,
+                              [&](TickType_t t) { return xQueueSendToBack(handle, &item, t) == pdTRUE; });
+        return traceResult(ok, trace::Event::QueueSend, trace::Event::QueueSendFail);
     }
+
     // Добавляет элемент в начало очереди
     bool sendToFront(const T& item, uint32_t ms = 0) {
-        return xQueueSendToFront(handle, &item, pdMS_TO_TICKS(ms)) == pdTRUE;
+        traceBeforeSend(pdMS_TO_TICKS(ms));
+        const bool ok = watch(pdMS_TO_TICKS(ms), blocking::Kind::QueueFull, true,
+                              [&](TickType_t t) { return xQueueSendToFront(handle, &item, t) == pdTRUE; });
+        return traceResult(ok, trace::Event::QueueSend, trace::Event::QueueSendFail);
     }
+
     // Получает элемент из очереди
     bool receive(T& item, uint32_t ms = 0) {
-        return xQueueReceive(handle, &item, pdMS_TO_TICKS(ms)) == pdTRUE;
+        traceBeforeReceive(pdMS_TO_TICKS(ms));
+        const bool ok = watch(pdMS_TO_TICKS(ms), blocking::Kind::QueueEmpty, true,
+                              [&](TickType_t t) { return xQueueReceive(handle, &item, t) == pdTRUE; });
+        return traceResult(ok, trace::Event::QueueReceive, trace::Event::QueueReceiveFail);
     }
+
     // Просматривает первый элемент очереди без удаления
     bool peek(T& item, uint32_t ms = 0) {
-        return xQueuePeek(handle, &item, pdMS_TO_TICKS(ms)) == pdTRUE;
+        traceBeforeReceive(pdMS_TO_TICKS(ms));
+        const bool ok = watch(pdMS_TO_TICKS(ms), blocking::Kind::QueueEmpty, false,
+                              [&](TickType_t t) { return xQueuePeek(handle, &item, t) == pdTRUE; });
+        return traceResult(ok, trace::Event::QueuePeek, trace::Event::QueueReceiveFail);
     }
+
     // Перезаписывает элемент в очереди
     bool overwrite(const T& item) {
-        return xQueueOverwrite(handle, &item) == pdTRUE;
+        const bool ok = watch(0, blocking::Kind::QueueFull, true,
+                              [&](TickType_t) { return xQueueOverwrite(handle, &item) == pdTRUE; });
+        return traceResult(ok, trace::Event::QueueSend, trace::Event::QueueSendFail);
     }
+
     // Добавляет элемент в очередь из прерывания
     bool sendFromISR(const T& item, BaseType_t* pxHigherPriorityTaskWoken) {
-        return xQueueSendFromISR(handle, &item, pxHigherPriorityTaskWoken) == pdTRUE;
+        const bool ok = xQueueSendFromISR(handle, &item, pxHigherPriorityTaskWoken) == pdTRUE;
+        return traceResultFromISR(watchFromISR(ok, true), trace::Event::QueueSend, trace::Event::QueueSendFail);
     }
+
     // Добавляет элемент в конец очереди из прерывания
     bool sendToBackFromISR(const T& item, BaseType_t* pxHigherPriorityTaskWoken) {
-        return xQueueSendToBackFromISR(handle, &item, pxHigherPriorityTaskWoken) == pdTRUE;
+        const bool ok = xQueueSendToBackFromISR(handle, &item, pxHigherPriorityTaskWoken) == pdTRUE;
+        return traceResultFromISR(watchFromISR(ok, true), trace::Event::QueueSend, trace::Event::QueueSendFail);
     }
+
     // Добавляет элемент в начало очереди из прерывания
     bool sendToFrontFromISR(const T& item, BaseType_t* pxHigherPriorityTaskWoken) {
-        return xQueueSendToFrontFromISR(handle, &item, pxHigherPriorityTaskWoken) == pdTRUE;
+        const bool ok = xQueueSendToFrontFromISR(handle, &item, pxHigherPriorityTaskWoken) == pdTRUE;
+        return traceResultFromISR(watchFromISR(ok, true), trace::Event::QueueSend, trace::Event::QueueSendFail);
     }
+
     // Получает элемент из очереди из прерывания
     bool receiveFromISR(T& item, BaseType_t* pxHigherPriorityTaskWoken) {
-        return xQueueReceiveFromISR(handle, &item, pxHigherPriorityTaskWoken) == pdTRUE;
+        const bool ok = xQueueReceiveFromISR(handle, &item, pxHigherPriorityTaskWoken) == pdTRUE;
+        return traceResultFromISR(watchFromISR(ok, false), trace::Event::QueueReceive, trace::Event::QueueReceiveFail);
     }
+
     // Просматривает первый элемент очереди из прерывания без удаления
     bool peekFromISR(T& item) {
-        return xQueuePeekFromISR(handle, &item) == pdTRUE;
+        return traceResultFromISR(xQueuePeekFromISR(handle, &item) == pdTRUE, trace::Event::QueuePeek,
+                                  trace::Event::QueueReceiveFail);
     }
+
     // Перезаписывает элемент в очереди из прерывания
     bool overwriteFromISR(const T& item, BaseType_t* pxHigherPriorityTaskWoken) {
-        return xQueueOverwriteFromISR(handle, &item, pxHigherPriorityTaskWoken) == pdTRUE;
+        const bool ok = xQueueOverwriteFromISR(handle, &item, pxHigherPriorityTaskWoken) == pdTRUE;
+        return traceResultFromISR(watchFromISR(ok, true), trace::Event::QueueSend, trace::Event::QueueSendFail);
     }
 };
 
@@ -130,7 +241,40 @@ class Queue : public QueueTypeBase<T> {
             abort();
         }
     };
+
+    // RAM очереди на length элементов: объект и блок из кучи
+    static constexpr size_t footprint(size_t length) {
+        return sizeof(Queue) + ::footprint::queue(length, sizeof(T));
+    }
+};
+
+#if configSUPPORT_STATIC_ALLOCATION
+// Очередь со статической памятью: длина задаётся при компиляции, куча не нужна
+template <class T, size_t Length>
+class StaticQueue : public QueueTypeBase<T> {
+  public:
+    StaticQueue()
+        : QueueTypeBase<T>(xQueueCreateStatic(Length, sizeof(T), storage, &control)) {
+        if (this->handle == nullptr) {
+            configASSERT(false && "Failed to create static queue");
+            abort();
+        }
+    }
+
+    static constexpr size_t capacity() {
+        return Length;
+    }
+
+    // Всё внутри объекта: буфер и управляющий блок
+    static constexpr size_t footprint() {
+        return sizeof(StaticQueue);
+    }
+
+  private:
+    alignas(T) uint8_t storage[Length * sizeof(T)];
+    StaticQueue_t      control;
 };
+#endif
 #endif  // QUEUE_CPP_H
 
 
@@ -0,0 +1,180 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+// Ограничитель частоты «ведро токенов».
+//
+// В ведре до burst токенов, пополнение — rate токенов в секунду. Пополнение считается
+// лениво по счётчику тиков при каждом обращении: ни таймера, ни служебной задачи.
+// Дробные токены не теряются — кредит хранится в долях 1/configTICK_RATE_HZ токена.
+// rate == 0 — без ограничений.
+//
+// Состояние защищено короткой критической секцией, поэтому есть варианты FromISR.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cstdint>
+
+class RateLimiter {
+  public:
+    RateLimiter(uint32_t ratePerSecond, uint32_t burst) {
+        configure(ratePerSecond, burst);
+    }
+
+    RateLimiter(const RateLimiter&)            = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // Сменить параметры; ведро снова полное
+    void configure(uint32_t ratePerSecond, uint32_t burst) {
+        lock();
+        rate     = ratePerSecond;
+        capacity = static_cast<uint64_t>(burst) * configTICK_RATE_HZ;
+        credit   = capacity;
+        last     = xTaskGetTickCount();
+        unlock();
+    }
+
+    // Взять n токенов без ожидания
+    bool tryAcquire(uint32_t n = 1) {
+        lock();
+        bool ok = take(xTaskGetTickCount(), n);
+        unlock();
+        return ok;
+    }
+
+    // Взять n токенов из прерывания
+    bool tryAcquireFromISR(uint32_t n = 1) {
+        UBaseType_t saved = lockFromISR();
+        bool        ok    = take(xTaskGetTickCountFromISR(), n);
+        unlockFromISR(saved);
+        return ok;
+    }
+
+    // Взять n токенов, подождав до ms. Если токены не накопятся к концу ожидания,
+    // false возвращается сразу, без сна.
+    bool acquire(uint32_t n, uint32_t ms) {
+        TickType_t left = pdMS_TO_TICKS(ms);
+        for (;;) {
+            lock();
+            bool       ok   = take(xTaskGetTickCount(), n);
+            TickType_t wait = ok ? 0 : waitTicks(n);
+            unlock();
+            if (ok) return true;
+            if (wait > left) return false;
+            vTaskDelay(wait);
+            left -= wait;
+        }
+    }
+
+    // Через сколько тиков будет n токенов (0 — уже есть, portMAX_DELAY — никогда)
+    TickType_t delayFor(uint32_t n = 1) {
+        lock();
+        refill(xTaskGetTickCount());
+        TickType_t wait = !rate || credit >= need(n) ? 0 : waitTicks(n);
+        unlock();
+        return wait;
+    }
+
+    // Целых токенов в ведре
+    uint32_t available() {
+        lock();
+        refill(xTaskGetTickCount());
+        uint32_t n = rate ? static_cast<uint32_t>(credit / configTICK_RATE_HZ) : UINT32_MAX;
+        unlock();
+        return n;
+    }
+
+    uint32_t ratePerSecond() const {
+        return rate;
+    }
+
+  private:
+    uint32_t   rate     = 0;
+    uint64_t   capacity = 0;  // burst в долях токена
+    uint64_t   credit   = 0;  // доли токена: 1 токен = configTICK_RATE_HZ
+    TickType_t last     = 0;
+#ifdef ESP_PLATFORM
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+    static uint64_t need(uint32_t n) {
+        return static_cast<uint64_t>(n) * configTICK_RATE_HZ;
+    }
+
+    // За тик прибавляется rate долей
+    void refill(TickType_t now) {
+        TickType_t elapsed = now - last;
+        last               = now;
+        if (!rate || !elapsed) return;
+        uint64_t room = capacity - credit;
+        uint64_t add  = static_cast<uint64_t>(elapsed) * rate;
+        credit += add < room ? add : room;
+    }
+
+    bool take(TickType_t now, uint32_t n) {
+        if (!rate) return true;
+        refill(now);
+        if (credit < need(n)) return false;
+        credit -= need(n);
+        return true;
+    }
+
+    // Тиков до накопления n токенов (кредита сейчас не хватает); n > burst — никогда
+    TickType_t waitTicks(uint32_t n) const {
+        if (need(n) > capacity) return portMAX_DELAY;
+        uint64_t missing = need(n) - credit;
+        return static_cast<TickType_t>((missing + rate - 1) / rate);
+    }
+
+#ifdef ESP_PLATFORM
+    void lock() {
+        taskENTER_CRITICAL(&mux);
+    }
+    void unlock() {
+        taskEXIT_CRITICAL(&mux);
+    }
+    UBaseType_t lockFromISR() {
+        taskENTER_CRITICAL_ISR(&mux);
+        return 0;
+    }
+    void unlockFromISR(UBaseType_t) {
+        taskEXIT_CRITICAL_ISR(&mux);
+    }
+#else
+    void lock() {
+        taskENTER_CRITICAL();
+    }
+    void unlock() {
+        taskEXIT_CRITICAL();
+    }
+    UBaseType_t lockFromISR() {
+        return taskENTER_CRITICAL_FROM_ISR();
+    }
+    void unlockFromISR(UBaseType_t saved) {
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+    }
+#endif
+};
+
+#endif  // RATE_LIMITER_H
+
+/*
+RateLimiter telemetry(20, 5);  // 20 сообщений в секунду, всплеск до 5
+
+void telemetryTask(void*) {
+    for (;;) {
+        Sample s = read();
+        if (telemetry.tryAcquire()) {
+            uplink.send(s);
+        } else {
+            ++skipped;  // лишнее не отправляем
+        }
+    }
+}
+
+// Или дождаться токена, но не дольше 100 мс
+if (telemetry.acquire(1, 100)) uplink.send(s);
+*/
@@ -0,0 +1,364 @@
+#ifndef REMOTE_QUEUE_BRIDGE_H
+#define REMOTE_QUEUE_BRIDGE_H
+
+// Мост очереди между узлами: элементы Queue<T> на одном узле попадают в Queue<T>
+// на другом через ByteTransport (UART, SPI, сокет).
+//
+// Отправляющая сторона (startSender) копит элементы в пачку, как Nagle: пачка уходит,
+// когда набралось batch элементов или с первого элемента прошло linger мс. Одна пачка —
+// один кадр и одна запись в транспорт вместо записи на каждый элемент.
+//
+// Поток регулируется кредитами: принимающая сторона (startReceiver) разрешает столько
+// элементов, сколько свободно в её очереди, и добавляет кредит по мере того, как
+// потребитель её разбирает. Без кредита отправитель не шлёт, элементы ждут в исходной
+// очереди — производители получают обычное противодавление Queue<T>.
+//
+// Кадр: A5 5A, тип, 0, длина полезной нагрузки (2 байта LE), нагрузка, CRC-16/CCITT
+// (от типа до конца нагрузки). Данные: номер последнего элемента пачки с начала
+// работы (4 байта) и элементы; кредит: сколько элементов всего разрешено (4 байта).
+// Оба счётчика абсолютные, поэтому потерянный кадр не ломает учёт: по разрыву номеров
+// принимающая сторона считает потерянные элементы, следующий кредит заменяет пропавший.
+// Испорченный кадр пропускается с поиском следующего A5 5A.
+//
+// Если транспорт сообщил, что связь закрыта (ByteTransport::Closed), задача моста больше
+// не опрашивает его и спит до stop(); closed() становится true.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "ByteTransport.h"
+#include "Footprint.h"
+#include "QueueCpp.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace bridge {
+
+// Счётчики стороны моста с момента старта
+struct Stats {
+    uint32_t items;      // элементов отправлено / принято
+    uint32_t batches;    // кадров данных
+    uint32_t wireBytes;  // байт кадров отправлено (данные и кредиты)
+    uint32_t stalls;     // отправитель упёрся в кредит
+    uint32_t lost;       // приём: разрывы в номерах; отправка: элементы пачек, не записанных в транспорт
+    uint32_t overflow;   // принимающая сторона: очередь полна вопреки кредиту
+    uint32_t badFrames;  // испорченные кадры
+};
+
+struct Config {
+    uint16_t batch    = 16;   // элементов в пачке, не больше MaxBatch
+    uint32_t lingerMs = 2;    // сколько ждать добора пачки после первого элемента
+    uint32_t creditMs = 100;  // повтор кредита на простое (на случай его потери)
+};
+
+enum FrameType : uint8_t { Data = 1, Credit = 2 };
+
+constexpr uint8_t Sync0   = 0xA5;
+constexpr uint8_t Sync1   = 0x5A;
+constexpr size_t  Header  = 6;
+constexpr size_t  Trailer = 2;
+
+// CRC-16/CCITT-FALSE
+inline uint16_t crc16(const uint8_t* p, size_t n) {
+    uint16_t crc = 0xFFFF;
+    while (n--) {
+        crc ^= static_cast<uint16_t>(*p++) << 8;
+        for (int i = 0; i < 8; ++i) crc = crc & 0x8000 ? static_cast<uint16_t>(crc << 1 ^ 0x1021) : crc << 1;
+    }
+    return crc;
+}
+
+inline void put32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+inline uint32_t get32(const uint8_t* p) {
+    return p[0] | p[1] << 8 | p[2] << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+}  // namespace bridge
+
+template <typename T, size_t MaxBatch = 32>
+class RemoteQueueBridge {
+    static_assert(std::is_trivially_copyable<T>::value, "RemoteQueueBridge items must be trivially copyable");
+    static_assert(MaxBatch > 0, "RemoteQueueBridge needs room for one item");
+
+  public:
+    static constexpr size_t MaxPayload = 4 + MaxBatch * sizeof(T);
+    static constexpr size_t MaxFrame   = bridge::Header + MaxPayload + bridge::Trailer;
+    static_assert(MaxPayload <= 0xFFFF, "RemoteQueueBridge batch does not fit a frame");
+
+    explicit RemoteQueueBridge(ByteTransport* link, const bridge::Config& config = bridge::Config())
+        : link(link), config(config) {
+        configASSERT(link && config.batch > 0 && config.batch <= MaxBatch);
+    }
+
+    ~RemoteQueueBridge() {
+        stop();
+    }
+
+    RemoteQueueBridge(const RemoteQueueBridge&)            = delete;
+    RemoteQueueBridge& operator=(const RemoteQueueBridge&) = delete;
+
+    // Забирать элементы из source и отправлять пачками
+    bool startSender(QueueTypeBase<T>& source, const char* name = "bridge_tx", UBaseType_t priority = 2,
+                     configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        queue = &source;
+        return xTaskCreate(runSender, name, stackDepth, this, priority, &worker) == pdPASS;
+    }
+
+    // Принимать пачки и класть элементы в sink; кредит — по свободному месту в sink
+    bool startReceiver(QueueTypeBase<T>& sink, const char* name = "bridge_rx", UBaseType_t priority = 2,
+                       configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        queue = &sink;
+        return xTaskCreate(runReceiver, name, stackDepth, this, priority, &worker) == pdPASS;
+    }
+
+    void stop() {
+        if (worker) vTaskDelete(worker);
+        worker = nullptr;
+    }
+
+    // Транспорт сообщил о разрыве, задача моста остановилась
+    bool closed() const {
+        return linkClosed.load(std::memory_order_relaxed);
+    }
+
+    // Отправитель: сколько ещё элементов можно послать без нового кредита
+    uint32_t credit() const {
+        return granted.load(std::memory_order_relaxed) - counted.load(std::memory_order_relaxed);
+    }
+
+    bridge::Stats stats() const {
+        return bridge::Stats{counters.items.load(std::memory_order_relaxed),
+                             counters.batches.load(std::memory_order_relaxed),
+                             counters.wireBytes.load(std::memory_order_relaxed),
+                             counters.stalls.load(std::memory_order_relaxed),
+                             counters.lost.load(std::memory_order_relaxed),
+                             counters.overflow.load(std::memory_order_relaxed),
+                             counters.badFrames.load(std::memory_order_relaxed)};
+    }
+
+    // RAM моста: объект с буферами кадров, стек и TCB служебной задачи
+    static constexpr size_t footprint(configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        return sizeof(RemoteQueueBridge) + ::footprint::task(stackDepth);
+    }
+
+  private:
+    ByteTransport*    link;
+    bridge::Config    config;
+    QueueTypeBase<T>* queue  = nullptr;
+    TaskHandle_t      worker = nullptr;
+
+    // Отправитель: разрешено всего и отправлено; получатель: разрешено и номер последнего
+    std::atomic<uint32_t> granted{0};
+    std::atomic<uint32_t> counted{0};
+    std::atomic<bool>     linkClosed{false};
+
+    uint8_t tx[MaxFrame];
+    uint8_t rx[MaxFrame * 2];
+    size_t  have = 0;
+
+    struct {
+        std::atomic<uint32_t> items{0};
+        std::atomic<uint32_t> batches{0};
+        std::atomic<uint32_t> wireBytes{0};
+        std::atomic<uint32_t> stalls{0};
+        std::atomic<uint32_t> lost{0};
+        std::atomic<uint32_t> overflow{0};
+        std::atomic<uint32_t> badFrames{0};
+    } counters;
+
+    static void bump(std::atomic<uint32_t>& c, uint32_t n = 1) {
+        c.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    // ---- Кадры ----
+
+    bool sendFrame(bridge::FrameType type, size_t payload) {
+        tx[0] = bridge::Sync0;
+        tx[1] = bridge::Sync1;
+        tx[2] = type;
+        tx[3] = 0;
+        tx[4] = static_cast<uint8_t>(payload);
+        tx[5] = static_cast<uint8_t>(payload >> 8);
+        const uint16_t crc = bridge::crc16(tx + 2, bridge::Header - 2 + payload);
+        tx[bridge::Header + payload]     = static_cast<uint8_t>(crc);
+        tx[bridge::Header + payload + 1] = static_cast<uint8_t>(crc >> 8);
+        const size_t len                 = bridge::Header + payload + bridge::Trailer;
+        bump(counters.wireBytes, static_cast<uint32_t>(len));
+        return link->write(tx, len);
+    }
+
+    // Прочитать из транспорта, ожидая до ms, и разобрать все целые кадры. false — связь закрыта.
+    bool poll(uint32_t ms) {
+        const size_t n = link->read(rx + have, sizeof(rx) - have, ms);
+        if (n == ByteTransport::Closed) {
+            linkClosed.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        have += n;
+        size_t at = 0;
+        while (have - at >= bridge::Header) {
+            const uint8_t* f = rx + at;
+            if (f[0] != bridge::Sync0 || f[1] != bridge::Sync1) {
+                ++at;  // поиск начала кадра
+                continue;
+            }
+            const size_t payload = f[4] | f[5] << 8;
+            if (payload > MaxPayload) {
+                bump(counters.badFrames);
+                ++at;
+                continue;
+            }
+            const size_t len = bridge::Header + payload + bridge::Trailer;
+            if (have - at < len) break;
+            const uint16_t crc = f[len - 2] | f[len - 1] << 8;
+            if (bridge::crc16(f + 2, bridge::Header - 2 + payload) != crc) {
+                bump(counters.badFrames);
+                ++at;
+                continue;
+            }
+            onFrame(f[2], f + bridge::Header, payload);
+            at += len;
+        }
+        std::memmove(rx, rx + at, have - at);
+        have -= at;
+        return true;
+    }
+
+    // Связь закрыта: не крутиться на пустых чтениях, ждать stop()
+    [[noreturn]] static void park() {
+        for (;;) vTaskDelay(portMAX_DELAY);
+    }
+
+    void onFrame(uint8_t type, const uint8_t* payload, size_t len) {
+        if (len < 4) {
+            bump(counters.badFrames);
+            return;
+        }
+        const uint32_t value = bridge::get32(payload);
+        if (type == bridge::Credit) {
+            // Кредиты могут прийти не по порядку только после потерь — берём больший
+            if (static_cast<int32_t>(value - granted.load(std::memory_order_relaxed)) > 0) {
+                granted.store(value, std::memory_order_relaxed);
+            }
+        } else if (type == bridge::Data && (len - 4) % sizeof(T) == 0) {
+            deliver(value, payload + 4, static_cast<uint32_t>((len - 4) / sizeof(T)));
+        } else {
+            bump(counters.badFrames);
+        }
+    }
+
+    // ---- Отправитель ----
+
+    static void runSender(void* arg) {
+        static_cast<RemoteQueueBridge*>(arg)->senderLoop();
+    }
+
+    void senderLoop() {
+        for (;;) {
+            if (!poll(0)) park();
+            const uint32_t avail = credit();
+            if (avail == 0) {
+                bump(counters.stalls);
+                while (credit() == 0) {
+                    if (!poll(config.creditMs)) park();
+                }
+                continue;
+            }
+            const uint32_t limit = avail < config.batch ? avail : config.batch;
+            uint8_t*       items = tx + bridge::Header + 4;
+            T              item;
+            if (!queue->receive(item, config.creditMs)) continue;
+            std::memcpy(items, &item, sizeof(T));
+            uint32_t n = 1;
+
+            // Добрать пачку: не дольше linger с первого элемента
+            const TickType_t start = xTaskGetTickCount();
+            const TickType_t limitTicks = pdMS_TO_TICKS(config.lingerMs);
+            while (n < limit) {
+                const TickType_t spent = xTaskGetTickCount() - start;
+                const uint32_t   wait  = spent < limitTicks ? pdTICKS_TO_MS(limitTicks - spent) : 0;
+                if (!queue->receive(item, wait)) break;
+                std::memcpy(items + n * sizeof(T), &item, sizeof(T));
+                ++n;
+            }
+
+            const uint32_t last = counted.load(std::memory_order_relaxed) + n;
+            bridge::put32(tx + bridge::Header, last);
+            if (!sendFrame(bridge::Data, 4 + n * sizeof(T))) {
+                bump(counters.lost, n);  // элементы потеряны вместе со связью
+                continue;
+            }
+            counted.store(last, std::memory_order_relaxed);
+            bump(counters.items, n);
+            bump(counters.batches);
+        }
+    }
+
+    // ---- Получатель ----
+
+    static void runReceiver(void* arg) {
+        static_cast<RemoteQueueBridge*>(arg)->receiverLoop();
+    }
+
+    void receiverLoop() {
+        grant(true);
+        for (;;) {
+            const uint32_t before = counted.load(std::memory_order_relaxed);
+            if (!poll(config.creditMs)) park();
+            // Простой: повторить кредит на случай, если прошлый не дошёл
+            grant(counted.load(std::memory_order_relaxed) == before);
+        }
+    }
+
+    void deliver(uint32_t last, const uint8_t* items, uint32_t n) {
+        const uint32_t first = last - n;
+        const uint32_t seen  = counted.load(std::memory_order_relaxed);
+        if (first != seen) bump(counters.lost, first - seen);
+        counted.store(last, std::memory_order_relaxed);
+        for (uint32_t i = 0; i < n; ++i) {
+            T item;
+            std::memcpy(&item, items + i * sizeof(T), sizeof(T));
+            if (!queue->send(item)) bump(counters.overflow);
+        }
+        bump(counters.items, n);
+        bump(counters.batches);
+    }
+
+    // Разрешить столько, сколько свободно в очереди сверх ещё не пришедшего
+    void grant(bool force) {
+        const uint32_t arrived     = counted.load(std::memory_order_relaxed);
+        const uint32_t outstanding = granted.load(std::memory_order_relaxed) - arrived;
+        const uint32_t spaces      = static_cast<uint32_t>(queue->spacesAvailable());
+        const uint32_t fresh       = spaces > outstanding ? spaces - outstanding : 0;
+        // Мелкие прибавки копятся до пачки, чтобы не слать кредит на каждый элемент
+        if (!force && (fresh == 0 || (fresh < config.batch && outstanding > 0))) return;
+        granted.store(arrived + (spaces > outstanding ? spaces : outstanding), std::memory_order_relaxed);
+        bridge::put32(tx + bridge::Header, granted.load(std::memory_order_relaxed));
+        sendFrame(bridge::Credit, 4);
+    }
+};
+
+#endif  // REMOTE_QUEUE_BRIDGE_H
+
+/*
+// Узел A: всё, что кладут в outbox, уходит по UART
+Queue<Reading>                    outbox(64);
+UartTransport                     uart(UART_NUM_1);
+RemoteQueueBridge<Reading, 32>    tx(&uart, bridge::Config{32, 5, 100});  // пачка 32, linger 5 мс
+tx.startSender(outbox);
+
+// Узел B: элементы появляются в inbox, кредит — по её свободному месту
+Queue<Reading>                    inbox(128);
+RemoteQueueBridge<Reading, 32>    rx(&uart, bridge::Config{32, 5, 100});
+rx.startReceiver(inbox);
+inbox.receive(reading, portMAX_DELAY);
+*/
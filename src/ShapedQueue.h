@@ -0,0 +1,210 @@
+#ifndef SHAPED_QUEUE_H
+#define SHAPED_QUEUE_H
+
+// Очередь с формированием трафика: несколько классов отправителей делят одного получателя.
+//
+// У каждого класса своя очередь StaticQueue<T, Depth> и свой RateLimiter. send() сначала
+// берёт токен: нет токена и ms == 0 — отказ (rejected), иначе ждёт токен (delayed) и затем
+// место в очереди; очередь так и не освободилась — потеря (dropped).
+//
+// receive() выбирает класс по взвешенному циклическому обходу (deficit round robin): подряд
+// из класса берётся до weight элементов, пустой класс пропускается. Элемент класса с весом w
+// ждёт не больше суммы весов остальных классов выборок — как бы ни заваливали очередь другие.
+// Счётный семафор хранит общее число элементов, выбор класса идёт под мьютексом.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "QueueCpp.h"
+#include "RateLimiter.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if !configSUPPORT_STATIC_ALLOCATION
+#error "ShapedQueue requires configSUPPORT_STATIC_ALLOCATION"
+#endif
+
+template <typename T, size_t Classes, size_t Depth>
+class ShapedQueue {
+    static_assert(Classes > 0 && Depth > 0, "ShapedQueue needs at least one class and slot");
+
+  public:
+    // Счётчики класса с момента создания
+    struct ClassStats {
+        uint32_t sent;      // попало в очередь
+        uint32_t rejected;  // нет токена и ждать нельзя или токен не накопился за ms
+        uint32_t delayed;   // пришлось ждать токен
+        uint32_t dropped;   // токен был, но очередь класса полна
+        uint32_t received;
+    };
+
+    // По умолчанию все классы без ограничения частоты и с весом 1
+    ShapedQueue() {
+        items = xSemaphoreCreateCountingStatic(Classes * Depth, 0, &itemsBuffer);
+        pick  = xSemaphoreCreateMutexStatic(&pickBuffer);
+        if (items == nullptr || pick == nullptr) {
+            configASSERT(false && "Failed to create shaped queue");
+            abort();
+        }
+    }
+
+    ~ShapedQueue() {
+        vSemaphoreDelete(pick);
+        vSemaphoreDelete(items);
+    }
+
+    ShapedQueue(const ShapedQueue&)            = delete;
+    ShapedQueue& operator=(const ShapedQueue&) = delete;
+
+    // Частота (0 — без ограничения), всплеск и вес класса при выборке
+    void configure(size_t cls, uint32_t ratePerSecond, uint32_t burst, uint32_t weight = 1) {
+        configASSERT(cls < Classes && weight > 0);
+        lanes[cls].limiter.configure(ratePerSecond, burst);
+        lanes[cls].weight = weight ? weight : 1;
+    }
+
+    // Отправить от имени класса, ожидая токен и место в очереди в сумме не дольше ms
+    bool send(size_t cls, const T& item, uint32_t ms = 0) {
+        configASSERT(cls < Classes);
+        Lane&            lane  = lanes[cls];
+        const TickType_t start = xTaskGetTickCount();
+        if (!lane.limiter.tryAcquire()) {
+            if (ms == 0 || !lane.limiter.acquire(1, ms)) {
+                lane.rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            lane.delayed.fetch_add(1, std::memory_order_relaxed);
+        }
+        const uint32_t spent = pdTICKS_TO_MS(xTaskGetTickCount() - start);
+        if (!lane.queue.send(item, spent < ms ? ms - spent : 0)) {
+            lane.dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        lane.sent.fetch_add(1, std::memory_order_relaxed);
+        xSemaphoreGive(items);
+        return true;
+    }
+
+    // Отправить из прерывания: без ожидания, нет токена — отказ
+    bool sendFromISR(size_t cls, const T& item, BaseType_t* pxHigherPriorityTaskWoken) {
+        configASSERT(cls < Classes);
+        Lane& lane = lanes[cls];
+        if (!lane.limiter.tryAcquireFromISR()) {
+            lane.rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (!lane.queue.sendFromISR(item, pxHigherPriorityTaskWoken)) {
+            lane.dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        lane.sent.fetch_add(1, std::memory_order_relaxed);
+        xSemaphoreGiveFromISR(items, pxHigherPriorityTaskWoken);
+        return true;
+    }
+
+    // Получить следующий элемент по взвешенному обходу; cls — класс, откуда он взят
+    bool receive(T& item, uint32_t ms = 0, size_t* cls = nullptr) {
+        if (xSemaphoreTake(items, pdMS_TO_TICKS(ms)) != pdTRUE) return false;
+        xSemaphoreTake(pick, portMAX_DELAY);
+        // Семафор выдан — элемент есть хотя бы в одной очереди, обход найдёт его за круг
+        bool found = false;
+        for (size_t tries = 0; tries <= Classes && !found; ++tries) {
+            const size_t c    = cursor;
+            Lane&        lane = lanes[c];
+            if (credit[c] == 0) credit[c] = lane.weight;
+            if (lane.queue.receive(item, 0)) {
+                found = true;
+                lane.received.fetch_add(1, std::memory_order_relaxed);
+                if (cls) *cls = c;
+                if (--credit[c] > 0) continue;
+            } else {
+                credit[c] = 0;  // пустой класс не копит кредит
+            }
+            cursor = (c + 1) % Classes;
+        }
+        xSemaphoreGive(pick);
+        configASSERT(found);
+        return found;
+    }
+
+    // Элементов во всех очередях
+    size_t messagesWaiting() const {
+        return uxSemaphoreGetCount(items);
+    }
+
+    ClassStats stats(size_t cls) const {
+        configASSERT(cls < Classes);
+        const Lane& lane = lanes[cls];
+        return {lane.sent.load(std::memory_order_relaxed), lane.rejected.load(std::memory_order_relaxed),
+                lane.delayed.load(std::memory_order_relaxed), lane.dropped.load(std::memory_order_relaxed),
+                lane.received.load(std::memory_order_relaxed)};
+    }
+
+    // Ограничитель класса: посмотреть токены, сменить параметры на ходу
+    RateLimiter& limiter(size_t cls) {
+        configASSERT(cls < Classes);
+        return lanes[cls].limiter;
+    }
+
+    static constexpr size_t classes() {
+        return Classes;
+    }
+
+    // Всё внутри объекта: очереди классов и семафоры
+    static constexpr size_t footprint() {
+        return sizeof(ShapedQueue);
+    }
+
+  private:
+    struct Lane {
+        StaticQueue<T, Depth> queue;
+        RateLimiter           limiter{0, 0};
+        uint32_t              weight = 1;
+        std::atomic<uint32_t> sent{0};
+        std::atomic<uint32_t> rejected{0};
+        std::atomic<uint32_t> delayed{0};
+        std::atomic<uint32_t> dropped{0};
+        std::atomic<uint32_t> received{0};
+    };
+
+    Lane              lanes[Classes];
+    uint32_t          credit[Classes] = {};  // под pick: сколько ещё взять из класса подряд
+    size_t            cursor          = 0;
+    SemaphoreHandle_t items           = nullptr;  // общее число элементов
+    SemaphoreHandle_t pick            = nullptr;
+    StaticSemaphore_t itemsBuffer;
+    StaticSemaphore_t pickBuffer;
+};
+
+#endif  // SHAPED_QUEUE_H
+
+/*
+enum Traffic : size_t { Control, Telemetry, Bulk };
+
+ShapedQueue<Message, 3, 16> uplink;
+
+void setup() {
+    uplink.configure(Control, 0, 0, 4);       // без ограничения, 4 выборки за круг
+    uplink.configure(Telemetry, 50, 10, 2);   // 50 в секунду, всплеск 10
+    uplink.configure(Bulk, 200, 20, 1);
+}
+
+// Отправители
+uplink.send(Control, msg);                    // токен есть всегда
+if (!uplink.send(Bulk, chunk)) retryLater();  // сверх бюджета — отказ без ожидания
+uplink.send(Telemetry, sample, 20);           // подождать токен и место до 20 мс
+
+// Получатель
+Message m;
+size_t  from;
+for (;;) {
+    if (uplink.receive(m, 1000, &from)) transmit(m);
+}
+
+auto s = uplink.stats(Bulk);                  // s.rejected, s.delayed, s.dropped
+*/
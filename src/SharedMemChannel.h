@@ -0,0 +1,269 @@
+#ifndef SHARED_MEM_CHANNEL_H
+#define SHARED_MEM_CHANNEL_H
+
+// Канал между двумя образами FreeRTOS (по одному на ядро) или двумя процессами через
+// общую память: кольцо без блокировок и его управляющий блок целиком лежат в области,
+// которую даёт пользователь, — общий раздел RAM на плате или memfd/shm на хосте.
+//
+// Один производитель и один потребитель. Индексы — свободно бегущие 32-битные счётчики,
+// каждый на своей строке кэша (FREERTOS_CPP_CACHE_LINE): производитель пишет только head,
+// потребитель — только tail, и строки не «прыгают» между ядрами на каждой записи.
+// Чужой индекс каждая сторона кэширует у себя и перечитывает, лишь когда кольцо кажется
+// полным (пустым).
+//
+// Ожидание — через Doorbell (src/Doorbell.h): звонят, только если другая сторона
+// отметила в управляющем блоке, что ждёт, поэтому в потоке данных звонков почти нет.
+// Без звонка на место send() с ms > 0 опрашивает кольцо раз в тик.
+//
+// Одна сторона создаёт канал (shm::Create: размечает область), другая подключается
+// (shm::Attach: проверяет разметку, attached()). Элементы копируются memcpy и должны
+// быть тривиально копируемыми; обе стороны обязаны одинаково видеть T.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "Doorbell.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+// Размер строки кэша (ESP32-S3 — 32, Cortex-A и x86 — 64)
+#ifndef FREERTOS_CPP_CACHE_LINE
+#define FREERTOS_CPP_CACHE_LINE 64
+#endif
+
+namespace shm {
+
+enum Role : uint8_t { Create, Attach };
+
+// Слова для FutexDoorbell внутри управляющего блока
+enum Bell : uint8_t { DataBell, SpaceBell };
+
+constexpr size_t CacheLine = FREERTOS_CPP_CACHE_LINE;
+
+// Управляющий блок в начале области
+struct Control {
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared counters must be lock-free");
+
+    alignas(CacheLine) std::atomic<uint32_t> magic;  // пишется последним при создании
+    uint32_t capacity;                               // степень двойки
+    uint32_t itemSize;
+
+    alignas(CacheLine) std::atomic<uint32_t> head;  // пишет производитель
+    alignas(CacheLine) std::atomic<uint32_t> tail;  // пишет потребитель
+
+    // Флаги ожидания и слова звонков: трогаются только на медленном пути
+    alignas(CacheLine) std::atomic<uint32_t> consumerWaiting;
+    std::atomic<uint32_t> producerWaiting;
+    std::atomic<uint32_t> bells[2];
+};
+
+constexpr uint32_t Magic = 0x53484D31;  // "SHM1"
+
+}  // namespace shm
+
+template <typename T>
+class SharedMemChannel {
+    static_assert(std::is_trivially_copyable<T>::value, "SharedMemChannel items must be trivially copyable");
+
+  public:
+    // Байт области под кольцо на capacity элементов (capacity — степень двойки)
+    static constexpr size_t regionBytes(size_t capacity) {
+        return sizeof(shm::Control) + capacity * sizeof(T);
+    }
+
+    // RAM одной стороны: объект и область на capacity элементов (у второй стороны — только объект)
+    static constexpr size_t footprint(size_t capacity) {
+        return sizeof(SharedMemChannel) + regionBytes(capacity);
+    }
+
+    // region должна быть выровнена на строку кэша; ёмкость — наибольшая степень двойки,
+    // которая помещается. dataBell будит потребителя, spaceBell — производителя.
+    SharedMemChannel(void* region, size_t bytes, shm::Role role, Doorbell* dataBell, Doorbell* spaceBell = nullptr)
+        : ctl(static_cast<shm::Control*>(region)),
+          items(static_cast<uint8_t*>(region) + sizeof(shm::Control)),
+          dataBell(dataBell),
+          spaceBell(spaceBell),
+          bytes(bytes) {
+        configASSERT(reinterpret_cast<uintptr_t>(region) % alignof(shm::Control) == 0);
+        configASSERT(bytes >= regionBytes(1));
+        if (role == shm::Create) {
+            uint32_t cap = 1;
+            while (regionBytes(static_cast<size_t>(cap) * 2) <= bytes) cap *= 2;
+            new (ctl) shm::Control();
+            ctl->capacity = cap;
+            ctl->itemSize = sizeof(T);
+            ctl->magic.store(shm::Magic, std::memory_order_release);
+        }
+        validate();
+    }
+
+    SharedMemChannel(const SharedMemChannel&)            = delete;
+    SharedMemChannel& operator=(const SharedMemChannel&) = delete;
+
+    // Разметка области верна: создана этой или другой стороной под тот же T.
+    // Подключившаяся раньше создателя сторона может звать это, пока не станет true.
+    bool attached() {
+        if (!ok) validate();
+        return ok;
+    }
+
+    size_t capacity() const {
+        return ok ? mask + 1 : 0;
+    }
+
+    // Слово для FutexDoorbell в управляющем блоке области
+    static std::atomic<uint32_t>* bellWord(void* region, shm::Bell which) {
+        return &static_cast<shm::Control*>(region)->bells[which];
+    }
+
+    // ---- Производитель ----
+
+    bool send(const T& item, uint32_t ms = 0) {
+        configASSERT(ok);
+        const TickType_t start = xTaskGetTickCount();
+        const TickType_t limit = pdMS_TO_TICKS(ms);
+        for (;;) {
+            if (trySend(item)) return true;
+            const TickType_t spent = xTaskGetTickCount() - start;
+            if (spent >= limit) return false;
+            if (!spaceBell) {
+                vTaskDelay(1);
+                continue;
+            }
+            const uint32_t token = spaceBell->arm();
+            ctl->producerWaiting.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (trySend(item)) {
+                ctl->producerWaiting.store(0, std::memory_order_relaxed);
+                return true;
+            }
+            // Часы симулятора стоят, пока нить спит в системном вызове: таймаут звонка — конец
+            if (!spaceBell->wait(token, pdTICKS_TO_MS(limit - spent))) {
+                ctl->producerWaiting.store(0, std::memory_order_relaxed);
+                return trySend(item);
+            }
+        }
+    }
+
+    // ---- Потребитель ----
+
+    bool receive(T& item, uint32_t ms = 0) {
+        configASSERT(ok);
+        const TickType_t start = xTaskGetTickCount();
+        const TickType_t limit = pdMS_TO_TICKS(ms);
+        for (;;) {
+            if (tryReceive(item)) return true;
+            const TickType_t spent = xTaskGetTickCount() - start;
+            if (spent >= limit) return false;
+            if (!dataBell) {
+                vTaskDelay(1);
+                continue;
+            }
+            const uint32_t token = dataBell->arm();
+            ctl->consumerWaiting.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (tryReceive(item)) {
+                ctl->consumerWaiting.store(0, std::memory_order_relaxed);
+                return true;
+            }
+            if (!dataBell->wait(token, pdTICKS_TO_MS(limit - spent))) {
+                ctl->consumerWaiting.store(0, std::memory_order_relaxed);
+                return tryReceive(item);
+            }
+        }
+    }
+
+    // Элементов в кольце (снимок; точен только для одной из сторон)
+    size_t messagesWaiting() const {
+        if (!ok) return 0;
+        return ctl->head.load(std::memory_order_acquire) - ctl->tail.load(std::memory_order_acquire);
+    }
+
+  private:
+    shm::Control* ctl;
+    uint8_t*      items;
+    Doorbell*     dataBell;
+    Doorbell*     spaceBell;
+    size_t        bytes;
+    uint32_t      mask = 0;
+    bool          ok   = false;
+
+    // Локальные копии чужих индексов — каждая пишется только своей стороной
+    uint32_t cachedHead = 0;  // у потребителя
+    uint32_t cachedTail = 0;  // у производителя
+
+    void validate() {
+        ok = ctl->magic.load(std::memory_order_acquire) == shm::Magic && ctl->itemSize == sizeof(T) &&
+             regionBytes(ctl->capacity) <= bytes;
+        if (!ok) return;
+        mask       = ctl->capacity - 1;
+        cachedHead = ctl->head.load(std::memory_order_acquire);
+        cachedTail = ctl->tail.load(std::memory_order_acquire);
+    }
+
+    uint8_t* slot(uint32_t index) {
+        return items + static_cast<size_t>(index & mask) * sizeof(T);
+    }
+
+    bool trySend(const T& item) {
+        const uint32_t head = ctl->head.load(std::memory_order_relaxed);
+        if (head - cachedTail > mask) {
+            cachedTail = ctl->tail.load(std::memory_order_acquire);
+            if (head - cachedTail > mask) return false;
+        }
+        std::memcpy(slot(head), &item, sizeof(T));
+        ctl->head.store(head + 1, std::memory_order_release);
+        wake(ctl->consumerWaiting, dataBell);
+        return true;
+    }
+
+    bool tryReceive(T& item) {
+        const uint32_t tail = ctl->tail.load(std::memory_order_relaxed);
+        if (tail == cachedHead) {
+            cachedHead = ctl->head.load(std::memory_order_acquire);
+            if (tail == cachedHead) return false;
+        }
+        std::memcpy(&item, slot(tail), sizeof(T));
+        ctl->tail.store(tail + 1, std::memory_order_release);
+        wake(ctl->producerWaiting, spaceBell);
+        return true;
+    }
+
+    // Позвонить, если другая сторона ждёт (пара к fence в send()/receive())
+    static void wake(std::atomic<uint32_t>& waiting, Doorbell* bell) {
+        if (!bell) return;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiting.load(std::memory_order_relaxed) && waiting.exchange(0, std::memory_order_relaxed)) bell->ring();
+    }
+};
+
+#endif  // SHARED_MEM_CHANNEL_H
+
+/*
+// Общий раздел RAM на плате: ядро 0 создаёт, ядро 1 подключается
+extern uint8_t shared[];  // из скрипта компоновки, выровнен на строку кэша
+IrqDoorbell    toCore1(raiseIpiCore1, nullptr);
+SharedMemChannel<Frame> tx(shared, 4096, shm::Create, &toCore1);
+
+// Ядро 1
+IrqDoorbell             fromCore0(raiseIpiCore0, nullptr);  // signalFromISR() — в обработчике IPI
+SharedMemChannel<Frame> rx(shared, 4096, shm::Attach, &fromCore0);
+while (!rx.attached()) vTaskDelay(1);
+Frame f;
+if (rx.receive(f, 100)) handle(f);
+
+// Linux: memfd, отображённый обоими процессами, звонки — futex в управляющем блоке
+int   fd  = memfd_create("channel", 0);
+ftruncate(fd, 1 << 16);
+void* mem = mmap(nullptr, 1 << 16, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+FutexDoorbell data(SharedMemChannel<Frame>::bellWord(mem, shm::DataBell));
+FutexDoorbell space(SharedMemChannel<Frame>::bellWord(mem, shm::SpaceBell));
+SharedMemChannel<Frame> ch(mem, 1 << 16, shm::Create, &data, &space);
+*/
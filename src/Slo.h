@@ -0,0 +1,324 @@
+#ifndef SLO_H
+#define SLO_H
+
+// Сквозные задержки путей против заявленных сроков (SLO): «кнопка в ISR → привод < 2 мс».
+//
+// Начало пути ставит отметку времени — slo::Token (4 байта, микросекунды). Отметка едет
+// дальше вместе с данными, например полем элемента Queue<T>. Конец пути зовёт
+// path.end(token): задержка попадает в гистограмму пути, превышение срока увеличивает
+// счётчик нарушений, а худший случай запоминается вместе с задачей, которая закрыла путь.
+// При нарушении можно выставить бит в EventGroup пользователя. Бит не снимается сам:
+// его сбрасывает тот, кто разобрал тревогу.
+//
+// Включается при компиляции: -DFREERTOS_CPP_SLO=1. Без него Token — пустая структура,
+// а start()/end() — пустые inline-функции.
+//
+// Запись — атомарные счётчики без блокировок, поэтому начинать и заканчивать путь можно
+// и в прерывании. Гистограмма лог-линейная: до 8 мкс точно, дальше по 4 корзины на каждую
+// степень двойки, до ~1 с (76 корзин по 4 байта на путь).
+//
+// Часы — FREERTOS_CPP_SLO_CLOCK_US, по умолчанию общие FREERTOS_CPP_CLOCK_US (MicrosClock.h).
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "EvenGroupCpp.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cstddef>
+#include <cstdint>
+
+#ifndef FREERTOS_CPP_SLO
+#define FREERTOS_CPP_SLO 0
+#endif
+
+#if FREERTOS_CPP_SLO
+
+#include <atomic>
+
+#ifndef FREERTOS_CPP_SLO_CLOCK_US
+#include "MicrosClock.h"
+#define FREERTOS_CPP_SLO_CLOCK_US() FREERTOS_CPP_CLOCK_US()
+#endif
+
+#endif  // FREERTOS_CPP_SLO
+
+namespace slo {
+
+constexpr bool Enabled = FREERTOS_CPP_SLO != 0;
+
+// Снимок пути
+struct Stats {
+    const char*  name;
+    uint32_t     deadlineUs;
+    uint32_t     count;       // закрытых путей
+    uint32_t     violations;  // из них дольше срока
+    uint32_t     worstUs;     // худшая задержка
+    TaskHandle_t worstTask;   // кто закрыл худший путь; nullptr — прерывание
+    uint32_t     p50Us;       // верхние границы корзин гистограммы
+    uint32_t     p99Us;
+};
+
+#if FREERTOS_CPP_SLO
+
+// Отметка начала пути. 0 — «не отмечен»: end() такой токен пропускает.
+struct Token {
+    uint32_t us = 0;
+
+    explicit operator bool() const {
+        return us != 0;
+    }
+};
+
+// Отметить начало пути (из задачи или прерывания)
+inline Token now() {
+    const uint32_t us = FREERTOS_CPP_SLO_CLOCK_US();
+    return Token{us ? us : 1};
+}
+
+class Path {
+  public:
+    static constexpr size_t Buckets = 76;
+
+    // Путь со сроком deadlineUs. alarms/alarmBit — куда сообщать о нарушении.
+    Path(const char* name, uint32_t deadlineUs, EventGroup* alarms = nullptr, EventBits_t alarmBit = 0)
+        : pathName(name), deadline(deadlineUs), alarmGroup(alarms), bit(alarmBit) {
+        Path* h = head().load(std::memory_order_relaxed);
+        do {
+            next = h;
+        } while (!head().compare_exchange_weak(h, this, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // Пути обычно живут всё время работы; локальный путь при удалении уходит из списка
+    ~Path() {
+        const bool running = xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+        if (running) vTaskSuspendAll();
+        Path* p = head().load(std::memory_order_relaxed);
+        if (p == this) {
+            head().store(next, std::memory_order_relaxed);
+        } else {
+            while (p && p->next != this) p = p->next;
+            if (p) p->next = next;
+        }
+        if (running) xTaskResumeAll();
+    }
+
+    Path(const Path&)            = delete;
+    Path& operator=(const Path&) = delete;
+
+    Token start() const {
+        return now();
+    }
+
+    // Закрыть путь (из задачи). Возвращает задержку в мкс.
+    uint32_t end(Token t) {
+        const uint32_t us = record(t, xTaskGetCurrentTaskHandle());
+        if (us > deadline && alarmGroup) alarmGroup->setBits(bit);
+        return us;
+    }
+
+    // Закрыть путь (из прерывания)
+    uint32_t endFromISR(Token t, BaseType_t* higherPriorityTaskWoken = nullptr) {
+        const uint32_t us = record(t, nullptr);
+        if (us > deadline && alarmGroup) alarmGroup->setBitsFromISR(bit, higherPriorityTaskWoken);
+        return us;
+    }
+
+    const char* name() const {
+        return pathName;
+    }
+
+    uint32_t deadlineUs() const {
+        return deadline;
+    }
+
+    // Задержка, которую не превысили permille тысячных закрытых путей (верхняя граница корзины)
+    uint32_t percentileUs(uint32_t permille) const {
+        uint32_t total = 0;
+        for (const auto& c : counts) total += c.load(std::memory_order_relaxed);
+        if (total == 0) return 0;
+        const uint64_t rank = (static_cast<uint64_t>(total) * permille + 999) / 1000;
+        uint64_t       seen = 0;
+        for (size_t i = 0; i < Buckets; ++i) {
+            seen += counts[i].load(std::memory_order_relaxed);
+            if (seen >= rank && seen > 0) return upperBound(i);
+        }
+        return upperBound(Buckets - 1);
+    }
+
+    Stats stats() const {
+        return Stats{pathName,
+                     deadline,
+                     count.load(std::memory_order_relaxed),
+                     violations.load(std::memory_order_relaxed),
+                     worst.load(std::memory_order_relaxed),
+                     worstTask.load(std::memory_order_relaxed),
+                     percentileUs(500),
+                     percentileUs(990)};
+    }
+
+    void reset() {
+        for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+        count.store(0, std::memory_order_relaxed);
+        violations.store(0, std::memory_order_relaxed);
+        worst.store(0, std::memory_order_relaxed);
+        worstTask.store(nullptr, std::memory_order_relaxed);
+    }
+
+    // Все пути прошивки, последний созданный — первым. Не создавать и не удалять пути во время обхода.
+    template <class F>
+    static void forEach(F&& fn) {
+        for (Path* p = head().load(std::memory_order_acquire); p; p = p->next) fn(*p);
+    }
+
+    // Путь с наибольшим числом нарушений (при равенстве — с худшей задержкой относительно срока)
+    static Path* worstOffender() {
+        Path*    found = nullptr;
+        uint32_t most  = 0;
+        uint64_t ratio = 0;  // worst / deadline, в тысячных
+        forEach([&](Path& p) {
+            const uint32_t v = p.violations.load(std::memory_order_relaxed);
+            const uint64_t r = static_cast<uint64_t>(p.worst.load(std::memory_order_relaxed)) * 1000 /
+                               (p.deadline ? p.deadline : 1);
+            if (v > most || (v == most && v > 0 && r > ratio)) {
+                found = &p;
+                most  = v;
+                ratio = r;
+            }
+        });
+        return found;
+    }
+
+    // Индекс корзины для задержки в мкс
+    static constexpr size_t bucketOf(uint32_t us) {
+        if (us < 8) return us;
+        if (us >= MaxUs) us = MaxUs - 1;
+        const unsigned e = 31u - static_cast<unsigned>(__builtin_clz(us));  // 3..19
+        return 8 + (e - 3) * 4 + ((us >> (e - 2)) & 3);
+    }
+
+    // Наибольшая задержка, попадающая в корзину
+    static constexpr uint32_t upperBound(size_t i) {
+        if (i < 8) return static_cast<uint32_t>(i);
+        const unsigned e   = 3 + static_cast<unsigned>(i - 8) / 4;
+        const uint32_t sub = static_cast<uint32_t>(i - 8) % 4;
+        return ((4 + sub + 1) << (e - 2)) - 1;
+    }
+
+  private:
+    static constexpr uint32_t MaxUs = 1u << 20;
+
+    static std::atomic<Path*>& head() {
+        static std::atomic<Path*> first{nullptr};
+        return first;
+    }
+
+    uint32_t record(Token t, TaskHandle_t task) {
+        if (!t) return 0;
+        const uint32_t us = FREERTOS_CPP_SLO_CLOCK_US() - t.us;
+        counts[bucketOf(us)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        if (us > deadline) violations.fetch_add(1, std::memory_order_relaxed);
+        uint32_t w = worst.load(std::memory_order_relaxed);
+        while (us > w) {
+            if (worst.compare_exchange_weak(w, us, std::memory_order_relaxed)) {
+                worstTask.store(task, std::memory_order_relaxed);  // при гонке — задача одного из худших
+                break;
+            }
+        }
+        return us;
+    }
+
+    const char*               pathName;
+    uint32_t                  deadline;
+    EventGroup*               alarmGroup;
+    EventBits_t               bit;
+    Path*                     next = nullptr;
+    std::atomic<uint32_t>     counts[Buckets] = {};
+    std::atomic<uint32_t>     count{0};
+    std::atomic<uint32_t>     violations{0};
+    std::atomic<uint32_t>     worst{0};
+    std::atomic<TaskHandle_t> worstTask{nullptr};
+};
+
+#else  // FREERTOS_CPP_SLO
+
+struct Token {
+    explicit operator bool() const {
+        return false;
+    }
+};
+
+inline Token now() {
+    return Token{};
+}
+
+class Path {
+  public:
+    Path(const char*, uint32_t, EventGroup* = nullptr, EventBits_t = 0) {}
+
+    Token start() const {
+        return Token{};
+    }
+    uint32_t end(Token) {
+        return 0;
+    }
+    uint32_t endFromISR(Token, BaseType_t* = nullptr) {
+        return 0;
+    }
+    uint32_t percentileUs(uint32_t) const {
+        return 0;
+    }
+    Stats stats() const {
+        return Stats{};
+    }
+    void reset() {}
+
+    template <class F>
+    static void forEach(F&&) {}
+
+    static Path* worstOffender() {
+        return nullptr;
+    }
+};
+
+#endif  // FREERTOS_CPP_SLO
+
+}  // namespace slo
+
+#endif  // SLO_H
+
+/*
+EventGroup health;
+constexpr EventBits_t SloMissed = 1 << 4;
+slo::Path buttonToActuator("button->actuator", 2000, &health, SloMissed);
+
+struct Command {
+    uint8_t    level;
+    slo::Token t;  // едет вместе с командой
+};
+Queue<Command> commands(8);
+
+void IRAM_ATTR buttonIsr(void*) {
+    BaseType_t woken = pdFALSE;
+    commands.sendFromISR(Command{1, slo::now()}, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void actuatorTask(void*) {
+    Command c;
+    for (;;) {
+        if (commands.receive(c, portMAX_DELAY)) {
+            driveActuator(c.level);
+            buttonToActuator.end(c.t);
+        }
+    }
+}
+
+// В диагностике
+slo::Path::forEach([](slo::Path& p) {
+    slo::Stats s = p.stats();
+    printf("%s: n=%u miss=%u p99=%uus worst=%uus\n", s.name, s.count, s.violations, s.p99Us, s.worstUs);
+});
+*/
@@ -0,0 +1,404 @@
+#ifndef SPILL_QUEUE_H
+#define SPILL_QUEUE_H
+
+// Очередь с вытеснением на блочный носитель: SpillQueue<T, BlockBytes, Slots, HeadSlots>.
+//
+// Записи собираются в RAM блоками по BlockBytes (заголовок + Items записей). Всего в RAM
+// Slots блоков: голова — до HeadSlots блоков перед потребителем, хвост — блоки, которые
+// заполняет производитель. Пока середины на носителе нет, заполненные блоки хвоста
+// переходят в голову без ввода-вывода, и очередь работает как обычная кольцевая в RAM.
+// Когда голова полна (потребитель не успевает, канал связи лежит) и свободных блоков RAM
+// остаётся не больше половины хвоста, самые старые блоки хвоста дописываются на
+// BlockDevice последовательно по кольцу блоков, а RAM освобождается.
+// Когда в голове есть место, самый старый блок с носителя подкачивается в неё заранее,
+// так что потребитель читает из RAM. Порядок FIFO сохраняется: голова, носитель, хвост.
+//
+// Ввод-вывод делает служебная задача (start()); send() и receive() трогают только RAM.
+// Без start() или без носителя — очередь на Slots * Items записей. send() не ждёт: если
+// свободного блока нет (носитель полон или не успевает), запись теряется и считается в
+// dropped. Пока голова ждёт подкачки, один свободный блок оставляется под неё.
+// Производителей может быть несколько, потребитель — один. Из прерываний не используется.
+// Указатели кольца на носителе хранятся в RAM: после перезапуска содержимое носителя
+// не восстанавливается.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "BlockDevice.h"
+#include "Footprint.h"
+#include "NotifyIndex.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace spill {
+
+struct Stats {
+    uint32_t sent;        // записей принято
+    uint32_t received;    // записей выдано
+    uint32_t dropped;     // потеряно: нет места или блок не прочитался
+    uint32_t spilled;     // блоков записано на носитель
+    uint32_t prefetched;  // блоков подкачано с носителя
+    uint32_t promoted;    // блоков передано из хвоста в голову без ввода-вывода
+    uint32_t ioErrors;    // неудачных чтений и записей
+};
+
+}  // namespace spill
+
+template <typename T, size_t BlockBytes = 512, size_t Slots = 8, size_t HeadSlots = 2>
+class SpillQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "records are written to storage bytewise");
+    static_assert(HeadSlots >= 1 && Slots >= HeadSlots + 2, "need head slots, an open block and one to spill");
+    static_assert(Slots <= 255, "slot indices are 8-bit");
+
+    static constexpr uint32_t Magic        = 0x51505331;  // "SPQ1"
+    static constexpr size_t   HeaderSize   = 16;
+    static constexpr size_t   SpillReserve = (Slots - HeadSlots) / 2;  // свободных блоков, ниже — на носитель
+
+  public:
+    // Записей в блоке
+    static constexpr size_t Items = (BlockBytes - HeaderSize) / sizeof(T);
+    static_assert(BlockBytes > HeaderSize && Items >= 1, "block too small for one record");
+    static_assert(Items <= UINT16_MAX, "read position is 16-bit");
+
+    explicit SpillQueue(BlockDevice* device = nullptr) : dev(device) {
+        configASSERT(!dev || dev->blockSize() == BlockBytes);
+        for (size_t i = 0; i < Slots; ++i) freeSlots.push(static_cast<uint8_t>(i));
+    }
+
+    ~SpillQueue() {
+        stop();
+    }
+
+    SpillQueue(const SpillQueue&)            = delete;
+    SpillQueue& operator=(const SpillQueue&) = delete;
+
+    // Запустить служебную задачу ввода-вывода
+    bool start(const char* name = "spill", UBaseType_t priority = tskIDLE_PRIORITY + 1,
+               configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        if (worker || !dev) return false;
+        return xTaskCreate(run, name, stackDepth, this, priority, &worker) == pdPASS;
+    }
+
+    void stop() {
+        if (worker) vTaskDelete(worker);
+        worker = nullptr;
+    }
+
+    // Положить запись. false — места нет ни в RAM, ни на носителе; запись потеряна.
+    bool send(const T& item) {
+        lock();
+        if (back.empty() || full(back.last())) {
+            if (freeSlots.size() <= fetchReserve()) {
+                ++counters.dropped;
+                unlock();
+                return false;
+            }
+            const uint8_t s = freeSlots.pop();
+            Block&        b = slots[s].block;
+            b.magic         = Magic;
+            b.seq           = nextSeq++;
+            b.count         = 0;
+            pos[s]          = 0;
+            back.push(s);
+        }
+        Block& b             = slots[back.last()].block;
+        b.items[b.count++]   = item;
+        const bool   sealed  = b.count == Items;
+        TaskHandle_t wake    = waiter;
+        waiter               = nullptr;
+        ++stored;
+        ++counters.sent;
+        unlock();
+        if (wake) notify::library::give(wake);
+        if (sealed && worker) notify::library::give(worker);
+        return true;
+    }
+
+    // Взять самую старую запись, ожидая до ms. Один потребитель.
+    bool receive(T& item, uint32_t ms = 0) {
+        const TickType_t start = xTaskGetTickCount();
+        const TickType_t limit = pdMS_TO_TICKS(ms);
+        for (;;) {
+            bool freed = false;
+            lock();
+            if (take(item, freed)) {
+                unlock();
+                if (freed && worker) notify::library::give(worker);
+                return true;
+            }
+            const TickType_t spent = xTaskGetTickCount() - start;
+            waiter                 = spent < limit ? xTaskGetCurrentTaskHandle() : nullptr;
+            unlock();
+            if (spent >= limit) return false;
+            notify::library::take(limit - spent);
+        }
+    }
+
+    // Записей в очереди, включая лежащие на носителе
+    size_t messagesWaiting() {
+        lock();
+        const size_t n = stored;
+        unlock();
+        return n;
+    }
+
+    // Блоков сейчас на носителе
+    uint32_t blocksOnDevice() {
+        lock();
+        const uint32_t n = writePos - readPos;
+        unlock();
+        return n;
+    }
+
+    spill::Stats stats() {
+        lock();
+        const spill::Stats s = counters;
+        unlock();
+        return s;
+    }
+
+    // Записей в RAM без носителя
+    static constexpr size_t ramCapacity() {
+        return Slots * Items;
+    }
+
+    // RAM: блоки внутри объекта, стек и TCB служебной задачи
+    static constexpr size_t footprint(configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        return sizeof(SpillQueue) + ::footprint::task(stackDepth);
+    }
+
+  private:
+    struct Block {
+        uint32_t magic;
+        uint32_t seq;
+        uint32_t count;
+        uint32_t reserved;
+        T        items[Items];
+    };
+    static_assert(sizeof(Block) <= BlockBytes, "over-aligned record");
+
+    // Блок в RAM: ровно BlockBytes байт для устройства
+    struct Slot {
+        Block   block;
+        uint8_t pad[BlockBytes - sizeof(Block) ? BlockBytes - sizeof(Block) : 1];
+    };
+
+    // Очередь номеров слотов
+    struct Ring {
+        uint8_t idx[Slots];
+        uint8_t first = 0;
+        uint8_t n     = 0;
+
+        bool empty() const {
+            return n == 0;
+        }
+        size_t size() const {
+            return n;
+        }
+        uint8_t head() const {
+            return idx[first];
+        }
+        uint8_t last() const {
+            return idx[(first + n - 1) % Slots];
+        }
+        void push(uint8_t s) {
+            idx[(first + n++) % Slots] = s;
+        }
+        void pushFront(uint8_t s) {
+            first      = static_cast<uint8_t>((first + Slots - 1) % Slots);
+            idx[first] = s;
+            ++n;
+        }
+        uint8_t pop() {
+            const uint8_t s = idx[first];
+            first           = static_cast<uint8_t>((first + 1) % Slots);
+            --n;
+            return s;
+        }
+    };
+
+    Slot         slots[Slots];
+    uint16_t     pos[Slots] = {};  // позиция чтения в блоке
+    Ring         front;            // голова: блоки перед потребителем
+    Ring         back;             // хвост: последний может быть открыт для записи
+    Ring         freeSlots;
+    BlockDevice* dev;
+    uint32_t     readPos  = 0;  // блоков прочитано с носителя
+    uint32_t     writePos = 0;  // блоков записано (включая пишущийся)
+    uint32_t     nextSeq  = 0;
+    size_t       stored   = 0;
+    spill::Stats counters = {};
+    TaskHandle_t waiter   = nullptr;
+    TaskHandle_t worker   = nullptr;
+#ifdef ESP_PLATFORM
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+    bool full(uint8_t s) const {
+        return slots[s].block.count == Items;
+    }
+
+    // Под замком: свободных блоков, которые send() не трогает. Пока на носителе есть блоки,
+    // а голова не полна, последний свободный блок ждёт fetch(): иначе производитель выше
+    // служебной задачи занимает каждый освобождённый блок, и очередь встаёт навсегда
+    size_t fetchReserve() const {
+        return writePos != readPos && front.size() < HeadSlots ? 1 : 0;
+    }
+
+    // Под замком: следующая запись по порядку голова -> носитель -> хвост
+    bool take(T& item, bool& freed) {
+        Ring* q = !front.empty() ? &front : (writePos == readPos && !back.empty() ? &back : nullptr);
+        if (!q) return false;
+        const uint8_t s = q->head();
+        Block&        b = slots[s].block;
+        if (pos[s] == b.count) return false;  // открытый блок уже дочитан
+        item = b.items[pos[s]++];
+        --stored;
+        ++counters.received;
+        if (pos[s] == b.count) {
+            if (full(s)) {
+                q->pop();
+                freeSlots.push(s);
+                freed = true;
+            } else {
+                pos[s] = b.count = 0;  // открытый блок: писать снова с начала
+            }
+        }
+        return true;
+    }
+
+    static void run(void* arg) {
+        auto* self = static_cast<SpillQueue*>(arg);
+        for (;;) {
+            while (self->step()) {
+            }
+            notify::library::take(portMAX_DELAY);
+        }
+    }
+
+    // Одно действие служебной задачи; false — делать нечего
+    bool step() {
+        lock();
+        const size_t   sealed   = back.size() - (!back.empty() && !full(back.last()) ? 1 : 0);
+        const uint32_t onDevice = writePos - readPos;
+
+        // Носитель пуст: готовый блок хвоста сразу в голову
+        if (onDevice == 0 && sealed && front.size() < HeadSlots) {
+            front.push(back.pop());
+            ++counters.promoted;
+            unlock();
+            return true;
+        }
+
+        const bool canFetch = onDevice > 0 && front.size() < HeadSlots && !freeSlots.empty();
+        const bool canSpill = sealed && onDevice < dev->blockCount() && freeSlots.size() <= SpillReserve;
+        // Потребителю нечего читать — сначала подкачка, иначе сначала освободить RAM
+        if (canFetch && (front.empty() || !canSpill)) return fetch();
+        if (canSpill) return spillOne();
+        unlock();
+        return false;
+    }
+
+    // Под замком (снимается): дописать самый старый блок хвоста на носитель
+    bool spillOne() {
+        const uint8_t  s  = back.pop();
+        const uint32_t at = writePos++;
+        unlock();
+        const bool ok = dev->write(at % dev->blockCount(), &slots[s]);
+        lock();
+        if (ok) {
+            freeSlots.push(s);
+            ++counters.spilled;
+        } else {
+            // Вернуть блок на место; повтор — при следующем пробуждении
+            --writePos;
+            back.pushFront(s);
+            ++counters.ioErrors;
+        }
+        unlock();
+        return ok;
+    }
+
+    // Под замком (снимается): подкачать самый старый блок с носителя в голову
+    bool fetch() {
+        const uint8_t  s  = freeSlots.pop();
+        const uint32_t at = readPos;
+        unlock();
+        bool ok = dev->read(at % dev->blockCount(), &slots[s]);
+        lock();
+        const Block& b = slots[s].block;
+        ok             = ok && b.magic == Magic && b.count == Items;
+        ++readPos;
+        TaskHandle_t wake = nullptr;
+        if (ok) {
+            pos[s] = 0;
+            front.push(s);
+            ++counters.prefetched;
+            wake   = waiter;
+            waiter = nullptr;
+        } else {
+            // Блок не читается: пропустить, иначе очередь встанет навсегда
+            freeSlots.push(s);
+            stored -= Items;
+            counters.dropped += Items;
+            ++counters.ioErrors;
+        }
+        unlock();
+        if (wake) notify::library::give(wake);
+        return true;
+    }
+
+#ifdef ESP_PLATFORM
+    void lock() {
+        taskENTER_CRITICAL(&mux);
+    }
+    void unlock() {
+        taskEXIT_CRITICAL(&mux);
+    }
+#else
+    void lock() {
+        taskENTER_CRITICAL();
+    }
+    void unlock() {
+        taskEXIT_CRITICAL();
+    }
+#endif
+};
+
+#endif  // SPILL_QUEUE_H
+
+/*
+struct Sample {
+    uint32_t time;
+    int16_t  values[6];
+};
+
+// Блок флеша 4 КБ — 255 записей; 4 блока в RAM (16 КБ), 2 из них — перед отправкой.
+// Раздел на 1 МБ — ещё ~65 тыс. записей на время отсутствия связи (см. BlockDevice.h).
+PartitionDevice             flash(esp_partition_find_first(ESP_PARTITION_TYPE_DATA, 0x40, "spill"));
+SpillQueue<Sample, 4096, 4> telemetry(&flash);
+
+void setup() {
+    telemetry.start("spill", 2);
+}
+
+void sensorTask(void*) {
+    for (;;) {
+        if (!telemetry.send(readSensors())) lostSamples++;  // носитель тоже полон
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+void uplinkTask(void*) {
+    Sample s;
+    for (;;) {
+        if (telemetry.receive(s, 1000)) {
+            while (!uplink.transmit(s)) vTaskDelay(pdMS_TO_TICKS(500));  // связь лежит — копим
+        }
+    }
+}
+*/
@@ -0,0 +1,392 @@
+#ifndef SYSTEM_MONITOR_H
+#define SYSTEM_MONITOR_H
+
+// Служебная задача-монитор: загрузка CPU по задачам и запас стека.
+//
+// Раз в период снимает uxTaskGetSystemState() (счётчики времени выполнения и
+// high-water mark стека), считает приращения счётчиков и держит скользящее окно из
+// Window периодов. Всё хранится в самом объекте — во время работы куча не нужна.
+// Пороговые тревоги выставляются битами в EventGroup пользователя (уровнем: бит стоит,
+// пока условие выполняется), отчёт отдаётся копией или компактным бинарным снимком.
+//
+// Требует configUSE_TRACE_FACILITY и configGENERATE_RUN_TIME_STATS.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "EvenGroupCpp.h"
+#include "Footprint.h"
+#include "Guarded.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if !configUSE_TRACE_FACILITY || !configGENERATE_RUN_TIME_STATS
+#error "SystemMonitor requires configUSE_TRACE_FACILITY and configGENERATE_RUN_TIME_STATS"
+#endif
+
+template <size_t MaxTasks = 16, size_t Window = 10>
+class SystemMonitor {
+    static_assert(MaxTasks > 0 && MaxTasks <= 255, "MaxTasks must fit the snapshot header");
+    static_assert(Window > 0, "Window must be at least one period");
+
+    using Counter = decltype(TaskStatus_t::ulRunTimeCounter);
+
+  public:
+    // Биты тревог (сдвигаются на Config::alarmShift, чтобы делить группу с другими флагами)
+    enum Alarm : EventBits_t {
+        CpuLoad      = 1 << 0,  // общая загрузка за окно выше порога
+        TaskCpu      = 1 << 1,  // какая-то задача (кроме IDLE) занимает CPU выше порога
+        StackLow     = 1 << 2,  // у какой-то задачи запас стека меньше порога
+        TooManyTasks = 1 << 3,  // задач больше MaxTasks — снимок не сделан
+        AllAlarms    = CpuLoad | TaskCpu | StackLow | TooManyTasks
+    };
+
+    struct Config {
+        TickType_t period          = pdMS_TO_TICKS(1000);
+        uint16_t   cpuLoadAlarm    = 9000;  // сотые доли процента
+        uint16_t   taskCpuAlarm    = 8000;  // сотые доли процента
+        uint32_t   stackAlarmWords = 128;   // запас стека в словах StackType_t
+        uint8_t    alarmShift      = 0;
+    };
+
+    struct TaskInfo {
+        TaskHandle_t handle;
+        char         name[configMAX_TASK_NAME_LEN];
+        UBaseType_t  number;
+        eTaskState   state;
+        UBaseType_t  priority;
+        uint16_t     cpu;        // за последний период, сотые доли процента
+        uint16_t     cpuAvg;     // за окно
+        uint32_t     stackFree;  // минимальный запас стека за всё время, слова
+    };
+
+    struct Report {
+        uint32_t    sequence;  // номер снимка; 0 — отчёта ещё нет
+        uint16_t    load;      // загрузка за последний период, сотые доли процента
+        uint16_t    loadAvg;   // за окно
+        EventBits_t alarms;    // активные тревоги (без сдвига)
+        size_t      count;
+        TaskInfo    tasks[MaxTasks];
+    };
+
+    // Бинарный снимок (little-endian):
+    //   заголовок 12 байт: magic u16, version u8, count u8, sequence u32, loadAvg u16, alarms u16
+    //   на задачу 20 байт: number u16, cpuAvg u16, stackFree u16, priority u8, state u8, name[12]
+    static constexpr uint16_t SnapshotMagic   = 0x4D53;  // "SM"
+    static constexpr uint8_t  SnapshotVersion = 1;
+    static constexpr size_t   HeaderSize      = 12;
+    static constexpr size_t   EntrySize       = 20;
+    static constexpr size_t   SnapshotName    = 12;
+    static constexpr size_t   SnapshotSize    = HeaderSize + EntrySize * MaxTasks;
+
+    explicit SystemMonitor(EventGroup& alarms) : SystemMonitor(alarms, Config()) {}
+
+    SystemMonitor(EventGroup& alarms, const Config& cfg) : alarmGroup(alarms), config(cfg) {
+        auto r      = report();
+        r->sequence = 0;
+        r->load = r->loadAvg = 0;
+        r->alarms            = 0;
+        r->count             = 0;
+    }
+
+    ~SystemMonitor() {
+        if (task) vTaskDelete(task);
+    }
+
+    SystemMonitor(const SystemMonitor&)            = delete;
+    SystemMonitor& operator=(const SystemMonitor&) = delete;
+
+    // Запустить служебную задачу (снимки раз в Config::period)
+    bool start(const char* name = "sysmon", UBaseType_t priority = tskIDLE_PRIORITY + 1,
+               configSTACK_DEPTH_TYPE stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        if (task) return false;
+        return xTaskCreate(run, name, stackDepth, this, priority, &task) == pdPASS;
+    }
+
+    TaskHandle_t taskHandle() const {
+        return task;
+    }
+
+    // RAM: окно статистики, стек и TCB служебной задачи
+    static constexpr size_t footprint(size_t stackDepth = configMINIMAL_STACK_SIZE * 2) {
+        return sizeof(SystemMonitor) + ::footprint::task(stackDepth);
+    }
+
+    // Снять показания. Вызывается служебной задачей; без start() — вручную из одной задачи.
+    // Первый вызов только запоминает счётчики.
+    void sample() {
+        Counter           total = 0;
+        const UBaseType_t n     = uxTaskGetSystemState(statuses, MaxTasks, &total);
+        if (n == 0) {
+            // Массив мал: ядро ничего не заполнило
+            {
+                auto r    = report();
+                r->count  = 0;
+                r->alarms = TooManyTasks;
+                ++r->sequence;
+            }
+            publishAlarms(TooManyTasks);
+            return;
+        }
+
+        const bool     primed     = hasPrevious;
+        const uint32_t totalDelta = primed ? static_cast<uint32_t>(static_cast<Counter>(total - prevTotal)) : 0;
+        prevTotal                 = total;
+        hasPrevious               = true;
+        pushWindow(totalWindow, totalSum, totalDelta);
+
+        // Сначала вычистить удалённые задачи: новые займут их места в tracks
+        for (size_t i = 0; i < trackCount; ++i) tracks[i].seen = false;
+        for (UBaseType_t i = 0; i < n; ++i) {
+            if (Track* t = find(statuses[i])) t->seen = true;
+        }
+        dropDeleted();
+
+        uint64_t idleDelta = 0, idleSum = 0;
+        for (UBaseType_t i = 0; i < n; ++i) {
+            const TaskStatus_t& s = statuses[i];
+            Track&              t = track(s, primed);
+            const uint32_t      d = static_cast<uint32_t>(static_cast<Counter>(s.ulRunTimeCounter - t.prev));
+            t.prev                = s.ulRunTimeCounter;
+            pushWindow(t.window, t.sum, d);
+            if (isIdle(s.pcTaskName)) {
+                idleDelta += d;
+                idleSum += t.sum;
+            }
+        }
+        slot = (slot + 1) % Window;
+
+        // Счётчик общего времени — настенные часы; на SMP ёмкость в Cores раз больше
+        const uint64_t capacity    = static_cast<uint64_t>(totalDelta) * Cores;
+        const uint64_t capacityAvg = totalSum * Cores;
+
+        EventBits_t active = 0;
+        {
+            auto r     = report();
+            r->count   = n;
+            r->load    = capacity ? static_cast<uint16_t>(10000 - share(idleDelta, capacity)) : 0;
+            r->loadAvg = capacityAvg ? static_cast<uint16_t>(10000 - share(idleSum, capacityAvg)) : 0;
+            if (primed && r->loadAvg >= config.cpuLoadAlarm) active |= CpuLoad;
+
+            for (UBaseType_t i = 0; i < n; ++i) {
+                const TaskStatus_t& s    = statuses[i];
+                const Track&        t    = *find(s);
+                TaskInfo&           info = r->tasks[i];
+                info.handle              = s.xHandle;
+                std::strncpy(info.name, s.pcTaskName, configMAX_TASK_NAME_LEN - 1);
+                info.name[configMAX_TASK_NAME_LEN - 1] = '\0';
+                info.number                            = s.xTaskNumber;
+                info.state                             = s.eCurrentState;
+                info.priority                          = s.uxCurrentPriority;
+                info.cpu                               = capacity ? share(t.window[lastSlot()], capacity) : 0;
+                info.cpuAvg                            = capacityAvg ? share(t.sum, capacityAvg) : 0;
+                info.stackFree                         = s.usStackHighWaterMark;
+
+                if (primed && !isIdle(s.pcTaskName) && info.cpuAvg >= config.taskCpuAlarm) active |= TaskCpu;
+                if (info.stackFree < config.stackAlarmWords) active |= StackLow;
+            }
+            r->alarms = active;
+            ++r->sequence;
+        }
+        publishAlarms(active);
+    }
+
+    // Копия последнего отчёта
+    Report lastReport() {
+        return *report();
+    }
+
+    // Активные тревоги (без сдвига)
+    EventBits_t alarms() {
+        return report()->alarms;
+    }
+
+    // Записать бинарный снимок в buf. Возвращает число байт или 0, если буфер мал.
+    size_t snapshot(uint8_t* buf, size_t size) {
+        auto         r      = report();
+        const size_t needed = HeaderSize + EntrySize * r->count;
+        if (!buf || size < needed) return 0;
+
+        uint8_t* p = buf;
+        p          = put16(p, SnapshotMagic);
+        *p++       = SnapshotVersion;
+        *p++       = static_cast<uint8_t>(r->count);
+        p          = put32(p, r->sequence);
+        p          = put16(p, r->loadAvg);
+        p          = put16(p, static_cast<uint16_t>(r->alarms));
+        for (size_t i = 0; i < r->count; ++i) {
+            const TaskInfo& t = r->tasks[i];
+            p                 = put16(p, static_cast<uint16_t>(t.number));
+            p                 = put16(p, t.cpuAvg);
+            p                 = put16(p, t.stackFree > 0xFFFF ? 0xFFFF : static_cast<uint16_t>(t.stackFree));
+            *p++              = static_cast<uint8_t>(t.priority);
+            *p++              = static_cast<uint8_t>(t.state);
+            std::memset(p, 0, SnapshotName);
+            std::strncpy(reinterpret_cast<char*>(p), t.name, SnapshotName);
+            p += SnapshotName;
+        }
+        return needed;
+    }
+
+  private:
+#if defined(configNUMBER_OF_CORES)
+    static constexpr uint32_t Cores = configNUMBER_OF_CORES;
+#elif defined(portNUM_PROCESSORS)
+    static constexpr uint32_t Cores = portNUM_PROCESSORS;
+#else
+    static constexpr uint32_t Cores = 1;
+#endif
+
+    // Приращения счётчика одной задачи за последние Window периодов
+    struct Track {
+        TaskHandle_t handle;
+        UBaseType_t  number;  // отличает новую задачу с тем же адресом TCB
+        Counter      prev;
+        uint32_t     window[Window];
+        uint64_t     sum;
+        bool         seen;
+    };
+
+    EventGroup&      alarmGroup;
+    Config           config;
+    TaskHandle_t     task = nullptr;
+    Guarded<Report>  published;
+
+    TaskStatus_t statuses[MaxTasks];
+    Track        tracks[MaxTasks];
+    size_t       trackCount = 0;
+    uint32_t     totalWindow[Window]{};
+    uint64_t     totalSum    = 0;
+    Counter      prevTotal   = 0;
+    size_t       slot        = 0;
+    bool         hasPrevious = false;
+
+    typename Guarded<Report>::Access report() {
+        return published();
+    }
+
+    static void run(void* arg) {
+        auto*      self = static_cast<SystemMonitor*>(arg);
+        TickType_t last = xTaskGetTickCount();
+        for (;;) {
+            vTaskDelayUntil(&last, self->config.period);
+            self->sample();
+        }
+    }
+
+    static bool isIdle(const char* name) {
+        return std::strncmp(name, "IDLE", 4) == 0;  // IDLE, IDLE0, IDLE1 ...
+    }
+
+    static uint16_t share(uint64_t part, uint64_t whole) {
+        uint64_t v = part * 10000 / whole;
+        return static_cast<uint16_t>(v > 10000 ? 10000 : v);
+    }
+
+    size_t lastSlot() const {
+        return (slot + Window - 1) % Window;
+    }
+
+    void pushWindow(uint32_t (&window)[Window], uint64_t& sum, uint32_t value) {
+        sum -= window[slot];
+        window[slot] = value;
+        sum += value;
+    }
+
+    Track* find(const TaskStatus_t& s) {
+        for (size_t i = 0; i < trackCount; ++i) {
+            if (tracks[i].handle == s.xHandle && tracks[i].number == s.xTaskNumber) return &tracks[i];
+        }
+        return nullptr;
+    }
+
+    // Найти или завести учёт задачи. Задача, появившаяся после первого снимка,
+    // создана в этом периоде — её счётчик целиком приходится на него.
+    Track& track(const TaskStatus_t& s, bool primed) {
+        Track* t = find(s);
+        if (!t) {
+            // Места хватает: задач в снимке не больше MaxTasks, удалённые уже вычищены
+            configASSERT(trackCount < MaxTasks);
+            t = &tracks[trackCount++];
+            std::memset(t, 0, sizeof(Track));
+            t->handle = s.xHandle;
+            t->number = s.xTaskNumber;
+            t->prev   = primed ? 0 : s.ulRunTimeCounter;
+        }
+        return *t;
+    }
+
+    void dropDeleted() {
+        for (size_t i = 0; i < trackCount;) {
+            if (tracks[i].seen) {
+                ++i;
+            } else {
+                tracks[i] = tracks[--trackCount];
+            }
+        }
+    }
+
+    void publishAlarms(EventBits_t active) {
+        const EventBits_t mask = static_cast<EventBits_t>(AllAlarms) << config.alarmShift;
+        const EventBits_t set  = active << config.alarmShift;
+        const EventBits_t now  = alarmGroup.getBits();
+        if (set & ~now) alarmGroup.setBits(set & ~now);
+        if (now & mask & ~set) alarmGroup.clearBits(now & mask & ~set);
+    }
+
+    static uint8_t* put16(uint8_t* p, uint16_t v) {
+        p[0] = static_cast<uint8_t>(v);
+        p[1] = static_cast<uint8_t>(v >> 8);
+        return p + 2;
+    }
+
+    static uint8_t* put32(uint8_t* p, uint32_t v) {
+        p = put16(p, static_cast<uint16_t>(v));
+        return put16(p, static_cast<uint16_t>(v >> 16));
+    }
+};
+
+#endif  // SYSTEM_MONITOR_H
+
+/*
+using Monitor = SystemMonitor<24, 10>;  // до 24 задач, окно 10 периодов
+
+Monitor::Config monitorConfig() {
+    Monitor::Config cfg;
+    cfg.period          = pdMS_TO_TICKS(500);
+    cfg.cpuLoadAlarm    = 9500;  // 95% за 5 секунд
+    cfg.stackAlarmWords = 256;
+    return cfg;
+}
+
+EventGroup health;
+Monitor    monitor(health, monitorConfig());
+
+void setup() {
+    monitor.start("sysmon", 1);
+}
+
+void watchdogTask(void*) {
+    for (;;) {
+        EventBits_t bits = health.waitBits(Monitor::StackLow | Monitor::CpuLoad, false, false, 1000);
+        if (bits & Monitor::StackLow) {
+            Monitor::Report report = monitor.lastReport();  // ~1 КБ: не на маленьком стеке
+            for (size_t i = 0; i < report.count; ++i) {
+                if (report.tasks[i].stackFree < 256) {
+                    printf("%s: %u words left\n", report.tasks[i].name, unsigned(report.tasks[i].stackFree));
+                }
+            }
+        }
+    }
+}
+
+// Выгрузка: 12 + 20 * N байт
+uint8_t buf[Monitor::SnapshotSize];
+size_t  n = monitor.snapshot(buf, sizeof(buf));
+mqttPublish("device/health", buf, n);
+*/
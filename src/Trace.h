@@ -0,0 +1,213 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Трассировка операций обёрток (QueueTypeBase, Guarded, EventGroup).
+//
+// Включается при компиляции: -DFREERTOS_CPP_TRACE=1. Без него все вызовы
+// trace::emit() — пустые inline-функции, обёртки не платят ничего.
+//
+// Каждое событие — запись trace::Record (16 байт) в кольцо своего ядра:
+// резерв слота одним atomic fetch_add + чтение часов + 4 слова — порядка 20 тактов,
+// без блокировок и запрета прерываний. Кольцо перезаписывает старые записи
+// (бортовой самописец): после всплеска задержки останавливаем запись и делаем дамп.
+//
+// Часы (FREERTOS_CPP_TRACE_CLOCK / FREERTOS_CPP_TRACE_CLOCK_HZ): по умолчанию общий мелкий
+// счётчик FREERTOS_CPP_CLOCK_CYCLES (MicrosClock.h) — такты на ESP32, наносекунды на хосте.
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "TraceFormat.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifndef FREERTOS_CPP_TRACE
+#define FREERTOS_CPP_TRACE 0
+#endif
+
+#if FREERTOS_CPP_TRACE
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+
+#ifndef FREERTOS_CPP_TRACE_CLOCK
+#include "MicrosClock.h"
+#define FREERTOS_CPP_TRACE_CLOCK()  FREERTOS_CPP_CLOCK_CYCLES()
+#define FREERTOS_CPP_TRACE_CLOCK_HZ FREERTOS_CPP_CLOCK_CYCLES_HZ
+#endif
+
+#ifndef FREERTOS_CPP_TRACE_CORES
+#ifdef portNUM_PROCESSORS
+#define FREERTOS_CPP_TRACE_CORES portNUM_PROCESSORS
+#else
+#define FREERTOS_CPP_TRACE_CORES 1
+#endif
+#endif
+
+#ifndef FREERTOS_CPP_TRACE_CORE_ID
+#if FREERTOS_CPP_TRACE_CORES > 1
+#define FREERTOS_CPP_TRACE_CORE_ID() xPortGetCoreID()
+#else
+#define FREERTOS_CPP_TRACE_CORE_ID() 0
+#endif
+#endif
+
+// Записей на ядро (степень двойки)
+#ifndef FREERTOS_CPP_TRACE_RING_SIZE
+#define FREERTOS_CPP_TRACE_RING_SIZE 1024
+#endif
+
+#ifndef FREERTOS_CPP_TRACE_MAX_NAMES
+#define FREERTOS_CPP_TRACE_MAX_NAMES 32
+#endif
+
+namespace trace {
+
+constexpr bool     Enabled  = true;
+constexpr uint32_t Cores    = FREERTOS_CPP_TRACE_CORES;
+constexpr uint32_t RingSize = FREERTOS_CPP_TRACE_RING_SIZE;
+constexpr uint32_t MaxNames = FREERTOS_CPP_TRACE_MAX_NAMES;
+static_assert((RingSize & (RingSize - 1)) == 0, "FREERTOS_CPP_TRACE_RING_SIZE must be a power of two");
+
+struct Ring {
+    std::atomic<uint32_t> head{0};  // всего записей с момента reset()
+    Record                records[RingSize];
+};
+
+inline Ring                  rings[Cores];
+inline std::atomic<bool>     recording{true};
+inline NameEntry             names[MaxNames];
+inline std::atomic<uint32_t> nameCount{0};
+
+inline uint32_t objectId(const void* object) {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(object));
+}
+
+inline void record(Event e, const void* object, uint32_t arg, uint32_t task) {
+    if (!recording.load(std::memory_order_relaxed)) return;
+    Ring&    ring = rings[FREERTOS_CPP_TRACE_CORE_ID()];
+    uint32_t i    = ring.head.fetch_add(1, std::memory_order_relaxed) & (RingSize - 1);
+    Record&  r    = ring.records[i];
+    r.time        = static_cast<uint32_t>(FREERTOS_CPP_TRACE_CLOCK());
+    r.task        = task;
+    r.object      = objectId(object);
+    r.typeArg     = Record::pack(e, arg);
+}
+
+// Событие из задачи
+inline void emit(Event e, const void* object, uint32_t arg = 0) {
+    record(e, object, arg, objectId(xTaskGetCurrentTaskHandle()));
+}
+
+// Событие из прерывания
+inline void emitFromISR(Event e, const void* object, uint32_t arg = 0) {
+    record(e, object, arg, IsrTask);
+}
+
+// Подписать объект (хэндл очереди, мьютекс Guarded, группу событий) для конвертера
+inline void name(const void* object, const char* text) {
+    uint32_t i = nameCount.fetch_add(1, std::memory_order_relaxed);
+    if (i >= MaxNames) {
+        nameCount.store(MaxNames, std::memory_order_relaxed);
+        return;
+    }
+    names[i].object = objectId(object);
+    std::strncpy(names[i].name, text ? text : "", NameLength - 1);
+    names[i].name[NameLength - 1] = '\0';
+}
+
+// Подписать дорожку задачи её именем FreeRTOS (по умолчанию — текущую)
+inline void nameTask(TaskHandle_t task = nullptr) {
+    if (!task) task = xTaskGetCurrentTaskHandle();
+    name(task, pcTaskGetName(task));
+}
+
+// Остановить/возобновить запись (перед дампом — остановить)
+inline void setRecording(bool on) {
+    recording.store(on, std::memory_order_relaxed);
+}
+
+// Очистить кольца (имена сохраняются)
+inline void reset() {
+    for (Ring& ring : rings) ring.head.store(0, std::memory_order_relaxed);
+}
+
+// Куда писать дамп: файл, UART, буфер для выгрузки
+using Sink = void (*)(const void* data, size_t size, void* ctx);
+
+// Выгрузить все кольца в формате TraceFormat.h
+inline void dump(Sink sink, void* ctx) {
+    uint32_t   count = nameCount.load(std::memory_order_relaxed);
+    FileHeader header{};
+    header.magic      = FileMagic;
+    header.version    = FileVersion;
+    header.recordSize = sizeof(Record);
+    header.cores      = Cores;
+    header.nameCount  = count < MaxNames ? count : MaxNames;
+    header.clockHz    = FREERTOS_CPP_TRACE_CLOCK_HZ;
+    header.dumpTime   = FREERTOS_CPP_TRACE_CLOCK();
+    sink(&header, sizeof(header), ctx);
+    sink(names, header.nameCount * sizeof(NameEntry), ctx);
+
+    for (uint32_t c = 0; c < Cores; ++c) {
+        const Ring& ring  = rings[c];
+        uint32_t    head  = ring.head.load(std::memory_order_acquire);
+        uint32_t    saved = head < RingSize ? head : RingSize;
+        CoreHeader  core{c, saved, head - saved, 0};
+        sink(&core, sizeof(core), ctx);
+        // Самая старая запись — сразу за головой
+        uint32_t first = (head - saved) & (RingSize - 1);
+        uint32_t tail  = RingSize - first < saved ? RingSize - first : saved;
+        sink(&ring.records[first], tail * sizeof(Record), ctx);
+        sink(&ring.records[0], (saved - tail) * sizeof(Record), ctx);
+    }
+}
+
+}  // namespace trace
+
+#else  // FREERTOS_CPP_TRACE
+
+namespace trace {
+
+constexpr bool Enabled = false;
+
+inline void emit(Event, const void*, uint32_t = 0) {}
+inline void emitFromISR(Event, const void*, uint32_t = 0) {}
+inline void name(const void*, const char*) {}
+inline void nameTask(TaskHandle_t = nullptr) {}
+
+}  // namespace trace
+
+#endif  // FREERTOS_CPP_TRACE
+
+#endif  // TRACE_H
+
+/*
+// Сборка с -DFREERTOS_CPP_TRACE=1
+
+Queue<Sample>     samples(32);
+Guarded<Settings> settings;
+
+void setup() {
+    samples.setTraceName("samples");
+    settings.setTraceName("settings");
+    ...
+}
+
+void workerTask(void*) {
+    trace::nameTask();  // дорожка задачи будет подписана её именем
+    ...
+}
+
+// Всплеск задержки: останавливаем запись и выгружаем кольца
+void onLatencySpike() {
+    trace::setRecording(false);
+    trace::dump([](const void* data, size_t size, void* ctx) {
+        fwrite(data, 1, size, static_cast<FILE*>(ctx));
+    }, dumpFile);
+}
+
+// На ПК:  trace2perfetto trace.bin trace.json  → открыть в ui.perfetto.dev
+*/
@@ -0,0 +1,113 @@
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+// Формат трассы обёрток: записи фиксированного размера и файл дампа.
+// Не зависит от FreeRTOS — его же читает хостовый конвертер (host/tools/trace2perfetto).
+
+#include <cstdint>
+
+namespace trace {
+
+enum class Event : uint8_t {
+    None = 0,
+
+    // Очереди: arg — глубина очереди после операции
+    QueueSend,
+    QueueSendBlock,  // очередь полна, задача уходит ждать места
+    QueueSendFail,
+    QueueReceive,
+    QueueReceiveBlock,  // очередь пуста, задача уходит ждать элемента
+    QueueReceiveFail,
+    QueuePeek,
+    QueueReset,
+
+    // Guarded: object — мьютекс
+    LockRequest,
+    LockAcquired,
+    LockReleased,
+
+    // EventGroup: arg — биты (младшие 24)
+    EventSet,
+    EventClear,
+    EventWaitBegin,
+    EventWaitEnd,
+
+    Count
+};
+
+// Задача, от имени которой пишутся события из прерываний
+constexpr uint32_t IsrTask = 0;
+
+// 16 байт: время, задача, объект, тип + аргумент
+struct Record {
+    uint32_t time;     // младшие 32 бита часов трассы
+    uint32_t task;     // младшие 32 бита TaskHandle_t, IsrTask — прерывание
+    uint32_t object;   // младшие 32 бита хэндла объекта
+    uint32_t typeArg;  // тип в старшем байте, аргумент в младших 24 битах
+
+    Event event() const {
+        return static_cast<Event>(typeArg >> 24);
+    }
+    uint32_t arg() const {
+        return typeArg & 0xFFFFFFu;
+    }
+    static uint32_t pack(Event e, uint32_t arg) {
+        return (static_cast<uint32_t>(e) << 24) | (arg & 0xFFFFFFu);
+    }
+};
+static_assert(sizeof(Record) == 16, "trace::Record must stay 16 bytes");
+
+constexpr uint32_t NameLength = 16;
+
+// Имя объекта или задачи для конвертера
+struct NameEntry {
+    uint32_t object;
+    char     name[NameLength];
+};
+
+// Дамп: FileHeader, nameCount × NameEntry, затем для каждого ядра CoreHeader и count × Record
+// в порядке записи (от старых к новым). Все поля — little-endian, как на ESP32/x86.
+constexpr uint32_t FileMagic   = 0x52545246u;  // "FRTR"
+constexpr uint16_t FileVersion = 1;
+
+struct FileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t cores;
+    uint32_t nameCount;
+    uint64_t clockHz;
+    uint64_t dumpTime;  // полное значение часов в момент дампа — опора для разворота 32-битных меток
+};
+
+struct CoreHeader {
+    uint32_t core;
+    uint32_t count;
+    uint32_t lost;  // записи, затёртые кольцом
+    uint32_t reserved;
+};
+
+inline const char* eventName(Event e) {
+    switch (e) {
+        case Event::QueueSend: return "queue_send";
+        case Event::QueueSendBlock: return "queue_send_block";
+        case Event::QueueSendFail: return "queue_send_fail";
+        case Event::QueueReceive: return "queue_receive";
+        case Event::QueueReceiveBlock: return "queue_receive_block";
+        case Event::QueueReceiveFail: return "queue_receive_fail";
+        case Event::QueuePeek: return "queue_peek";
+        case Event::QueueReset: return "queue_reset";
+        case Event::LockRequest: return "lock_request";
+        case Event::LockAcquired: return "lock_acquired";
+        case Event::LockReleased: return "lock_released";
+        case Event::EventSet: return "event_set";
+        case Event::EventClear: return "event_clear";
+        case Event::EventWaitBegin: return "event_wait_begin";
+        case Event::EventWaitEnd: return "event_wait_end";
+        default: return "unknown";
+    }
+}
+
+}  // namespace trace
+
+#endif  // TRACE_FORMAT_H
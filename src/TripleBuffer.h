@@ -0,0 +1,152 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+// Тройной буфер: передача «последнего кадра» большого размера без копирования.
+//
+// Три буфера T: один пишет производитель, один читает потребитель, третий — последний
+// опубликованный. publish() и acquire() — один atomic exchange индекса среднего буфера,
+// ни одна сторона не ждёт другую и не копирует данные. У производителя всегда есть
+// свободный буфер; кадр, который потребитель не успел забрать, заменяется новым
+// и учитывается в skipped().
+//
+// Один производитель и один потребитель. publish() можно звать из прерывания
+// (publishFromISR). Потребитель может ждать нового кадра: waitNewer() спит на
+// уведомлении задачи (индекс библиотеки, NotifyIndex.h).
+
+#ifdef Arduino_h
+#include <Arduino.h>
+#endif
+
+#include "NotifyIndex.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <atomic>
+#include <cstdint>
+
+template <typename T>
+class TripleBuffer {
+  public:
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&)            = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // ---- Производитель ----
+
+    // Буфер для следующего кадра; в нём лежит один из старых кадров
+    T& writeBuffer() {
+        return buffers[writeIndex];
+    }
+
+    // Опубликовать записанный кадр и получить новый буфер для записи
+    void publish() {
+        if (TaskHandle_t w = swapIn()) notify::library::give(w);
+    }
+
+    void publishFromISR(BaseType_t* pxHigherPriorityTaskWoken) {
+        if (TaskHandle_t w = swapIn()) notify::library::giveFromISR(w, pxHigherPriorityTaskWoken);
+    }
+
+    // ---- Потребитель ----
+
+    // Забрать последний опубликованный кадр, если он новее текущего. false — нового нет,
+    // readBuffer() остаётся прежним.
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & Fresh)) return false;
+        uint8_t old = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex   = old & IndexMask;
+        acquired.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Ждать нового кадра до ms и забрать его
+    bool waitNewer(uint32_t ms) {
+        if (acquire()) return true;
+        const TickType_t start = xTaskGetTickCount();
+        const TickType_t limit = pdMS_TO_TICKS(ms);
+        waiter.store(xTaskGetCurrentTaskHandle(), std::memory_order_seq_cst);
+        bool ok = acquire();  // кадр мог появиться до регистрации
+        while (!ok) {
+            const TickType_t spent = xTaskGetTickCount() - start;
+            if (spent >= limit) break;
+            notify::library::take(limit - spent);
+            ok = acquire();  // уведомление могло остаться от прошлого ожидания
+        }
+        waiter.store(nullptr, std::memory_order_relaxed);
+        return ok;
+    }
+
+    // Кадр, забранный последним acquire()
+    const T& readBuffer() const {
+        return buffers[readIndex];
+    }
+
+    // Есть опубликованный кадр, который ещё не забран
+    bool hasNewer() const {
+        return middle.load(std::memory_order_relaxed) & Fresh;
+    }
+
+    // ---- Счётчики ----
+
+    uint32_t published() const {
+        return publishedCount.load(std::memory_order_relaxed);
+    }
+
+    uint32_t consumed() const {
+        return acquired.load(std::memory_order_relaxed);
+    }
+
+    // Кадры, заменённые новыми до того, как потребитель их забрал
+    uint32_t skipped() const {
+        return skippedCount.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr uint8_t IndexMask = 0x3;
+    static constexpr uint8_t Fresh     = 0x4;  // в среднем буфере кадр, ещё не забранный потребителем
+
+    T                         buffers[3] = {};
+    std::atomic<uint8_t>      middle{1};  // индекс среднего буфера | Fresh
+    uint8_t                   writeIndex = 0;
+    uint8_t                   readIndex  = 2;
+    std::atomic<TaskHandle_t> waiter{nullptr};
+    std::atomic<uint32_t>     publishedCount{0};
+    std::atomic<uint32_t>     acquired{0};
+    std::atomic<uint32_t>     skippedCount{0};
+
+    // Поменять записанный буфер со средним; вернуть ждущего потребителя
+    TaskHandle_t swapIn() {
+        uint8_t old = middle.exchange(static_cast<uint8_t>(writeIndex | Fresh), std::memory_order_acq_rel);
+        writeIndex  = old & IndexMask;
+        publishedCount.fetch_add(1, std::memory_order_relaxed);
+        if (old & Fresh) skippedCount.fetch_add(1, std::memory_order_relaxed);
+        return waiter.load(std::memory_order_seq_cst);
+    }
+};
+
+#endif  // TRIPLE_BUFFER_H
+
+/*
+struct Frame {
+    uint16_t pixels[160 * 120];  // 37.5 КБ
+};
+
+static TripleBuffer<Frame> frames;  // три кадра, статически
+
+void cameraTask(void*) {
+    for (;;) {
+        Frame& f = frames.writeBuffer();
+        camera.capture(f.pixels);  // пишем на месте
+        frames.publish();
+    }
+}
+
+void displayTask(void*) {
+    for (;;) {
+        if (frames.waitNewer(100)) {
+            show(frames.readBuffer());
+        }
+        // frames.skipped() — сколько кадров дисплей не успел показать
+    }
+}
+*/
@@ -0,0 +1,48 @@
+#ifndef TEST_HARNESS_H
+#define TEST_HARNESS_H
+
+// Минимальный тестовый каркас для хостовой сборки.
+// Тесты выполняются внутри задачи FreeRTOS под настоящим планировщиком:
+// TestMain.cpp создаёт задачу-раннер, запускает vTaskStartScheduler()
+// и по окончании останавливает его через vTaskEndScheduler().
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cstdio>
+
+namespace test {
+
+using TestFn = void (*)();
+
+struct Case {
+    const char* name;
+    TestFn      fn;
+    Case*       next;
+};
+
+// Регистрация теста (вызывается из статических конструкторов TEST_CASE)
+void registerCase(Case* c);
+
+// Фиксирует результат проверки
+void check(bool ok, const char* expr, const char* file, int line);
+
+// Приоритет задачи-раннера; вспомогательные задачи тестов создаются относительно него
+constexpr UBaseType_t RunnerPriority = tskIDLE_PRIORITY + 2;
+
+struct Registrar {
+    Registrar(const char* name, TestFn fn) : c{name, fn, nullptr} {
+        registerCase(&c);
+    }
+    Case c;
+};
+
+}  // namespace test
+
+#define TEST_CASE(name)                                          \
+    static void name();                                          \
+    static ::test::Registrar name##_registrar(#name, &name);     \
+    static void name()
+
+#define CHECK(expr) ::test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+#endif  // TEST_HARNESS_H
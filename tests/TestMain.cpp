@@ -0,0 +1,53 @@
+#include "TestHarness.h"
+
+namespace test {
+
+static Case* firstCase = nullptr;
+static Case* lastCase  = nullptr;
+static int   failures  = 0;
+static int   checks    = 0;
+static bool  finished  = false;  // раннер дошёл до конца, а не планировщик остановился сам
+
+void registerCase(Case* c) {
+    // Сохраняем порядок объявления внутри файла
+    if (lastCase) {
+        lastCase->next = c;
+    } else {
+        firstCase = c;
+    }
+    lastCase = c;
+}
+
+void check(bool ok, const char* expr, const char* file, int line) {
+    ++checks;
+    if (!ok) {
+        ++failures;
+        std::printf("  FAILED: %s (%s:%d)\n", expr, file, line);
+    }
+}
+
+static void runnerTask(void*) {
+    int failedCases = 0;
+    for (Case* c = firstCase; c; c = c->next) {
+        int before = failures;
+        std::printf("[ RUN  ] %s\n", c->name);
+        c->fn();
+        bool ok = failures == before;
+        if (!ok) ++failedCases;
+        std::printf("[ %s ] %s\n", ok ? " OK " : "FAIL", c->name);
+    }
+    std::printf("%d checks, %d failed case(s)\n", checks, failedCases);
+    std::fflush(stdout);
+    finished = true;
+    vTaskEndScheduler();
+    vTaskDelete(nullptr);
+}
+
+}  // namespace test
+
+int main() {
+    xTaskCreate(test::runnerTask, "runner", configMINIMAL_STACK_SIZE * 4, nullptr, test::RunnerPriority, nullptr);
+    vTaskStartScheduler();
+    if (!test::finished) std::printf("scheduler stopped before all cases finished\n");
+    return test::finished && test::failures == 0 ? 0 : 1;
+}
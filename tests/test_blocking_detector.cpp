@@ -0,0 +1,175 @@
+#include "TestHarness.h"
+
+// Собирается с FREERTOS_CPP_BLOCKING=1 (см. tests/CMakeLists.txt)
+#include "Guarded.h"
+#include "QueueCpp.h"
+
+#include <cstring>
+
+// Сценарии разыгрываются задачами ниже и выше раннера; раннер ждёт их через vTaskDelay.
+// Виртуальное время: ожидание длится ровно столько тиков, сколько держатель спал.
+
+namespace {
+
+constexpr UBaseType_t Low  = test::RunnerPriority - 1;
+constexpr UBaseType_t High = test::RunnerPriority + 1;
+
+using Fn = void (*)();
+
+// Запустить fn в задаче с приоритетом prio и именем name
+void spawn(const char* name, UBaseType_t prio, Fn fn) {
+    xTaskCreate(
+        [](void* p) {
+            reinterpret_cast<Fn>(p)();
+            vTaskDelete(nullptr);
+        },
+        name, configMINIMAL_STACK_SIZE * 2, reinterpret_cast<void*>(fn), prio, nullptr);
+}
+
+const blocking::Entry* find(const blocking::Entry* rows, size_t n, const char* name) {
+    for (size_t i = 0; i < n; ++i) {
+        if (rows[i].name && std::strcmp(rows[i].name, name) == 0) return &rows[i];
+    }
+    return nullptr;
+}
+
+Guarded<int>* lockA;
+Guarded<int>* lockB;
+Queue<int>*   queue;
+
+}  // namespace
+
+TEST_CASE(blocking_records_mutex_inversion) {
+    blocking::reset();
+    Guarded<int> a;
+    a.setTraceName("a");
+    lockA = &a;
+
+    // Неоспоренный захват в отчёт не попадает
+    { auto v = a(); }
+
+    spawn("low", Low, [] {
+        auto v = (*lockA)();
+        vTaskDelay(5);
+    });
+    vTaskDelay(1);  // low взял мьютекс и спит с ним
+    spawn("high", High, [] { auto v = (*lockA)(); });
+    vTaskDelay(10);
+
+    blocking::Entry rows[4];
+    const size_t    n = blocking::report(rows, 4);
+    CHECK(n == 1);
+    const blocking::Entry& r = rows[0];
+    CHECK(std::strcmp(r.name, "a") == 0 && r.kind == blocking::Kind::Mutex);
+    CHECK(r.blocks == 1 && r.inversions == 1 && r.maxDepth == 1);
+    CHECK(r.maxUs > 3900 && r.maxUs <= 4000 && r.inversionUs == r.maxUs);
+    CHECK(std::strcmp(r.waiter, "high") == 0 && std::strcmp(r.blocker, "low") == 0);
+    CHECK(r.waiterPriority == High && r.blockerPriority == Low);
+    CHECK(blocking::dropped() == 0);
+}
+
+TEST_CASE(blocking_chain_depth_and_ranking) {
+    blocking::reset();
+    Guarded<int> a, b;
+    a.setTraceName("a");
+    b.setTraceName("b");
+    lockA = &a;
+    lockB = &b;
+
+    // mid держит b; low держит a и ждёт b; high ждёт a → цепочка high → low → mid
+    spawn("mid", Low, [] {
+        auto v = (*lockB)();
+        vTaskDelay(8);
+    });
+    vTaskDelay(1);
+    spawn("low", Low, [] {
+        auto v = (*lockA)();
+        auto w = (*lockB)();
+    });
+    vTaskDelay(1);
+    spawn("high", High, [] { auto v = (*lockA)(); });
+    vTaskDelay(10);
+
+    blocking::Entry rows[4];
+    const size_t    n = blocking::report(rows, 4);
+    CHECK(n == 2);
+    // a — инверсия, b — долгое ожидание без инверсии: a первым
+    CHECK(std::strcmp(rows[0].name, "a") == 0 && std::strcmp(rows[1].name, "b") == 0);
+    CHECK(rows[0].inversions == 1 && rows[0].maxDepth == 2);
+    CHECK(rows[1].inversions == 0 && rows[1].blocks == 1 && rows[1].maxDepth == 1);
+    CHECK(std::strcmp(rows[1].waiter, "low") == 0 && std::strcmp(rows[1].blocker, "mid") == 0);
+    CHECK(rows[1].maxUs > rows[0].maxUs);  // low ждал b дольше, чем high ждал a
+
+    // Порог выше ожидания: ожидание без инверсии не пишется
+    blocking::reset();
+    blocking::setLongBlockUs(100000);
+    spawn("mid", Low, [] {
+        auto v = (*lockB)();
+        vTaskDelay(3);
+    });
+    vTaskDelay(1);
+    spawn("low", Low, [] { auto v = (*lockB)(); });
+    vTaskDelay(5);
+    CHECK(blocking::report(rows, 4) == 0);
+    blocking::setLongBlockUs(FREERTOS_CPP_BLOCKING_LONG_US);
+}
+
+TEST_CASE(blocking_queue_starved_by_lower_priority) {
+    blocking::reset();
+    Queue<int> q(2);
+    q.setTraceName("q");
+    queue = &q;
+
+    // low кормит очередь редко, high её ждёт — инверсия через голодание
+    spawn("low", Low, [] {
+        queue->send(1);
+        vTaskDelay(4);
+        queue->send(2);
+    });
+    vTaskDelay(1);
+    spawn("high", High, [] {
+        int v = 0;
+        queue->receive(v, portMAX_DELAY);  // уже лежит
+        queue->receive(v, portMAX_DELAY);  // ждёт low
+    });
+    vTaskDelay(6);
+
+    blocking::Entry rows[4];
+    const size_t    n = blocking::report(rows, 4);
+    const blocking::Entry* r = find(rows, n, "q");
+    CHECK(n == 1 && r);
+    CHECK(r->kind == blocking::Kind::QueueEmpty && r->inversions == 1 && r->blocks == 1);
+    CHECK(std::strcmp(r->waiter, "high") == 0 && std::strcmp(r->blocker, "low") == 0);
+    CHECK(r->maxUs > 2900 && r->maxUs <= 4000);
+
+    // Отправка из ISR: поставщик неизвестен — ожидание долгое, но не инверсия
+    blocking::reset();
+    BaseType_t  woken = pdFALSE;
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    q.sendFromISR(3, &woken);
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    int v = 0;
+    CHECK(q.receive(v) && v == 3);
+    CHECK(!q.receive(v, 2));
+    CHECK(blocking::report(rows, 4) == 1);
+    CHECK(rows[0].inversions == 0 && rows[0].blocker[0] == '\0' && rows[0].maxUs >= 1000);
+}
+
+TEST_CASE(blocking_queue_supplier_deleted_before_wait) {
+    blocking::reset();
+    Queue<int> q(2);
+    q.setTraceName("q");
+    queue = &q;
+
+    // Поставщик положил и удалился; ожидание берёт его имя и приоритет из снимка
+    spawn("gone", Low, [] { queue->send(1); });
+    vTaskDelay(2);
+    int v = 0;
+    CHECK(q.receive(v) && v == 1);
+    CHECK(!q.receive(v, 2));
+
+    blocking::Entry rows[4];
+    CHECK(blocking::report(rows, 4) == 1);
+    CHECK(rows[0].inversions == 1 && std::strcmp(rows[0].blocker, "gone") == 0);
+    CHECK(rows[0].blockerPriority == Low && rows[0].waiterPriority == test::RunnerPriority);
+}
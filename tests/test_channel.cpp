@@ -0,0 +1,163 @@
+#include "TestHarness.h"
+
+#include "Channel.h"
+
+// Вспомогательные задачи ниже раннера: они работают, только когда раннер ждёт в канале.
+
+namespace {
+
+constexpr UBaseType_t HelperPriority = test::RunnerPriority - 1;
+
+// Считает присваивания копированием — сколько раз значение переложили
+struct Tracked {
+    int        v = 0;
+    static int copies;
+
+    Tracked() = default;
+    explicit Tracked(int x) : v(x) {}
+    Tracked(const Tracked& o) : v(o.v) {
+        ++copies;
+    }
+    Tracked& operator=(const Tracked& o) {
+        v = o.v;
+        ++copies;
+        return *this;
+    }
+};
+int Tracked::copies = 0;
+
+// Запустить функцию в отдельной задаче после задержки
+struct Later {
+    void (*fn)();
+    TickType_t delay;
+};
+
+void runLater(void (*fn)(), TickType_t delay) {
+    static Later later;
+    later = {fn, delay};
+    xTaskCreate(
+        [](void* p) {
+            Later l = *static_cast<Later*>(p);
+            vTaskDelay(l.delay);
+            l.fn();
+            vTaskDelete(nullptr);
+        },
+        "helper", configMINIMAL_STACK_SIZE * 2, &later, HelperPriority, nullptr);
+}
+
+}  // namespace
+
+TEST_CASE(buffered_channel_is_fifo) {
+    Channel<int, 3> ch;
+    CHECK(ch.capacity() == 3);
+    for (int i = 1; i <= 3; ++i) CHECK(ch.send(i));
+    CHECK(!ch.send(4));
+    CHECK(ch.size() == 3);
+    int v = 0;
+    for (int i = 1; i <= 3; ++i) CHECK(ch.receive(v) && v == i);
+    CHECK(!ch.receive(v));
+
+    TickType_t start = xTaskGetTickCount();
+    CHECK(!ch.receive(v, 5));
+    CHECK(xTaskGetTickCount() - start >= 5);
+}
+
+TEST_CASE(rendezvous_hands_value_directly) {
+    static Channel<Tracked> ch;
+    static Tracked          got;
+    static bool             received;
+    CHECK(!ch.send(Tracked(1)));  // получателя нет — без ожидания не отправить
+
+    received = false;
+    runLater([] { received = ch.receive(got, 1000); }, 2);
+    Tracked item(42);
+    Tracked::copies = 0;
+    CHECK(ch.send(item, 1000));
+    vTaskDelay(1);
+    CHECK(received && got.v == 42);
+    CHECK(Tracked::copies == 1);  // из переменной отправителя сразу в переменную получателя
+
+    // Через буфер — две копии: в буфер и из него
+    static Channel<Tracked, 1> buffered;
+    Tracked::copies = 0;
+    CHECK(buffered.send(item));
+    CHECK(buffered.receive(got));
+    CHECK(Tracked::copies == 2);
+}
+
+TEST_CASE(select_prefers_earlier_ready_case) {
+    Channel<int, 2> a, b;
+    int             x = 0, y = 0;
+    CHECK(channel::select({channel::recv(a, x), channel::recv(b, y)}, 0) == -1);
+
+    CHECK(b.send(20));
+    CHECK(channel::select({channel::recv(a, x), channel::recv(b, y)}, 0) == 1);
+    CHECK(y == 20);
+
+    CHECK(a.send(10) && b.send(21));
+    CHECK(channel::select({channel::recv(a, x), channel::recv(b, y)}, 0) == 0);
+    CHECK(x == 10 && b.size() == 1);
+
+    // Отправка тоже вариант: в полный канал нельзя, в пустой — можно
+    CHECK(a.send(11) && a.send(12));
+    CHECK(channel::select({channel::send(a, 13), channel::recv(b, y)}, 0) == 1);
+    CHECK(channel::select({channel::send(a, 13), channel::send(b, 22)}, 0) == 1);
+}
+
+TEST_CASE(select_waits_on_several_channels) {
+    static Channel<int> a, b;
+    int                 x = 0, y = 0;
+    runLater([] { b.send(7, 1000); }, 3);
+    TickType_t start = xTaskGetTickCount();
+    CHECK(channel::select({channel::recv(a, x), channel::recv(b, y)}, 1000) == 1);
+    CHECK(y == 7 && x == 0);
+    CHECK(xTaskGetTickCount() - start >= 3);
+
+    // Несработавший вариант снят с очереди a: отправить туда без получателя нельзя
+    CHECK(!a.send(1));
+
+    // Таймаут тоже снимает оба варианта
+    CHECK(channel::select({channel::recv(a, x), channel::recv(b, y)}, 3) == -1);
+    CHECK(!a.send(1) && !b.send(1));
+}
+
+TEST_CASE(select_send_or_receive) {
+    static Channel<int> out, in;
+    static int          taken;
+    taken = 0;
+    runLater([] { out.receive(taken, 1000); }, 2);
+    int  v  = 0;
+    bool ok = false;
+    CHECK(channel::select({channel::send(out, 99, &ok), channel::recv(in, v)}, 1000) == 0);
+    CHECK(ok);
+    vTaskDelay(1);
+    CHECK(taken == 99);
+}
+
+TEST_CASE(close_drains_then_fails) {
+    Channel<int, 4> ch;
+    CHECK(ch.send(1) && ch.send(2));
+    ch.close();
+    CHECK(ch.isClosed());
+    CHECK(!ch.send(3, 100));
+    int v = 0;
+    CHECK(ch.receive(v, 100) && v == 1);
+    CHECK(ch.receive(v, 100) && v == 2);
+    TickType_t start = xTaskGetTickCount();
+    CHECK(!ch.receive(v, 100));
+    CHECK(xTaskGetTickCount() == start);  // закрытый и пустой — без ожидания
+
+    bool ok = true;
+    CHECK(channel::select({channel::recv(ch, v, &ok)}, 100) == 0);
+    CHECK(!ok);
+}
+
+TEST_CASE(close_wakes_blocked_peers) {
+    static Channel<int> ch;
+    int                 v = 0;
+    runLater([] { ch.close(); }, 3);
+    TickType_t start = xTaskGetTickCount();
+    CHECK(!ch.receive(v, 1000));
+    TickType_t waited = xTaskGetTickCount() - start;
+    CHECK(waited >= 3 && waited < 100);
+}
@@ -0,0 +1,181 @@
+#include "TestHarness.h"
+
+#include "CompressedChannel.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr UBaseType_t HelperPriority = test::RunnerPriority + 1;
+
+struct Sample {
+    uint32_t time;       // переполняется
+    int16_t  accel[3];
+    int8_t   level;      // скачет между крайними значениями
+    uint8_t  untouched;  // не в списке полей
+};
+
+#define SAMPLE_FIELDS &Sample::time, &Sample::accel, &Sample::level
+
+using Channel = CompressedChannel<Sample, 256, SAMPLE_FIELDS>;
+using Dec     = compress::Decoder<Sample, SAMPLE_FIELDS>;
+using Enc     = compress::Encoder<Sample, SAMPLE_FIELDS>;
+
+static_assert(Enc::MaxPayload == 5 + 3 * 3 + 2, "varint bytes per field width");
+
+Sample make(uint32_t i) {
+    Sample s{};
+    s.time     = 0xFFFFFF00u + i * 10;
+    s.accel[0] = static_cast<int16_t>(1000 + (i % 7));
+    s.accel[1] = static_cast<int16_t>(-2000 - (i % 5));
+    s.accel[2] = static_cast<int16_t>(i & 1 ? 32767 : -32768);
+    s.level    = static_cast<int8_t>(i % 3 == 0 ? 127 : -128);
+    return s;
+}
+
+bool same(const Sample& a, const Sample& b) {
+    return a.time == b.time && std::memcmp(a.accel, b.accel, sizeof(a.accel)) == 0 && a.level == b.level;
+}
+
+}  // namespace
+
+TEST_CASE(varint_and_zigzag) {
+    uint8_t buf[10];
+    CHECK(compress::putVarint(buf, 0) == 1 && buf[0] == 0);
+    CHECK(compress::putVarint(buf, 300) == 2 && buf[0] == 0xAC && buf[1] == 0x02);
+    CHECK(compress::putVarint(buf, UINT64_MAX) == 10);
+    uint64_t v = 0;
+    CHECK(compress::getVarint(buf, buf + 10, v) == 10 && v == UINT64_MAX);
+    CHECK(compress::getVarint(buf, buf + 9, v) == 0);  // оборвалось
+
+    CHECK(compress::zigzag(0) == 0 && compress::zigzag(-1) == 1 && compress::zigzag(1) == 2);
+    CHECK(compress::unzigzag(compress::zigzag(INT64_MIN)) == INT64_MIN);
+}
+
+TEST_CASE(codec_round_trip_with_wraparound) {
+    Enc     enc(8);
+    Dec     dec;
+    uint8_t frame[Enc::MaxFrame];
+    int     keys = 0;
+    bool    ok   = true;
+    for (uint32_t i = 0; i < 100; ++i) {
+        const Sample s   = make(i);
+        const bool   key = enc.keyframeDue();
+        const size_t len = enc.encode(s, frame);
+        keys += key;
+        Sample out{};
+        size_t used = 0;
+        ok          = ok && dec.decode(frame, len, out, used) == compress::Status::Sample && used == len;
+        ok          = ok && same(out, s) && out.untouched == 0;
+        // Разностный кадр: время +10, остальное рядом — кроме скачущих полей
+        if (!key) ok = ok && len < sizeof(Sample);
+    }
+    CHECK(ok);
+    CHECK(keys == 13);  // 0, 8, 16, ... 96
+
+    // Неполный кадр — ждать байтов
+    const size_t len = enc.encode(make(100), frame);
+    Sample       out{};
+    size_t       used = 0;
+    CHECK(dec.decode(frame, len - 1, out, used) == compress::Status::Incomplete && used == 0);
+}
+
+TEST_CASE(integral_sample_without_fields) {
+    compress::Encoder<int32_t> enc(0);
+    compress::Decoder<int32_t> dec;
+    uint8_t                    frame[compress::Encoder<int32_t>::MaxFrame];
+    int32_t                    out  = 0;
+    size_t                     used = 0;
+
+    CHECK(enc.encode(-100000, frame) == 4);  // ключевой: заголовок + 3 байта
+    CHECK(dec.decode(frame, sizeof(frame), out, used) == compress::Status::Sample && out == -100000);
+    CHECK(enc.encode(-100001, frame) == 2);  // разность -1
+    CHECK(dec.decode(frame, sizeof(frame), out, used) == compress::Status::Sample && out == -100001);
+    CHECK(!enc.keyframeDue());  // интервал 0: только первый
+}
+
+TEST_CASE(channel_delivers_in_order_and_compresses) {
+    static Channel ch(16);
+    xTaskCreate(
+        [](void*) {
+            // Плавный сигнал: после первого кадра по байту на поле
+            for (uint32_t i = 0; i < 500; ++i) {
+                Sample s{};
+                s.time     = i * 10;
+                s.accel[0] = static_cast<int16_t>(100 + i % 4);
+                s.accel[1] = -50;
+                s.accel[2] = static_cast<int16_t>(i / 8);
+                s.level    = 3;
+                while (!ch.send(s)) vTaskDelay(1);
+            }
+            vTaskDelete(nullptr);
+        },
+        "producer", configMINIMAL_STACK_SIZE * 2, nullptr, HelperPriority, nullptr);
+
+    Sample s{};
+    bool   ok = true;
+    for (uint32_t i = 0; i < 500; ++i) {
+        ok = ok && ch.receive(s, 100) && s.time == i * 10 && s.accel[0] == 100 + static_cast<int>(i % 4) &&
+             s.accel[1] == -50 && s.accel[2] == static_cast<int>(i / 8) && s.level == 3;
+    }
+    CHECK(ok);
+    CHECK(!ch.receive(s, 5));
+
+    compress::Stats st = ch.stats();
+    CHECK(st.received == 500 && st.sent == 500);
+    CHECK(st.keyframes >= 500 / 16);
+    CHECK(st.rawBytes == 500 * sizeof(Sample));
+    CHECK(st.ratio() > 1.5f);
+}
+
+TEST_CASE(overflow_drops_and_next_frame_is_key) {
+    Channel  ch(0);  // ключевые кадры только первый и после потерь
+    uint32_t i = 0;
+    while (ch.send(make(i))) ++i;
+    CHECK(ch.stats().dropped == 1 && ch.stats().keyframes == 1);
+
+    // Пропущен образец i: декодер не должен отсчитывать разность от него
+    Sample s{};
+    for (uint32_t k = 0; k < i; ++k) CHECK(ch.receive(s) && same(s, make(k)));
+    CHECK(ch.send(make(i + 1)));
+    CHECK(ch.stats().keyframes == 2);
+    CHECK(ch.receive(s) && same(s, make(i + 1)));
+}
+
+TEST_CASE(remote_decoder_resyncs_on_keyframe) {
+    Channel ch(4);
+    for (uint32_t i = 0; i < 12; ++i) CHECK(ch.send(make(i)));
+
+    uint8_t      bytes[256];
+    const size_t n = ch.receiveEncoded(bytes, sizeof(bytes));
+    CHECK(n == ch.stats().encodedBytes);
+
+    // Потеряно начало потока: первые кадры пропускаются, с ключевого (образец 4) — точно
+    Enc     enc(4);
+    uint8_t frame[Enc::MaxFrame];
+    size_t  lost = 0;
+    for (uint32_t i = 0; i < 2; ++i) lost += enc.encode(make(i), frame);
+
+    Dec      dec;
+    size_t   at      = lost;
+    uint32_t skipped = 0;
+    uint32_t next    = 4;
+    bool     ok      = true;
+    while (at < n) {
+        Sample                 s{};
+        size_t                 used = 0;
+        const compress::Status st   = dec.decode(bytes + at, n - at, s, used);
+        at += used;
+        if (st == compress::Status::Skipped) ++skipped;
+        if (st == compress::Status::Sample) ok = ok && same(s, make(next++));
+        if (st == compress::Status::Incomplete || st == compress::Status::Corrupt) ok = false;
+    }
+    CHECK(ok && skipped == 2 && next == 12);
+
+    // Мусор в потоке: кадр отбрасывается, синхронизация до ключевого кадра
+    uint8_t junk[2] = {0xFF, 0x7F};  // заявленная длина больше любого кадра
+    Sample  s{};
+    size_t  used = 0;
+    CHECK(dec.decode(junk, sizeof(junk), s, used) == compress::Status::Corrupt && used == 1);
+    CHECK(!dec.inSync());
+}
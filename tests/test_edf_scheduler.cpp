@@ -0,0 +1,142 @@
+#include "TestHarness.h"
+
+#include "EdfScheduler.h"
+#include "NotifyIndex.h"
+#include "PeriodicTask.h"
+#include "SimKernel.h"
+
+// Сроки проверяются точно: время виртуальное, модель стоимости нулевая, задания
+// расходуют ровно заявленный WCET. Полоса EDF — над раннером, раннер только ждёт.
+
+namespace {
+
+constexpr UBaseType_t Base = test::RunnerPriority + 1;
+
+TickType_t freshStart() {
+    sim::setCostModel(sim::CostModel::zero());
+    vTaskDelay(1);
+    return xTaskGetTickCount();
+}
+
+struct Load {
+    uint64_t   us;
+    TickType_t starts[16];
+    size_t     count;
+
+    static void run(void* p) {
+        auto* l = static_cast<Load*>(p);
+        if (l->count < 16) l->starts[l->count] = xTaskGetTickCount();
+        ++l->count;
+        sim::consume(l->us * 1000);
+    }
+};
+
+}  // namespace
+
+// U = 2/5 + 4/7 = 97%: по RM задача с периодом 7 срывает срок, EDF укладывается
+TEST_CASE(edf_schedules_set_that_rm_misses) {
+    TickType_t t0 = freshStart();
+    Load       a{2000, {}, 0};
+    Load       b{4000, {}, 0};
+    {
+        EdfScheduler<2> edf(Base, 2);
+        CHECK(edf.add(Load::run, &a, "a", 5, 5, 2000) == 0);
+        CHECK(edf.add(Load::run, &b, "b", 7, 7, 4000) == 1);
+        CHECK(edf.density() == 4000 + 5715);
+        CHECK(edf.start());
+        vTaskDelay(70);
+        edf::TaskStats sa = edf.stats(0);
+        edf::TaskStats sb = edf.stats(1);
+        CHECK(sa.jobs >= 13 && sb.jobs >= 9);
+        CHECK(sa.misses == 0 && sb.misses == 0);
+        CHECK(sa.skipped == 0 && sb.skipped == 0);
+        CHECK(sa.worstResponse <= 5 && sb.worstResponse <= 7);
+    }
+    // В момент 5 у b срок 7, у a — 10: b дорабатывает, a начинает в 6
+    CHECK(a.starts[0] == t0 && a.starts[1] == t0 + 6);
+    CHECK(b.starts[0] == t0 + 2);
+
+    // Тот же набор с фиксированными приоритетами по RM
+    static Load ra{2000, {}, 0};
+    static Load rb{4000, {}, 0};
+    freshStart();
+    {
+        PeriodicTask<5, void (*)()> fast([] { Load::run(&ra); });
+        PeriodicTask<7, void (*)()> slow([] { Load::run(&rb); }, {0, periodic::Missed::CatchUp, 4000});
+        CHECK(fast.start("rm5", Base + 1));
+        CHECK(slow.start("rm7", Base));
+        vTaskDelay(70);
+        CHECK(fast.stats().overruns == 0);
+        CHECK(slow.stats().overruns > 0);
+    }
+}
+
+TEST_CASE(admission_rejects_overload) {
+    EdfScheduler<4> edf(Base, 2);
+    CHECK(edf.add(Load::run, nullptr, "a", 5, 5, 2000) == 0);
+    CHECK(edf.add(Load::run, nullptr, "b", 7, 0, 4000) == 1);  // срок 0 — равен периоду
+    CHECK(!edf.admits(100, 100, 5000));
+    CHECK(edf.add(Load::run, nullptr, "c", 100, 100, 5000) == -1);
+    CHECK(edf.admits(100, 100, 2000));
+    CHECK(edf.add(Load::run, nullptr, "d", 100, 100, 2000) == 2);
+    CHECK(edf.density() == 4000 + 5715 + 200);
+    CHECK(edf.size() == 3);
+
+    // Короткий срок считается по плотности: 1 мс на срок 2 мс — уже 50%
+    EdfScheduler<2> tight(Base, 2);
+    CHECK(tight.add(Load::run, nullptr, "t", 10, 2, 1000) == 0);
+    CHECK(tight.density() == 5000);
+    CHECK(tight.add(Load::run, nullptr, "u", 10, 2, 1001) == -1);
+}
+
+TEST_CASE(misses_and_skips_are_counted) {
+    freshStart();
+    // Заявлено меньше, чем тратится на самом деле: тест приёма пропускает
+    Load late{3000, {}, 0};
+    Load overrun{3000, {}, 0};
+    {
+        EdfScheduler<2> edf(Base, 2);
+        CHECK(edf.add(Load::run, &late, "late", 10, 2, 500) == 0);
+        CHECK(edf.add(Load::run, &overrun, "over", 20, 20, 500) == 1);
+        CHECK(edf.start());
+        vTaskDelay(40);
+        edf::TaskStats s = edf.stats(0);
+        CHECK(s.jobs >= 3 && s.misses == s.jobs);
+        CHECK(s.worstResponse >= 3);
+        CHECK(edf.stats(1).misses == 0);
+        CHECK(!edf.start());  // уже запущен
+    }
+
+    Load busy{3000, {}, 0};
+    {
+        EdfScheduler<1> edf(Base, 1);
+        CHECK(edf.add(Load::run, &busy, "busy", 2, 2, 1000) == 0);
+        CHECK(edf.start());
+        vTaskDelay(20);
+        edf::TaskStats s = edf.stats(0);
+        CHECK(s.skipped > 0);
+        CHECK(s.misses == s.jobs);
+    }
+}
+
+// Первое задание оставляет себе лишнее уведомление на индексе библиотеки (как недобранная
+// отдача от Channel): это не выпуск, заданий ровно столько, сколько периодов
+TEST_CASE(stray_notification_is_not_a_release) {
+    freshStart();
+    Load stray{1000, {}, 0};
+    {
+        EdfScheduler<1> edf(Base, 1);
+        CHECK(edf.add(
+                  [&stray] {
+                      Load::run(&stray);
+                      if (stray.count == 1) notify::library::give(xTaskGetCurrentTaskHandle());
+                  },
+                  "stray", 10, 10, 1000) == 0);
+        CHECK(edf.start());
+        vTaskDelay(35);
+        edf::TaskStats s = edf.stats(0);
+        CHECK(s.jobs == 4 && stray.count == 4);
+        CHECK(s.misses == 0 && s.skipped == 0);
+        CHECK(stray.starts[1] - stray.starts[0] == 10);
+    }
+}
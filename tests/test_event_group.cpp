@@ -0,0 +1,150 @@
+#include "TestHarness.h"
+
+#include "EvenGroupCpp.h"
+#include <utility>
+
+namespace {
+
+class TestEvents : public EventGroup {
+  public:
+    enum : EventBits_t {
+        ready   = getBit<0>(),
+        done    = getBit<1>(),
+        error   = getBit<2>(),
+        taskA   = getBit<8>(),
+        taskB   = getBit<9>(),
+        runner  = getBit<10>(),
+    };
+
+    static EventBits_t maskFromIndex(unsigned i) {
+        return getBit(i);
+    }
+};
+
+struct SetterArgs {
+    EventGroup* group;
+    EventBits_t bits;
+    uint32_t    delayMs;
+};
+
+void setterTask(void* p) {
+    auto* args = static_cast<SetterArgs*>(p);
+    vTaskDelay(pdMS_TO_TICKS(args->delayMs));
+    args->group->setBits(args->bits);
+    vTaskDelete(nullptr);
+}
+
+struct SyncArgs {
+    EventGroup*  group;
+    EventBits_t  own;
+    EventBits_t  all;
+    volatile int passed;
+};
+
+void syncTask(void* p) {
+    auto* args = static_cast<SyncArgs*>(p);
+    EventBits_t bits = args->group->sync(args->own, args->all, 1000);
+    if ((bits & args->all) == args->all) {
+        args->passed = 1;
+    }
+    vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+TEST_CASE(event_group_set_clear_get) {
+    TestEvents ev;
+    CHECK(ev.isValid());
+    CHECK(ev.getBits() == 0);
+
+    ev.setBits(TestEvents::ready | TestEvents::error);
+    CHECK(ev.getBits() == (TestEvents::ready | TestEvents::error));
+    CHECK(ev.getBitsFromISR() == ev.getBits());
+
+    EventBits_t before = ev.clearBits(TestEvents::error);
+    CHECK(before == (TestEvents::ready | TestEvents::error));
+    CHECK(ev.getBits() == TestEvents::ready);
+    CHECK(TestEvents::maskFromIndex(10) == TestEvents::runner);
+}
+
+TEST_CASE(event_group_wait_any_all) {
+    TestEvents ev;
+    ev.setBits(TestEvents::ready);
+
+    // Любой из битов — выходим сразу
+    EventBits_t bits = ev.waitBits(TestEvents::ready | TestEvents::done, false);
+    CHECK(bits & TestEvents::ready);
+
+    // Все биты — без таймаута не дождались
+    bits = ev.waitBits(TestEvents::ready | TestEvents::done, true);
+    CHECK((bits & TestEvents::done) == 0);
+
+    // clearOnExit снимает дождавшиеся биты
+    ev.setBits(TestEvents::done);
+    bits = ev.waitBits(TestEvents::ready | TestEvents::done, true, true);
+    CHECK((bits & (TestEvents::ready | TestEvents::done)) == (TestEvents::ready | TestEvents::done));
+    CHECK(ev.getBits() == 0);
+}
+
+TEST_CASE(event_group_wait_timeout) {
+    TestEvents ev;
+    TickType_t  start = xTaskGetTickCount();
+    EventBits_t bits  = ev.waitBits(TestEvents::done, true, false, 20);
+    CHECK((bits & TestEvents::done) == 0);
+    CHECK(xTaskGetTickCount() - start >= pdMS_TO_TICKS(20));
+}
+
+TEST_CASE(event_group_wakeup_from_other_task) {
+    TestEvents ev;
+    SetterArgs args{&ev, TestEvents::done, 5};
+    xTaskCreate(setterTask, "setter", configMINIMAL_STACK_SIZE, &args, test::RunnerPriority, nullptr);
+
+    EventBits_t bits = ev.waitBits(TestEvents::done, true, true, 1000);
+    CHECK(bits & TestEvents::done);
+    CHECK((ev.getBits() & TestEvents::done) == 0);
+}
+
+TEST_CASE(event_group_isr_api) {
+    TestEvents ev;
+    BaseType_t woken = pdFALSE;
+    CHECK(ev.setBitsFromISR(TestEvents::ready, &woken) == pdPASS);
+    CHECK(ev.waitBits(TestEvents::ready, true, false, 100) & TestEvents::ready);
+    CHECK(ev.clearBitsFromISR(TestEvents::ready) == pdPASS);
+    // Из "ISR" очистка откладывается в timer-task — ждём её выполнения
+    vTaskDelay(pdMS_TO_TICKS(5));
+    CHECK(ev.getBits() == 0);
+}
+
+TEST_CASE(event_group_sync_barrier) {
+    TestEvents        ev;
+    const EventBits_t all = TestEvents::taskA | TestEvents::taskB | TestEvents::runner;
+    SyncArgs          a{&ev, TestEvents::taskA, all, 0};
+    SyncArgs          b{&ev, TestEvents::taskB, all, 0};
+    xTaskCreate(syncTask, "syncA", configMINIMAL_STACK_SIZE, &a, test::RunnerPriority + 1, nullptr);
+    xTaskCreate(syncTask, "syncB", configMINIMAL_STACK_SIZE, &b, test::RunnerPriority + 1, nullptr);
+
+    EventBits_t bits = ev.sync(TestEvents::runner, all, 1000);
+    CHECK((bits & all) == all);
+    CHECK(a.passed == 1);
+    CHECK(b.passed == 1);
+}
+
+TEST_CASE(event_group_move_and_wrap) {
+    EventGroup a;
+    EventGroupHandle_t h = a.nativeHandle();
+
+    EventGroup b(std::move(a));
+    CHECK(!a.isValid());
+    CHECK(b.nativeHandle() == h);
+
+    EventGroup c(xEventGroupCreate(), true);
+    c = std::move(b);
+    CHECK(c.nativeHandle() == h);
+
+    // Необладающая обёртка не удаляет чужую группу
+    {
+        EventGroup view(h);
+        view.setBits(1);
+    }
+    CHECK(c.getBits() == 1);
+}
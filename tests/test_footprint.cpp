@@ -0,0 +1,116 @@
+#include "TestHarness.h"
+
+#include "Channel.h"
+#include "EvenGroupCpp.h"
+#include "Footprint.h"
+#include "Guarded.h"
+#include "Logger.h"
+#include "PeriodicTask.h"
+#include "QueueCpp.h"
+#include "RateLimiter.h"
+#include "ShapedQueue.h"
+#include "SharedMemChannel.h"
+#include "SpillQueue.h"
+#include "TripleBuffer.h"
+
+#include <cstring>
+
+namespace {
+
+struct Packet {
+    uint8_t data[64];
+};
+
+struct Stats {
+    uint32_t rx, tx, errors;
+};
+
+void poll() {}
+
+// Блок кучи: заголовок и выравнивание
+static_assert(footprint::heap(1) == portBYTE_ALIGNMENT * ((1 + FREERTOS_CPP_HEAP_BLOCK_OVERHEAD + portBYTE_ALIGNMENT - 1) /
+                                                          portBYTE_ALIGNMENT));
+static_assert(footprint::heap(64) >= 64 + FREERTOS_CPP_HEAP_BLOCK_OVERHEAD);
+static_assert(footprint::heap(64) % portBYTE_ALIGNMENT == 0);
+
+// Статические обёртки: всё внутри объекта
+static_assert(StaticQueue<Packet, 8>::footprint() == sizeof(StaticQueue<Packet, 8>));
+static_assert(StaticQueue<Packet, 8>::footprint() >= 8 * sizeof(Packet) + sizeof(StaticQueue_t));
+static_assert(Guarded<Stats>::footprint() == sizeof(Guarded<Stats>), "mutex lives inside the object");
+static_assert(sizeof(Guarded<Stats>) >= sizeof(Stats) + sizeof(StaticSemaphore_t));
+static_assert(ShapedQueue<Packet, 2, 4>::footprint() >= 2 * StaticQueue<Packet, 4>::footprint());
+
+// Динамические: объект плюс блоки из кучи
+static_assert(Queue<Packet>::footprint(16) == sizeof(Queue<Packet>) + footprint::queue(16, sizeof(Packet)));
+static_assert(Queue<Packet>::footprint(16) > 16 * sizeof(Packet));
+static_assert(EventGroup::footprint() == sizeof(EventGroup) + footprint::eventGroup());
+static_assert(PeriodicTask<10>::footprint(256) ==
+              sizeof(PeriodicTask<10>) + footprint::heap(256 * sizeof(StackType_t)) + footprint::heap(sizeof(StaticTask_t)));
+static_assert(PeriodicTask<10>::footprint() == PeriodicTask<10>::footprint(configMINIMAL_STACK_SIZE * 2));
+static_assert(SpillQueue<Packet>::footprint(256) == sizeof(SpillQueue<Packet>) + footprint::task(256));
+static_assert(sizeof(SpillQueue<Packet>) >= 8 * 512, "blocks live inside the object");
+static_assert(SharedMemChannel<Packet>::footprint(8) ==
+              sizeof(SharedMemChannel<Packet>) + SharedMemChannel<Packet>::regionBytes(8));
+
+// Без footprint() — просто sizeof
+static_assert(footprint::of<RateLimiter>() == sizeof(RateLimiter));
+static_assert(footprint::of<Stats>() == sizeof(Stats));
+static_assert(footprint::of<footprint::Bytes<100>>() == 100);
+static_assert(footprint::of<Logger>() == Logger::footprint());
+
+FREERTOS_CPP_RAM_BUDGET(Radio, 256 * 1024, StaticQueue<Packet, 8>, Guarded<Stats>, PeriodicTask<10>,
+                        footprint::Bytes<Queue<Packet>::footprint(16)>);
+FREERTOS_CPP_RAM_BUDGET(Events, 1024, EventGroup, Guarded<Stats>);
+
+static_assert(Radio::total == StaticQueue<Packet, 8>::footprint() + Guarded<Stats>::footprint() +
+                                  PeriodicTask<10>::footprint() + Queue<Packet>::footprint(16));
+static_assert(Radio::objects == 4);
+static_assert(Radio::headroom == Radio::budget - Radio::total);
+static_assert(footprint::total<Radio, Events>() == Radio::total + Events::total);
+
+// Превышение даёт headroom 0 (в FREERTOS_CPP_RAM_BUDGET — ошибку компиляции)
+static_assert(footprint::Subsystem<16, StaticQueue<Packet, 8>>::headroom == 0);
+
+// Объекты в секции библиотеки конструируются и работают как обычные
+FREERTOS_CPP_RAM StaticQueue<Packet, 4> placedQueue;
+FREERTOS_CPP_RAM Guarded<Stats>         placedStats;
+FREERTOS_CPP_RAM PeriodicTask<10>       placedPoller(poll);
+
+// Константная инициализация с ненулевыми полями (индексы TripleBuffer, vptr Channel)
+FREERTOS_CPP_RAM_DATA TripleBuffer<Stats> placedFrames;
+FREERTOS_CPP_RAM_DATA Channel<int, 4>     placedChannel;
+
+}  // namespace
+
+TEST_CASE(report_lists_subsystems) {
+    footprint::Line lines[2];
+    CHECK((footprint::report<Radio, Events>(lines, 2) == 2));
+    CHECK(std::strcmp(lines[0].name, "Radio") == 0);
+    CHECK(lines[0].total == Radio::total && lines[0].budget == 256 * 1024);
+    CHECK(std::strcmp(lines[1].name, "Events") == 0);
+    CHECK(lines[1].total == Events::total);
+
+    // Меньше места, чем подсистем: заполняется сколько влезло, возвращается общее число
+    footprint::Line one[1] = {};
+    CHECK((footprint::report<Radio, Events>(one, 1) == 2));
+    CHECK(one[0].total == Radio::total);
+}
+
+TEST_CASE(placed_objects_work) {
+    Packet p{};
+    p.data[0] = 7;
+    CHECK(placedQueue.send(p));
+    Packet out{};
+    CHECK(placedQueue.receive(out) && out.data[0] == 7);
+
+    placedStats()->rx = 3;
+    CHECK(placedStats()->rx == 3);
+    CHECK(placedPoller.handle() == nullptr);
+
+    placedFrames.writeBuffer().tx = 5;
+    placedFrames.publish();
+    CHECK(placedFrames.acquire() && placedFrames.readBuffer().tx == 5);
+    CHECK(placedChannel.send(9));
+    int v = 0;
+    CHECK(placedChannel.receive(v) && v == 9);
+}
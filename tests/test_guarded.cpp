@@ -0,0 +1,116 @@
+#include "TestHarness.h"
+
+#include "Guarded.h"
+#include <utility>
+
+namespace {
+
+struct Counters {
+    uint32_t a;
+    uint32_t b;
+};
+
+struct WorkerArgs {
+    Guarded<Counters>* shared;
+    uint32_t           iterations;
+    QueueHandle_t      done;
+};
+
+// Каждая итерация отдаёт процессор внутри критической секции —
+// без мьютекса a и b разошлись бы.
+void workerTask(void* p) {
+    auto* args = static_cast<WorkerArgs*>(p);
+    for (uint32_t i = 0; i < args->iterations; ++i) {
+        auto s = (*args->shared)();
+        uint32_t a = s->a;
+        taskYIELD();
+        s->a = a + 1;
+        s->b++;
+    }
+    xSemaphoreGive(args->done);
+    vTaskDelete(nullptr);
+}
+
+struct WaiterArgs {
+    Guarded<Counters>* shared;
+    volatile int       acquired;
+};
+
+void waiterTask(void* p) {
+    auto* args = static_cast<WaiterArgs*>(p);
+    {
+        auto s = (*args->shared)();
+        s->a   = 42;
+    }
+    args->acquired = 1;
+    vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+TEST_CASE(guarded_access_reads_and_writes) {
+    Guarded<Counters> g;
+    {
+        auto s = g();
+        s->a   = 1;
+        (*s).b = 2;
+    }
+    Counters copy;
+    {
+        auto s = g();
+        copy   = *s;
+    }
+    CHECK(copy.a == 1);
+    CHECK(copy.b == 2);
+}
+
+TEST_CASE(guarded_mutual_exclusion) {
+    Guarded<Counters> g;
+    {
+        auto s = g();
+        *s     = Counters{0, 0};
+    }
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(2, 0);
+    WorkerArgs        args{&g, 500, done};
+    xTaskCreate(workerTask, "w1", configMINIMAL_STACK_SIZE, &args, test::RunnerPriority, nullptr);
+    xTaskCreate(workerTask, "w2", configMINIMAL_STACK_SIZE, &args, test::RunnerPriority, nullptr);
+
+    CHECK(xSemaphoreTake(done, pdMS_TO_TICKS(5000)) == pdTRUE);
+    CHECK(xSemaphoreTake(done, pdMS_TO_TICKS(5000)) == pdTRUE);
+    vSemaphoreDelete(done);
+
+    auto s = g();
+    CHECK(s->a == 1000);
+    CHECK(s->b == 1000);
+}
+
+// Пока Access жив, задача с более высоким приоритетом не может войти;
+// после разрушения Access она получает мьютекс сразу.
+TEST_CASE(guarded_blocks_until_access_released) {
+    Guarded<Counters> g;
+    WaiterArgs        args{&g, 0};
+    {
+        auto s = g();
+        s->a   = 0;
+        xTaskCreate(waiterTask, "waiter", configMINIMAL_STACK_SIZE, &args, test::RunnerPriority + 1, nullptr);
+        vTaskDelay(pdMS_TO_TICKS(5));
+        CHECK(args.acquired == 0);
+        CHECK(s->a == 0);
+    }
+    CHECK(args.acquired == 1);
+    auto s = g();
+    CHECK(s->a == 42);
+}
+
+TEST_CASE(guarded_access_move) {
+    Guarded<Counters> g;
+    {
+        auto s1 = g();
+        s1->a   = 7;
+        auto s2 = std::move(s1);
+        s2->b   = 8;
+    }  // мьютекс отдаётся ровно один раз
+    auto s = g();
+    CHECK(s->a == 7);
+    CHECK(s->b == 8);
+}
@@ -0,0 +1,75 @@
+#include "TestHarness.h"
+
+#include "InplaceFunction.h"
+#include "PeriodicTask.h"
+#include "QueueCpp.h"
+
+#include <type_traits>
+
+namespace {
+
+int twice(int v) {
+    return v * 2;
+}
+
+using Callback = InplaceFunction<int(int)>;
+
+static_assert(std::is_trivially_copyable_v<Callback>, "must survive memcpy through a queue");
+static_assert(std::is_trivially_destructible_v<Callback>, "no destructor to run");
+static_assert(Callback::capacity() == FREERTOS_CPP_INPLACE_FUNCTION_SIZE, "default capacity");
+static_assert(sizeof(InplaceFunction<void(), 8>) <= 8 + alignof(std::max_align_t) + sizeof(void*), "no hidden state");
+
+}  // namespace
+
+TEST_CASE(calls_captures_and_function_pointers) {
+    Callback empty;
+    CHECK(!empty && empty == nullptr);
+
+    int      base = 10;
+    Callback add  = [&base](int v) { return v + base; };
+    CHECK(add && add != nullptr);
+    CHECK(add(5) == 15);
+    base = 20;
+    CHECK(add(5) == 25);  // захват по ссылке
+
+    Callback fp = twice;
+    CHECK(fp(21) == 42);
+
+    // Четыре указателя — ёмкость по умолчанию целиком
+    int*     a = &base;
+    int*     b = &base;
+    int*     c = &base;
+    int*     d = &base;
+    Callback full = [a, b, c, d](int v) { return *a + *b + *c + *d + v; };
+    CHECK(full(1) == 81);
+
+    add = nullptr;
+    CHECK(!add);
+}
+
+TEST_CASE(mutable_state_lives_inside) {
+    InplaceFunction<int()> counter = [n = 0]() mutable { return ++n; };
+    CHECK(counter() == 1);
+    CHECK(counter() == 2);
+    InplaceFunction<int()> copy = counter;  // копия продолжает со своего состояния
+    CHECK(copy() == 3);
+    CHECK(counter() == 3);
+}
+
+TEST_CASE(travels_through_queue) {
+    Queue<Callback> q(4);
+    for (int i = 1; i <= 3; ++i) CHECK(q.send([i](int v) { return v * i; }));
+    Callback f;
+    int      sum = 0;
+    while (q.receive(f)) sum += f(10);
+    CHECK(sum == 10 + 20 + 30);
+}
+
+TEST_CASE(periodic_task_takes_capturing_lambda) {
+    int              runs = 0;
+    PeriodicTask<1>  loop([&runs] { ++runs; });
+    CHECK(loop.start("lambda", test::RunnerPriority + 1));
+    vTaskDelay(3);
+    loop.stop();
+    CHECK(runs >= 2);
+}
@@ -0,0 +1,88 @@
+#include "TestHarness.h"
+
+#include "EvenGroupCpp.h"
+#include "Guarded.h"
+#include "Lazy.h"
+#include "QueueCpp.h"
+
+// Объекты ниже инициализируются константой: FREERTOS_CPP_CONSTINIT не даст собрать тест,
+// если у Lazy появится динамический конструктор.
+
+namespace {
+
+constexpr UBaseType_t HelperPriority = test::RunnerPriority + 1;
+
+struct Settings {
+    int speed;
+};
+
+// Строится долго: пока одна задача в конструкторе, другие успевают обратиться
+struct Slow {
+    static int built;
+    int        id;
+
+    Slow() {
+        vTaskDelay(3);
+        id = ++built;
+    }
+};
+int Slow::built = 0;
+
+FREERTOS_CPP_CONSTINIT Lazy<Queue<int>, 4>     inbox;
+FREERTOS_CPP_CONSTINIT Lazy<EventGroup>        events;
+FREERTOS_CPP_CONSTINIT Lazy<Guarded<Settings>> settings;
+FREERTOS_CPP_CONSTINIT Lazy<Queue<int>, 2>     channels[3];
+FREERTOS_CPP_CONSTINIT Lazy<Slow>              slow;
+
+Slow*         seen[3];
+volatile int  finished = 0;
+
+}  // namespace
+
+TEST_CASE(created_on_first_use) {
+    CHECK(!inbox.ready());
+    CHECK(inbox->spacesAvailable() == 4);
+    CHECK(inbox.ready());
+    CHECK(inbox->send(7));
+    int v = 0;
+    CHECK((*inbox).receive(v) && v == 7);
+
+    CHECK(!settings.ready());
+    settings()->speed = 5;  // как у самого Guarded
+    CHECK(settings()->speed == 5);
+}
+
+TEST_CASE(init_all_creates_in_one_pass) {
+    CHECK(!events.ready());
+    for (auto& c : channels) CHECK(!c.ready());
+
+    lazy::initAll(events, channels);
+    CHECK(events.ready());
+    for (auto& c : channels) CHECK(c.ready() && c->spacesAvailable() == 2);
+
+    // Повторно — без пересоздания
+    EventGroup* before = &*events;
+    events->setBits(1);
+    lazy::initAll(events);
+    CHECK(&*events == before && events->getBits() == 1);
+}
+
+TEST_CASE(concurrent_first_use_builds_once) {
+    finished = 0;
+    for (int i = 0; i < 3; ++i) {
+        xTaskCreate(
+            [](void* p) {
+                vTaskDelay(1);  // раннер уже в конструкторе
+                seen[reinterpret_cast<intptr_t>(p)] = &slow.get();
+                ++finished;
+                vTaskDelete(nullptr);
+            },
+            "lazy", configMINIMAL_STACK_SIZE * 2, reinterpret_cast<void*>(static_cast<intptr_t>(i)),
+            HelperPriority, nullptr);
+    }
+    Slow& mine = slow.get();
+    vTaskDelay(3);
+    CHECK(finished == 3);
+    CHECK(Slow::built == 1 && mine.id == 1);
+    for (Slow* s : seen) CHECK(s == &mine);
+}
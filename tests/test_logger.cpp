@@ -0,0 +1,104 @@
+#include "TestHarness.h"
+
+// Потолок Debug: LOG_VERBOSE не компилируется ни в одном модуле
+#define FREERTOS_CPP_LOG_LEVEL 4
+#include "Logger.h"
+
+#include <string>
+
+namespace {
+
+LOG_MODULE(App, Verbose);
+LOG_MODULE(Quiet, Warn);
+
+std::string captured;
+
+void capture(const char* line, size_t length, void* ctx) {
+    static_cast<std::string*>(ctx)->append(line, length);
+}
+
+// Вывести всё накопленное в глобальном логе и вернуть текст без меток времени
+std::string drainGlobal() {
+    captured.clear();
+    logger::global.setSink(capture, &captured);
+    logger::global.drain();
+    std::string out;
+    size_t      pos = 0;
+    while (pos < captured.size()) {
+        size_t end = captured.find('\n', pos);
+        out += captured.substr(pos + 9, end - pos - 9 + 1);  // "%8lu " — 9 символов
+        pos = end + 1;
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST_CASE(formats_deferred_arguments) {
+    drainGlobal();
+    LOG_INFO(App, "a=%d b=%u x=%04x s=%s f=%.2f c=%c %%", -5, 7u, 0xab, "str", 1.5f, 'z');
+    CHECK(drainGlobal() == "I App: a=-5 b=7 x=00ab s=str f=1.50 c=z %\n");
+}
+
+TEST_CASE(length_modifiers_and_star_width) {
+    drainGlobal();
+    long          l  = -100000;
+    unsigned long ul = 4000000000ul;
+    long long     ll = -(1ll << 40);
+    LOG_DEBUG(App, "%ld %lu %lld %zu", l, ul, ll, sizeof(uint64_t));
+    LOG_ERROR(App, "[%*d|%-5s|%p]", 6, 42, "ab", static_cast<void*>(nullptr));
+    char nullPtr[32];
+    std::snprintf(nullPtr, sizeof(nullPtr), "%p", static_cast<void*>(nullptr));
+    CHECK(drainGlobal() == "D App: -100000 4000000000 -1099511627776 8\n"
+                           "E App: [    42|ab   |" + std::string(nullPtr) + "]\n");
+}
+
+TEST_CASE(levels_are_filtered_at_compile_time) {
+    drainGlobal();
+    int evaluated = 0;
+    LOG_INFO(Quiet, "%d", ++evaluated);    // ниже уровня модуля
+    LOG_VERBOSE(App, "%d", ++evaluated);   // выше общего потолка
+    LOG_WARN(Quiet, "kept %d", ++evaluated);
+    CHECK(evaluated == 1);
+    CHECK(drainGlobal() == "W Quiet: kept 1\n");
+    static_assert(!logger::enabled<Quiet>(logger::Level::Info), "Quiet is Warn");
+    static_assert(logger::enabled<App>(logger::Level::Debug), "App is Verbose, ceiling Debug");
+}
+
+TEST_CASE(isr_records_are_marked) {
+    drainGlobal();
+    LOG_WARN_ISR(App, "overflow %u", 3u);
+    CHECK(drainGlobal() == "W App(isr): overflow 3\n");
+}
+
+TEST_CASE(overflow_is_counted_and_reported) {
+    drainGlobal();
+    const uint32_t before = logger::global.dropped();
+    uint32_t       failed = 0;
+    for (uint32_t i = 0; i < logger::RingSize + 5; ++i) {
+        if (!logger::global.write("App", logger::Level::Info, false, "n=%u", i)) ++failed;
+    }
+    CHECK(failed == 5);
+    CHECK(logger::global.dropped() - before == 5);
+
+    std::string out = drainGlobal();
+    CHECK(out.compare(0, 30, "W log: 5 messages dropped\nI Ap") == 0);
+    CHECK(out.find("n=0\n") != std::string::npos);
+    CHECK(out.find("n=" + std::to_string(logger::RingSize - 1) + "\n") != std::string::npos);
+    CHECK(out.find("n=" + std::to_string(logger::RingSize) + "\n") == std::string::npos);
+    CHECK(drainGlobal().empty());  // о потерях сообщается один раз
+}
+
+TEST_CASE(drain_task_prints_in_background) {
+    std::string out;
+    {
+        Logger log;
+        log.setSink(capture, &out);
+        CHECK(log.start("log", test::RunnerPriority - 1, configMINIMAL_STACK_SIZE, 1));
+        CHECK(log.write("Bg", logger::Level::Info, false, "hello %d", 1));
+        CHECK(log.write("Bg", logger::Level::Error, false, "bye"));
+        vTaskDelay(5);
+    }
+    CHECK(out.find("I Bg: hello 1\n") != std::string::npos);
+    CHECK(out.find("E Bg: bye\n") != std::string::npos);
+}
@@ -0,0 +1,161 @@
+#include "TestHarness.h"
+
+#include "Channel.h"
+#include "NotifyChannel.h"
+#include "TripleBuffer.h"
+
+// Получатель — раннер; отправители — задачи выше раннера (срабатывают сразу после
+// создания) или «прерывания» внутри taskENTER_CRITICAL_FROM_ISR.
+
+namespace {
+
+struct Ticks : notify::Counting {};
+struct Flags : notify::Bits {};
+struct Level : notify::Value<int16_t> {};
+using TestNotify = notify::Registry<Ticks, Flags, Level>;
+
+static_assert(TestNotify::index<Ticks> == FREERTOS_CPP_NOTIFY_FIRST_INDEX, "first kind gets the first index");
+static_assert(TestNotify::index<Level> == FREERTOS_CPP_NOTIFY_FIRST_INDEX + 2, "indices follow the list");
+static_assert(TestNotify::Channel<Flags>::index() == TestNotify::index<Flags>, "channel uses registry index");
+static_assert(!TestNotify::contains<int>, "unknown kind");
+static_assert(TestNotify::index<Ticks> > FREERTOS_CPP_NOTIFY_LIBRARY_INDEX, "registry skips the library index");
+static_assert(!notify::detail::unique<Ticks, Flags, Ticks>(), "duplicate kind is detected");
+
+constexpr UBaseType_t SenderPriority = test::RunnerPriority + 1;
+
+// Запустить fn(arg) в задаче выше раннера
+void runHigh(void (*fn)(void*), void* arg) {
+    xTaskCreate(fn, "sender", configMINIMAL_STACK_SIZE, arg, SenderPriority, nullptr);
+}
+
+}  // namespace
+
+TEST_CASE(notify_counting_counts_and_times_out) {
+    TestNotify::Channel<Ticks> ch;
+    CHECK(!ch.isBound());
+    ch.give();  // не привязан — теряется
+    ch.bindCurrent();
+    CHECK(!ch.take());
+
+    ch.give();
+    ch.give();
+    ch.give();
+    CHECK(ch.take() && ch.take());
+    CHECK(ch.takeAll() == 1);
+    CHECK(!ch.take(5));
+
+    // Из другой задачи: ждём, пока отправитель отработает после задержки
+    runHigh(
+        [](void* p) {
+            vTaskDelay(3);
+            static_cast<TestNotify::Channel<Ticks>*>(p)->give();
+            vTaskDelete(nullptr);
+        },
+        &ch);
+    const TickType_t start = xTaskGetTickCount();
+    CHECK(ch.take(100));
+    CHECK(xTaskGetTickCount() - start == 3);
+}
+
+TEST_CASE(notify_counting_from_isr) {
+    TestNotify::Channel<Ticks> ch(xTaskGetCurrentTaskHandle());
+    BaseType_t                 woken = pdFALSE;
+    UBaseType_t                saved = taskENTER_CRITICAL_FROM_ISR();
+    ch.giveFromISR(&woken);
+    ch.giveFromISR(&woken);
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    CHECK(woken == pdFALSE);  // раннер не ждал
+    CHECK(ch.takeAll(10) == 2);
+}
+
+TEST_CASE(notify_bits_any_and_all) {
+    TestNotify::Channel<Flags> ch;
+    ch.bindCurrent();
+    ch.set(0x1 | 0x8);
+    CHECK(ch.peek() == 0x9);
+    CHECK(ch.wait(0x3) == 0x1);  // любой: снят только дождавшийся бит
+    CHECK(ch.peek() == 0x8);
+    CHECK(ch.wait(0x3, true, 5) == 0);  // все: 0x2 так и не пришёл
+    CHECK(ch.peek() == 0x8);
+
+    // Биты приходят по одному из двух задач — ждём оба
+    static TestNotify::Channel<Flags>* target;
+    target = &ch;
+    runHigh(
+        [](void*) {
+            vTaskDelay(2);
+            target->set(0x1);
+            vTaskDelay(2);
+            target->set(0x2);
+            vTaskDelete(nullptr);
+        },
+        nullptr);
+    const TickType_t start = xTaskGetTickCount();
+    CHECK(ch.wait(0x3, true, 100) == 0x3);
+    CHECK(xTaskGetTickCount() - start == 4);
+    CHECK(ch.peek() == 0x8);
+    ch.clear();
+    CHECK(ch.peek() == 0);
+}
+
+TEST_CASE(notify_value_overwrite_and_try_post) {
+    TestNotify::Channel<Level> ch;
+    ch.bindCurrent();
+    int16_t v = 0;
+    CHECK(!ch.receive(v));
+
+    ch.post(-5);
+    ch.post(7);  // перезаписывает непрочитанное
+    CHECK(ch.receive(v) && v == 7);
+    CHECK(!ch.receive(v, 2));
+
+    CHECK(ch.tryPost(1));
+    CHECK(!ch.tryPost(2));  // первое ещё не прочитано
+    CHECK(ch.receive(v) && v == 1);
+
+    BaseType_t  woken = pdFALSE;
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    ch.postFromISR(-300, &woken);
+    CHECK(!ch.tryPostFromISR(4, &woken));
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    CHECK(ch.receive(v) && v == -300);
+}
+
+TEST_CASE(notify_channels_do_not_share_slots) {
+    TestNotify::Channel<Ticks> ticks(xTaskGetCurrentTaskHandle());
+    TestNotify::Channel<Flags> flags(xTaskGetCurrentTaskHandle());
+    TestNotify::Channel<Level> level(xTaskGetCurrentTaskHandle());
+
+    ticks.give();
+    flags.set(0x4);
+    level.post(42);
+    // Индекс 0 (ulTaskNotifyTake без индекса) ничего не получил
+    CHECK(ulTaskNotifyTake(pdTRUE, 0) == 0);
+
+    int16_t v = 0;
+    CHECK(level.receive(v) && v == 42);
+    CHECK(flags.wait(0x4) == 0x4);
+    CHECK(ticks.takeAll() == 1);
+    CHECK(!ticks.take() && flags.peek() == 0 && !level.receive(v));
+    CHECK(TestNotify::Channel<Ticks>::footprint() == sizeof(TaskHandle_t));
+}
+
+// Ожидания библиотеки и код пользователя на индексе 0 не забирают уведомления друг друга
+TEST_CASE(library_waits_use_their_own_index) {
+    static_assert(FREERTOS_CPP_NOTIFY_LIBRARY_INDEX != 0, "host configs have a notification array");
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+    // Отдача пользователя не будит Channel и переживает его ожидание
+    Channel<int, 1> ch;
+    int             v = 0;
+    xTaskNotifyGive(self);
+    CHECK(!ch.receive(v, 2));
+    CHECK(ulTaskNotifyTake(pdTRUE, 0) == 1);
+
+    // Лишнее уведомление библиотеки (например, от прошлого ожидания) не видно на индексе 0,
+    // а ожидание TripleBuffer после него всё равно ждёт кадра
+    TripleBuffer<int> frames;
+    notify::library::give(self);
+    CHECK(ulTaskNotifyTake(pdTRUE, 0) == 0);
+    CHECK(!frames.waitNewer(2));
+}
@@ -0,0 +1,136 @@
+#include "TestHarness.h"
+
+#include "PeriodicTask.h"
+#include "SimKernel.h"
+
+// Моменты запуска и джиттер проверяются точно: время виртуальное, модель стоимости нулевая.
+// Периодическая задача выше раннера — раннер только ждёт и читает статистику.
+
+namespace {
+
+constexpr UBaseType_t Priority = test::RunnerPriority + 1;
+
+TickType_t freshStart() {
+    sim::setCostModel(sim::CostModel::zero());
+    vTaskDelay(1);
+    return xTaskGetTickCount();
+}
+
+// Работа запуска: 300 мкс, а запуск с номером slowRun — slowUs
+struct Work {
+    TickType_t* starts;
+    size_t      capacity;
+    size_t*     count;
+    size_t      slowRun = SIZE_MAX;
+    uint64_t    slowUs  = 0;
+
+    void operator()() {
+        if (*count < capacity) starts[*count] = xTaskGetTickCount();
+        sim::consume((*count == slowRun ? slowUs : 300) * 1000);
+        ++*count;
+    }
+};
+
+}  // namespace
+
+TEST_CASE(runs_on_fixed_grid) {
+    TickType_t starts[16];
+    size_t     count = 0;
+    TickType_t t0    = freshStart();
+    {
+        PeriodicTask<2, Work> loop(Work{starts, 16, &count});
+        CHECK(loop.start("loop", Priority));
+        vTaskDelay(21);
+        auto s = loop.stats();
+        CHECK(s.runs == 11);
+        CHECK(s.overruns == 0 && s.skipped == 0 && s.overBudget == 0);
+        CHECK(s.jitter.count() == 10 && s.jitter.max() == 0);
+        CHECK(s.exec.count() == 11 && s.exec.max() == 300 && s.exec.mean() == 300);
+        CHECK(s.exec.percentile(99) == 300);
+    }
+    CHECK(count == 11);
+    for (size_t i = 0; i < count; ++i) CHECK(starts[i] == t0 + 2 * i);
+}
+
+TEST_CASE(phase_offsets_first_run) {
+    TickType_t starts[4];
+    size_t     count = 0;
+    TickType_t t0    = freshStart();
+    {
+        PeriodicTask<4, Work> loop(Work{starts, 4, &count}, {1, periodic::Missed::Skip, 4000});
+        CHECK(loop.start("phase", Priority));
+        vTaskDelay(10);
+    }
+    CHECK(count == 3);
+    CHECK(starts[0] == t0 + 1 && starts[1] == t0 + 5 && starts[2] == t0 + 9);
+}
+
+TEST_CASE(skip_policy_stays_on_grid) {
+    TickType_t starts[16];
+    size_t     count = 0;
+    TickType_t t0    = freshStart();
+    {
+        // Третий запуск длится 2.25 периода: моменты t0+6 и t0+8 пропадают
+        PeriodicTask<2, Work> loop(Work{starts, 16, &count, 2, 4500});
+        CHECK(loop.start("skip", Priority));
+        vTaskDelay(21);
+        auto s = loop.stats();
+        CHECK(s.runs == 9);
+        CHECK(s.overruns == 1 && s.skipped == 2 && s.overBudget == 1);
+        CHECK(s.jitter.max() == 0);  // интервалы совпадают с сеткой
+        CHECK(s.exec.max() == 4500);
+    }
+    CHECK(starts[2] == t0 + 4 && starts[3] == t0 + 10 && starts[8] == t0 + 20);
+}
+
+TEST_CASE(catch_up_policy_runs_missed_periods) {
+    TickType_t starts[16];
+    size_t     count = 0;
+    TickType_t t0    = freshStart();
+    {
+        PeriodicTask<2, Work> loop(Work{starts, 16, &count, 2, 4500}, {0, periodic::Missed::CatchUp, 2000});
+        CHECK(loop.start("catchup", Priority));
+        vTaskDelay(21);
+        auto s = loop.stats();
+        CHECK(s.runs == 11);
+        CHECK(s.skipped == 0 && s.overruns == 2);  // долгий запуск и первый догоняющий
+        CHECK(s.jitter.max() == 2500);             // догоняющий стартовал на 2.5 мс позже сетки
+    }
+    CHECK(starts[3] == t0 + 8 && starts[4] == t0 + 8 && starts[5] == t0 + 10);
+}
+
+TEST_CASE(stop_and_reset_stats) {
+    TickType_t starts[8];
+    size_t     count = 0;
+    freshStart();
+    PeriodicTask<1, Work> loop(Work{starts, 8, &count});
+    CHECK(loop.start("stop", Priority));
+    CHECK(!loop.start("again", Priority));
+    vTaskDelay(3);
+    loop.resetStats();
+    vTaskDelay(2);
+    CHECK(loop.stats().runs == 2);
+    loop.stop();
+    CHECK(loop.handle() == nullptr);
+    vTaskDelay(3);
+    CHECK(loop.stats().runs == 2);
+}
+
+TEST_CASE(histogram_buckets_are_powers_of_two) {
+    periodic::Histogram h;
+    CHECK(h.percentile(50) == 0);
+    h.record(0);
+    h.record(1);
+    h.record(3);
+    h.record(100);
+    for (int i = 0; i < 96; ++i) h.record(700);
+    CHECK(h.bucket(0) == 1 && h.bucket(1) == 1 && h.bucket(2) == 1 && h.bucket(7) == 1 && h.bucket(10) == 96);
+    CHECK(h.count() == 100 && h.max() == 700);
+    CHECK(h.percentile(1) == 0);
+    CHECK(h.percentile(4) == 127);
+    CHECK(h.percentile(50) == 700);  // граница корзины 1023 ограничена максимумом
+    h.record(UINT32_MAX);
+    CHECK(h.bucket(periodic::Histogram::Buckets - 1) == 1);
+    h.reset();
+    CHECK(h.count() == 0 && h.max() == 0 && h.mean() == 0);
+}
@@ -0,0 +1,126 @@
+#include "TestHarness.h"
+
+#include "QueueCpp.h"
+
+namespace {
+
+struct Sample {
+    uint32_t id;
+    int16_t  x, y, z;
+};
+
+struct ProducerArgs {
+    Queue<uint32_t>*  queue;
+    uint32_t          count;
+    volatile bool     done;
+};
+
+void producerTask(void* p) {
+    auto* args = static_cast<ProducerArgs*>(p);
+    for (uint32_t i = 0; i < args->count; ++i) {
+        args->queue->send(i, 1000);
+    }
+    args->done = true;
+    vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+TEST_CASE(queue_send_receive_fifo) {
+    Queue<int> q(4);
+    CHECK(q.nativeHandle() != nullptr);
+    CHECK(q.isEmpty());
+    CHECK(q.spacesAvailable() == 4);
+    for (int i = 0; i < 4; ++i) {
+        CHECK(q.send(i));
+    }
+    CHECK(q.isFull());
+    CHECK(q.messagesWaiting() == 4);
+    CHECK(!q.send(99));
+
+    int v = -1;
+    for (int i = 0; i < 4; ++i) {
+        CHECK(q.receive(v) && v == i);
+    }
+    CHECK(!q.receive(v));
+}
+
+TEST_CASE(queue_front_back_peek) {
+    Queue<int> q(3);
+    CHECK(q.sendToBack(2));
+    CHECK(q.sendToFront(1));
+    CHECK(q.sendToBack(3));
+
+    int v = 0;
+    CHECK(q.peek(v) && v == 1);
+    CHECK(q.messagesWaiting() == 3);
+    CHECK(q.receive(v) && v == 1);
+    CHECK(q.receive(v) && v == 2);
+    CHECK(q.receive(v) && v == 3);
+}
+
+TEST_CASE(queue_overwrite) {
+    Queue<Sample> q(1);
+    CHECK(q.overwrite(Sample{1, 1, 2, 3}));
+    CHECK(q.overwrite(Sample{2, 4, 5, 6}));
+    CHECK(q.messagesWaiting() == 1);
+
+    Sample s{};
+    CHECK(q.peek(s) && s.id == 2 && s.z == 6);
+}
+
+TEST_CASE(queue_reset) {
+    Queue<int> q(8);
+    for (int i = 0; i < 5; ++i) q.send(i);
+    CHECK(q.reset());
+    CHECK(q.isEmpty());
+    CHECK(q.spacesAvailable() == 8);
+}
+
+TEST_CASE(queue_receive_timeout) {
+    Queue<int> q(1);
+    int        v     = 0;
+    TickType_t start = xTaskGetTickCount();
+    CHECK(!q.receive(v, 20));
+    CHECK(xTaskGetTickCount() - start >= pdMS_TO_TICKS(20));
+}
+
+TEST_CASE(queue_isr_api) {
+    Queue<int> q(2);
+    BaseType_t woken = pdFALSE;
+    CHECK(q.isEmptyISR());
+    CHECK(q.sendFromISR(1, &woken));
+    CHECK(q.sendToFrontFromISR(0, &woken));
+    CHECK(q.isFullISR());
+    CHECK(!q.sendToBackFromISR(2, &woken));
+
+    int v = -1;
+    CHECK(q.peekFromISR(v) && v == 0);
+    CHECK(q.receiveFromISR(v, &woken) && v == 0);
+    CHECK(q.receiveFromISR(v, &woken) && v == 1);
+
+    Queue<int> one(1);
+    CHECK(one.overwriteFromISR(5, &woken));
+    CHECK(one.overwriteFromISR(6, &woken));
+    CHECK(one.receive(v) && v == 6);
+}
+
+// Производитель с более высоким приоритетом упирается в полную очередь
+// и блокируется, пока потребитель (раннер) не освободит место.
+TEST_CASE(queue_blocking_handoff_between_tasks) {
+    Queue<uint32_t> q(4);
+    ProducerArgs    args{&q, 1000, false};
+    xTaskCreate(producerTask, "producer", configMINIMAL_STACK_SIZE, &args, test::RunnerPriority + 1, nullptr);
+
+    bool     ordered = true;
+    uint32_t v       = 0;
+    for (uint32_t i = 0; i < args.count; ++i) {
+        if (!q.receive(v, 1000) || v != i) {
+            ordered = false;
+            break;
+        }
+    }
+    CHECK(ordered);
+    CHECK(args.done);
+    CHECK(q.isEmpty());
+}
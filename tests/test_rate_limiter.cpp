@@ -0,0 +1,151 @@
+#include "TestHarness.h"
+
+#include "RateLimiter.h"
+#include "ShapedQueue.h"
+
+// Частоты выбраны так, что токен копится целое число тиков: 100 в секунду — 10 тиков.
+
+namespace {
+
+constexpr TickType_t TokenTicks = configTICK_RATE_HZ / 100;
+
+}  // namespace
+
+TEST_CASE(bucket_allows_burst_then_rate) {
+    RateLimiter rl(100, 5);
+    for (int i = 0; i < 5; ++i) CHECK(rl.tryAcquire());
+    CHECK(!rl.tryAcquire());
+    CHECK(rl.available() == 0);
+    CHECK(rl.delayFor() > 0 && rl.delayFor() <= TokenTicks);
+    CHECK(rl.delayFor(6) == portMAX_DELAY);  // больше всплеска не накопится никогда
+
+    vTaskDelay(TokenTicks);
+    CHECK(rl.tryAcquire());
+    CHECK(!rl.tryAcquire());
+
+    vTaskDelay(TokenTicks * 20);  // ведро не переполняется
+    CHECK(rl.available() == 5);
+}
+
+TEST_CASE(acquire_waits_or_fails_fast) {
+    RateLimiter rl(100, 1);
+    CHECK(rl.tryAcquire());
+
+    TickType_t start = xTaskGetTickCount();
+    CHECK(!rl.acquire(1, 2));  // токен будет через 10 тиков — не ждём зря
+    CHECK(xTaskGetTickCount() - start < 2);
+    CHECK(!rl.acquire(2, 1000));
+
+    start = xTaskGetTickCount();
+    CHECK(rl.acquire(1, 50));
+    TickType_t waited = xTaskGetTickCount() - start;
+    CHECK(waited >= TokenTicks / 2 && waited <= TokenTicks * 2);
+}
+
+TEST_CASE(zero_rate_is_unlimited) {
+    RateLimiter rl(0, 0);
+    for (int i = 0; i < 1000; ++i) CHECK(rl.tryAcquire());
+    CHECK(rl.delayFor(100) == 0);
+    CHECK(rl.available() == UINT32_MAX);
+
+    rl.configure(100, 1);
+    CHECK(rl.tryAcquire());
+    CHECK(!rl.tryAcquire());
+}
+
+TEST_CASE(weighted_receive_bounds_latency) {
+    auto* q = new ShapedQueue<int, 3, 16>;
+    q->configure(0, 0, 0, 1);  // срочные
+    q->configure(1, 0, 0, 1);
+    q->configure(2, 0, 0, 3);  // массовые с большим весом
+    for (int i = 0; i < 10; ++i) {
+        CHECK(q->send(1, 100 + i));
+        CHECK(q->send(2, 200 + i));
+    }
+
+    // Доли по весам: на один элемент класса 1 — три из класса 2
+    int    v;
+    size_t from;
+    size_t count[3] = {};
+    for (int i = 0; i < 8; ++i) {
+        CHECK(q->receive(v, 0, &from));
+        ++count[from];
+    }
+    CHECK(count[1] == 2 && count[2] == 6);
+    CHECK(q->receive(v, 0, &from) && from == 1 && v == 102);  // порядок внутри класса сохраняется
+
+    // Срочный элемент за массовым потоком ждёт не больше суммы весов остальных классов
+    CHECK(q->send(0, 1));
+    size_t position = 0;
+    do {
+        CHECK(q->receive(v, 0, &from));
+        ++position;
+    } while (from != 0 && position < 20);
+    CHECK(from == 0 && v == 1);
+    CHECK(position <= 1 + 3 + 1);
+    CHECK(q->messagesWaiting() == 20 - 9 - position + 1);
+    delete q;
+}
+
+TEST_CASE(shaped_send_counts_rejects_and_delays) {
+    auto* q = new ShapedQueue<int, 2, 4>;
+    q->configure(1, 100, 2);
+    CHECK(q->send(1, 1));
+    CHECK(q->send(1, 2));
+    CHECK(!q->send(1, 3));     // бюджет исчерпан, ждать нельзя
+    CHECK(q->send(1, 4, 50));  // дождались токена
+    CHECK(!q->send(1, 5, 2));  // токен не накопится за 2 мс
+
+    auto s = q->stats(1);
+    CHECK(s.sent == 3 && s.rejected == 2 && s.delayed == 1 && s.dropped == 0);
+
+    // Класс без ограничения упирается только в свою очередь
+    for (int i = 0; i < 4; ++i) CHECK(q->send(0, i));
+    CHECK(!q->send(0, 4));
+    CHECK(!q->send(0, 4, 3));
+    s = q->stats(0);
+    CHECK(s.sent == 4 && s.rejected == 0 && s.dropped == 2);
+
+    int v;
+    while (q->receive(v)) {
+    }
+    CHECK(q->stats(0).received == 4 && q->stats(1).received == 3);
+    delete q;
+}
+
+TEST_CASE(receive_blocks_until_send) {
+    static ShapedQueue<int, 2, 4> q;
+    int                           v;
+    TickType_t                    start = xTaskGetTickCount();
+    CHECK(!q.receive(v, 5));
+    CHECK(xTaskGetTickCount() - start >= 5);
+
+    TaskHandle_t sender;
+    xTaskCreate(
+        [](void*) {
+            vTaskDelay(3);
+            q.send(1, 42);
+            vTaskDelete(nullptr);
+        },
+        "sender", configMINIMAL_STACK_SIZE, nullptr, test::RunnerPriority - 1, &sender);
+    size_t from = 0;
+    CHECK(q.receive(v, 100, &from));
+    CHECK(v == 42 && from == 1);
+    vTaskDelay(2);
+}
+
+TEST_CASE(isr_send_takes_tokens_without_waiting) {
+    auto* q = new ShapedQueue<int, 1, 4>;
+    q->configure(0, 100, 1);
+    BaseType_t  woken = pdFALSE;
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    bool        first = q->sendFromISR(0, 7, &woken);
+    bool        again = q->sendFromISR(0, 8, &woken);
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    CHECK(first && !again);
+    CHECK(q->stats(0).rejected == 1);
+    int v;
+    CHECK(q->receive(v) && v == 7);
+    CHECK(!q->receive(v));
+    delete q;
+}
@@ -0,0 +1,177 @@
+#include "TestHarness.h"
+
+#include "RemoteQueueBridge.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Обе стороны моста — в одном образе: транспорт соединяет две задачи.
+// Задачи моста выше раннера, поэтому кадр разбирается сразу, как только записан.
+
+namespace {
+
+constexpr UBaseType_t BridgePriority = test::RunnerPriority + 1;
+
+struct Reading {
+    uint32_t seq;
+    int16_t  value[3];
+};
+
+using Bridge = RemoteQueueBridge<Reading, 16>;
+
+Reading make(uint32_t seq) {
+    return Reading{seq, {static_cast<int16_t>(seq), static_cast<int16_t>(-seq), 7}};
+}
+
+// Прогнать n элементов: производитель ниже раннера, потребитель (раннер) отстаёт
+bool pump(Queue<Reading>& source, Queue<Reading>& sink, uint32_t n, uint32_t expectedFirst = 0) {
+    static Queue<Reading>* src;
+    static uint32_t        count;
+    src   = &source;
+    count = n;
+    xTaskCreate(
+        [](void*) {
+            for (uint32_t i = 0; i < count; ++i) src->send(make(i), portMAX_DELAY);
+            vTaskDelete(nullptr);
+        },
+        "producer", configMINIMAL_STACK_SIZE * 2, nullptr, test::RunnerPriority - 1, nullptr);
+
+    Reading r{};
+    bool    ok = true;
+    for (uint32_t i = expectedFirst; i < n; ++i) {
+        ok = ok && sink.receive(r, 1000) && r.seq == i && r.value[1] == static_cast<int16_t>(-i);
+        if (i % 50 == 0) vTaskDelay(3);
+    }
+    return ok;
+}
+
+// Транспорт, который теряет одну запись
+struct Lossy : ByteTransport {
+    ByteTransport* inner;
+    int            dropWrite;
+    int            writes = 0;
+
+    Lossy(ByteTransport* inner, int dropWrite) : inner(inner), dropWrite(dropWrite) {}
+
+    bool write(const void* data, size_t len) override {
+        if (writes++ == dropWrite) return true;  // «ушло» в никуда
+        return inner->write(data, len);
+    }
+    size_t read(void* dst, size_t max, uint32_t ms) override {
+        return inner->read(dst, max, ms);
+    }
+};
+
+}  // namespace
+
+TEST_CASE(crc_matches_ccitt_false) {
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    CHECK(bridge::crc16(check, sizeof(check)) == 0x29B1);
+}
+
+TEST_CASE(loopback_batches_with_credit_backpressure) {
+    LoopbackLink<512> link;
+    Queue<Reading>    source(64);
+    Queue<Reading>    sink(16);
+    Bridge            tx(&link.a(), bridge::Config{8, 2, 20});
+    Bridge            rx(&link.b(), bridge::Config{8, 2, 20});
+    CHECK(rx.startReceiver(sink, "rx", BridgePriority));
+    CHECK(tx.startSender(source, "tx", BridgePriority));
+
+    CHECK(pump(source, sink, 600));
+    vTaskDelay(5);
+    bridge::Stats s = tx.stats();
+    bridge::Stats r = rx.stats();
+    CHECK(s.items == 600 && r.items == 600);
+    CHECK(s.batches < 600 / 2);  // элементы шли пачками
+    CHECK(s.stalls > 0);         // потребитель отставал — отправитель ждал кредит
+    CHECK(r.lost == 0 && r.overflow == 0 && r.badFrames == 0);
+    CHECK(tx.credit() <= 16);  // больше, чем влезает в sink, не разрешалось
+
+    rx.stop();
+    tx.stop();
+}
+
+TEST_CASE(linger_flushes_partial_batch) {
+    LoopbackLink<512> link;
+    Queue<Reading>    source(8);
+    Queue<Reading>    sink(8);
+    Bridge            tx(&link.a(), bridge::Config{16, 5, 20});
+    Bridge            rx(&link.b(), bridge::Config{16, 5, 20});
+    CHECK(rx.startReceiver(sink, "rx", BridgePriority));
+    CHECK(tx.startSender(source, "tx", BridgePriority));
+    vTaskDelay(1);  // кредит дошёл
+
+    // Один элемент: пачка не наберётся, уходит по истечении linger
+    const TickType_t start = xTaskGetTickCount();
+    CHECK(source.send(make(1)));
+    Reading r{};
+    CHECK(sink.receive(r, 100) && r.seq == 1);
+    const TickType_t waited = xTaskGetTickCount() - start;
+    CHECK(waited >= pdMS_TO_TICKS(5) && waited <= pdMS_TO_TICKS(7));
+    CHECK(tx.stats().batches == 1);
+
+    rx.stop();
+    tx.stop();
+}
+
+TEST_CASE(unix_socket_with_junk_and_lost_frame) {
+    int fds[2];
+    CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    UnixSocketTransport left(fds[0]);
+    UnixSocketTransport right(fds[1]);
+
+    // Мусор до первого кадра и одна пропавшая пачка данных (вторая запись отправителя)
+    const uint8_t junk[] = {0x00, bridge::Sync0, 0x13, bridge::Sync0, bridge::Sync1, 0x01};
+    CHECK(left.write(junk, sizeof(junk)));
+    Lossy lossy(&left, 1);
+
+    Queue<Reading> source(64);
+    Queue<Reading> sink(32);
+    Bridge         tx(&lossy, bridge::Config{8, 1, 20});
+    Bridge         rx(&right, bridge::Config{8, 1, 20});
+    CHECK(rx.startReceiver(sink, "rx", BridgePriority));
+    vTaskDelay(2);  // кредит ждёт в сокете
+    for (uint32_t i = 0; i < 32; ++i) CHECK(source.send(make(i)));
+    CHECK(tx.startSender(source, "tx", BridgePriority));
+
+    // Пачки по 8: первая пришла, вторая (8..15) пропала, дальше по порядку
+    Reading r{};
+    bool    ok = true;
+    for (uint32_t i = 0; i < 8; ++i) ok = ok && sink.receive(r, 1000) && r.seq == i;
+    for (uint32_t i = 16; i < 32; ++i) ok = ok && sink.receive(r, 1000) && r.seq == i;
+    CHECK(ok);
+    bridge::Stats s = rx.stats();
+    CHECK(s.lost == 8 && s.items == 24);
+    CHECK(s.badFrames > 0);
+
+    rx.stop();
+    tx.stop();
+}
+
+TEST_CASE(closed_socket_parks_bridge) {
+    int fds[2];
+    CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    UnixSocketTransport left(fds[0]);
+
+    // Другая сторона успела дать кредит и закрылась: данные уйти не могут
+    uint8_t frame[bridge::Header + 4 + bridge::Trailer] = {bridge::Sync0, bridge::Sync1, bridge::Credit, 0, 4, 0};
+    bridge::put32(frame + bridge::Header, 16);
+    const uint16_t crc            = bridge::crc16(frame + 2, bridge::Header - 2 + 4);
+    frame[bridge::Header + 4]     = static_cast<uint8_t>(crc);
+    frame[bridge::Header + 4 + 1] = static_cast<uint8_t>(crc >> 8);
+    CHECK(::write(fds[1], frame, sizeof(frame)) == static_cast<ssize_t>(sizeof(frame)));
+    ::close(fds[1]);
+
+    Queue<Reading> source(8);
+    for (uint32_t i = 0; i < 4; ++i) CHECK(source.send(make(i)));
+    Bridge tx(&left, bridge::Config{8, 1, 20});
+    CHECK(tx.startSender(source, "tx", BridgePriority));
+
+    // Задача моста выше раннера: раннер дождался бы этого только если она уснула
+    vTaskDelay(10);
+    CHECK(tx.closed());
+    bridge::Stats s = tx.stats();
+    CHECK(s.lost == 4 && s.items == 0 && s.batches == 0);
+    tx.stop();
+}
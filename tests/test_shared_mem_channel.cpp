@@ -0,0 +1,178 @@
+#include "TestHarness.h"
+
+#include "SharedMemChannel.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Два процесса: тест запускает этот же исполняемый файл с SHM_PEER=<memfd>,<eventfd>.
+// Второй процесс поднимает свой планировщик в статическом конструкторе и не доходит до
+// main(): отвечает эхом из канала «туда» в канал «обратно» и выходит.
+
+namespace {
+
+constexpr UBaseType_t HelperPriority = test::RunnerPriority + 1;
+
+struct Msg {
+    uint32_t seq;
+    uint32_t value;
+};
+
+constexpr uint32_t Stop       = UINT32_MAX;
+constexpr size_t   RegionSize = SharedMemChannel<Msg>::regionBytes(64);  // одно направление
+constexpr size_t   MapSize    = 2 * RegionSize;
+
+uint8_t* mapShared(int fd) {
+    void* mem = mmap(nullptr, MapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return mem == MAP_FAILED ? nullptr : static_cast<uint8_t*>(mem);
+}
+
+// ---- Второй процесс ----
+
+int peerMemFd   = -1;
+int peerEventFd = -1;
+
+void peerTask(void*) {
+    uint8_t* mem = mapShared(peerMemFd);
+    if (!mem) _exit(2);
+    // «Туда» будит eventfd, «обратно» — futex в управляющем блоке
+    EventFdDoorbell        toPeer(peerEventFd);
+    FutexDoorbell          toParent(SharedMemChannel<Msg>::bellWord(mem + RegionSize, shm::DataBell));
+    SharedMemChannel<Msg>  in(mem, RegionSize, shm::Attach, &toPeer);
+    SharedMemChannel<Msg>  out(mem + RegionSize, RegionSize, shm::Attach, &toParent);
+    if (!in.attached() || !out.attached()) _exit(3);
+
+    Msg m{};
+    while (in.receive(m, 5000) && m.seq != Stop) {
+        m.value = m.value * 2 + 1;
+        if (!out.send(m, 5000)) _exit(4);
+    }
+    _exit(m.seq == Stop ? 0 : 5);
+}
+
+struct PeerHook {
+    PeerHook() {
+        const char* env = std::getenv("SHM_PEER");
+        if (!env || std::sscanf(env, "%d,%d", &peerMemFd, &peerEventFd) != 2) return;
+        xTaskCreate(peerTask, "peer", configMINIMAL_STACK_SIZE * 4, nullptr, test::RunnerPriority, nullptr);
+        vTaskStartScheduler();
+        _exit(6);
+    }
+} peerHook;
+
+// Запустить второй процесс; до exec — только async-signal-safe вызовы
+pid_t spawnPeer(int memFd, int eventFd) {
+    char  env[48];
+    char  self[] = "/proc/self/exe";
+    char* argv[] = {self, nullptr};
+    std::snprintf(env, sizeof(env), "SHM_PEER=%d,%d", memFd, eventFd);
+    char* envp[] = {env, nullptr};
+    pid_t pid    = fork();
+    if (pid == 0) {
+        execve(self, argv, envp);
+        _exit(127);
+    }
+    return pid;
+}
+
+// ---- Один процесс: два «ядра» — две задачи, звонок — прямой вызов ----
+
+alignas(shm::CacheLine) uint8_t local[SharedMemChannel<Msg>::regionBytes(16) + 100];
+
+IrqDoorbell* dataSide;
+IrqDoorbell* spaceSide;
+
+}  // namespace
+
+TEST_CASE(layout_and_attach) {
+    static_assert(sizeof(shm::Control) == 4 * shm::CacheLine, "indices on separate cache lines");
+    static_assert(offsetof(shm::Control, tail) - offsetof(shm::Control, head) == shm::CacheLine, "");
+
+    std::memset(local, 0, sizeof(local));
+    SharedMemChannel<Msg> early(local, sizeof(local), shm::Attach, nullptr);
+    CHECK(!early.attached());  // другая сторона ещё не разметила область
+
+    SharedMemChannel<Msg> owner(local, sizeof(local), shm::Create, nullptr);
+    CHECK(owner.attached() && owner.capacity() == 16);  // 16 влезает, 32 — нет
+    CHECK(early.attached() && early.capacity() == 16);
+    SharedMemChannel<uint32_t> wrongType(local, sizeof(local), shm::Attach, nullptr);
+    CHECK(!wrongType.attached());
+
+    for (uint32_t i = 0; i < 16; ++i) CHECK(owner.send(Msg{i, i}));
+    CHECK(!owner.send(Msg{16, 16}));
+    CHECK(early.messagesWaiting() == 16);
+    Msg m{};
+    for (uint32_t i = 0; i < 16; ++i) CHECK(early.receive(m) && m.seq == i);
+    CHECK(!early.receive(m));
+}
+
+TEST_CASE(two_tasks_with_irq_doorbells) {
+    static IrqDoorbell data([](void*) { dataSide->signal(); }, nullptr);
+    static IrqDoorbell space([](void*) { spaceSide->signal(); }, nullptr);
+    dataSide  = &data;
+    spaceSide = &space;
+    static SharedMemChannel<Msg> tx(local, sizeof(local), shm::Create, &data, &space);
+    static SharedMemChannel<Msg> rx(local, sizeof(local), shm::Attach, &data, &space);
+
+    // Производитель выше раннера: упирается в полное кольцо и ждёт звонка «место есть»
+    xTaskCreate(
+        [](void*) {
+            for (uint32_t i = 0; i < 1000; ++i) tx.send(Msg{i, i * 3}, 1000);
+            vTaskDelete(nullptr);
+        },
+        "producer", configMINIMAL_STACK_SIZE * 2, nullptr, HelperPriority, nullptr);
+
+    Msg  m{};
+    bool ok = true;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ok = ok && rx.receive(m, 100) && m.seq == i && m.value == i * 3;
+        if (i % 100 == 0) vTaskDelay(2);  // потребитель отстаёт
+    }
+    CHECK(ok);
+    TickType_t start = xTaskGetTickCount();
+    CHECK(!rx.receive(m, 5));
+    CHECK(xTaskGetTickCount() - start >= 5);
+}
+
+TEST_CASE(two_processes_share_memfd) {
+    int memFd   = memfd_create("shm_channel_test", 0);
+    int eventFd = eventfd(0, 0);
+    CHECK(memFd >= 0 && eventFd >= 0);
+    CHECK(ftruncate(memFd, MapSize) == 0);
+    uint8_t* mem = mapShared(memFd);
+    CHECK(mem != nullptr);
+    if (!mem) return;
+
+    EventFdDoorbell       toPeer(eventFd);
+    FutexDoorbell         toParent(SharedMemChannel<Msg>::bellWord(mem + RegionSize, shm::DataBell));
+    SharedMemChannel<Msg> out(mem, RegionSize, shm::Create, &toPeer);
+    SharedMemChannel<Msg> in(mem + RegionSize, RegionSize, shm::Create, &toParent);
+    CHECK(out.capacity() == 64 && in.capacity() == 64);
+
+    pid_t pid = spawnPeer(memFd, eventFd);
+    CHECK(pid > 0);
+
+    // Пачками не больше ёмкости: эхо не упрётся в полное кольцо «обратно»
+    bool     ok  = true;
+    uint32_t seq = 0;
+    for (int round = 0; round < 100 && ok; ++round) {
+        for (int k = 0; k < 32; ++k, ++seq) ok = ok && out.send(Msg{seq, seq}, 1000);
+        Msg m{};
+        for (uint32_t k = seq - 32; k < seq; ++k) ok = ok && in.receive(m, 5000) && m.seq == k && m.value == k * 2 + 1;
+    }
+    CHECK(ok);
+    CHECK(out.send(Msg{Stop, 0}, 1000));
+
+    int status = -1;
+    CHECK(waitpid(pid, &status, 0) == pid);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    munmap(mem, MapSize);
+    close(eventFd);
+    close(memFd);
+}
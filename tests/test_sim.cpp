@@ -0,0 +1,173 @@
+#include "TestHarness.h"
+
+#include "QueueCpp.h"
+#include "SimKernel.h"
+#include "freertos/semphr.h"
+
+// Тесты самого симулятора: виртуальное время должно быть точным до наносекунды.
+
+namespace {
+
+constexpr uint64_t TickNs = 1000000000ull / configTICK_RATE_HZ;
+
+// Нулевая модель стоимости и выравнивание на границу тика
+uint64_t freshStart() {
+    sim::setCostModel(sim::CostModel::zero());
+    vTaskDelay(1);
+    return sim::nowNs();
+}
+
+struct Timed {
+    SemaphoreHandle_t done;
+    uint64_t          workNs;
+    uint64_t          startNs;
+    uint64_t          endNs;
+};
+
+void delayedWakeTask(void* p) {
+    auto* t = static_cast<Timed*>(p);
+    vTaskDelay(1);
+    t->endNs = sim::nowNs();
+    xSemaphoreGive(t->done);
+    vTaskDelete(nullptr);
+}
+
+void busyTask(void* p) {
+    auto* t    = static_cast<Timed*>(p);
+    t->startNs = sim::nowNs();
+    sim::consume(t->workNs);
+    t->endNs = sim::nowNs();
+    xSemaphoreGive(t->done);
+    vTaskDelete(nullptr);
+}
+
+struct MutexArgs {
+    SemaphoreHandle_t mutex;
+    SemaphoreHandle_t done;
+    uint64_t          releasedNs;
+};
+
+void lowHolderTask(void* p) {
+    auto* a = static_cast<MutexArgs*>(p);
+    xSemaphoreTake(a->mutex, portMAX_DELAY);
+    sim::consume(2 * TickNs);
+    a->releasedNs = sim::nowNs();
+    xSemaphoreGive(a->mutex);
+    xSemaphoreGive(a->done);
+    vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+TEST_CASE(delay_is_exact) {
+    uint64_t t0 = freshStart();
+    vTaskDelay(5);
+    CHECK(sim::nowNs() == t0 + 5 * TickNs);
+
+    TickType_t last = xTaskGetTickCount();
+    vTaskDelayUntil(&last, 3);
+    CHECK(sim::nowNs() == t0 + 8 * TickNs);
+}
+
+TEST_CASE(cost_model_charges_operations) {
+    freshStart();
+    sim::CostModel m = sim::CostModel::zero();
+    m.ns[static_cast<size_t>(sim::Op::QueueSend)] = 1000;
+    m.copyPsPerByte                               = 500;
+    sim::setCostModel(m);
+
+    Queue<uint64_t> q(4);
+    uint64_t        t0 = sim::nowNs();
+    CHECK(q.send(42));
+    CHECK(sim::nowNs() - t0 == 1000 + 4);  // 8 байт по 0.5 нс
+
+    t0 = sim::nowNs();
+    uint64_t v = 0;
+    CHECK(q.receive(v));
+    CHECK(v == 42);
+    CHECK(sim::nowNs() - t0 == 4);  // у receive только копирование
+    sim::setCostModel(sim::CostModel::zero());
+}
+
+TEST_CASE(consume_is_preempted_by_higher_priority_wake) {
+    uint64_t t0 = freshStart();
+    Timed    high{xSemaphoreCreateBinary(), 0, 0, 0};
+    xTaskCreate(delayedWakeTask, "high", configMINIMAL_STACK_SIZE, &high, test::RunnerPriority + 1, nullptr);
+
+    sim::consume(3 * TickNs);
+    CHECK(high.endNs == t0 + TickNs);  // проснулась посреди consume()
+    CHECK(sim::nowNs() == t0 + 3 * TickNs);
+    CHECK(xSemaphoreTake(high.done, 0) == pdTRUE);
+    vSemaphoreDelete(high.done);
+}
+
+TEST_CASE(isr_events_feed_queue) {
+    uint64_t       t0 = freshStart();
+    Queue<uint32_t> q(16);
+    for (uint32_t i = 0; i < 10; ++i) {
+        sim::at(t0 + (i + 1) * 100000, [&q, i] {
+            BaseType_t woken = pdFALSE;
+            q.sendFromISR(i, &woken);
+            CHECK(sim::inIsr());
+            portYIELD_FROM_ISR(woken);
+        });
+    }
+    uint64_t interrupts = sim::stats().interrupts;
+    for (uint32_t i = 0; i < 10; ++i) {
+        uint32_t v = 0;
+        CHECK(q.receive(v, 10));
+        CHECK(v == i);
+        CHECK(sim::nowNs() == t0 + (i + 1) * 100000);
+    }
+    CHECK(sim::stats().interrupts - interrupts == 10);
+    CHECK(!sim::inIsr());
+}
+
+TEST_CASE(equal_priorities_share_cpu_by_tick) {
+    uint64_t          t0   = freshStart();
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(2, 0);
+    // Половина тика в конце — чтобы окончание работы не совпало с границей тика
+    Timed             a{done, 4 * TickNs + TickNs / 2, 0, 0};
+    Timed             b{done, 4 * TickNs + TickNs / 2, 0, 0};
+
+    // Обе задачи должны стать готовыми одновременно
+    vTaskSuspendAll();
+    xTaskCreate(busyTask, "a", configMINIMAL_STACK_SIZE, &a, test::RunnerPriority + 1, nullptr);
+    xTaskCreate(busyTask, "b", configMINIMAL_STACK_SIZE, &b, test::RunnerPriority + 1, nullptr);
+    xTaskResumeAll();
+
+    CHECK(xSemaphoreTake(done, 0) == pdTRUE);
+    CHECK(xSemaphoreTake(done, 0) == pdTRUE);
+    CHECK(a.startNs == t0);
+    CHECK(b.startNs == t0 + TickNs);
+    CHECK(a.endNs == t0 + 8 * TickNs + TickNs / 2);  // пятый квант a — неполный
+    CHECK(b.endNs == t0 + 9 * TickNs);
+    vSemaphoreDelete(done);
+}
+
+TEST_CASE(mutex_priority_inheritance) {
+    vTaskPrioritySet(nullptr, test::RunnerPriority + 3);
+    uint64_t  t0 = freshStart();
+    MutexArgs args{xSemaphoreCreateMutex(), xSemaphoreCreateCounting(2, 0), 0};
+    Timed     medium{args.done, 10 * TickNs, 0, 0};
+
+    TaskHandle_t low;
+    xTaskCreate(lowHolderTask, "low", configMINIMAL_STACK_SIZE, &args, test::RunnerPriority - 1, &low);
+    vTaskDelay(1);  // low захватывает мьютекс и успевает поработать один тик
+    CHECK(xSemaphoreGetMutexHolder(args.mutex) == low);
+
+    xTaskCreate(busyTask, "medium", configMINIMAL_STACK_SIZE, &medium, test::RunnerPriority + 1, nullptr);
+    CHECK(xSemaphoreTake(args.mutex, portMAX_DELAY) == pdTRUE);
+    // Без наследования medium вытеснил бы low на 10 тиков
+    CHECK(args.releasedNs == t0 + 2 * TickNs);
+    CHECK(sim::nowNs() == t0 + 2 * TickNs);
+    CHECK(uxTaskPriorityGet(low) == test::RunnerPriority - 1);
+    xSemaphoreGive(args.mutex);
+
+    CHECK(xSemaphoreTake(args.done, portMAX_DELAY) == pdTRUE);
+    CHECK(xSemaphoreTake(args.done, portMAX_DELAY) == pdTRUE);
+    CHECK(medium.endNs == t0 + 12 * TickNs);
+    vSemaphoreDelete(args.done);
+    vSemaphoreDelete(args.mutex);
+    vTaskPrioritySet(nullptr, test::RunnerPriority);
+}
@@ -0,0 +1,104 @@
+#include "TestHarness.h"
+
+// Собирается с FREERTOS_CPP_SLO=1 (см. tests/CMakeLists.txt)
+#include "QueueCpp.h"
+#include "Slo.h"
+
+// Виртуальное время: задержка пути — ровно столько тиков, сколько обработчик спал,
+// без нескольких микросекунд на сами вызовы.
+
+namespace {
+
+struct Command {
+    uint32_t   delayTicks;
+    slo::Token t;
+};
+
+struct Consumer {
+    Queue<Command>* commands;
+    slo::Path*      path;
+    uint32_t        n;
+};
+
+constexpr EventBits_t Missed = 1 << 3;
+
+}  // namespace
+
+TEST_CASE(slo_histogram_buckets) {
+    bool ok = true;
+    for (uint32_t us = 0; us < (1u << 20); us += 1 + us / 16) {
+        const size_t b = slo::Path::bucketOf(us);
+        ok = ok && b < slo::Path::Buckets && slo::Path::upperBound(b) >= us;
+        ok = ok && (b == 0 || slo::Path::upperBound(b - 1) < us);
+    }
+    CHECK(ok);
+    CHECK(slo::Path::bucketOf(5) == 5);
+    CHECK(slo::Path::bucketOf(UINT32_MAX) == slo::Path::Buckets - 1);
+    static_assert(slo::Enabled, "test is built with FREERTOS_CPP_SLO=1");
+}
+
+TEST_CASE(slo_token_flows_through_queue) {
+    EventGroup     health;
+    slo::Path      path("cmd->done", 1500, &health, Missed);
+    Queue<Command> commands(4);
+    Consumer       c{&commands, &path, 9};
+
+    TaskHandle_t consumer = nullptr;
+    xTaskCreate(
+        [](void* p) {
+            auto*   c = static_cast<Consumer*>(p);
+            Command cmd{};
+            for (uint32_t i = 0; i < c->n; ++i) {
+                c->commands->receive(cmd, portMAX_DELAY);
+                if (cmd.delayTicks) vTaskDelay(cmd.delayTicks);
+                c->path->end(cmd.t);
+            }
+            vTaskDelete(nullptr);
+        },
+        "consumer", configMINIMAL_STACK_SIZE * 2, &c, test::RunnerPriority + 1, &consumer);
+
+    // Задержки 0, 1, 2 тика по кругу; срок 1.5 мс нарушают только двухтиковые
+    for (uint32_t i = 0; i < c.n; ++i) {
+        vTaskDelay(3);  // с границы тика, обработчик уже свободен
+        CHECK(commands.send(Command{i % 3, path.start()}));
+    }
+    vTaskDelay(3);
+
+    slo::Stats s = path.stats();
+    CHECK(s.count == 9);
+    CHECK(s.violations == 3);
+    CHECK(s.worstUs > 1900 && s.worstUs <= 2000);
+    CHECK(s.worstTask == consumer);
+    CHECK(s.p50Us >= 900 && s.p50Us < 1500);  // медиана — однотиковые
+    CHECK(s.p99Us >= s.worstUs);
+    CHECK(health.getBits() & Missed);
+    CHECK(slo::Path::worstOffender() == &path);
+}
+
+TEST_CASE(slo_isr_end_and_worst_offender) {
+    slo::Path fast("fast", 100);
+    slo::Path slow("slow", 5000);
+
+    size_t paths = 0;
+    slo::Path::forEach([&](slo::Path&) { ++paths; });
+    CHECK(paths == 2);  // пути прошлого теста ушли из списка вместе с объектами
+    CHECK(slo::Path::worstOffender() == nullptr);
+
+    slo::Token t = fast.start();
+    vTaskDelay(1);
+    BaseType_t  woken = pdFALSE;
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    CHECK(fast.endFromISR(t, &woken) > 100);
+    CHECK(slow.endFromISR(t, &woken) < 5000);
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    CHECK(fast.stats().violations == 1 && fast.stats().worstTask == nullptr);
+    CHECK(slow.stats().violations == 0 && slow.stats().count == 1);
+    CHECK(slo::Path::worstOffender() == &fast);
+
+    // Неотмеченный токен пропускается; reset обнуляет путь
+    CHECK(fast.end(slo::Token{}) == 0 && fast.stats().count == 1);
+    fast.reset();
+    CHECK(fast.stats().count == 0 && fast.stats().worstUs == 0 && fast.percentileUs(990) == 0);
+    CHECK(slo::Path::worstOffender() == nullptr);
+}
@@ -0,0 +1,224 @@
+#include "TestHarness.h"
+
+#include "SpillQueue.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+// Служебная задача обычно выше раннера: ввод-вывод выполняется сразу после send()/receive(),
+// поэтому состояние носителя в проверках детерминировано.
+
+namespace {
+
+constexpr UBaseType_t WorkerPriority = test::RunnerPriority + 1;
+constexpr UBaseType_t HelperPriority = test::RunnerPriority - 1;
+
+struct Record {
+    uint32_t seq;
+    uint32_t payload[3];
+};
+
+using Spill = SpillQueue<Record, 512, 8, 2>;
+static_assert(Spill::Items == 31, "16-byte header, 31 records per 512-byte block");
+
+// Временный файл, удаляется вместе с объектом
+struct TempFile {
+    char path[32] = "/tmp/spill_test_XXXXXX";
+
+    TempFile() {
+        int fd = mkstemp(path);
+        if (fd >= 0) close(fd);
+    }
+    ~TempFile() {
+        unlink(path);
+    }
+};
+
+// Носитель в памяти, который умеет один раз не прочитать блок
+struct RamDevice : BlockDevice {
+    uint8_t  data[16][512];
+    int      failRead = -1;
+    uint32_t reads    = 0;
+    uint32_t writes   = 0;
+
+    size_t blockSize() const override {
+        return 512;
+    }
+    uint32_t blockCount() const override {
+        return 16;
+    }
+    bool read(uint32_t block, void* dst) override {
+        ++reads;
+        if (static_cast<int>(block) == failRead) {
+            failRead = -1;  // один раз: кольцо носителя ещё вернётся к этому блоку
+            return false;
+        }
+        std::memcpy(dst, data[block], 512);
+        return true;
+    }
+    bool write(uint32_t block, const void* src) override {
+        ++writes;
+        std::memcpy(data[block], src, 512);
+        return true;
+    }
+};
+
+Record make(uint32_t seq) {
+    return Record{seq, {seq * 3, ~seq, 0xA5A5A5A5}};
+}
+
+bool intact(const Record& r) {
+    return r.payload[0] == r.seq * 3 && r.payload[1] == ~r.seq && r.payload[2] == 0xA5A5A5A5;
+}
+
+// Прочитать n записей; true — все по порядку с first и целые
+template <typename Q>
+bool drainInOrder(Q& q, uint32_t first, uint32_t n, uint32_t ms = 100) {
+    Record r{};
+    for (uint32_t i = 0; i < n; ++i) {
+        if (!q.receive(r, ms) || r.seq != first + i || !intact(r)) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST_CASE(ram_only_without_worker) {
+    Spill q;
+    CHECK(!q.start());  // без носителя служебная задача не нужна
+    for (uint32_t i = 0; i < Spill::ramCapacity(); ++i) CHECK(q.send(make(i)));
+    CHECK(!q.send(make(999)));
+    CHECK(q.stats().dropped == 1);
+    CHECK(q.messagesWaiting() == Spill::ramCapacity());
+
+    CHECK(drainInOrder(q, 0, Spill::ramCapacity(), 0));
+    Record r{};
+    TickType_t start = xTaskGetTickCount();
+    CHECK(!q.receive(r, 5));
+    CHECK(xTaskGetTickCount() - start >= 5);
+
+    // Открытый блок читается по мере записи и переиспользуется
+    for (uint32_t i = 0; i < 100; ++i) {
+        CHECK(q.send(make(i)));
+        CHECK(q.receive(r) && r.seq == i);
+    }
+    CHECK(q.stats().received == Spill::ramCapacity() + 100);
+}
+
+TEST_CASE(burst_spills_to_file_and_comes_back_in_order) {
+    TempFile        file;
+    FileBlockDevice dev(file.path, 512, 64);
+    CHECK(dev.isOpen());
+    Spill q(&dev);
+    CHECK(q.start("spill", WorkerPriority));
+
+    // Потребитель стоит: в 6 раз больше, чем вмещает RAM
+    const uint32_t n = static_cast<uint32_t>(Spill::ramCapacity() * 6);
+    bool           ok = true;
+    for (uint32_t i = 0; i < n; ++i) ok = ok && q.send(make(i));
+    CHECK(ok);
+    CHECK(q.messagesWaiting() == n);
+    CHECK(q.blocksOnDevice() > 0);
+    spill::Stats s = q.stats();
+    CHECK(s.dropped == 0 && s.spilled == q.blocksOnDevice());
+    CHECK(s.promoted == 2);  // голова заполнилась без ввода-вывода
+
+    CHECK(drainInOrder(q, 0, n));
+    s = q.stats();
+    CHECK(s.prefetched == s.spilled && s.ioErrors == 0);
+    CHECK(q.blocksOnDevice() == 0 && q.messagesWaiting() == 0);
+    q.stop();
+}
+
+TEST_CASE(producer_and_consumer_interleave) {
+    static RamDevice dev;
+    static Spill     q(&dev);
+    static uint32_t  produced;
+    CHECK(q.start("spill", WorkerPriority));
+
+    // Производитель ниже раннера пишет пачками; раннер читает с паузами
+    produced = 0;
+    xTaskCreate(
+        [](void*) {
+            for (int burst = 0; burst < 20; ++burst) {
+                for (int i = 0; i < 50; ++i) q.send(make(produced++));
+                vTaskDelay(1);
+            }
+            vTaskDelete(nullptr);
+        },
+        "producer", configMINIMAL_STACK_SIZE * 2, nullptr, HelperPriority, nullptr);
+
+    Record   r{};
+    uint32_t expected = 0;
+    bool     ok       = true;
+    while (expected < 1000 && q.receive(r, 100)) {
+        ok = ok && r.seq == expected && intact(r);
+        ++expected;
+        if (expected % 200 == 0) vTaskDelay(5);  // потребитель отстаёт — середина уходит на носитель
+    }
+    CHECK(ok && expected == 1000);
+    CHECK(q.stats().dropped == 0);
+    CHECK(dev.writes > 0 && dev.reads == dev.writes);
+    q.stop();
+}
+
+TEST_CASE(full_device_drops_and_bad_block_is_skipped) {
+    static RamDevice dev;
+    Spill            q(&dev);
+    CHECK(q.start("spill", WorkerPriority));
+
+    uint32_t sent = 0;
+    while (q.send(make(sent))) ++sent;
+    // Носитель (16 блоков) и RAM заняты; часть RAM — голова и открытый блок
+    CHECK(q.blocksOnDevice() == 16);
+    CHECK(sent >= 16 * Spill::Items);
+    CHECK(q.stats().dropped == 1);
+
+    // Первый блок на носителе не читается: он пропускается целиком, остальное по порядку
+    dev.failRead = 0;
+    const uint32_t head = 2 * Spill::Items;
+    CHECK(drainInOrder(q, 0, head));
+    CHECK(drainInOrder(q, head + Spill::Items, sent - head - Spill::Items));
+    spill::Stats s = q.stats();
+    CHECK(s.ioErrors == 1 && s.dropped == 1 + Spill::Items);
+    CHECK(q.messagesWaiting() == 0);
+    q.stop();
+}
+
+TEST_CASE(slow_worker_with_full_device_does_not_wedge) {
+    static RamDevice dev;
+    Spill            q(&dev);
+    CHECK(q.start("spill", HelperPriority));  // служебная задача ниже производителя
+
+    // Заполнить носитель: при отказе уступить служебной задаче и повторить ту же запись
+    uint32_t sent = 0;
+    while (q.blocksOnDevice() < 16) {
+        if (q.send(make(sent))) {
+            ++sent;
+        } else {
+            vTaskDelay(1);
+        }
+    }
+    while (q.send(make(sent))) ++sent;
+
+    // Потребитель освобождает блоки, производитель без пауз пытается их занять
+    Record   r{};
+    uint32_t expected = 0;
+    bool     ok       = true;
+    for (int i = 0; i < 2000; ++i) {
+        if (q.receive(r, 0)) {
+            ok = ok && r.seq == expected && intact(r);
+            ++expected;
+        }
+        if (q.send(make(sent))) ++sent;
+    }
+    CHECK(ok);
+
+    // Производитель остановился: всё оставшееся дочитывается по порядку
+    CHECK(drainInOrder(q, expected, sent - expected, 50));
+    CHECK(q.messagesWaiting() == 0 && q.blocksOnDevice() == 0);
+    CHECK(q.stats().ioErrors == 0);
+    q.stop();
+}
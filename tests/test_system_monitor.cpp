@@ -0,0 +1,228 @@
+#include "TestHarness.h"
+
+#include "SimKernel.h"
+#include "SystemMonitor.h"
+#include "freertos/semphr.h"
+
+#include <cstdio>
+#include <cstring>
+
+// Доли CPU проверяются точно: в симуляторе время виртуальное, а модель стоимости нулевая.
+
+namespace {
+
+constexpr uint64_t TickNs = 1000000000ull / configTICK_RATE_HZ;
+
+using Monitor = SystemMonitor<8, 2>;
+
+void freshStart() {
+    sim::setCostModel(sim::CostModel::zero());
+    vTaskDelay(1);
+}
+
+Monitor::Config quietConfig() {
+    Monitor::Config cfg;
+    cfg.cpuLoadAlarm    = 10000;
+    cfg.taskCpuAlarm    = 10000;
+    cfg.stackAlarmWords = 0;
+    return cfg;
+}
+
+const Monitor::TaskInfo* byName(const Monitor::Report& r, const char* name) {
+    for (size_t i = 0; i < r.count; ++i) {
+        if (std::strcmp(r.tasks[i].name, name) == 0) return &r.tasks[i];
+    }
+    return nullptr;
+}
+
+struct StackArgs {
+    SemaphoreHandle_t go;
+    SemaphoreHandle_t done;
+};
+
+void deepStackTask(void* p) {
+    auto* a = static_cast<StackArgs*>(p);
+    sim::useStack(200);
+    xSemaphoreTake(a->go, portMAX_DELAY);
+    xSemaphoreGive(a->done);
+    vTaskDelete(nullptr);
+}
+
+void idleForever(void*) {
+    for (;;) vTaskDelay(portMAX_DELAY);
+}
+
+}  // namespace
+
+TEST_CASE(cpu_share_over_sliding_window) {
+    freshStart();
+    EventGroup      eg;
+    Monitor::Config cfg = quietConfig();
+    cfg.cpuLoadAlarm    = 7000;
+    cfg.taskCpuAlarm    = 7000;
+    Monitor mon(eg, cfg);
+
+    mon.sample();  // первый снимок только запоминает счётчики
+    CHECK(mon.lastReport().loadAvg == 0);
+    CHECK(mon.alarms() == 0);
+
+    sim::consume(3 * TickNs);
+    vTaskDelay(1);
+    mon.sample();
+    Monitor::Report r = mon.lastReport();
+    CHECK(r.sequence == 2);
+    CHECK(r.load == 7500);
+    CHECK(r.loadAvg == 7500);
+    const Monitor::TaskInfo* runner = byName(r, "runner");
+    const Monitor::TaskInfo* idle   = byName(r, "IDLE");
+    CHECK(runner && runner->cpu == 7500 && runner->cpuAvg == 7500);
+    CHECK(idle && idle->cpu == 2500);
+    CHECK(r.alarms == (Monitor::CpuLoad | Monitor::TaskCpu));
+    CHECK(eg.getBits() == (Monitor::CpuLoad | Monitor::TaskCpu));
+
+    // Простой: за последний период 0%, за окно из двух периодов — 3 тика из 8
+    vTaskDelay(4);
+    mon.sample();
+    r      = mon.lastReport();
+    runner = byName(r, "runner");
+    CHECK(r.load == 0);
+    CHECK(r.loadAvg == 3750);
+    CHECK(runner && runner->cpu == 0 && runner->cpuAvg == 3750);
+    CHECK(r.alarms == 0);
+    CHECK(eg.getBits() == 0);
+}
+
+TEST_CASE(stack_high_water_alarm) {
+    freshStart();
+    EventGroup      eg;
+    Monitor::Config cfg = quietConfig();
+    cfg.stackAlarmWords = 100;
+    Monitor   mon(eg, cfg);
+    StackArgs args{xSemaphoreCreateBinary(), xSemaphoreCreateBinary()};
+    xTaskCreate(deepStackTask, "deep", 256, &args, test::RunnerPriority + 1, nullptr);
+
+    mon.sample();
+    Monitor::Report          r    = mon.lastReport();
+    const Monitor::TaskInfo* deep = byName(r, "deep");
+    CHECK(deep && deep->stackFree == 56);
+    CHECK(deep && deep->state == eBlocked);
+    CHECK(eg.getBits() == Monitor::StackLow);
+
+    // Задача удалена — тревога снимается на следующем снимке
+    xSemaphoreGive(args.go);
+    CHECK(xSemaphoreTake(args.done, portMAX_DELAY) == pdTRUE);
+    mon.sample();
+    r = mon.lastReport();
+    CHECK(byName(r, "deep") == nullptr);
+    CHECK(eg.getBits() == 0);
+    vSemaphoreDelete(args.go);
+    vSemaphoreDelete(args.done);
+}
+
+TEST_CASE(too_many_tasks_alarm) {
+    using Tiny = SystemMonitor<1, 1>;
+    EventGroup eg;
+    Tiny       mon(eg);  // раннер и IDLE уже не помещаются
+    mon.sample();
+    CHECK(mon.alarms() == Tiny::TooManyTasks);
+    CHECK(eg.getBits() == Tiny::TooManyTasks);
+    CHECK(mon.lastReport().count == 0);
+}
+
+// Таблица полна, одна задача удалена и создана другая в том же периоде:
+// новая занимает место удалённой, а не пишет за край
+TEST_CASE(task_replaced_while_table_is_full) {
+    freshStart();
+    EventGroup   eg;
+    Monitor      mon(eg, quietConfig());
+    TaskHandle_t fillers[8] = {};
+    size_t       made       = 0;
+    char         name[configMAX_TASK_NAME_LEN];
+    while (uxTaskGetNumberOfTasks() < 8) {
+        std::snprintf(name, sizeof(name), "fill%u", unsigned(made));
+        xTaskCreate(idleForever, name, configMINIMAL_STACK_SIZE, nullptr, test::RunnerPriority - 1, &fillers[made++]);
+    }
+    mon.sample();
+    mon.sample();
+    CHECK(mon.lastReport().count == 8 && mon.alarms() == 0);
+
+    vTaskDelete(fillers[0]);
+    xTaskCreate(idleForever, "fresh", configMINIMAL_STACK_SIZE, nullptr, test::RunnerPriority - 1, &fillers[0]);
+    sim::consume(TickNs);
+    vTaskDelay(1);
+    mon.sample();
+    Monitor::Report r = mon.lastReport();
+    CHECK(r.count == 8 && r.alarms == 0);
+    CHECK(byName(r, "fill0") == nullptr && byName(r, "fresh") != nullptr);
+    const Monitor::TaskInfo* runner = byName(r, "runner");
+    CHECK(runner && runner->cpu == 5000);
+
+    for (size_t i = 0; i < made; ++i) vTaskDelete(fillers[i]);
+}
+
+TEST_CASE(alarm_bits_are_shifted_and_keep_foreign_bits) {
+    freshStart();
+    EventGroup eg;
+    eg.setBits(0x1);
+    Monitor::Config cfg = quietConfig();
+    cfg.cpuLoadAlarm    = 5000;
+    cfg.alarmShift      = 4;
+    Monitor mon(eg, cfg);
+
+    mon.sample();
+    sim::consume(TickNs);
+    vTaskDelay(1);
+    mon.sample();
+    CHECK(eg.getBits() == (0x1 | (Monitor::CpuLoad << 4)));
+
+    vTaskDelay(10);
+    mon.sample();
+    CHECK(eg.getBits() == 0x1);
+}
+
+TEST_CASE(snapshot_layout) {
+    freshStart();
+    EventGroup eg;
+    Monitor    mon(eg, quietConfig());
+    mon.sample();
+    sim::consume(TickNs);
+    vTaskDelay(1);
+    mon.sample();
+    Monitor::Report r = mon.lastReport();
+
+    uint8_t buf[Monitor::SnapshotSize];
+    CHECK(mon.snapshot(buf, Monitor::HeaderSize) == 0);
+    size_t n = mon.snapshot(buf, sizeof(buf));
+    CHECK(n == Monitor::HeaderSize + Monitor::EntrySize * r.count);
+    CHECK(buf[0] == 0x53 && buf[1] == 0x4D);
+    CHECK(buf[2] == Monitor::SnapshotVersion);
+    CHECK(buf[3] == r.count);
+    CHECK((buf[4] | buf[5] << 8) == static_cast<int>(r.sequence));
+    CHECK((buf[8] | buf[9] << 8) == 5000);
+
+    for (size_t i = 0; i < r.count; ++i) {
+        const uint8_t* e = buf + Monitor::HeaderSize + i * Monitor::EntrySize;
+        CHECK((e[0] | e[1] << 8) == static_cast<int>(r.tasks[i].number));
+        CHECK((e[2] | e[3] << 8) == r.tasks[i].cpuAvg);
+        CHECK(e[6] == r.tasks[i].priority);
+        CHECK(std::strncmp(reinterpret_cast<const char*>(e + 8), r.tasks[i].name, Monitor::SnapshotName) == 0);
+    }
+}
+
+TEST_CASE(service_task_samples_every_period) {
+    freshStart();
+    EventGroup      eg;
+    Monitor::Config cfg = quietConfig();
+    cfg.period          = 10;
+    {
+        Monitor mon(eg, cfg);
+        CHECK(mon.start("sysmon", test::RunnerPriority + 1));
+        CHECK(!mon.start());
+        vTaskDelay(35);
+        Monitor::Report r = mon.lastReport();
+        CHECK(r.sequence == 3);
+        CHECK(byName(r, "sysmon") != nullptr);
+        CHECK(r.loadAvg == 0);  // раннер спал, монитор работает за нулевую стоимость
+    }
+    CHECK(uxTaskGetNumberOfTasks() == 2);  // деструктор удалил задачу монитора
+}
@@ -0,0 +1,235 @@
+#include "TestHarness.h"
+
+// Собирается с FREERTOS_CPP_TRACE=1 и маленьким кольцом (см. tests/CMakeLists.txt)
+#include "EvenGroupCpp.h"
+#include "Guarded.h"
+#include "QueueCpp.h"
+#include "Trace.h"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+struct Dump {
+    trace::FileHeader             header;
+    std::vector<trace::NameEntry> names;
+    trace::CoreHeader             core;
+    std::vector<trace::Record>    records;
+};
+
+void appendTo(const void* data, size_t size, void* ctx) {
+    auto* bytes = static_cast<std::vector<uint8_t>*>(ctx);
+    auto* p     = static_cast<const uint8_t*>(data);
+    bytes->insert(bytes->end(), p, p + size);
+}
+
+template <typename T>
+void take(const std::vector<uint8_t>& bytes, size_t& pos, T& value) {
+    std::memcpy(&value, bytes.data() + pos, sizeof(T));
+    pos += sizeof(T);
+}
+
+Dump dumpNow() {
+    std::vector<uint8_t> bytes;
+    trace::dump(appendTo, &bytes);
+    Dump   d{};
+    size_t pos = 0;
+    take(bytes, pos, d.header);
+    d.names.resize(d.header.nameCount);
+    for (auto& n : d.names) take(bytes, pos, n);
+    take(bytes, pos, d.core);
+    d.records.resize(d.core.count);
+    for (auto& r : d.records) take(bytes, pos, r);
+    CHECK(pos == bytes.size());
+    return d;
+}
+
+// События одного объекта
+std::vector<trace::Record> of(const Dump& d, const void* object) {
+    std::vector<trace::Record> r;
+    for (const auto& rec : d.records) {
+        if (rec.object == trace::objectId(object)) r.push_back(rec);
+    }
+    return r;
+}
+
+uint32_t self() {
+    return trace::objectId(xTaskGetCurrentTaskHandle());
+}
+
+struct ContentionArgs {
+    Guarded<int>*    shared;
+    Queue<uint32_t>* queue;
+    QueueHandle_t    done;
+};
+
+void contenderTask(void* p) {
+    auto* a = static_cast<ContentionArgs*>(p);
+    trace::nameTask();
+    for (uint32_t i = 0; i < 4; ++i) {
+        {
+            auto s = (*a->shared)();
+            ++*s;
+            vTaskDelay(1);  // держим мьютекс, пока раннер ждёт
+        }
+        a->queue->send(i, 100);
+    }
+    xSemaphoreGive(a->done);
+    vTaskDelete(nullptr);
+}
+
+}  // namespace
+
+TEST_CASE(trace_header_and_names) {
+    trace::reset();
+    Queue<int> q(2);
+    q.setTraceName("queue_with_long_name");
+    Dump d = dumpNow();
+    CHECK(d.header.magic == trace::FileMagic);
+    CHECK(d.header.version == trace::FileVersion);
+    CHECK(d.header.recordSize == sizeof(trace::Record));
+    CHECK(d.header.cores == trace::Cores);
+    CHECK(d.header.clockHz > 0);
+    CHECK(!d.names.empty());
+    const trace::NameEntry& n = d.names.back();
+    CHECK(n.object == trace::objectId(q.nativeHandle()));
+    CHECK(std::strcmp(n.name, "queue_with_long") == 0);  // обрезано до NameLength-1
+}
+
+TEST_CASE(trace_queue_events_carry_depth) {
+    trace::reset();
+    Queue<int> q(2);
+    CHECK(q.send(1));
+    CHECK(q.send(2));
+    CHECK(!q.send(3));
+    int v = 0;
+    CHECK(q.receive(v));
+
+    auto r = of(dumpNow(), q.nativeHandle());
+    CHECK(r.size() == 4);
+    if (r.size() != 4) return;
+    CHECK(r[0].event() == trace::Event::QueueSend && r[0].arg() == 1);
+    CHECK(r[1].event() == trace::Event::QueueSend && r[1].arg() == 2);
+    CHECK(r[2].event() == trace::Event::QueueSendFail && r[2].arg() == 2);
+    CHECK(r[3].event() == trace::Event::QueueReceive && r[3].arg() == 1);
+    CHECK(r[0].task == self());
+}
+
+TEST_CASE(trace_queue_block_and_timeout) {
+    trace::reset();
+    Queue<int> q(1);
+    int        v = 0;
+    CHECK(!q.receive(v, 2));
+    CHECK(!q.receive(v));  // без ожидания — блокировки нет
+
+    auto r = of(dumpNow(), q.nativeHandle());
+    CHECK(r.size() == 3);
+    if (r.size() != 3) return;
+    CHECK(r[0].event() == trace::Event::QueueReceiveBlock);
+    CHECK(r[1].event() == trace::Event::QueueReceiveFail);
+    CHECK(r[2].event() == trace::Event::QueueReceiveFail);
+}
+
+TEST_CASE(trace_isr_events_use_isr_lane) {
+    trace::reset();
+    Queue<int> q(2);
+    BaseType_t woken = pdFALSE;
+    CHECK(q.sendFromISR(7, &woken));
+
+    auto r = of(dumpNow(), q.nativeHandle());
+    CHECK(r.size() == 1);
+    if (r.empty()) return;
+    CHECK(r[0].task == trace::IsrTask);
+    CHECK(r[0].event() == trace::Event::QueueSend && r[0].arg() == 1);
+}
+
+TEST_CASE(trace_guarded_lock_sequence) {
+    trace::reset();
+    Guarded<int> g;
+    {
+        auto a = g();
+        *a     = 5;
+    }
+    Dump d = dumpNow();
+    CHECK(d.records.size() == 3);
+    if (d.records.size() != 3) return;
+    CHECK(d.records[0].event() == trace::Event::LockRequest);
+    CHECK(d.records[1].event() == trace::Event::LockAcquired);
+    CHECK(d.records[2].event() == trace::Event::LockReleased);
+    CHECK(d.records[0].object == d.records[2].object);
+    CHECK(d.records[2].task == self());
+}
+
+TEST_CASE(trace_event_group_wait) {
+    trace::reset();
+    EventGroup eg;
+    eg.setBits(0x3);
+    CHECK(eg.waitBits(0x1, true, true) == 0x3);
+    eg.clearBits(0x2);
+
+    auto r = of(dumpNow(), eg.nativeHandle());
+    CHECK(r.size() == 4);
+    if (r.size() != 4) return;
+    CHECK(r[0].event() == trace::Event::EventSet && r[0].arg() == 0x3);
+    CHECK(r[1].event() == trace::Event::EventWaitBegin && r[1].arg() == 0x1);
+    CHECK(r[2].event() == trace::Event::EventWaitEnd && r[2].arg() == 0x3);
+    CHECK(r[3].event() == trace::Event::EventClear && r[3].arg() == 0x2);
+}
+
+TEST_CASE(trace_ring_keeps_newest) {
+    trace::reset();
+    const uint32_t total = trace::RingSize + 10;
+    for (uint32_t i = 0; i < total; ++i) trace::emit(trace::Event::EventSet, nullptr, i);
+
+    Dump d = dumpNow();
+    CHECK(d.core.count == trace::RingSize);
+    CHECK(d.core.lost == 10);
+    CHECK(d.records.front().arg() == 10);
+    CHECK(d.records.back().arg() == total - 1);
+    for (size_t i = 1; i < d.records.size(); ++i) {
+        CHECK(d.records[i].time - d.records[i - 1].time < 0x80000000u);  // по порядку записи
+    }
+}
+
+TEST_CASE(trace_recording_can_be_paused) {
+    trace::reset();
+    trace::setRecording(false);
+    trace::emit(trace::Event::EventSet, nullptr, 1);
+    trace::setRecording(true);
+    CHECK(dumpNow().records.empty());
+}
+
+// Пишет trace_test.bin для проверки конвертера (тест trace2perfetto_smoke)
+TEST_CASE(trace_dump_contention_for_converter) {
+    trace::reset();
+    trace::nameTask();
+    Guarded<int>    shared;
+    Queue<uint32_t> queue(2);
+    shared.setTraceName("shared");
+    queue.setTraceName("results");
+    *shared() = 0;  // Guarded не инициализирует int
+    ContentionArgs args{&shared, &queue, xSemaphoreCreateBinary()};
+    xTaskCreate(contenderTask, "contender", configMINIMAL_STACK_SIZE, &args, test::RunnerPriority + 1, nullptr);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        {
+            auto s = shared();
+            ++*s;
+        }
+        uint32_t v = 0;
+        CHECK(queue.receive(v, 100));
+    }
+    CHECK(xSemaphoreTake(args.done, pdMS_TO_TICKS(1000)) == pdTRUE);
+    vSemaphoreDelete(args.done);
+    CHECK(*shared() == 8);
+
+    trace::setRecording(false);
+    std::FILE* f = std::fopen("trace_test.bin", "wb");
+    CHECK(f != nullptr);
+    if (!f) return;
+    trace::dump(
+        [](const void* data, size_t size, void* ctx) { std::fwrite(data, 1, size, static_cast<std::FILE*>(ctx)); }, f);
+    std::fclose(f);
+    trace::setRecording(true);
+}
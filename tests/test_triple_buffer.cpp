@@ -0,0 +1,117 @@
+#include "TestHarness.h"
+
+#include "TripleBuffer.h"
+
+namespace {
+
+struct Frame {
+    uint32_t seq;
+    uint32_t data[64];
+
+    void fill(uint32_t s, bool yieldMidway = false) {
+        seq = s;
+        for (size_t i = 0; i < 64; ++i) {
+            data[i] = s;
+            if (yieldMidway && i == 32) taskYIELD();
+        }
+    }
+
+    bool consistent() const {
+        for (uint32_t v : data) {
+            if (v != seq) return false;
+        }
+        return true;
+    }
+};
+
+}  // namespace
+
+TEST_CASE(acquire_returns_latest_frame) {
+    auto* tb = new TripleBuffer<Frame>;
+    CHECK(!tb->acquire());
+    CHECK(!tb->hasNewer());
+
+    tb->writeBuffer().fill(1);
+    tb->publish();
+    tb->writeBuffer().fill(2);
+    tb->publish();
+    CHECK(tb->hasNewer());
+    CHECK(tb->acquire());
+    CHECK(tb->readBuffer().seq == 2 && tb->readBuffer().consistent());
+    CHECK(!tb->acquire());  // нового нет — кадр остаётся прежним
+    CHECK(tb->readBuffer().seq == 2);
+
+    CHECK(tb->published() == 2 && tb->consumed() == 1 && tb->skipped() == 1);
+    delete tb;
+}
+
+TEST_CASE(writer_and_reader_never_share_a_buffer) {
+    auto* tb = new TripleBuffer<Frame>;
+    for (uint32_t i = 0; i < 20; ++i) {
+        Frame& w = tb->writeBuffer();
+        CHECK(&w != &tb->readBuffer());
+        w.fill(i);
+        tb->publish();
+        if (i % 3 == 0) {
+            CHECK(tb->acquire());
+            CHECK(tb->readBuffer().seq == i);
+        }
+        CHECK(&tb->writeBuffer() != &tb->readBuffer());
+    }
+    delete tb;
+}
+
+TEST_CASE(wait_newer_times_out_and_wakes) {
+    static TripleBuffer<Frame> tb;
+    TickType_t                 start = xTaskGetTickCount();
+    CHECK(!tb.waitNewer(5));
+    CHECK(xTaskGetTickCount() - start >= 5);
+
+    xTaskCreate(
+        [](void*) {
+            vTaskDelay(3);
+            tb.writeBuffer().fill(7);
+            tb.publish();
+            vTaskDelete(nullptr);
+        },
+        "producer", configMINIMAL_STACK_SIZE, nullptr, test::RunnerPriority - 1, nullptr);
+    start = xTaskGetTickCount();
+    CHECK(tb.waitNewer(100));
+    CHECK(tb.readBuffer().seq == 7);
+    CHECK(xTaskGetTickCount() - start >= 3 && xTaskGetTickCount() - start < 10);
+    vTaskDelay(2);
+}
+
+TEST_CASE(concurrent_frames_are_never_torn) {
+    static TripleBuffer<Frame> tb;
+    static constexpr uint32_t  Frames = 500;
+    static uint32_t            base;
+    base = tb.published();
+    const uint32_t consumedBefore = tb.consumed();
+    const uint32_t skippedBefore  = tb.skipped();
+
+    xTaskCreate(
+        [](void*) {
+            for (uint32_t i = 1; i <= Frames; ++i) {
+                tb.writeBuffer().fill(1000 + i, true);
+                tb.publish();
+                taskYIELD();
+            }
+            vTaskDelete(nullptr);
+        },
+        "producer", configMINIMAL_STACK_SIZE * 2, nullptr, test::RunnerPriority, nullptr);
+
+    uint32_t last = 0;
+    bool     ok   = true;
+    while (last != 1000 + Frames && tb.waitNewer(1000)) {
+        const Frame& f = tb.readBuffer();
+        ok             = ok && f.consistent() && f.seq > last;
+        last           = f.seq;
+        taskYIELD();
+    }
+    CHECK(ok);
+    CHECK(last == 1000 + Frames);
+    vTaskDelay(2);
+    CHECK(tb.published() - base == Frames);
+    CHECK((tb.consumed() - consumedBefore) + (tb.skipped() - skippedBefore) == Frames);
+}